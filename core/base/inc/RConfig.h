@@ -441,6 +441,14 @@
 #    define R__HIDDEN
 #endif
 
+/* thread local storage class of file statics (not defined when the      */
+/* compiler does not support it, the caller must then provide a fallback) */
+#if !defined(__CINT__) && defined(_MSC_VER)
+#    define R__TLS __declspec(thread)
+#elif !defined(__CINT__) && ((defined(__GNUC__) && !defined(__APPLE__)) || defined(__INTEL_COMPILER))
+#    define R__TLS __thread
+#endif
+
 #ifdef __INTEL_COMPILER
 #   define R__INTEL_COMPILER
 #   define R__ANSISTREAM      /* ANSI C++ Standard Library conformant */
@@ -29,8 +29,6 @@
 #include "TObjArray.h"
 #endif
 
-class TExMap;
-
 class TProcessID : public TNamed {
 
 private:
@@ -39,13 +37,16 @@ private:
 
 protected:
    Int_t              fCount;     //!Reference count to this object (from TFile)
-   TObjArray         *fObjects;   //!Array pointing to the referenced objects
-   
+   TObjArray *volatile fObjects;  //!Array pointing to the referenced objects
+   TObjArray         *fRetired;   //!Arrays replaced by a larger one or cleared, kept for GetObjectWithID
+
    static TProcessID *fgPID;      //Pointer to current session ProcessID
    static TObjArray  *fgPIDs;     //Table of ProcessIDs
-   static TExMap     *fgObjPIDs;  //Table pointer to pids
    static UInt_t      fgNumber;   //Referenced objects count
-  
+
+   void               Retire(TObjArray *objects);
+   void               SetObjectAt(UInt_t uid, TObject *obj);
+
 public:
    TProcessID();
    virtual ~TProcessID();
@@ -54,7 +55,7 @@ public:
    Int_t            DecrementCount();
    Int_t            IncrementCount();
    Int_t            GetCount() const {return fCount;}
-   TObjArray       *GetObjects() const {return fObjects;}
+   TObjArray       *GetObjects() const;
    TObject         *GetObjectWithID(UInt_t uid);
    void             PutObjectWithID(TObject *obj, UInt_t uid=0);
    virtual void     RecursiveRemove(TObject *obj);
@@ -42,6 +42,7 @@ private:
    static ReAllocFun_t   fgReAllocHook;        // custom ReAlloc
    static ReAllocCFun_t  fgReAllocCHook;       // custom ReAlloc with length check
    static Bool_t         fgHasCustomNewDelete; // true if using ROOT's new/delete
+   static Bool_t         fgHasSlabAllocator;   // true if small objects are allocated in slabs
 
 public:
    virtual ~TStorage() { }
@@ -73,6 +74,14 @@ public:
 
    static Bool_t HasCustomNewDelete();
 
+   // slab allocator for small objects
+   static void   EnableSlabAllocator(Bool_t enable = kTRUE);
+   static Bool_t HasSlabAllocator();
+   static Int_t  GetSlabClasses();
+   static size_t GetSlabClassSize(Int_t iclass);
+   static size_t GetSlabChunkSize();
+   static void   GetSlabStatistics(Int_t iclass, Long64_t &nalloc, Long64_t &nfree, Long64_t &nchunks);
+
    // only valid after call to a TStorage allocating method
    static void   AddToHeap(ULong_t begin, ULong_t end);
    static Bool_t IsOnHeap(void *p);
@@ -206,6 +206,7 @@ protected:
    void           InitChar(char c);               // Initialize from char
 
    enum { kAlignment = 16 };
+   enum { kFormBufSize = 512 };         // size of the stack buffer used by AppendFormat
    static Ssiz_t  Align(Ssiz_t s) { return (s + (kAlignment-1)) & ~(kAlignment-1); }
    static Ssiz_t  Recommend(Ssiz_t s) { return (s < kMinCap ? kMinCap : Align(s+1)) - 1; }
    static Ssiz_t  AdjustCapacity(Ssiz_t oldCap, Ssiz_t newCap);
@@ -320,6 +321,11 @@ public:
    TString     &Append(const TString &s);
    TString     &Append(const TString &s, Ssiz_t n);
    TString     &Append(char c, Ssiz_t rep = 1);   // Append c rep times
+   TString     &AppendFormat(const char *fmt, ...)  // Append printf style formatted string
+#if defined(__GNUC__) && !defined(__CINT__)
+   __attribute__((format(printf, 2, 3)))   /* 1 is the this pointer */
+#endif
+   ;
    Int_t        Atoi() const;
    Long64_t     Atoll() const;
    Double_t     Atof() const;
@@ -39,7 +39,16 @@
 // its own fUniqueID to find the pointer to the referenced object.
 // See TProcessID::GetObjectWithID and PutObjectWithID.
 //
-// When a referenced object is deleted, its slot in fObjects is set to null.
+// When a referenced object is deleted, its slot in the table is set to null.
+//
+// GetObjectWithID does not take any lock: the table is only changed in
+// place slot by slot, under a lock. When it is too small it is replaced
+// by a larger copy, and the arrays replaced (or removed by Clear) are kept
+// until the TProcessID is deleted, so that a thread still reading them
+// never reads freed memory. AssignID gives the new unique ids with an
+// atomic counter and only locks a mutex chosen by the object address, so
+// that TRefs and TRefArrays can be created and dereferenced concurrently
+// by several threads.
 //
 // See also TProcessUUID: a specialized TProcessID to manage the single list
 // of TUUIDs.
@@ -55,9 +64,94 @@
 TObjArray  *TProcessID::fgPIDs   = 0; //pointer to the list of TProcessID
 TProcessID *TProcessID::fgPID    = 0; //pointer to the TProcessID of the current session
 UInt_t      TProcessID::fgNumber = 0; //Current referenced object instance count
-TExMap     *TProcessID::fgObjPIDs= 0; //Table (pointer,pids)
 ClassImp(TProcessID)
 
+#if defined(__GNUC__) || defined(__INTEL_COMPILER)
+#define R__PID_BARRIER() __sync_synchronize()
+#define R__PID_NEXTNUMBER(n) __sync_add_and_fetch(&(n), 1)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#pragma intrinsic(_ReadWriteBarrier, _InterlockedIncrement)
+#define R__PID_BARRIER() _ReadWriteBarrier()
+#define R__PID_NEXTNUMBER(n) (UInt_t)_InterlockedIncrement((volatile long*)&(n))
+#else
+#define R__PID_BARRIER()
+#endif
+
+namespace {
+
+   const Int_t   kMinObjects = 100;
+   const Int_t   kMaxObjects = 1 << 24;                 // uids have 24 bits
+   const Int_t   kNShards    = 16;
+   const Int_t   kAliveSize  = 1024;
+   const ULong_t kAliveFree  = 1;                       // tombstone
+
+   // Table (pointer,pid) of the objects referenced in more than 255 pids,
+   // split in shards with their own lock. The shard locks also serialize
+   // AssignID for a given object.
+   TExMap        *gObjPIDs[kNShards];
+   TVirtualMutex *gShardMutex[kNShards];
+   TVirtualMutex *gObjectsMutex = 0;
+
+   // Addresses of the existing TProcessIDs, for the lock-free IsValid.
+   volatile ULong_t gAlivePIDs[kAliveSize];
+   Bool_t           gAliveOverflow = kFALSE;
+
+   //___________________________________________________________________________
+   inline Int_t Shard(const void *obj)
+   {
+      // Shard of the object at obj.
+
+      return Int_t(((ULong_t)obj >> 4) ^ ((ULong_t)obj >> 12)) & (kNShards-1);
+   }
+
+   //___________________________________________________________________________
+   inline Int_t AliveSlot(const void *pid)
+   {
+      // First slot of pid in gAlivePIDs.
+
+      return Int_t(((ULong_t)pid >> 4) * 2654435761UL) & (kAliveSize-1);
+   }
+
+   //___________________________________________________________________________
+   Int_t FindAlive(const void *pid)
+   {
+      // Return the slot of pid in gAlivePIDs, -1 if not found.
+
+      Int_t i = AliveSlot(pid);
+      for (Int_t n = 0; n < kAliveSize; n++, i = (i+1) & (kAliveSize-1)) {
+         ULong_t p = gAlivePIDs[i];
+         if (p == (ULong_t)pid) return i;
+         if (p == 0) return -1;
+      }
+      return -1;
+   }
+
+   //___________________________________________________________________________
+   void AddAlive(const void *pid)
+   {
+      // Register a new TProcessID. Called with gROOTMutex held.
+
+      Int_t i = AliveSlot(pid);
+      for (Int_t n = 0; n < kAliveSize; n++, i = (i+1) & (kAliveSize-1)) {
+         if (gAlivePIDs[i] == 0 || gAlivePIDs[i] == kAliveFree) {
+            gAlivePIDs[i] = (ULong_t)pid;
+            return;
+         }
+      }
+      gAliveOverflow = kTRUE;
+   }
+
+   //___________________________________________________________________________
+   void RemoveAlive(const void *pid)
+   {
+      // Unregister a deleted TProcessID. Called with gROOTMutex held.
+
+      Int_t i = FindAlive(pid);
+      if (i >= 0) gAlivePIDs[i] = kAliveFree;
+   }
+}
+
 //______________________________________________________________________________
 static inline ULong_t Void_Hash(const void *ptr)
 {
@@ -73,6 +167,10 @@ TProcessID::TProcessID()
 
    fCount = 0;
    fObjects = 0;
+   fRetired = 0;
+
+   R__LOCKGUARD2(gROOTMutex);
+   AddAlive(this);
 }
 
 //______________________________________________________________________________
@@ -80,9 +178,14 @@ TProcessID::~TProcessID()
 {
    // Destructor.
 
-   delete fObjects;
-   fObjects = 0;
+   Clear();
+   if (fRetired) {
+      fRetired->Delete();
+      delete fRetired;
+      fRetired = 0;
+   }
    R__LOCKGUARD2(gROOTMutex);
+   RemoveAlive(this);
    fgPIDs->Remove(this);
 }
 
@@ -120,17 +223,27 @@ UInt_t TProcessID::AssignID(TObject *obj)
    // If the object is not yet referenced, its kIsReferenced bit is set
    // and its fUniqueID set to the current number of referenced objects so far.
 
-   R__LOCKGUARD2(gROOTMutex);
-
    UInt_t uid = obj->GetUniqueID() & 0xffffff;
    if (obj == fgPID->GetObjectWithID(uid)) return uid;
+
+   // Only the threads assigning an id to the same object have to wait
+   // for each other.
+   R__LOCKGUARD2(gShardMutex[Shard(obj)]);
+
+   uid = obj->GetUniqueID() & 0xffffff;
    if (obj->TestBit(kIsReferenced)) {
       fgPID->PutObjectWithID(obj,uid);
       return uid;
    }
-   fgNumber++;
+#ifdef R__PID_NEXTNUMBER
+   uid = R__PID_NEXTNUMBER(fgNumber);
+#else
+   {
+      R__LOCKGUARD2(gROOTMutex);
+      uid = ++fgNumber;
+   }
+#endif
    obj->SetBit(kIsReferenced);
-   uid = fgNumber;
    obj->SetUniqueID(uid);
    fgPID->PutObjectWithID(obj,uid);
    return uid;
@@ -139,8 +252,17 @@ UInt_t TProcessID::AssignID(TObject *obj)
 //______________________________________________________________________________
 void TProcessID::CheckInit()
 {
-   // Initialize fObjects.
-   if (!fObjects) fObjects = new TObjArray(100);
+   // Allocate the table of referenced objects. This is done when the first
+   // object is stored (see SetObjectAt), so that the TProcessIDs of files
+   // without referenced objects do not use memory for it.
+
+   if (fObjects) return;
+   R__LOCKGUARD2(gObjectsMutex);
+   if (!fObjects) {
+      TObjArray *objects = new TObjArray(kMinObjects);
+      R__PID_BARRIER();
+      fObjects = objects;
+   }
 }
 
 //______________________________________________________________________________
@@ -159,10 +281,16 @@ void TProcessID::Cleanup()
 //______________________________________________________________________________
 void TProcessID::Clear(Option_t *)
 {
-   // delete the TObjArray pointing to referenced objects
+   // remove the TObjArray pointing to referenced objects
    // this function is called by TFile::Close("R")
+   // The array is only deleted with the TProcessID, since other threads
+   // may still be reading it in GetObjectWithID.
 
-   delete fObjects; fObjects = 0;
+   if (!fObjects) return;
+   R__LOCKGUARD2(gObjectsMutex);
+   TObjArray *objects = fObjects;
+   fObjects = 0;
+   Retire(objects);
 }
 
 //______________________________________________________________________________
@@ -198,15 +326,19 @@ TProcessID *TProcessID::GetProcessWithUID(UInt_t uid, const void *obj)
    // static function returning a pointer to TProcessID with its pid
    // encoded in the highest byte of uid
 
-   R__LOCKGUARD2(gROOTMutex);
-
    Int_t pid = (uid>>24)&0xff;
    if (pid==0xff) {
       // Look up the pid in the table (pointer,pid)
-      if (fgObjPIDs==0) return 0;
+      Int_t shard = Shard(obj);
+      R__LOCKGUARD2(gShardMutex[shard]);
+      if (gObjPIDs[shard]==0) return 0;
       ULong_t hash = Void_Hash(obj);
-      pid = fgObjPIDs->GetValue(hash,(Long_t)obj);
+      pid = gObjPIDs[shard]->GetValue(hash,(Long_t)obj);
    }
+   // the session ProcessID is always the first one
+   if (pid == 0 && fgPIDs) return fgPID;
+
+   R__LOCKGUARD2(gROOTMutex);
    return (TProcessID*)fgPIDs->At(pid);
 }
 
@@ -232,7 +364,6 @@ Int_t TProcessID::IncrementCount()
 {
    // Increase the reference count to this object.
 
-   if (!fObjects) fObjects = new TObjArray(100);
    fCount++;
    return fCount;
 }
@@ -250,11 +381,26 @@ UInt_t TProcessID::GetObjectCount()
 TObject *TProcessID::GetObjectWithID(UInt_t uidd)
 {
    //returns the TObject with unique identifier uid in the table of objects
+   //This function does not take any lock.
 
    Int_t uid = uidd & 0xffffff;  //take only the 24 lower bits
 
-   if (fObjects==0 || uid >= fObjects->GetSize()) return 0;
-   return fObjects->UncheckedAt(uid);
+   TObjArray *objects = fObjects;
+   if (objects==0 || uid >= objects->GetSize()) return 0;
+   return objects->UncheckedAt(uid);
+}
+
+//______________________________________________________________________________
+TObjArray *TProcessID::GetObjects() const
+{
+   //returns the array pointing to the referenced objects at the index of
+   //their unique identifier, 0 if no object was referenced yet.
+   //The array is the table itself: it may be replaced by a larger one when
+   //more objects are referenced, and must not be modified while other
+   //threads use this TProcessID.
+
+   R__LOCKGUARD2(gObjectsMutex);
+   return fObjects;
 }
 
 //______________________________________________________________________________
@@ -279,6 +425,11 @@ Bool_t TProcessID::IsValid(TProcessID *pid)
 {
    // static function. return kTRUE if pid is a valid TProcessID
 
+   if (fgPIDs==0) return kFALSE;
+   // Without lock: pid is valid if it is an existing TProcessID. The
+   // list of TProcessIDs is only searched if there are too many of them.
+   if (!gAliveOverflow) return FindAlive(pid) >= 0;
+
    R__LOCKGUARD2(gROOTMutex);
 
    if (fgPIDs==0) return kFALSE;
@@ -295,22 +446,23 @@ void TProcessID::PutObjectWithID(TObject *obj, UInt_t uid)
 
    if (uid == 0) uid = obj->GetUniqueID() & 0xffffff;
 
-   if (!fObjects) fObjects = new TObjArray(100);
-   fObjects->AddAtAndExpand(obj,uid);
+   SetObjectAt(uid, obj);
 
    obj->SetBit(kMustCleanup);
    if ( (obj->GetUniqueID()&0xff000000)==0xff000000 ) {
       // We have more than 255 pids we need to store this
       // pointer in the table(pointer,pid) since there is no
       // more space in fUniqueID
-      if (fgObjPIDs==0) fgObjPIDs = new TExMap;
+      Int_t shard = Shard(obj);
+      R__LOCKGUARD2(gShardMutex[shard]);
+      if (gObjPIDs[shard]==0) gObjPIDs[shard] = new TExMap;
       ULong_t hash = Void_Hash(obj);
 
       // We use operator() rather than Add() because
       // if the address has already been registered, we want to
       // update it's uniqueID (this can easily happen when the
       // referenced object have been stored in a TClonesArray.
-      (*fgObjPIDs)(hash, (Long_t)obj) = GetUniqueID();
+      (*gObjPIDs[shard])(hash, (Long_t)obj) = GetUniqueID();
    }
 }
 
@@ -323,9 +475,52 @@ void TProcessID::RecursiveRemove(TObject *obj)
    if (!fObjects) return;
    if (!obj->TestBit(kIsReferenced)) return;
    UInt_t uid = obj->GetUniqueID() & 0xffffff;
+   if (obj != GetObjectWithID(uid)) return;
+   R__LOCKGUARD2(gObjectsMutex);
    if (obj == GetObjectWithID(uid)) fObjects->RemoveAt(uid);
 }
 
+//______________________________________________________________________________
+void TProcessID::Retire(TObjArray *objects)
+{
+   //keeps an array no longer used as table until this TProcessID is
+   //deleted, since GetObjectWithID may still be reading it.
+   //Called with the table lock held.
+
+   if (!objects) return;
+   if (!fRetired) fRetired = new TObjArray(4);
+   fRetired->Add(objects);
+}
+
+//______________________________________________________________________________
+void TProcessID::SetObjectAt(UInt_t uid, TObject *obj)
+{
+   //stores obj (possibly 0) at the uid th slot in the table of objects.
+   //If the table is too small, it is replaced by a larger copy.
+
+   Int_t slot = uid & 0xffffff;
+   if (!obj && (!fObjects || slot >= fObjects->GetSize())) return;
+
+   R__LOCKGUARD2(gObjectsMutex);
+   TObjArray *objects = fObjects;
+   if (!objects || slot >= objects->GetSize()) {
+      if (!obj) return;
+      Int_t size = objects ? objects->GetSize() : kMinObjects;
+      while (size <= slot) size *= 2;
+      if (size > kMaxObjects) size = kMaxObjects;
+      TObjArray *larger = new TObjArray(size);
+      if (objects) {
+         for (Int_t i = 0; i <= objects->GetLast(); i++)
+            larger->AddAt(objects->UncheckedAt(i), i);
+      }
+      R__PID_BARRIER();
+      fObjects = larger;
+      Retire(objects);
+      objects = larger;
+   }
+   if (obj) objects->AddAt(obj, slot);
+   else     objects->RemoveAt(slot);
+}
 
 //______________________________________________________________________________
 void TProcessID::SetObjectCount(UInt_t number)
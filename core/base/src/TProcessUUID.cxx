@@ -23,7 +23,7 @@
 // When a TUUID is removed from the list, the corresponding bit
 // is reset in fActive.
 // The object corresponding to a TUUID at slot I can be found
-// via fObjects->At(I).
+// via GetObjectWithID(I).
 // One can use two mechanisms to find the object corresponding to a TUUID:
 //  1- the input is the TUUID.AsString. One can find the corresponding 
 //     TObjString object objs in fUUIDs via THashList::FindObject(name).
@@ -81,8 +81,7 @@ UInt_t TProcessUUID::AddUUID(TUUID &uuid, TObject *obj)
       objs->SetUniqueID(number);
       obj->SetUniqueID(number);
       obj->SetBit(kHasUUID);
-      if (number >= (UInt_t)fObjects->GetSize()) fObjects->AddAtAndExpand(obj,number);
-      if (fObjects->UncheckedAt(number) == 0) fObjects->AddAt(obj,number);
+      if (GetObjectWithID(number) == 0) SetObjectAt(number,obj);
       return number;
    }   
 
@@ -94,7 +93,7 @@ UInt_t TProcessUUID::AddUUID(TUUID &uuid, TObject *obj)
    obj->SetUniqueID(number);
    obj->SetBit(kHasUUID);
    fActive->SetBitNumber(number);
-   fObjects->AddAtAndExpand(obj,number);
+   SetObjectAt(number,obj);
    return number;
 }
 
@@ -136,7 +135,7 @@ void TProcessUUID::RemoveUUID(UInt_t number)
 {
    //Remove entry number in the list of uuids
    
-   if (number > (UInt_t)fObjects->GetSize()) return;
+   if (number > 0xffffff) return;
    TObjLink *lnk = fUUIDs->FirstLink();
    while (lnk) {
       TObject *obj = lnk->GetObject();
@@ -144,7 +143,7 @@ void TProcessUUID::RemoveUUID(UInt_t number)
          fUUIDs->Remove(lnk);
          delete obj;
          fActive->ResetBit(number);
-         fObjects->AddAt(0,number);
+         SetObjectAt(number,0);
          return;
       }
       lnk = lnk->Next();
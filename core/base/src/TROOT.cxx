@@ -1387,6 +1387,9 @@ void TROOT::InitSystem()
 
       fgMemCheck = gEnv->GetValue("Root.MemCheck", 0);
 
+      if (gEnv->GetValue("Root.ObjectSlabs", 0))
+         TStorage::EnableSlabAllocator();
+
       TObject::SetObjectStat(gEnv->GetValue("Root.ObjectStat", 0));
    }
 }
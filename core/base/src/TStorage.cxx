@@ -29,9 +29,26 @@
 // Set the compile option R__NOSTATS to de-activate all memory checking //
 // and statistics gathering in the system.                              //
 //                                                                      //
+// With the resource Root.ObjectSlabs (or EnableSlabAllocator()) the    //
+// small objects created via TObject::operator new are allocated in     //
+// 64 kB slabs of equal size blocks (in 16 bytes steps up to 256 bytes) //
+// instead of with malloc. Each thread keeps a cache of free blocks per //
+// size, so that most allocations and deallocations take no lock and    //
+// the objects created by a thread are close to each other in memory.   //
+// Blocks are exchanged with a global pool, protected by gGlobalMutex,  //
+// in batches. When a thread ends its free blocks return to the pool.   //
+// Slabs are never returned to the system. The allocation statistics    //
+// are printed by TMemStat::PrintSlabStatistics().                      //
+//                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include <stdlib.h>
+#ifdef WIN32
+#include <malloc.h>
+#include "Windows4Root.h"
+#else
+#include <pthread.h>
+#endif
 
 #include "TROOT.h"
 #include "TObjectTable.h"
@@ -70,6 +87,7 @@ void         *TStorage::fgFreeHookData;
 ReAllocFun_t  TStorage::fgReAllocHook;
 ReAllocCFun_t TStorage::fgReAllocCHook;
 Bool_t        TStorage::fgHasCustomNewDelete;
+Bool_t        TStorage::fgHasSlabAllocator;
 
 
 ClassImp(TStorage)
@@ -87,6 +105,298 @@ static void   **gTraceArray = 0;
 static Int_t    gTraceCapacity = 10, gTraceIndex = 0,
                 gMemSize = -1, gMemIndex = -1;
 
+//------------------------------------------------------------------------------
+// Slab allocator for small objects.
+
+namespace {
+
+   const size_t  kSlabGrain     = 16;                    // block size step
+   const size_t  kSlabMaxSize   = 256;                   // largest block
+   const Int_t   kSlabClasses   = kSlabMaxSize/kSlabGrain;
+   const Int_t   kSlabChunkBits = 16;
+   const size_t  kSlabChunkSize = size_t(1) << kSlabChunkBits;    // 64 kB slabs
+   const Int_t   kSlabTableBits = 16;
+   const Int_t   kSlabTableSize = 1 << kSlabTableBits;
+   const Int_t   kSlabMaxChunks = kSlabTableSize/2;      // keep the table half empty
+
+   struct SlabBlock_t {
+      SlabBlock_t *fNext;
+   };
+
+   struct SlabPool_t {
+      SlabBlock_t *fFree;         // free blocks in the global pool
+      Long64_t     fNchunks;      // number of slabs of this size
+      Long64_t     fNalloc;       // allocations of the threads that ended
+      Long64_t     fNfree;        // deallocations of the threads that ended
+   };
+
+   struct SlabCache_t {
+      SlabBlock_t *fFree[kSlabClasses];      // free blocks of this thread
+      Int_t        fCount[kSlabClasses];     // number of free blocks
+      Long64_t     fNalloc[kSlabClasses];    // number of allocations
+      Long64_t     fNfree[kSlabClasses];     // number of deallocations
+      SlabCache_t *fNextCache;               // list of all caches
+   };
+
+   SlabPool_t     gSlabPool[kSlabClasses];
+   SlabCache_t   *gSlabCaches = 0;           // caches of all threads
+   Int_t          gSlabNchunks = 0;
+
+   // Hash table of the slabs: the slab address, which is aligned on
+   // kSlabChunkSize, or'ed with 1 + the size class. Entries are written
+   // once, under gGlobalMutex, and read without lock.
+   volatile ULong_t gSlabTable[kSlabTableSize];
+
+#ifdef R__TLS
+   R__TLS SlabCache_t *gTlsSlabCache = 0;
+   // key whose destructor releases the cache when the thread ends
+#ifdef WIN32
+   DWORD          gSlabKey = FLS_OUT_OF_INDEXES;
+#else
+   pthread_key_t  gSlabKey;
+   Bool_t         gSlabKeyCreated = kFALSE;
+#endif
+#else
+   SlabCache_t   *gSharedSlabCache = 0;
+#endif
+
+   //___________________________________________________________________________
+   inline Int_t SlabClass(size_t size)
+   {
+      // Size class of a block of size bytes.
+
+      return Int_t((size + kSlabGrain - 1) / kSlabGrain) - 1;
+   }
+
+   //___________________________________________________________________________
+   inline Int_t SlabBatch(Int_t iclass)
+   {
+      // Number of blocks moved at once between a thread cache and the pool.
+
+      Int_t n = Int_t(4096 / ((iclass+1)*kSlabGrain));
+      return n < 8 ? 8 : n;
+   }
+
+   //___________________________________________________________________________
+   inline Int_t SlabHash(ULong_t base)
+   {
+      // Slot of the slab at base in gSlabTable.
+
+      return Int_t(((ULong64_t)(base >> kSlabChunkBits) * 0x9E3779B97F4A7C15ULL)
+                   >> (64 - kSlabTableBits));
+   }
+
+   //___________________________________________________________________________
+   inline Int_t SlabFind(const void *p)
+   {
+      // Return the size class of the block at p, or -1 if p is not in a slab.
+
+      ULong_t base = (ULong_t)p & ~(ULong_t)(kSlabChunkSize-1);
+      for (Int_t i = SlabHash(base); ; i = (i+1) & (kSlabTableSize-1)) {
+         ULong_t key = gSlabTable[i];
+         if (!key) return -1;
+         if ((key & ~(ULong_t)(kSlabChunkSize-1)) == base)
+            return Int_t(key & (kSlabChunkSize-1)) - 1;
+      }
+   }
+
+   //___________________________________________________________________________
+   Bool_t SlabNewChunk(Int_t iclass)
+   {
+      // Allocate a new slab for the size class and put its blocks in the
+      // pool. Must be called with gGlobalMutex held.
+
+      if (gSlabNchunks >= kSlabMaxChunks) return kFALSE;
+      void *mem = 0;
+#ifdef WIN32
+      mem = _aligned_malloc(kSlabChunkSize, kSlabChunkSize);
+#else
+      if (posix_memalign(&mem, kSlabChunkSize, kSlabChunkSize)) mem = 0;
+#endif
+      if (!mem) return kFALSE;
+
+      ULong_t base = (ULong_t)mem;
+      Int_t i = SlabHash(base);
+      while (gSlabTable[i]) i = (i+1) & (kSlabTableSize-1);
+      gSlabTable[i] = base | ULong_t(iclass+1);
+      gSlabNchunks++;
+      TStorage::AddToHeap(base, base + kSlabChunkSize);
+
+      // thread the blocks in address order
+      size_t size = (iclass+1)*kSlabGrain;
+      char *last = (char*)mem + (kSlabChunkSize/size - 1)*size;
+      SlabBlock_t *head = gSlabPool[iclass].fFree;
+      for (char *b = last; b >= (char*)mem; b -= size) {
+         ((SlabBlock_t*)b)->fNext = head;
+         head = (SlabBlock_t*)b;
+      }
+      gSlabPool[iclass].fFree = head;
+      gSlabPool[iclass].fNchunks++;
+      return kTRUE;
+   }
+
+#ifdef R__TLS
+   //___________________________________________________________________________
+#ifdef WIN32
+   VOID WINAPI SlabReleaseCache(PVOID p)
+#else
+   void SlabReleaseCache(void *p)
+#endif
+   {
+      // Called when a thread ends: give all the free blocks of its cache
+      // back to the pool, keep its counters and delete the cache.
+
+      SlabCache_t *cache = (SlabCache_t*)p;
+      if (!cache) return;
+      {
+         R__LOCKGUARD(gGlobalMutex);
+         for (Int_t iclass = 0; iclass < kSlabClasses; iclass++) {
+            SlabPool_t &pool = gSlabPool[iclass];
+            while (cache->fFree[iclass]) {
+               SlabBlock_t *b = cache->fFree[iclass];
+               cache->fFree[iclass] = b->fNext;
+               b->fNext = pool.fFree;
+               pool.fFree = b;
+            }
+            pool.fNalloc += cache->fNalloc[iclass];
+            pool.fNfree  += cache->fNfree[iclass];
+         }
+         SlabCache_t **link = &gSlabCaches;
+         while (*link && *link != cache) link = &(*link)->fNextCache;
+         if (*link) *link = cache->fNextCache;
+      }
+      if (gTlsSlabCache == cache) gTlsSlabCache = 0;
+      free(cache);
+   }
+#endif
+
+   //___________________________________________________________________________
+   SlabCache_t *SlabGetCache()
+   {
+      // Return the block cache of the calling thread, create it if needed.
+      // Without thread local storage all threads share one cache and the
+      // callers have to hold gGlobalMutex.
+
+#ifdef R__TLS
+      SlabCache_t *cache = gTlsSlabCache;
+#else
+      SlabCache_t *cache = gSharedSlabCache;
+#endif
+      if (cache) return cache;
+
+      // The cache is not a TObject: no recursion into ObjectAlloc.
+      cache = (SlabCache_t*) calloc(1, sizeof(SlabCache_t));
+      if (!cache) return 0;
+      {
+         R__LOCKGUARD(gGlobalMutex);
+         cache->fNextCache = gSlabCaches;
+         gSlabCaches = cache;
+#ifdef R__TLS
+#ifdef WIN32
+         if (gSlabKey == FLS_OUT_OF_INDEXES) gSlabKey = FlsAlloc(SlabReleaseCache);
+#else
+         if (!gSlabKeyCreated)
+            gSlabKeyCreated = (pthread_key_create(&gSlabKey, SlabReleaseCache) == 0);
+#endif
+#endif
+      }
+#ifdef R__TLS
+      gTlsSlabCache = cache;
+#ifdef WIN32
+      if (gSlabKey != FLS_OUT_OF_INDEXES) FlsSetValue(gSlabKey, cache);
+#else
+      if (gSlabKeyCreated) pthread_setspecific(gSlabKey, cache);
+#endif
+#else
+      gSharedSlabCache = cache;
+#endif
+      return cache;
+   }
+
+   //___________________________________________________________________________
+   Bool_t SlabRefill(SlabCache_t *cache, Int_t iclass)
+   {
+      // Move a batch of free blocks from the pool to the thread cache.
+
+      R__LOCKGUARD(gGlobalMutex);
+
+      SlabPool_t &pool = gSlabPool[iclass];
+      if (!pool.fFree && !SlabNewChunk(iclass)) return kFALSE;
+      Int_t n = SlabBatch(iclass);
+      while (n-- && pool.fFree) {
+         SlabBlock_t *b = pool.fFree;
+         pool.fFree = b->fNext;
+         b->fNext = cache->fFree[iclass];
+         cache->fFree[iclass] = b;
+         cache->fCount[iclass]++;
+      }
+      return kTRUE;
+   }
+
+   //___________________________________________________________________________
+   void SlabFlush(SlabCache_t *cache, Int_t iclass)
+   {
+      // Return a batch of free blocks from the thread cache to the pool,
+      // so that they can be reused by other threads.
+
+      R__LOCKGUARD(gGlobalMutex);
+
+      SlabPool_t &pool = gSlabPool[iclass];
+      Int_t n = SlabBatch(iclass);
+      while (n-- && cache->fFree[iclass]) {
+         SlabBlock_t *b = cache->fFree[iclass];
+         cache->fFree[iclass] = b->fNext;
+         cache->fCount[iclass]--;
+         b->fNext = pool.fFree;
+         pool.fFree = b;
+      }
+   }
+
+   //___________________________________________________________________________
+   void *SlabAlloc(size_t size)
+   {
+      // Allocate a block of at least size bytes in a slab. Returns 0 if
+      // no slab can be allocated.
+
+#ifndef R__TLS
+      R__LOCKGUARD(gGlobalMutex);
+#endif
+      SlabCache_t *cache = SlabGetCache();
+      if (!cache) return 0;
+      Int_t iclass = SlabClass(size);
+      if (!cache->fFree[iclass] && !SlabRefill(cache, iclass)) return 0;
+      SlabBlock_t *b = cache->fFree[iclass];
+      cache->fFree[iclass] = b->fNext;
+      cache->fCount[iclass]--;
+      cache->fNalloc[iclass]++;
+      return b;
+   }
+
+   //___________________________________________________________________________
+   void SlabDealloc(void *vp, Int_t iclass)
+   {
+      // Put the block at vp in the cache of the calling thread.
+
+#ifndef R__TLS
+      R__LOCKGUARD(gGlobalMutex);
+#endif
+      SlabCache_t *cache = SlabGetCache();
+      if (!cache) {
+         R__LOCKGUARD(gGlobalMutex);
+         SlabBlock_t *b = (SlabBlock_t*)vp;
+         b->fNext = gSlabPool[iclass].fFree;
+         gSlabPool[iclass].fFree = b;
+         return;
+      }
+      SlabBlock_t *b = (SlabBlock_t*)vp;
+      b->fNext = cache->fFree[iclass];
+      cache->fFree[iclass] = b;
+      cache->fNfree[iclass]++;
+      if (++cache->fCount[iclass] > 2*SlabBatch(iclass))
+         SlabFlush(cache, iclass);
+   }
+}
+
 
 //______________________________________________________________________________
 void TStorage::EnterStat(size_t size, void *p)
@@ -322,6 +632,12 @@ void *TStorage::ObjectAlloc(size_t sz)
    // TStorage::IsOnHeap() to find out if the just created object is on
    // the heap.
 
+   if (fgHasSlabAllocator && sz && sz <= kSlabMaxSize) {
+      // the slabs are already registered with AddToHeap
+      void *vp = SlabAlloc(sz);
+      if (vp) return vp;
+   }
+
    // Needs to be protected by global mutex
    R__LOCKGUARD(gGlobalMutex);
 
@@ -345,6 +661,23 @@ void TStorage::ObjectDealloc(void *vp)
 {
    // Used to deallocate a TObject on the heap (via TObject::operator delete()).
 
+   if (gSlabNchunks && vp) {
+      // objects allocated before the slab allocator was disabled are
+      // still returned to their slab
+      Int_t iclass = SlabFind(vp);
+      if (iclass >= 0) {
+#ifndef NOCINT
+         // to handle delete with placement called via CINT
+         Long_t gvp = 0;
+         if (gCint) gvp = gCint->Getgvp();
+         if ((Long_t)vp == gvp && gvp != (Long_t)PVOID)
+            return;
+#endif
+         SlabDealloc(vp, iclass);
+         return;
+      }
+   }
+
    // Needs to be protected by global mutex
    R__LOCKGUARD(gGlobalMutex);
 
@@ -478,6 +811,74 @@ void TStorage::SetCustomNewDelete()
    fgHasCustomNewDelete = kTRUE;
 }
 
+//______________________________________________________________________________
+void TStorage::EnableSlabAllocator(Bool_t enable)
+{
+   // Allocate the small objects created via TObject::operator new in
+   // slabs with per-thread caches (see class description). Objects
+   // allocated before are not affected. Typically set via the resource
+   // Root.ObjectSlabs.
+
+   fgHasSlabAllocator = enable;
+}
+
+//______________________________________________________________________________
+Bool_t TStorage::HasSlabAllocator()
+{
+   // Return true if the small objects are allocated in slabs.
+
+   return fgHasSlabAllocator;
+}
+
+//______________________________________________________________________________
+Int_t TStorage::GetSlabClasses()
+{
+   // Return the number of block sizes of the slab allocator.
+
+   return kSlabClasses;
+}
+
+//______________________________________________________________________________
+size_t TStorage::GetSlabClassSize(Int_t iclass)
+{
+   // Return the block size in bytes of the size class iclass.
+
+   if (iclass < 0 || iclass >= kSlabClasses) return 0;
+   return (iclass+1)*kSlabGrain;
+}
+
+//______________________________________________________________________________
+size_t TStorage::GetSlabChunkSize()
+{
+   // Return the size in bytes of the slabs of the slab allocator.
+
+   return kSlabChunkSize;
+}
+
+//______________________________________________________________________________
+void TStorage::GetSlabStatistics(Int_t iclass, Long64_t &nalloc, Long64_t &nfree,
+                                 Long64_t &nchunks)
+{
+   // Return the number of allocations and deallocations of blocks of the
+   // size class iclass, summed over all threads (including the ones that
+   // ended), and the number of slabs of this size. The counters of the other threads are read
+   // while they may change, so the numbers are approximate while threads
+   // are allocating objects.
+
+   nalloc = nfree = nchunks = 0;
+   if (iclass < 0 || iclass >= kSlabClasses) return;
+
+   R__LOCKGUARD(gGlobalMutex);
+
+   nalloc = gSlabPool[iclass].fNalloc;
+   nfree  = gSlabPool[iclass].fNfree;
+   for (SlabCache_t *cache = gSlabCaches; cache; cache = cache->fNextCache) {
+      nalloc += cache->fNalloc[iclass];
+      nfree  += cache->fNfree[iclass];
+   }
+   nchunks = gSlabPool[iclass].fNchunks;
+}
+
 #ifdef WIN32
 
 //______________________________________________________________________________
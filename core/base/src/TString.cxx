@@ -1964,6 +1964,30 @@ TString TString::Format(const char *va_(fmt), ...)
    return str;
 }
 
+//______________________________________________________________________________
+TString &TString::AppendFormat(const char *va_(fmt), ...)
+{
+   // Append to the string the result of formatting with a printf style
+   // format descriptor. The result is formatted in a buffer on the stack
+   // and copied once at the end of the string, without the temporary
+   // TString of s += TString::Format(...).
+
+   char local[kFormBufSize];
+
+   va_list ap;
+   va_start(ap, va_(fmt));
+   int n = vsnprintf(local, sizeof(local), va_(fmt), ap);
+   va_end(ap);
+   if (n >= 0 && n < (int)sizeof(local))
+      return Append(local, n);
+
+   TString str;
+   va_start(ap, va_(fmt));
+   str.FormImp(va_(fmt), ap);
+   va_end(ap);
+   return Append(str);
+}
+
 //---- Global String Handling Functions ----------------------------------------
 
 static const int cb_size  = 4096;
@@ -27,6 +27,7 @@
 #endif
 
 class TClass;
+class TClonesArena;
 
 
 class TClonesArray : public TObjArray {
@@ -34,6 +35,12 @@ class TClonesArray : public TObjArray {
 protected:
    TClass       *fClass;       //!Pointer to the class
    TObjArray    *fKeep;        //!Saved copies of pointers to objects
+   TClonesArena *fArena;       //!Slabs in which the objects are constructed
+
+   static Bool_t fgUseArena;   //Default storage mode of new clones arrays
+
+   TObject         *NewObject();
+   void             FreeObject(TObject *obj);
 
 public:
    enum {
@@ -55,6 +62,8 @@ public:
    virtual void     ExpandCreate(Int_t n);
    virtual void     ExpandCreateFast(Int_t n);
    TClass          *GetClass() const { return fClass; }
+   Bool_t           GetUseArena() const;
+   void             SetUseArena(Bool_t arena = kTRUE);
    virtual void     SetOwner(Bool_t enable = kTRUE);
 
    void             AddFirst(TObject *) { MayNotUse("AddFirst"); }
@@ -84,6 +93,9 @@ public:
    TObject         *&operator[](Int_t idx);
    TObject         *operator[](Int_t idx) const;
 
+   static Bool_t    GetUseArenaDefault() { return fgUseArena; }
+   static void      SetUseArenaDefault(Bool_t arena = kTRUE) { fgUseArena = arena; }
+
    ClassDef(TClonesArray,4)  //An array of clone objects
 };
 
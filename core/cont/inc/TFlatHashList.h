@@ -0,0 +1,85 @@
+// @(#)root/cont:$Id$
+// Author: agent   18/10/26
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFlatHashList
+#define ROOT_TFlatHashList
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TFlatHashList                                                        //
+//                                                                      //
+// TFlatHashList is a list of TObject's with a flat hash index for      //
+// lookup. Like THashList the list keeps the objects ordered, but the   //
+// index is an open addressing (linear probing) table of (hash,object)  //
+// pairs instead of a THashTable of TList buckets: a lookup reads       //
+// consecutive slots instead of chasing list links, and adding an       //
+// object does not allocate a bucket link.                              //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_TList
+#include "TList.h"
+#endif
+
+
+class TFlatHashList : public TList {
+
+protected:
+   struct Slot_t {
+      ULong_t    fHash;     // hash value of the object
+      TObject   *fObject;   // object, 0 if the slot is empty
+   };
+
+   Slot_t     *fSlots;      //![fCapacity] index of the objects
+   Int_t       fCapacity;   //number of slots of the index (a power of 2)
+   Int_t       fTally;      //number of objects in the index
+
+   Int_t       GetHome(ULong_t hash) const;
+   void        IndexAdd(TObject *obj);
+   void        IndexRemove(TObject *obj);
+   void        IndexRemoveAt(Int_t slot);
+   void        IndexRemoveSlow(TObject *obj);
+
+private:
+   TFlatHashList(const TFlatHashList&);              // not implemented
+   TFlatHashList& operator=(const TFlatHashList&);   // not implemented
+
+public:
+   TFlatHashList(Int_t capacity=TCollection::kInitHashTableCapacity);
+   virtual    ~TFlatHashList();
+   Float_t    AverageCollisions() const;
+   void       Clear(Option_t *option="");
+   void       Delete(Option_t *option="");
+
+   TObject   *FindObject(const char *name) const;
+   TObject   *FindObject(const TObject *obj) const;
+   TObject   *FindNext(const char *name, Int_t &slot) const;
+
+   void       AddFirst(TObject *obj);
+   void       AddFirst(TObject *obj, Option_t *opt);
+   void       AddLast(TObject *obj);
+   void       AddLast(TObject *obj, Option_t *opt);
+   void       AddAt(TObject *obj, Int_t idx);
+   void       AddAfter(const TObject *after, TObject *obj);
+   void       AddAfter(TObjLink *after, TObject *obj);
+   void       AddBefore(const TObject *before, TObject *obj);
+   void       AddBefore(TObjLink *before, TObject *obj);
+   Int_t      GetCapacity() const { return fCapacity; }
+   void       RecursiveRemove(TObject *obj);
+   void       Rehash(Int_t newCapacity);
+   TObject   *Remove(TObject *obj);
+   TObject   *Remove(TObjLink *lnk);
+
+   ClassDef(TFlatHashList,0)  //Doubly linked list with a flat hash index for lookup
+};
+
+#endif
@@ -118,6 +118,20 @@
 //      must only be constructed/destructed at the beginning/end of the
 //      run.
 //
+//  NOTE 3
+//  ======
+//
+// By default each object is allocated separately on the heap. After
+// SetUseArena() (or for all new arrays after SetUseArenaDefault()) the
+// objects are instead constructed in large contiguous slabs owned by
+// the clones array, so that consecutive objects are consecutive in
+// memory. ExpandCreate(), ExpandCreateFast() and the Streamer reserve
+// one slab for all missing objects and the slabs grow geometrically.
+// Objects never move, so the pointers returned by the array stay valid.
+// The space of the objects released by Expand() or ExpandCreate() is
+// kept in the slabs for later reuse and is only returned to the system
+// when the clones array is deleted.
+//
 //////////////////////////////////////////////////////////////////////////
 
 #include <stdlib.h>
@@ -126,7 +140,167 @@
 #include "TROOT.h"
 #include "TClass.h"
 #include "TObjectTable.h"
+#include "TStorage.h"
+#include "TVirtualMutex.h"
+
+#include <vector>
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TClonesArena                                                         //
+//                                                                      //
+// Contiguous slabs of memory in which a TClonesArray constructs its    //
+// objects. All slots have the same size (the class size rounded up to  //
+// a multiple of 16 bytes). Slots are handed out sequentially from the  //
+// newest slab; released slots go to a free list. Slabs are reference   //
+// counted since AbsorbObjects() moves objects between clones arrays.   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+class TClonesArena {
+private:
+   struct Slab_t {
+      char   *fBegin;      // first slot
+      char   *fEnd;        // end of the last slot
+      Int_t   fRefs;       // number of arenas using this slab
+   };
+
+   size_t               fStride;      // size of a slot
+   Bool_t               fEnabled;     // allocate new objects in the slabs
+   char                *fNext;        // next free slot in the newest slab
+   char                *fLimit;       // end of the newest slab
+   Long64_t             fCapacity;    // number of slots in the own slabs
+   std::vector<Slab_t*> fSlabs;       // own and adopted slabs
+   std::vector<void*>   fFree;        // released slots
+
+   enum { kMinSlots = 16 };
+
+   TClonesArena(const TClonesArena&);            // not implemented
+   TClonesArena& operator=(const TClonesArena&); // not implemented
+
+public:
+   TClonesArena(size_t size, Bool_t enabled);
+   ~TClonesArena();
+
+   void   Adopt(const TClonesArena &other);
+   void  *Alloc();
+   size_t GetStride() const { return fStride; }
+   Bool_t IsEnabled() const { return fEnabled; }
+   Bool_t Owns(const void *p) const;
+   void   Release(void *p) { fFree.push_back(p); }
+   void   Reserve(Int_t n);
+   void   SetEnabled(Bool_t enabled) { fEnabled = enabled; }
+};
+
+//______________________________________________________________________________
+TClonesArena::TClonesArena(size_t size, Bool_t enabled)
+   : fStride((size + 15) & ~size_t(15)), fEnabled(enabled), fNext(0), fLimit(0),
+     fCapacity(0)
+{
+   // Create an arena for objects of size bytes. No memory is allocated
+   // before the first call to Alloc() or Reserve().
+
+   if (fStride == 0) fStride = 16;
+}
+
+//______________________________________________________________________________
+TClonesArena::~TClonesArena()
+{
+   // Release the slabs not used anymore by any other arena. The objects
+   // must have been destructed by the owning clones array.
+
+   for (UInt_t i = 0; i < fSlabs.size(); i++) {
+      Slab_t *slab = fSlabs[i];
+      if (--slab->fRefs == 0) {
+         ::operator delete(slab->fBegin);
+         delete slab;
+      }
+   }
+}
+
+//______________________________________________________________________________
+void TClonesArena::Adopt(const TClonesArena &other)
+{
+   // Share the slabs of the other arena, used when objects are moved
+   // from one clones array to another one.
+
+   for (UInt_t i = 0; i < other.fSlabs.size(); i++) {
+      Slab_t *slab = other.fSlabs[i];
+      Bool_t found = kFALSE;
+      for (UInt_t j = 0; j < fSlabs.size() && !found; j++)
+         found = (fSlabs[j] == slab);
+      if (found) continue;
+      slab->fRefs++;
+      fSlabs.push_back(slab);
+   }
+}
+
+//______________________________________________________________________________
+void *TClonesArena::Alloc()
+{
+   // Return the next free slot, allocating a new slab if needed.
+
+   if (fNext == fLimit) {
+      if (!fFree.empty()) {
+         void *p = fFree.back();
+         fFree.pop_back();
+         return p;
+      }
+      Reserve(1);
+   }
+   void *p = fNext;
+   fNext += fStride;
+   return p;
+}
 
+//______________________________________________________________________________
+Bool_t TClonesArena::Owns(const void *p) const
+{
+   // Return true if p points into one of the slabs. Since the slabs grow
+   // geometrically there are only a few of them.
+
+   const char *c = (const char*)p;
+   for (UInt_t i = 0; i < fSlabs.size(); i++)
+      if (c >= fSlabs[i]->fBegin && c < fSlabs[i]->fEnd) return kTRUE;
+   return kFALSE;
+}
+
+//______________________________________________________________________________
+void TClonesArena::Reserve(Int_t n)
+{
+   // Make sure that the next n calls to Alloc() do not need a new slab.
+   // A new slab holds at least n slots (minus the free ones) and at least
+   // as many as all the previous slabs, so that the number of slabs only
+   // grows logarithmically with the number of objects. The rest of the
+   // current slab is moved to the free list.
+
+   Long64_t room = (fLimit - fNext) / (Long64_t)fStride;
+   if (room + (Long64_t)fFree.size() >= n) return;
+
+   for (char *p = fLimit - fStride; room > 0; p -= fStride, room--)
+      fFree.push_back(p);
+
+   Long64_t nslots = n - (Long64_t)fFree.size();
+   if (nslots < fCapacity) nslots = fCapacity;
+   if (nslots < kMinSlots) nslots = kMinSlots;
+
+   Slab_t *slab = new Slab_t;
+   slab->fBegin = (char*) ::operator new(nslots * fStride);
+   slab->fEnd   = slab->fBegin + nslots * fStride;
+   slab->fRefs  = 1;
+   fSlabs.push_back(slab);
+   fCapacity += nslots;
+   fNext  = slab->fBegin;
+   fLimit = slab->fEnd;
+
+   // The objects are created on the heap (see TStorage::ObjectAlloc).
+   R__LOCKGUARD(gGlobalMutex);
+   TStorage::AddToHeap((ULong_t)slab->fBegin, (ULong_t)slab->fEnd);
+}
+
+
+Bool_t TClonesArray::fgUseArena = kFALSE;
 
 ClassImp(TClonesArray)
 
@@ -137,6 +311,7 @@ TClonesArray::TClonesArray() : TObjArray()
 
    fClass      = 0;
    fKeep       = 0;
+   fArena      = 0;
 }
 
 //______________________________________________________________________________
@@ -161,7 +336,8 @@ TClonesArray::TClonesArray(const char *classname, Int_t s, Bool_t) : TObjArray(s
    // The third argument is not used anymore and only there for backward
    // compatibility reasons.
 
-   fKeep = 0;
+   fKeep  = 0;
+   fArena = 0;
    SetClass(classname,s);
 }
 
@@ -187,7 +363,8 @@ TClonesArray::TClonesArray(const TClass *cl, Int_t s, Bool_t) : TObjArray(s)
    // The third argument is not used anymore and only there for backward
    // compatibility reasons.
 
-   fKeep = 0;
+   fKeep  = 0;
+   fArena = 0;
    SetClass(cl,s);
 }
 
@@ -198,6 +375,8 @@ TClonesArray::TClonesArray(const TClonesArray& tc): TObjArray(tc)
 
    fKeep = new TObjArray(tc.fSize);
    fClass = tc.fClass;
+   fArena = 0;
+   if (tc.GetUseArena()) SetUseArena();
 
    BypassStreamer(kTRUE);
 
@@ -226,9 +405,7 @@ TClonesArray& TClonesArray::operator=(const TClonesArray& tc)
 
    for (i = 0; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         if (TObject::GetObjectStat() && gObjectTable)
-            gObjectTable->RemoveQuietly(fKeep->fCont[i]);
-         ::operator delete(fKeep->fCont[i]);
+         FreeObject(fKeep->fCont[i]);
          fKeep->fCont[i] = 0;
          fCont[i] = 0;
       }
@@ -255,21 +432,18 @@ TClonesArray::~TClonesArray()
          TObject* p = fKeep->fCont[i];
          if (p && p->TestBit(kNotDeleted)) {
             // -- The TObject destructor has not been called.
-            fClass->Destructor(p);
+            // Objects in the arena slabs are destructed in place.
+            fClass->Destructor(p, fArena && fArena->Owns(p));
             fKeep->fCont[i] = 0;
          } else {
             // -- The TObject destructor was called, just free memory.
-            //
-            // remove any possible entries from the ObjectTable
-            if (TObject::GetObjectStat() && gObjectTable) {
-               gObjectTable->RemoveQuietly(p);
-            }
-            ::operator delete(p);
+            FreeObject(p);
             fKeep->fCont[i] = 0;
          }
       }
    }
    SafeDelete(fKeep);
+   SafeDelete(fArena);
 
    // Protect against erroneously setting of owner bit
    SetOwner(kFALSE);
@@ -469,9 +643,7 @@ void TClonesArray::Expand(Int_t newSize)
       // Expand() will shrink correctly
       for (int i = newSize; i < fSize; i++)
          if (fKeep->fCont[i]) {
-            if (TObject::GetObjectStat() && gObjectTable)
-               gObjectTable->RemoveQuietly(fKeep->fCont[i]);
-            ::operator delete(fKeep->fCont[i]);
+            FreeObject(fKeep->fCont[i]);
             fKeep->fCont[i] = 0;
          }
    }
@@ -498,9 +670,16 @@ void TClonesArray::ExpandCreate(Int_t n)
       Expand(TMath::Max(n, GrowBy(fSize)));
 
    Int_t i;
+   if (fArena && fArena->IsEnabled()) {
+      // allocate all the missing objects in one slab
+      Int_t nnew = 0;
+      for (i = 0; i < n; i++)
+         if (!fKeep->fCont[i]) nnew++;
+      fArena->Reserve(nnew);
+   }
    for (i = 0; i < n; i++) {
       if (!fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = NewObject();
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -510,9 +689,7 @@ void TClonesArray::ExpandCreate(Int_t n)
 
    for (i = n; i < fSize; i++)
       if (fKeep->fCont[i]) {
-         if (TObject::GetObjectStat() && gObjectTable)
-            gObjectTable->RemoveQuietly(fKeep->fCont[i]);
-         ::operator delete(fKeep->fCont[i]);
+         FreeObject(fKeep->fCont[i]);
          fKeep->fCont[i] = 0;
          fCont[i] = 0;
       }
@@ -536,9 +713,16 @@ void TClonesArray::ExpandCreateFast(Int_t n)
       Expand(TMath::Max(n, GrowBy(fSize)));
 
    Int_t i;
+   if (fArena && fArena->IsEnabled()) {
+      // allocate all the missing objects in one slab
+      Int_t nnew = 0;
+      for (i = 0; i < n; i++)
+         if (!fKeep->fCont[i]) nnew++;
+      fArena->Reserve(nnew);
+   }
    for (i = 0; i < n; i++) {
       if (!fKeep->fCont[i]) {
-         fKeep->fCont[i] = (TObject*)fClass->New();
+         fKeep->fCont[i] = NewObject();
       } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
          // The object has been deleted (or never initialized)
          fClass->New(fKeep->fCont[i]);
@@ -552,6 +736,24 @@ void TClonesArray::ExpandCreateFast(Int_t n)
    Changed();
 }
 
+//______________________________________________________________________________
+void TClonesArray::FreeObject(TObject *obj)
+{
+   // Release the space of an object whose destructor has already been
+   // called (or which was never constructed). Space in the arena slabs
+   // is kept for reuse, the other objects come from TStorage::ObjectAlloc
+   // (possibly in its slab allocator) or from the class operator new.
+
+   if (!obj) return;
+   // remove any possible entries from the ObjectTable
+   if (TObject::GetObjectStat() && gObjectTable)
+      gObjectTable->RemoveQuietly(obj);
+   if (fArena && fArena->Owns(obj))
+      fArena->Release(obj);
+   else
+      TStorage::ObjectDealloc(obj);
+}
+
 //______________________________________________________________________________
 TObject *TClonesArray::RemoveAt(Int_t idx)
 {
@@ -696,6 +898,7 @@ void TClonesArray::SetClass(const TClass *cl, Int_t s)
    delete [] name;
 
    fKeep = new TObjArray(s);
+   if (fgUseArena) SetUseArena();
 
    BypassStreamer(kTRUE);
 }
@@ -719,6 +922,39 @@ void TClonesArray::SetOwner(Bool_t /* enable */)
    // Nothing to be done.
 }
 
+//______________________________________________________________________________
+Bool_t TClonesArray::GetUseArena() const
+{
+   // Return true if new objects are constructed in the arena slabs.
+
+   return fArena && fArena->IsEnabled();
+}
+
+//______________________________________________________________________________
+void TClonesArray::SetUseArena(Bool_t arena)
+{
+   // Construct the new objects of the array in large contiguous slabs
+   // instead of allocating them one by one on the heap. Iterating over
+   // the objects and streaming them is then more cache friendly, in
+   // particular for arrays filled via ExpandCreate() or when reading.
+   // The objects already in the array are not moved.
+   // The default for new arrays is set by SetUseArenaDefault().
+
+   if (fArena) {
+      if (arena && fClass && fArena->GetStride() < (size_t)fClass->Size()) {
+         Error("SetUseArena", "arena slots are too small for class %s", fClass->GetName());
+         return;
+      }
+      fArena->SetEnabled(arena);
+   } else if (arena) {
+      if (!fClass) {
+         Error("SetUseArena", "invalid class specified in TClonesArray ctor");
+         return;
+      }
+      fArena = new TClonesArena(fClass->Size(), kTRUE);
+   }
+}
+
 //______________________________________________________________________________
 void TClonesArray::Sort(Int_t upto)
 {
@@ -798,6 +1034,10 @@ void TClonesArray::Streamer(TBuffer &b)
          //Error("Streamer", "expecting objects of type %s, finding objects"
          //   " of type %s", fClass->GetName(), cl->GetName());
          //return;
+         if (fArena && fArena->GetStride() < (size_t)cl->Size()) {
+            // the slots are too small for the new class
+            fArena->SetEnabled(kFALSE);
+         }
       }
 
       // make sure there are enough slots in the fKeep array
@@ -808,11 +1048,19 @@ void TClonesArray::Streamer(TBuffer &b)
       Int_t oldLast = fLast;
       fLast = nobjects-1;
 
+      if (fArena && fArena->IsEnabled()) {
+         // allocate all the missing objects in one slab
+         Int_t nnew = 0;
+         for (Int_t i = 0; i < nobjects; i++)
+            if (!fKeep->fCont[i]) nnew++;
+         fArena->Reserve(nnew);
+      }
+
       //TStreamerInfo *sinfo = fClass->GetStreamerInfo(clv);
       if (CanBypassStreamer() && !b.TestBit(TBuffer::kCannotHandleMemberWiseStreaming)) {
          for (Int_t i = 0; i < nobjects; i++) {
             if (!fKeep->fCont[i]) {
-               fKeep->fCont[i] = (TObject*)fClass->New();
+               fKeep->fCont[i] = NewObject();
             } else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                // The object has been deleted (or never initialized)
                fClass->New(fKeep->fCont[i]);
@@ -828,7 +1076,7 @@ void TClonesArray::Streamer(TBuffer &b)
             b >> nch;
             if (nch) {
                if (!fKeep->fCont[i])
-                  fKeep->fCont[i] = (TObject*)fClass->New();
+                  fKeep->fCont[i] = NewObject();
                else if (!fKeep->fCont[i]->TestBit(kNotDeleted)) {
                   // The object has been deleted (or never initialized)
                   fClass->New(fKeep->fCont[i]);
@@ -912,7 +1160,10 @@ TObject *&TClonesArray::operator[](Int_t idx)
       Expand(TMath::Max(idx+1, GrowBy(fSize)));
 
    if (!fKeep->fCont[idx]) {
-      fKeep->fCont[idx] = (TObject*) TStorage::ObjectAlloc(fClass->Size());
+      if (fArena && fArena->IsEnabled())
+         fKeep->fCont[idx] = (TObject*) fArena->Alloc();
+      else
+         fKeep->fCont[idx] = (TObject*) TStorage::ObjectAlloc(fClass->Size());
       // Reset the bit so that:
       //    obj = myClonesArray[i];
       //    obj->TestBit(TObject::kNotDeleted)
@@ -947,6 +1198,17 @@ TObject *TClonesArray::operator[](Int_t idx) const
    return fCont[idx];
 }
 
+//______________________________________________________________________________
+TObject *TClonesArray::NewObject()
+{
+   // Create an object of type fClass with the default ctor, in the arena
+   // slabs if enabled, otherwise on the heap.
+
+   if (fArena && fArena->IsEnabled())
+      return (TObject*)fClass->New(fArena->Alloc());
+   return (TObject*)fClass->New();
+}
+
 //______________________________________________________________________________
 TObject *TClonesArray::New(Int_t idx)
 {
@@ -984,6 +1246,12 @@ void TClonesArray::AbsorbObjects(TClonesArray *tc)
       return;
    }
 
+   // the objects of tc may live in its arena slabs
+   if (tc->fArena) {
+      if (!fArena) fArena = new TClonesArena(fClass->Size(), kFALSE);
+      fArena->Adopt(*tc->fArena);
+   }
+
    // cache the sorted status
    Bool_t wasSorted = IsSorted() && tc->IsSorted() &&
                       (Last() == 0 || Last()->Compare(tc->First()) == -1);
@@ -1029,6 +1297,12 @@ void TClonesArray::AbsorbObjects(TClonesArray *tc, Int_t idx1, Int_t idx2)
       return;
    }
 
+   // the objects of tc may live in its arena slabs
+   if (tc->fArena) {
+      if (!fArena) fArena = new TClonesArena(fClass->Size(), kFALSE);
+      fArena->Adopt(*tc->fArena);
+   }
+
    // cache the sorted status
    Bool_t wasSorted = IsSorted() && tc->IsSorted() &&
                       (Last() == 0 || Last()->Compare(tc->First()) == -1);
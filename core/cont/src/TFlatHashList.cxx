@@ -0,0 +1,437 @@
+// @(#)root/cont:$Id$
+// Author: agent   18/10/26
+
+/*************************************************************************
+ * Copyright (C) 1995-2013, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TFlatHashList                                                        //
+//                                                                      //
+// TFlatHashList implements a hybrid collection class consisting of a   //
+// flat hash index and a list to store TObject's. It can be used        //
+// instead of THashList: the list allows the objects to be ordered and  //
+// the index is used for quick lookup of objects by name or by hash     //
+// value (as returned by the TObject's Hash() function).                //
+//                                                                      //
+// The index is an open addressing table using linear probing. Each     //
+// slot holds the hash value and the address of one object, so that a   //
+// lookup compares the hash values of consecutive slots and only calls  //
+// GetName() or IsEqual() for the objects with the same hash value.     //
+// The table has a power of 2 number of slots, is kept at most half     //
+// full and grows automatically; Rehash() can be used to size it in     //
+// advance when the number of objects is known. Removing an object      //
+// moves back the following objects of its cluster, so that no          //
+// tombstones are left in the table.                                    //
+//                                                                      //
+// Several objects with the same name can be stored. FindObject()       //
+// returns one of them, FindNext() returns all of them.                 //
+// WARNING: if the name of an object in the list is modified, the list  //
+// must be rehashed.                                                    //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TFlatHashList.h"
+#include "TString.h"
+#include <string.h>
+
+
+ClassImp(TFlatHashList)
+
+//______________________________________________________________________________
+TFlatHashList::TFlatHashList(Int_t capacity) : fSlots(0), fCapacity(0), fTally(0)
+{
+   // Create a TFlatHashList object. Capacity is the number of objects the
+   // index can hold before growing.
+
+   Rehash(capacity);
+}
+
+//______________________________________________________________________________
+TFlatHashList::~TFlatHashList()
+{
+   // Delete a TFlatHashList. Objects are not deleted unless the list is the
+   // owner (set via SetOwner()).
+
+   Clear();
+   delete [] fSlots;
+}
+
+//______________________________________________________________________________
+inline Int_t TFlatHashList::GetHome(ULong_t hash) const
+{
+   // Return the first slot to probe for the hash value. The value is mixed
+   // since only its lowest bits select the slot.
+
+   UInt_t h = (UInt_t)(hash ^ (hash >> 16));
+   h *= 0x85ebca6bU;
+   h ^= h >> 13;
+   return Int_t(h & (fCapacity - 1));
+}
+
+//______________________________________________________________________________
+void TFlatHashList::IndexAdd(TObject *obj)
+{
+   // Add obj, which must already be linked in the list, to the index.
+   // If the index would become more than half full it is rebuilt from the
+   // list, which indexes obj as well.
+
+   if (!obj) return;
+   if (2*(fTally+1) > fCapacity) {
+      Rehash(2*(fTally+1));
+      return;
+   }
+
+   ULong_t hash = obj->Hash();
+   Int_t mask = fCapacity - 1;
+   Int_t slot = GetHome(hash);
+   while (fSlots[slot].fObject) slot = (slot + 1) & mask;
+   fSlots[slot].fHash   = hash;
+   fSlots[slot].fObject = obj;
+   fTally++;
+}
+
+//______________________________________________________________________________
+void TFlatHashList::IndexRemove(TObject *obj)
+{
+   // Remove obj from the index. The hash value of obj is used to find it;
+   // if it changed since obj was added, the whole index is scanned.
+
+   if (!obj || !fTally) return;
+
+   Int_t mask = fCapacity - 1;
+   for (Int_t slot = GetHome(obj->Hash()); fSlots[slot].fObject; slot = (slot + 1) & mask) {
+      if (fSlots[slot].fObject == obj) {
+         IndexRemoveAt(slot);
+         return;
+      }
+   }
+   IndexRemoveSlow(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::IndexRemoveAt(Int_t slot)
+{
+   // Empty the given slot of the index. The following objects of the
+   // cluster which would not be found anymore are moved back (backward
+   // shift deletion).
+
+   Int_t mask = fCapacity - 1;
+   Int_t next = slot;
+   while (1) {
+      next = (next + 1) & mask;
+      if (!fSlots[next].fObject) break;
+      Int_t home = GetHome(fSlots[next].fHash);
+      // The object can stay if its home is cyclically in ]slot,next].
+      Bool_t stay = (slot <= next) ? (slot < home && home <= next)
+                                   : (slot < home || home <= next);
+      if (stay) continue;
+      fSlots[slot] = fSlots[next];
+      slot = next;
+   }
+   fSlots[slot].fHash   = 0;
+   fSlots[slot].fObject = 0;
+   fTally--;
+}
+
+//______________________________________________________________________________
+void TFlatHashList::IndexRemoveSlow(TObject *obj)
+{
+   // Remove obj from the index without using its hash value, which may not
+   // be available anymore (e.g. when called from the object's destructor).
+
+   for (Int_t slot = 0; slot < fCapacity; slot++) {
+      if (fSlots[slot].fObject == obj) {
+         IndexRemoveAt(slot);
+         return;
+      }
+   }
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddFirst(TObject *obj)
+{
+   // Add object at the beginning of the list.
+
+   TList::AddFirst(obj);
+   IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddFirst(TObject *obj, Option_t *opt)
+{
+   // Add object at the beginning of the list and also store option.
+   // See THashList::AddFirst(TObject*,Option_t*).
+
+   TList::AddFirst(obj, opt);
+   IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddLast(TObject *obj)
+{
+   // Add object at the end of the list.
+
+   TList::AddLast(obj);
+   IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddLast(TObject *obj, Option_t *opt)
+{
+   // Add object at the end of the list and also store option.
+   // See THashList::AddLast(TObject*,Option_t*).
+
+   TList::AddLast(obj, opt);
+   IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddBefore(const TObject *before, TObject *obj)
+{
+   // Insert object before object before in the list.
+
+   Int_t size = fSize;
+   TList::AddBefore(before, obj);
+   if (fSize > size) IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddBefore(TObjLink *before, TObject *obj)
+{
+   // Insert object before object before in the list.
+
+   Int_t size = fSize;
+   TList::AddBefore(before, obj);
+   if (fSize > size) IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddAfter(const TObject *after, TObject *obj)
+{
+   // Insert object after object after in the list.
+
+   Int_t size = fSize;
+   TList::AddAfter(after, obj);
+   if (fSize > size) IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddAfter(TObjLink *after, TObject *obj)
+{
+   // Insert object after object after in the list.
+
+   Int_t size = fSize;
+   TList::AddAfter(after, obj);
+   if (fSize > size) IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::AddAt(TObject *obj, Int_t idx)
+{
+   // Insert object at location idx in the list.
+
+   TList::AddAt(obj, idx);
+   IndexAdd(obj);
+}
+
+//______________________________________________________________________________
+Float_t TFlatHashList::AverageCollisions() const
+{
+   // Return the average number of slots probed to find an object of the
+   // list. It stays close to 1 unless many objects have the same hash
+   // value (e.g. the same name).
+
+   if (!fTally) return 0;
+
+   Double_t probes = 0;
+   Int_t mask = fCapacity - 1;
+   for (Int_t slot = 0; slot < fCapacity; slot++) {
+      if (!fSlots[slot].fObject) continue;
+      probes += ((slot - GetHome(fSlots[slot].fHash)) & mask) + 1;
+   }
+   return Float_t(probes / fTally);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::Clear(Option_t *option)
+{
+   // Remove all objects from the list. Does not delete the objects unless
+   // the TFlatHashList is the owner (set via SetOwner()).
+
+   if (fTally) {
+      // clear the index first so no more lookups
+      memset(fSlots, 0, fCapacity*sizeof(Slot_t));
+      fTally = 0;
+   }
+   if (IsOwner())
+      TList::Delete(option);
+   else
+      TList::Clear(option);
+}
+
+//______________________________________________________________________________
+void TFlatHashList::Delete(Option_t *option)
+{
+   // Remove all objects from the list AND delete all heap based objects.
+   // If option="slow" then keep list consistent during delete. This allows
+   // recursive list operations during the delete (e.g. during the dtor
+   // of an object in this list one can still access the list to search for
+   // other not yet deleted objects).
+
+   Bool_t slow = option ? (!strcmp(option, "slow") ? kTRUE : kFALSE) : kFALSE;
+
+   if (!slow) {
+      if (fTally) {
+         // clear the index first so no more lookups
+         memset(fSlots, 0, fCapacity*sizeof(Slot_t));
+         fTally = 0;
+      }
+      TList::Delete(option);         // this deletes the objects
+   } else {
+      while (fFirst) {
+         TObjLink *tlk = fFirst;
+         fFirst = fFirst->Next();
+         fSize--;
+         // remove object from the index
+         IndexRemove(tlk->GetObject());
+         // delete only heap objects
+         if (tlk->GetObject() && tlk->GetObject()->IsOnHeap())
+            TCollection::GarbageCollect(tlk->GetObject());
+
+         delete tlk;
+      }
+      fFirst = fLast = fCache = 0;
+      fSize  = 0;
+   }
+}
+
+//______________________________________________________________________________
+TObject *TFlatHashList::FindObject(const char *name) const
+{
+   // Find object using its name. Uses the hash value returned by the
+   // TString::Hash() after converting name to a TString. If several
+   // objects have this name, one of them is returned.
+
+   Int_t slot = -1;
+   return FindNext(name, slot);
+}
+
+//______________________________________________________________________________
+TObject *TFlatHashList::FindObject(const TObject *obj) const
+{
+   // Find object using its hash value (returned by its Hash() member).
+
+   if (IsArgNull("FindObject", obj) || !fTally) return 0;
+
+   ULong_t hash = obj->Hash();
+   Int_t mask = fCapacity - 1;
+   for (Int_t slot = GetHome(hash); fSlots[slot].fObject; slot = (slot + 1) & mask) {
+      if (fSlots[slot].fHash == hash && fSlots[slot].fObject->IsEqual(obj))
+         return fSlots[slot].fObject;
+   }
+   return 0;
+}
+
+//______________________________________________________________________________
+TObject *TFlatHashList::FindNext(const char *name, Int_t &slot) const
+{
+   // Find the next object with the given name. Start with slot = -1;
+   // slot is updated so that the following calls return the other objects
+   // with this name, in no particular order, then 0. The list must not be
+   // modified in between. E.g.:
+   //    Int_t slot = -1;
+   //    while ((obj = list->FindNext(name, slot))) { ... }
+
+   if (!name || !fTally) return 0;
+
+   ULong_t hash = ::Hash(name);
+   Int_t mask = fCapacity - 1;
+   Int_t cur = (slot < 0) ? GetHome(hash) : ((slot + 1) & mask);
+   if (slot >= 0 && !fSlots[slot].fObject) return 0;
+   for (; fSlots[cur].fObject; cur = (cur + 1) & mask) {
+      if (fSlots[cur].fHash == hash && !strcmp(name, fSlots[cur].fObject->GetName())) {
+         slot = cur;
+         return fSlots[cur].fObject;
+      }
+   }
+   slot = cur;
+   return 0;
+}
+
+//______________________________________________________________________________
+void TFlatHashList::RecursiveRemove(TObject *obj)
+{
+   // Remove object from this collection and recursively remove the object
+   // from all other objects (and collections).
+   // The hash value of obj is not available anymore when RecursiveRemove
+   // is called from the TObject destructor, so the index is scanned.
+
+   if (!obj) return;
+
+   // Remove obj in the list itself
+   TObject *object = TList::Remove(obj);
+   if (object) IndexRemoveSlow(object);
+
+   // Scan again the list and invoke RecursiveRemove for all objects
+   TIter next(this);
+
+   while ((object = next())) {
+      if (object->TestBit(kNotDeleted)) object->RecursiveRemove(obj);
+   }
+}
+
+//______________________________________________________________________________
+void TFlatHashList::Rehash(Int_t newCapacity)
+{
+   // Resize the index so that it holds at least newCapacity objects while
+   // staying at most half full, and refill it in the order of the list.
+   // Must be called if the names of objects in the list were modified.
+   // Calling it with the expected number of objects before adding many
+   // objects avoids the successive automatic resizes.
+
+   if (newCapacity < fSize) newCapacity = fSize;
+   Int_t nslots = 16;
+   while (nslots < 2*newCapacity && nslots < (kMaxInt >> 1)) nslots <<= 1;
+
+   if (nslots != fCapacity) {
+      delete [] fSlots;
+      fSlots    = new Slot_t[nslots];
+      fCapacity = nslots;
+   }
+   memset(fSlots, 0, fCapacity*sizeof(Slot_t));
+   fTally = 0;
+
+   for (TObjLink *lnk = fFirst; lnk; lnk = lnk->Next()) IndexAdd(lnk->GetObject());
+}
+
+//______________________________________________________________________________
+TObject *TFlatHashList::Remove(TObject *obj)
+{
+   // Remove object from the list.
+
+   if (!obj || !FindObject(obj)) return 0;
+
+   TObject *ob = TList::Remove(obj);
+   IndexRemove(ob);
+   return ob;
+}
+
+//______________________________________________________________________________
+TObject *TFlatHashList::Remove(TObjLink *lnk)
+{
+   // Remove object via its objlink from the list.
+
+   if (!lnk) return 0;
+
+   TObject *obj = lnk->GetObject();
+
+   TList::Remove(lnk);
+   IndexRemove(obj);
+   return obj;
+}
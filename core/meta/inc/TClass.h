@@ -127,6 +127,8 @@ private:
    ROOT::DesFunc_t     fDestructor;     //pointer to a function call an object's destructor.
    ROOT::DirAutoAdd_t  fDirAutoAdd;     //pointer which implements the Directory Auto Add feature for this class.']'
    ClassStreamerFunc_t fStreamerFunc;   //Wrapper around this class custom Streamer member function.
+   mutable ClassStreamerInitFunc_t fCompiledStreamerInit; //!Initialization of the streamer generated by rootcint, not run yet.
+   mutable ClassStreamerFunc_t fCompiledStreamerFunc; //!Streamer generated by rootcint for the current layout of the class.
    Int_t               fSizeof;         //Sizeof the class.
 
    mutable Int_t      fCanSplit;        //!Indicates whether this class can be split or not.
@@ -167,6 +169,8 @@ private:
    void StreamerDefault(void *object, TBuffer &b, const TClass *onfile_class) const;
    
    static IdMap_t    *GetIdMap();       //Map from typeid to TClass pointer
+   static IdMap_t    *GetNameMap();     //Map from class name (and resolved names) to TClass pointer
+   static TClass     *LookupClass(const char *name, Bool_t load, Bool_t silent);
    static ENewType    fgCallingNew;     //Intent of why/how TClass::New() is called
    static Int_t       fgClassCount;     //provides unique id for a each class
                                         //stored in TObject::fUniqueID
@@ -306,6 +310,7 @@ public:
    ShowMembersFunc_t  GetShowMembersWrapper() const { return fShowMembers; }
    TClassStreamer    *GetStreamer() const; 
    ClassStreamerFunc_t GetStreamerFunc() const;
+   ClassStreamerFunc_t GetCompiledStreamerFunc() const;
    TObjArray         *GetStreamerInfos() const { return fStreamerInfo; }
    TVirtualStreamerInfo     *GetStreamerInfo(Int_t version=0) const;
    const type_info   *GetTypeInfo() const { return fTypeInfo; };
@@ -359,6 +364,7 @@ public:
    void               AdoptMemberStreamer(const char *name, TMemberStreamer *strm);
    void               SetMemberStreamer(const char *name, MemberStreamerFunc_t strm);
    void               SetStreamerFunc(ClassStreamerFunc_t strm);
+   void               SetCompiledStreamerInit(ClassStreamerInitFunc_t init);
 
    // Function to retrieve the TClass object and dictionary function
    static void           AddClass(TClass *cl);
@@ -59,6 +59,7 @@ namespace ROOT {
       DirAutoAdd_t                fDirAutoAdd;
       TClassStreamer             *fStreamer;
       ClassStreamerFunc_t         fStreamerFunc;
+      ClassStreamerInitFunc_t     fCompiledStreamerInit;
       TVirtualCollectionProxy    *fCollectionProxy;
       Int_t                       fSizeof;
       TCollectionProxyInfo       *fCollectionProxyInfo;
@@ -136,6 +137,7 @@ namespace ROOT {
       void                              SetReadRules( const std::vector<ROOT::TSchemaHelper>& rules );
       Short_t                           SetStreamer(ClassStreamerFunc_t);
       void                              SetStreamerFunc(ClassStreamerFunc_t);
+      void                              SetCompiledStreamerInit(ClassStreamerInitFunc_t);
       Short_t                           SetVersion(Short_t version);
 
       //   protected:
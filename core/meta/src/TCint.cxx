@@ -76,6 +76,17 @@ extern "C" int TCint_AutoLoadCallback(char *c, char *l) {
    return result;
 }
 
+static void *TCint_LockNameCache(bool lock, void *handle) {
+   // Lock and unlock the TClassEdit name cache with gCINTMutex.
+   if (lock) {
+      TVirtualMutex *mutex = gCINTMutex;
+      if (mutex) mutex->Lock();
+      return mutex;
+   }
+   if (handle) ((TVirtualMutex*)handle)->UnLock();
+   return 0;
+}
+
 extern "C" void *TCint_FindSpecialObject(char *c, G__ClassInfo *ci, void **p1, void **p2) {
    return TCint::FindSpecialObject(c, ci, p1, p2);
 }
@@ -117,7 +128,7 @@ int TCint_GenerateDictionary(const std::vector<std::string> &classes,
             chk = chk*3 + it->at(cursor);
          }
       }
-      fileName += TString::Format("_%u",chk);
+      fileName.AppendFormat("_%u",chk);
    }
    fileName += ".cxx";
 
@@ -297,6 +308,7 @@ TCint::TCint(const char *name, const char *title) : TInterpreter(name, title), f
    G__set_ignoreinclude(&IgnoreInclude);
    G__InitUpdateClassInfo(&TCint_UpdateClassInfo);
    G__InitGetSpecialObject(&TCint_FindSpecialObject);
+   TClassEdit::SetNameCacheLock(&TCint_LockNameCache);
 
    // check whether the compiler is available:
    char* path = gSystem->Which(gSystem->Getenv("PATH"), gSystem->BaseName(COMPILER));
@@ -698,6 +710,7 @@ void TCint::Reset()
    R__LOCKGUARD(gCINTMutex);
 
    G__scratch_upto(&fDictPos);
+   TClassEdit::ClearNameCache();
 }
 
 //______________________________________________________________________________
@@ -709,6 +722,7 @@ void TCint::ResetAll()
 
    G__init_cint("cint +V");
    G__init_process_cmd();
+   TClassEdit::ClearNameCache();
 }
 
 //______________________________________________________________________________
@@ -743,6 +757,7 @@ void TCint::RewindDictionary()
    R__LOCKGUARD(gCINTMutex);
 
    G__rewinddictionary();
+   TClassEdit::ClearNameCache();
 }
 
 //______________________________________________________________________________
@@ -2935,7 +2935,7 @@ int TCint_GenerateDictionary(const std::vector<std::string> &classes,
             chk = chk * 3 + it->at(cursor);
          }
       }
-      fileName += TString::Format("_%u", chk);
+      fileName.AppendFormat("_%u", chk);
    }
    fileName += ".cxx";
    if (gSystem->AccessPathName(fileName) != 0) {
@@ -147,71 +147,194 @@ static void MoveAddressInRepository(const char *where, void *oldadd, void *newad
 
 //______________________________________________________________________________
 //______________________________________________________________________________
-namespace ROOT {
-#define R__USE_STD_MAP
-   class TMapTypeToTClass {
-#if defined R__USE_STD_MAP
-     // This wrapper class allow to avoid putting #include <map> in the
-     // TROOT.h header file.
-   public:
-#ifdef R__GLOBALSTL
-      typedef map<string,TClass*>                 IdMap_t;
+// Memory barrier used to publish entries and tables of TMapTypeToTClass,
+// and the compiled streamers, to the lock-free readers.
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1))
+#define R__CLASSMAP_BARRIER() __sync_synchronize()
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define R__CLASSMAP_BARRIER() _ReadWriteBarrier()
 #else
-      typedef std::map<std::string,TClass*>       IdMap_t;
+#define R__CLASSMAP_BARRIER()
 #endif
-      typedef IdMap_t::key_type                   key_type;
-      typedef IdMap_t::const_iterator             const_iterator;
-      typedef IdMap_t::size_type                  size_type;
-#ifdef R__WIN32
-     // Window's std::map does NOT defined mapped_type
-      typedef TClass*                             mapped_type;
+
+// Load with acquire and store with release semantics: what the writer
+// stored before R__ClassMapRelease is visible to the reader after the
+// R__ClassMapAcquire which returns the released value.
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+template <class T> static inline T R__ClassMapAcquire(T volatile &x)
+{
+   return __atomic_load_n(&x, __ATOMIC_ACQUIRE);
+}
+template <class T> static inline void R__ClassMapRelease(T volatile &x, T v)
+{
+   __atomic_store_n(&x, v, __ATOMIC_RELEASE);
+}
 #else
-      typedef IdMap_t::mapped_type                mapped_type;
+template <class T> static inline T R__ClassMapAcquire(T volatile &x)
+{
+   T v = x;
+   R__CLASSMAP_BARRIER();
+   return v;
+}
+template <class T> static inline void R__ClassMapRelease(T volatile &x, T v)
+{
+   R__CLASSMAP_BARRIER();
+   x = v;
+}
 #endif
 
-   private:
-      IdMap_t fMap;
-
+namespace ROOT {
+   class TMapTypeToTClass {
+     // Map from a name (type_info name, class name or an alias of the
+     // class name) to the TClass pointer. Find() does not take any lock:
+     // the table is an open addressing hash table where entries are
+     // never moved or deleted, Remove() only resets the value. Add() and
+     // Remove() are serialized by a mutex; when the table is full, a
+     // bigger copy is published and the old one is kept alive until the
+     // map is deleted, so that concurrent readers can finish with it.
+     // The table, the keys and the values are published with release
+     // stores and read with acquire loads. A key may also be marked as
+     // missing (AddMissing), for the names known not to be classes.
+     // This wrapper class also allows to avoid putting #include <map>
+     // in the TROOT.h header file.
    public:
-      void Add(const key_type &key, mapped_type &obj) {
-         fMap[key] = obj;
+      typedef const char *key_type;
+      typedef TClass     *mapped_type;
+
+   private:
+      struct TEntry {
+         const char   *volatile fKey;     // owned copy of the key, 0 for an empty slot
+         UInt_t                 fHash;    // hash of the key
+         TClass       *volatile fValue;   // class, 0 if removed or missing
+         Bool_t                 fMissing; // the key is not a class name
+      };
+      struct TTable {
+         UInt_t   fMask;    // size - 1, size is a power of 2
+         UInt_t   fUsed;    // number of slots with a key
+         TEntry  *fEntries; // [fMask + 1]
+         TTable  *fOld;     // previous (retired) table
+      };
+
+      TTable *volatile  fTable;   // current table
+      TVirtualMutex    *fMutex;   // serializes writers
+      UInt_t            fAliases; // number of aliases added
+
+      static TTable *NewTable(UInt_t size) {
+         TTable *t = new TTable;
+         t->fMask = size - 1;
+         t->fUsed = 0;
+         t->fEntries = new TEntry[size];
+         memset(t->fEntries, 0, size*sizeof(TEntry));
+         t->fOld = 0;
+         return t;
+      }
+      static UInt_t Hash(const char *key) { return TString::Hash(key, strlen(key)); }
+      static TEntry *Lookup(TTable *t, const char *key, UInt_t hash) {
+         // Return the slot of the key or the empty slot where it should go.
+         for (UInt_t i = hash & t->fMask;; i = (i + 1) & t->fMask) {
+            TEntry *e = &t->fEntries[i];
+            const char *k = R__ClassMapAcquire(e->fKey);
+            if (!k || (e->fHash == hash && !strcmp(k, key))) return e;
+         }
       }
-      mapped_type Find(const key_type &key) const {
-         IdMap_t::const_iterator iter = fMap.find(key);
-         mapped_type cl = 0;
-         if (iter != fMap.end()) cl = iter->second;
-         return cl;
+      void Grow() {
+         // Publish a table twice as big, with the live entries.
+         TTable *old = fTable;
+         TTable *t = NewTable(2*(old->fMask + 1));
+         for (UInt_t i = 0; i <= old->fMask; ++i) {
+            const TEntry &e = old->fEntries[i];
+            if (!e.fKey || (!e.fValue && !e.fMissing)) continue;
+            *Lookup(t, e.fKey, e.fHash) = e;
+            ++t->fUsed;
+         }
+         t->fOld = old;
+         R__ClassMapRelease(fTable, t);
+      }
+      void Insert(TEntry *e, key_type key, UInt_t hash, mapped_type obj, Bool_t missing) {
+         // Fill the empty slot e and publish it, the key last.
+         if (4*(fTable->fUsed + 1) > 3*(fTable->fMask + 1)) {
+            Grow();
+            e = Lookup(fTable, key, hash);
+         }
+         e->fValue = obj;
+         e->fHash = hash;
+         e->fMissing = missing;
+         const char *k = StrDup(key);
+         R__ClassMapRelease(e->fKey, k);
+         ++fTable->fUsed;
       }
-      void Remove(const key_type &key) { fMap.erase(key); }
-#else
-   private:
-      TMap fMap;
 
    public:
-#ifdef R__COMPLETE_MEM_TERMINATION
-      TMapTypeToTClass() {
-         TIter next(&fMap);
-         TObjString *key;
-         while((key = (TObjString*)next())) {
-            delete key;
-         }         
-      }
-#endif
-      void Add(const char *key, TClass *&obj) {
-         TObjString *realkey = new TObjString(key);
-         fMap.Add(realkey, obj);
+      TMapTypeToTClass() : fTable(NewTable(1024)), fMutex(0), fAliases(0) {}
+      ~TMapTypeToTClass() {
+         // Keys are shared between the current and the retired tables.
+         std::set<const char*> keys;
+         while (fTable) {
+            TTable *t = fTable;
+            for (UInt_t i = 0; i <= t->fMask; ++i) {
+               const char *k = t->fEntries[i].fKey;
+               if (k) keys.insert(k);
+            }
+            fTable = t->fOld;
+            delete [] t->fEntries;
+            delete t;
+         }
+         for (std::set<const char*>::iterator k = keys.begin(); k != keys.end(); ++k) {
+            delete [] *k;
+         }
       }
-      TClass* Find(const char *key) const {
-         const TPair *a = (const TPair *)fMap.FindObject(key);
-         if (a) return (TClass*) a->Value();
-         return 0;
+      void Add(key_type key, mapped_type obj) {
+         R__LOCKGUARD2(fMutex);
+         const UInt_t hash = Hash(key);
+         TEntry *e = Lookup(fTable, key, hash);
+         if (e->fKey) {
+            e->fMissing = kFALSE;
+            R__ClassMapRelease(e->fValue, obj);
+            return;
+         }
+         Insert(e, key, hash, obj, kFALSE);
+      }
+      void AddMissing(key_type key) {
+         // Remember that key is not the name of a class.
+         R__LOCKGUARD2(fMutex);
+         const UInt_t hash = Hash(key);
+         TEntry *e = Lookup(fTable, key, hash);
+         if (e->fKey) {
+            if (!e->fValue) e->fMissing = kTRUE;
+            return;
+         }
+         Insert(e, key, hash, 0, kTRUE);
+      }
+      mapped_type Find(key_type key, Bool_t *missing = 0) const {
+         // Return the class of key, or 0. If missing is given, it is set to
+         // whether key was marked by AddMissing.
+         TEntry *e = Lookup(R__ClassMapAcquire(fTable), key, Hash(key));
+         TClass *cl = R__ClassMapAcquire(e->fValue);
+         if (missing) *missing = !cl && e->fMissing;
+         return cl;
       }
-      void Remove(const char *key) {
-         TObjString realkey(key);
-         TObject *actual = fMap.Remove(&realkey);
-         delete actual;
+      void Remove(key_type key) {
+         R__LOCKGUARD2(fMutex);
+         TEntry *e = Lookup(fTable, key, Hash(key));
+         if (e->fKey) e->fValue = 0;
+      }
+      void AddAlias(key_type key, mapped_type obj) {
+         // Add another name of obj, removed by RemoveValue.
+         Add(key, obj);
+         R__LOCKGUARD2(fMutex);
+         ++fAliases;
+      }
+      void RemoveValue(key_type key, mapped_type obj) {
+         // Remove obj's key and all its aliases.
+         R__LOCKGUARD2(fMutex);
+         TEntry *e = Lookup(fTable, key, Hash(key));
+         if (e->fKey && e->fValue == obj) e->fValue = 0;
+         if (!fAliases) return;
+         for (UInt_t i = 0; i <= fTable->fMask; ++i) {
+            if (fTable->fEntries[i].fValue == obj) fTable->fEntries[i].fValue = 0;
+         }
       }
-#endif
    };
 }
 
@@ -219,13 +342,29 @@ IdMap_t *TClass::GetIdMap() {
    
 #ifdef R__COMPLETE_MEM_TERMINATION
    static IdMap_t gIdMapObject;
-   return &gIdMap;
+   return &gIdMapObject;
 #else
    static IdMap_t *gIdMap = new IdMap_t;
    return gIdMap;
 #endif
 }
 
+//______________________________________________________________________________
+IdMap_t *TClass::GetNameMap()
+{
+   // static: Map from class names, and the names resolved to them by
+   // GetClass, to the TClass pointers. Used for lock-free lookups of
+   // the classes already known.
+
+#ifdef R__COMPLETE_MEM_TERMINATION
+   static IdMap_t gNameMapObject;
+   return &gNameMapObject;
+#else
+   static IdMap_t *gNameMap = new IdMap_t;
+   return gNameMap;
+#endif
+}
+
 //______________________________________________________________________________
 void TClass::AddClass(TClass *cl)
 {
@@ -233,6 +372,7 @@ void TClass::AddClass(TClass *cl)
 
    if (!cl) return;
    gROOT->GetListOfClasses()->Add(cl);
+   GetNameMap()->Add(cl->GetName(),cl);
    if (cl->GetTypeInfo()) {
       GetIdMap()->Add(cl->GetTypeInfo()->name(),cl);
    }
@@ -246,6 +386,7 @@ void TClass::RemoveClass(TClass *oldcl)
 
    if (!oldcl) return;
    gROOT->GetListOfClasses()->Remove(oldcl);
+   GetNameMap()->RemoveValue(oldcl->GetName(),oldcl);
    if (oldcl->GetTypeInfo()) {
       GetIdMap()->Remove(oldcl->GetTypeInfo()->name());
    }
@@ -744,7 +885,7 @@ TClass::TClass() :
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fCompiledStreamerInit(0), fCompiledStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE), 
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(kNone),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -768,7 +909,7 @@ TClass::TClass(const char *name, Bool_t silent) :
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fCompiledStreamerInit(0), fCompiledStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE), 
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(kNone),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -818,7 +959,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fCompiledStreamerInit(0), fCompiledStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE), 
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(kNone),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -847,7 +988,7 @@ TClass::TClass(const char *name, Version_t cversion,
    fTypeInfo(0), fShowMembers(0), fInterShowMembers(0),
    fStreamer(0), fIsA(0), fGlobalIsA(0), fIsAMethod(0),
    fMerge(0), fResetAfterMerge(0), fNew(0), fNewArray(0), fDelete(0), fDeleteArray(0),
-   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fSizeof(-1),
+   fDestructor(0), fDirAutoAdd(0), fStreamerFunc(0), fCompiledStreamerInit(0), fCompiledStreamerFunc(0), fSizeof(-1),
    fCanSplit(-1), fProperty(0),fVersionUsed(kFALSE), 
    fIsOffsetStreamerSet(kFALSE), fOffsetStreamer(0), fStreamerType(kNone),
    fCurrentInfo(0), fRefStart(0), fRefProxy(0),
@@ -1109,6 +1250,8 @@ TClass::TClass(const TClass& cl) :
   fDestructor(cl.fDestructor),
   fDirAutoAdd(cl.fDirAutoAdd),
   fStreamerFunc(cl.fStreamerFunc),
+  fCompiledStreamerInit(cl.fCompiledStreamerInit),
+  fCompiledStreamerFunc(cl.fCompiledStreamerFunc),
   fSizeof(cl.fSizeof),
   fCanSplit(cl.fCanSplit),
   fProperty(cl.fProperty),
@@ -1850,7 +1993,7 @@ void TClass::InterpretedShowMembers(void* obj, TMemberInspector &insp)
          int arrdim = gCint->DataMemberInfo_ArrayDim(dmi);
          for (int dim = 0; dim < arrdim; dim++) {
             int nelem = gCint->DataMemberInfo_MaxIndex(dmi, dim);
-            name += TString::Format("[%d]", nelem);
+            name.AppendFormat("[%d]", nelem);
          }
       }
 
@@ -2012,6 +2155,8 @@ TObject *TClass::Clone(const char *new_name) const
    copy->SetDestructor(fDestructor);
    copy->SetDirectoryAutoAdd(fDirAutoAdd);
    copy->fStreamerFunc = fStreamerFunc;
+   copy->fCompiledStreamerInit = fCompiledStreamerInit;
+   copy->fCompiledStreamerFunc = fCompiledStreamerFunc;
    if (fStreamer) {
       copy->AdoptStreamer(fStreamer->Generate());
    }
@@ -2427,6 +2572,30 @@ ClassStreamerFunc_t TClass::GetStreamerFunc() const
    return fStreamerFunc;
 }
 
+//______________________________________________________________________________
+ClassStreamerFunc_t TClass::GetCompiledStreamerFunc() const
+{
+   // Return the streamer generated by rootcint for the current layout of
+   // the class, or 0 if there is none (see SetCompiledStreamerInit). The
+   // first call initializes it under the CINT lock, stores it and only
+   // then clears the initialization function, with a memory barrier in
+   // between; the later calls see the cleared function, and read the
+   // streamer after a barrier as well, without taking the lock.
+
+   if (fCompiledStreamerInit) {
+      R__LOCKGUARD(gCINTMutex);
+      if (fCompiledStreamerInit) {
+         // The offsets of the data members need the dictionary.
+         fCompiledStreamerFunc = fClassInfo ? (*fCompiledStreamerInit)(const_cast<TClass*>(this)) : 0;
+         R__CLASSMAP_BARRIER();
+         fCompiledStreamerInit = 0;
+      }
+   } else {
+      R__CLASSMAP_BARRIER();
+   }
+   return fCompiledStreamerFunc;
+}
+
 //______________________________________________________________________________
 TVirtualIsAProxy* TClass::GetIsAProxy() const
 {
@@ -2445,10 +2614,44 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
    // If silent is 'true', do not warn about missing dictionary for the class.
    // (typically used for class that are used only for transient members)
    // Returns 0 in case class is not found.
+   //
+   // Classes already loaded are found without taking any lock, by their
+   // name or by any name which was already resolved to them (typedefs,
+   // names with STL default arguments, ...), and so are the names of
+   // the basic types, for which 0 is returned. Otherwise the class is
+   // searched and loaded holding gCINTMutex.
 
    if (!name || !strlen(name)) return 0;
    if (!gROOT->GetListOfClasses())    return 0;
 
+   Bool_t missing = kFALSE;
+   TClass *cl = GetNameMap()->Find(name, &missing);
+   if (cl && cl->IsLoaded()) return cl;
+   if (missing) return 0;
+
+   R__LOCKGUARD2(gCINTMutex);
+   cl = LookupClass(name, load, silent);
+   if (cl && cl->IsLoaded() && strcmp(name, cl->GetName())) {
+      // Remember the alias, it is removed together with the class.
+      GetNameMap()->AddAlias(name, cl);
+   } else if (!cl) {
+      // Remember the names of the basic types (and their typedefs), which
+      // will never be classes.
+      TDataType *type = gROOT->GetType(name);
+      if (type && type->GetType() != kOther_t && type->GetType() != kNoType_t) {
+         GetNameMap()->AddMissing(name);
+      }
+   }
+   return cl;
+}
+
+//______________________________________________________________________________
+TClass *TClass::LookupClass(const char *name, Bool_t load, Bool_t silent)
+{
+   // Static method doing the actual work of GetClass(const char*): search
+   // the class among the known ones, resolving typedefs and STL names,
+   // and load it if requested. Called with gCINTMutex held.
+
    TClass *cl = (TClass*)gROOT->GetListOfClasses()->FindObject(name);
    
    TClassEdit::TSplitType splitname( name, TClassEdit::kLong64 );
@@ -2487,6 +2690,7 @@ TClass *TClass::GetClass(const char *name, Bool_t load, Bool_t silent)
                // Remove the existing (soon to be invalid) TClass object to
                // avoid an infinite recursion.
                gROOT->GetListOfClasses()->Remove(cl);
+               GetNameMap()->RemoveValue(cl->GetName(),cl);
                TClass *newcl = GetClass(altname.c_str(),load);
                
                // since the name are different but we got a TClass, we assume
@@ -2607,7 +2811,12 @@ TClass *TClass::GetClass(const type_info& typeinfo, Bool_t load, Bool_t /* silen
    if (!gROOT->GetListOfClasses())    return 0;
 
 //printf("TClass::GetClass called, typeinfo.name=%s\n",typeinfo.name());
+   // Lock-free lookup of the classes already loaded.
    TClass* cl = GetIdMap()->Find(typeinfo.name());
+   if (cl && cl->IsLoaded()) return cl;
+
+   R__LOCKGUARD2(gCINTMutex);
+   cl = GetIdMap()->Find(typeinfo.name());
 
    if (cl) {
       if (cl->IsLoaded()) return cl;
@@ -4915,6 +5124,10 @@ void TClass::AdoptMemberStreamer(const char *name, TMemberStreamer *p)
 
    R__LOCKGUARD(gCINTMutex);
 
+   // The compiled streamer does not know about the member streamers.
+   fCompiledStreamerInit = 0;
+   fCompiledStreamerFunc = 0;
+
    TIter next(fRealData);
    TRealData *rd;
    while ((rd = (TRealData*)next())) {
@@ -5127,6 +5340,27 @@ void TClass::SetStreamerFunc(ClassStreamerFunc_t strm)
    }
 }
 
+//______________________________________________________________________________
+void TClass::SetCompiledStreamerInit(ClassStreamerInitFunc_t init)
+{
+   // Set the function initializing the streamer generated by rootcint
+   // (option --compiled-streamers) for the current layout of the class.
+   // The compiled streamer streams the data members with code specialised
+   // for their types, in the same format as the StreamerInfo actions.
+   // TBufferFile uses it instead of the actions when the object is
+   // written, or read with the StreamerInfo of the current class version;
+   // any schema evolution goes through the generic path. Installing a
+   // member streamer disables it. The initialization (offsets of the data
+   // members) is run once by GetCompiledStreamerFunc. Only the
+   // dictionaries of rootcint without -p register it; the classes of the
+   // other dictionaries (genreflex) always use the StreamerInfo.
+
+   R__LOCKGUARD(gCINTMutex);
+
+   fCompiledStreamerFunc = 0;
+   fCompiledStreamerInit = init;
+}
+
 //______________________________________________________________________________
 void TClass::SetMerge(ROOT::MergeFunc_t newMerge)
 {
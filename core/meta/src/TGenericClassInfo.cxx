@@ -48,7 +48,7 @@ namespace ROOT {
         fIsA(isa), fShowMembers(showmembers),
         fVersion(1),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-        fStreamerFunc(0), fCollectionProxy(0), fSizeof(sizof),
+        fStreamerFunc(0), fCompiledStreamerInit(0), fCollectionProxy(0), fSizeof(sizof),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
    {
       // Constructor.
@@ -68,7 +68,7 @@ namespace ROOT {
         fIsA(isa), fShowMembers(showmembers),
         fVersion(version),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-        fStreamerFunc(0), fCollectionProxy(0), fSizeof(sizof),
+        fStreamerFunc(0), fCompiledStreamerInit(0), fCollectionProxy(0), fSizeof(sizof),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
    {
       // Constructor with version number.
@@ -88,7 +88,7 @@ namespace ROOT {
         fIsA(isa), fShowMembers(0),
         fVersion(version),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-        fStreamerFunc(0), fCollectionProxy(0), fSizeof(sizof),
+        fStreamerFunc(0), fCompiledStreamerInit(0), fCollectionProxy(0), fSizeof(sizof),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
 
    {
@@ -110,7 +110,7 @@ namespace ROOT {
         fIsA(0), fShowMembers(0),
         fVersion(version),
         fMerge(0),fResetAfterMerge(0),fNew(0),fNewArray(0),fDelete(0),fDeleteArray(0),fDestructor(0), fDirAutoAdd(0), fStreamer(0),
-        fStreamerFunc(0), fCollectionProxy(0), fSizeof(0),
+        fStreamerFunc(0), fCompiledStreamerInit(0), fCollectionProxy(0), fSizeof(0),
         fCollectionProxyInfo(0), fCollectionStreamerInfo(0)
 
    {
@@ -224,6 +224,7 @@ namespace ROOT {
          fClass->SetDestructor(fDestructor);
          fClass->SetDirectoryAutoAdd(fDirAutoAdd);
          fClass->SetStreamerFunc(fStreamerFunc);
+         fClass->SetCompiledStreamerInit(fCompiledStreamerInit);
          fClass->SetMerge(fMerge);
          fClass->SetResetAfterMerge(fResetAfterMerge);
          fClass->AdoptStreamer(fStreamer); fStreamer = 0;
@@ -461,6 +462,16 @@ namespace ROOT {
       if (fClass) fClass->SetStreamerFunc(streamer);
    }
 
+   void TGenericClassInfo::SetCompiledStreamerInit(ClassStreamerInitFunc_t init)
+   {
+      // Set the function initializing the compiled streamer generated by
+      // rootcint for the current layout of the class, see
+      // TClass::SetCompiledStreamerInit.
+
+      fCompiledStreamerInit = init;
+      if (fClass) fClass->SetCompiledStreamerInit(init);
+   }
+
    const char *TGenericClassInfo::GetDeclFileName() const
    {
       // Get the name of the declaring header file.
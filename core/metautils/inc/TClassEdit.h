@@ -89,6 +89,13 @@ namespace TClassEdit {
    std::string ResolveTypedef(const char *tname, bool resolveAll = false);
    std::string ShortType (const char *typeDesc, int mode);
    std::string InsertStd(const char *tname);
+
+   // Cache of the results of ResolveTypedef and ShortType.
+   // The lock function is called with lock=true and handle=0 and returns
+   // the handle to pass back with lock=false to unlock.
+   typedef void *(*NameCacheLock_t)(bool lock, void *handle);
+   void        ClearNameCache();
+   void        SetNameCacheLock(NameCacheLock_t lockfunc);
 }
 
 #endif
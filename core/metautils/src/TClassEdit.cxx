@@ -7,14 +7,145 @@
 #include <assert.h>
 #include "TClassEdit.h"
 #include <ctype.h>
-#include "Rstrstream.h"
 #include <set>
+#include <map>
 
 // CINT's API.
 #include "Api.h"
 
 namespace std {} using namespace std;
 
+//______________________________________________________________________________
+namespace {
+   // Cache of the names computed by ResolveTypedef and ShortType, which
+   // are called with the same few names for every branch creation and
+   // collection proxy lookup. The key is the mode of ShortType (the
+   // ResolveTypedef entries use negative modes) and the name as spelled
+   // by the caller. The results depend on the typedefs and classes known
+   // to CINT, so a cache is cleared whenever their numbers change, and
+   // when ClearNameCache increments the generation.
+   // With thread local storage each thread has its own cache, which is
+   // read and filled without any lock; the caches are not released when
+   // their thread ends. Otherwise one cache is shared, protected by the
+   // lock function set by SetNameCacheLock.
+
+   typedef std::map<std::pair<int,std::string>, std::string> NameCacheMap_t;
+
+   const size_t kMaxCachedNames = 8192;
+
+   struct TNameCacheState {
+      int          fTypedefs;   // number of typedefs known to CINT
+      int          fClasses;    // number of classes known to CINT
+      unsigned int fGeneration; // value of gNameCacheGeneration
+
+      bool operator!=(const TNameCacheState &other) const {
+         return fTypedefs != other.fTypedefs || fClasses != other.fClasses ||
+                fGeneration != other.fGeneration;
+      }
+   };
+
+   struct TNameCache {
+      NameCacheMap_t  fNames; // results, by mode and name
+      TNameCacheState fState; // state of CINT the results are valid for
+
+      TNameCache() { fState.fTypedefs = fState.fClasses = -1; fState.fGeneration = 0; }
+   };
+
+   volatile unsigned int       gNameCacheGeneration = 0;
+   TClassEdit::NameCacheLock_t gNameCacheLock = 0;
+#ifdef R__TLS
+   R__TLS TNameCache          *gTlsNameCache = 0;
+#else
+   TNameCache                  gNameCache;
+#endif
+
+   class TNameCacheGuard {
+   private:
+      void *fHandle;
+      TNameCacheGuard(const TNameCacheGuard&);            // not implemented
+      TNameCacheGuard &operator=(const TNameCacheGuard&); // not implemented
+   public:
+      TNameCacheGuard() : fHandle(gNameCacheLock ? (*gNameCacheLock)(true, 0) : 0) {}
+      ~TNameCacheGuard() { if (gNameCacheLock) (*gNameCacheLock)(false, fHandle); }
+   };
+
+   //______________________________________________________________________________
+   static TNameCache *GetNameCache()
+   {
+      // Return the cache of the calling thread, or the shared cache.
+
+#ifdef R__TLS
+      if (!gTlsNameCache) gTlsNameCache = new TNameCache;
+      return gTlsNameCache;
+#else
+      return &gNameCache;
+#endif
+   }
+
+   //______________________________________________________________________________
+   static bool FindCachedName(int mode, const char *name, string &result, TNameCacheState &state)
+   {
+      // Look for the result for name in the cache. Returns in state the
+      // state of CINT the result must be cached with.
+
+      state.fTypedefs   = G__TypedefInfo::GetNumTypedefs();
+      state.fClasses    = G__ClassInfo::GetNumClasses();
+      state.fGeneration = gNameCacheGeneration;
+
+      TNameCache *cache = GetNameCache();
+#ifndef R__TLS
+      TNameCacheGuard guard;
+#endif
+      if (state != cache->fState) {
+         cache->fNames.clear();
+         cache->fState = state;
+         return false;
+      }
+      NameCacheMap_t::const_iterator iter = cache->fNames.find(std::make_pair(mode, string(name)));
+      if (iter == cache->fNames.end()) return false;
+      result = iter->second;
+      return true;
+   }
+
+   //______________________________________________________________________________
+   static void AddCachedName(int mode, const char *name, const string &result, const TNameCacheState &state)
+   {
+      // Add the result for name, computed in the given state of CINT, to
+      // the cache. It is dropped if the state changed meanwhile.
+
+      TNameCache *cache = GetNameCache();
+#ifndef R__TLS
+      TNameCacheGuard guard;
+#endif
+      if (state != cache->fState) return;
+      if (cache->fNames.size() >= kMaxCachedNames) cache->fNames.clear();
+      cache->fNames.insert(std::make_pair(std::make_pair(mode, string(name)), result));
+   }
+}
+
+//______________________________________________________________________________
+void TClassEdit::ClearNameCache()
+{
+   // Clear the cache of the results of ResolveTypedef and ShortType. It is
+   // cleared automatically when typedefs or classes are declared to CINT;
+   // this must be called when CINT is reset or its dictionary rewound.
+   // The caches of all the threads are invalidated.
+
+   TNameCacheGuard guard;
+   ++gNameCacheGeneration;
+}
+
+//______________________________________________________________________________
+void TClassEdit::SetNameCacheLock(NameCacheLock_t lockfunc)
+{
+   // Set the function protecting the cache of ResolveTypedef and ShortType
+   // in multi-threaded programs. TClassEdit does not depend on the ROOT
+   // thread library, so the lock is provided by the interpreter interface.
+   // It is only used for lookups where there is no thread local storage.
+
+   gNameCacheLock = lockfunc;
+}
+
 //______________________________________________________________________________
 TClassEdit::TSplitType::TSplitType(const char *type2split, EModType mode) : fName(type2split), fNestedLocation(0)
 {
@@ -205,12 +336,18 @@ void TClassEdit::TSplitType::ShortType(std::string &answ, int mode)
       }
       bool hasconst = 0==strncmp("const ",fElements[i].c_str(),6);
       //NOTE: Should we also check the end of the type for 'const'?
-      fElements[i] = TClassEdit::ShortType(fElements[i].c_str(),mode);
+      // Swap in the shortened argument instead of copying it; argsplit
+      // refers to the original string, which must stay untouched meanwhile.
+      TSplitType argsplit(fElements[i].c_str(), (EModType) mode);
+      std::string shortArg;
+      argsplit.ShortType(shortArg, mode);
+      fElements[i].swap(shortArg);
       if (hasconst) {
-         fElements[i] = "const " + fElements[i];
+         fElements[i].insert(0, "const ", 6);
       }
    }
    
+   answ.reserve(strlen(fName));
    if (!fElements[0].empty()) {answ += fElements[0]; answ +="<";}
    
    if (mode & kDropAllDefault) {
@@ -222,13 +359,17 @@ void TClassEdit::TSplitType::ShortType(std::string &answ, int mode)
       td.Init(nameSuperLong.c_str());
       if (td.IsValid())
          nameSuperLong = td.TrueName();
+      std::string candidate;
+      candidate.reserve(nameSuperLong.size() + 3);
       while (++nargNonDefault < narg) {
          // If T<a> is a "typedef" (aka default template params)
          // to T<a,b> then we can strip the "b".
          const char* closeTemplate = " >";
          if (nonDefName[nonDefName.length() - 1] != '>')
             ++closeTemplate;
-         td.Init((nonDefName + closeTemplate).c_str());
+         candidate.assign(nonDefName);
+         candidate += closeTemplate;
+         td.Init(candidate.c_str());
          if (td.IsValid() && nameSuperLong == td.TrueName())
             break;
          if (nargNonDefault>1) nonDefName += ",";
@@ -459,8 +600,11 @@ int TClassEdit::GetSplit(const char *type, vector<string>& output, int &nestedLo
    output.clear();
    if (strlen(type)==0) return 0;
   
-   string full( mode & kLong64 ? TClassEdit::GetLong64_Name( CleanType(type, 1 /* keepInnerConst */) )
-               : CleanType(type, 1 /* keepInnerConst */) );
+   // Copy the cleaned name again only if there is a long long to replace.
+   string full( CleanType(type, 1 /* keepInnerConst */) );
+   if ( mode & kLong64 && full.find("long long") != string::npos ) {
+      full = TClassEdit::GetLong64_Name( full );
+   }
    if ( mode & kDropStd && strncmp( full.c_str(), "std::", 5) == 0) {
       full.erase(0,5);
    }
@@ -615,11 +759,14 @@ string TClassEdit::ShortType(const char *typeDesc, int mode)
    /////////////////////////////////////////////////////////////////////////////
 
    string answer;
+   TNameCacheState state;
+   if (FindCachedName(mode, typeDesc, answer, state)) return answer;
 
    // get list of all arguments
    TSplitType arglist(typeDesc, (EModType) mode);
    arglist.ShortType(answer, mode);
    
+   AddCachedName(mode, typeDesc, answer, state);
    return answer;
 }
 
@@ -701,16 +848,11 @@ namespace {
 }
 
 //______________________________________________________________________________
-string TClassEdit::ResolveTypedef(const char *tname, bool resolveAll)
+static string ResolveTypedefImp(const char *tname, bool resolveAll)
 {
+   // Implementation of TClassEdit::ResolveTypedef, called when the result
+   // is not in the cache.
 
-   // Return the name of type 'tname' with all its typedef components replaced
-   // by the actual type its points to
-   // For example for "typedef MyObj MyObjTypedef;"
-   //    vector<MyObjTypedef> return vector<MyObj>
-   //
-
-   if ( tname==0 || tname[0]==0 ) return "";
 
    if ( strchr(tname,'<')==0 && (tname[strlen(tname)-1]!='*') ) {
 
@@ -752,15 +894,15 @@ string TClassEdit::ResolveTypedef(const char *tname, bool resolveAll)
       return tname;
    }
 
+   // Build the answer in place: the components are copied into a single
+   // reusable buffer and appended to a string reserved for the whole
+   // name, instead of going through a stringstream and a temporary string
+   // per component.
    int len = strlen(tname);
-   string input(tname);
-#ifdef R__SSTREAM
-   // This is the modern implementation
-   stringstream answ;
-#else
-   // This is deprecated in the C++ standard
-   strstream answ;
-#endif
+   string answ;
+   answ.reserve(2*len);
+   string temp;
+   temp.reserve(len);
 
    int prev = 0;
    for (int i=0; i<len; ++i) {
@@ -772,35 +914,48 @@ string TClassEdit::ResolveTypedef(const char *tname, bool resolveAll)
          case '&':
          case ',':
          {
-            char keep = input[i];
-            string temp( input, prev,i-prev );
-
-            if ( (resolveAll&&(temp!="Double32_t")&&(temp!="Float16_t")) || ShouldReplace(temp.c_str())) {
-               answ << ResolveTypedef( temp.c_str(), resolveAll);
-            } else {
-               answ << temp;
+            if (i > prev) {
+               temp.assign(tname + prev, i - prev);
+               if ( (resolveAll&&(temp!="Double32_t")&&(temp!="Float16_t")) || ShouldReplace(temp.c_str())) {
+                  answ += TClassEdit::ResolveTypedef( temp.c_str(), resolveAll);
+               } else {
+                  answ += temp;
+               }
             }
-            answ << keep;
+            answ += tname[i];
             prev = i+1;
          }
       }
    }
-   const char *last = &(input.c_str()[prev]);
+   const char *last = tname + prev;
    if ((resolveAll&&(strcmp(last,"Double32_t")!=0)&&(strcmp(last,"Float16_t")!=0)) || ShouldReplace(last)) {
-      answ << ResolveTypedef( last, resolveAll);
+      answ += TClassEdit::ResolveTypedef( last, resolveAll);
    } else {
-      answ << last;
+      answ += last;
    }
-#ifndef R__SSTREAM
-   // Deprecated case
-   answ << ends;
-   std::string ret = answ.str();
-   answ.freeze(false);
-   return ret;
-#else
-   return answ.str();
-#endif
+   return answ;
+}
+
+//______________________________________________________________________________
+string TClassEdit::ResolveTypedef(const char *tname, bool resolveAll)
+{
+
+   // Return the name of type 'tname' with all its typedef components replaced
+   // by the actual type its points to
+   // For example for "typedef MyObj MyObjTypedef;"
+   //    vector<MyObjTypedef> return vector<MyObj>
+   //
+   // The results are cached, see ClearNameCache.
 
+   if ( tname==0 || tname[0]==0 ) return "";
+
+   string result;
+   int mode = resolveAll ? -2 : -1;
+   TNameCacheState state;
+   if (FindCachedName(mode, tname, result, state)) return result;
+   result = ResolveTypedefImp(tname, resolveAll);
+   AddCachedName(mode, tname, result, state);
+   return result;
 }
 
 
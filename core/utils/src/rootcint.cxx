@@ -60,6 +60,14 @@
 // file xxx.out; the remaining lines contains the list of classes for   //
 // which this run of rootcint produced a dictionary.                    //
 // This feature is used by ACliC (the automatic library generator).     //
+// The flag --compiled-streamers requests a streamer compiled for the   //
+// current layout of the simple classes with a '+' in the LinkDef, i.e. //
+// the classes whose only base is TObject and whose persistent data     //
+// members are fundamental types, enums, fixed size arrays of those or  //
+// std::vector of those. This streamer is used instead of the           //
+// StreamerInfo when reading and writing the current class version.     //
+// It is ignored together with -p; the dictionaries of genreflex never  //
+// contain compiled streamers.                                          //
 // The verbose flags have the following meaning:                        //
 //      -v   Display all messages                                       //
 //      -v0  Display no messages at all.                                //
@@ -248,6 +256,14 @@ const char *help =
 "list of libraries that are needed to properly link and load this\n"
 "dictionary. This list of libraries is saved in the file xxx.out.\n"
 "This feature is used by ACliC (the automatic library generator).\n"
+"The flag --compiled-streamers requests a streamer compiled for the\n"
+"current layout of the simple classes with a '+' in the LinkDef, i.e.\n"
+"the classes whose only base is TObject and whose persistent data\n"
+"members are fundamental types, enums, fixed size arrays of those or\n"
+"std::vector of those. This streamer is used instead of the\n"
+"StreamerInfo when reading and writing the current class version.\n"
+"It is ignored together with -p; the dictionaries of genreflex never\n"
+"contain compiled streamers.\n"
 "The verbose flags have the following meaning:\n"
 "      -v   Display all messages\n"
 "      -v0  Display no messages at all.\n"
@@ -352,6 +368,7 @@ std::ostream* dictSrcOut=&std::cout;
 G__ShadowMaker *shadowMaker=0;
 
 bool gNeedCollectionProxy = false;
+bool gCompiledStreamers = false;
 
 enum EDictType {
    kDictTypeCint,
@@ -1767,6 +1784,200 @@ G__TypeInfo &TemplateArg(G__BaseClassInfo &m, int count = 0)
    return ti;
 }
 
+//______________________________________________________________________________
+struct CompiledMember_t {
+   string fName;    // name of the data member
+   string fType;    // fundamental type of the value(s)
+   int    fLength;  // number of values of a fixed size array, 0 otherwise
+   bool   fVector;  // data member is a std::vector of fType
+};
+
+//______________________________________________________________________________
+const char *CompiledStreamerType(G__TypeInfo &type)
+{
+   // Return the type used by a compiled streamer to stream a value of
+   // the given type, or 0 if the type is not supported. Enums are
+   // streamed as int, like TStreamerInfo does.
+
+   static const char *types[] = { "bool", "char", "unsigned char", "short", "unsigned short",
+                                  "int", "unsigned int", "long", "unsigned long",
+                                  "long long", "unsigned long long", "float", "double", 0 };
+
+   if (type.Property() & (G__BIT_ISPOINTER|G__BIT_ISREFERENCE)) return 0;
+   if (type.Property() & G__BIT_ISENUM) return "int";
+   if (!(type.Property() & G__BIT_ISFUNDAMENTAL)) return 0;
+   // Float16_t and Double32_t have their own on file representation.
+   const char *name = type.Name();
+   if (!name || strstr(name,"Float16_t") || strstr(name,"Double32_t")) return 0;
+   const char *truename = type.TrueName();
+   if (!truename) return 0;
+   for (int i = 0; types[i]; ++i) {
+      if (!strcmp(truename, types[i])) return types[i];
+   }
+   return 0;
+}
+
+//______________________________________________________________________________
+bool GetCompiledStreamerMembers(G__ClassInfo &cl, std::vector<CompiledMember_t> &members, bool &tobject)
+{
+   // Return true if a compiled streamer can be generated for the class
+   // (option --compiled-streamers). This is the case for the classes with
+   // an automatic streamer ('+' in the LinkDef) and a positive class
+   // version, without schema evolution rules, whose only base class (if
+   // any) is TObject and whose persistent data members are fundamental
+   // types, enums, fixed size arrays of those or std::vector of those.
+   // On return, members describes the persistent data members in the
+   // order of the StreamerInfo and tobject is true if the class inherits
+   // from TObject.
+
+   members.clear();
+   tobject = false;
+
+   if (!gCompiledStreamers) return false;
+   if (!(cl.RootFlag() & G__USEBYTECOUNT) || (cl.RootFlag() & G__NOSTREAMER)) return false;
+   if (GetClassVersion(cl) <= 0) return false;
+   if (G__ReadRules.find(cl.Fullname()) != G__ReadRules.end() ||
+       G__ReadRawRules.find(cl.Fullname()) != G__ReadRawRules.end()) return false;
+
+   G__BaseClassInfo base(cl);
+   while (base.Next()) {
+      if (tobject || strcmp(base.Name(), "TObject") ||
+          !(base.Property() & G__BIT_ISPUBLIC) || (base.Property() & G__BIT_ISVIRTUALBASE)) {
+         return false;
+      }
+      tobject = true;
+   }
+
+   G__DataMemberInfo m(cl);
+   while (m.Next()) {
+      if ((m.Property() & G__BIT_ISSTATIC) ||
+          strncmp(m.Title(), "!", 1) == 0        ||
+          strcmp(m.Name(), "G__virtualinfo") == 0) continue;
+      if (m.Property() & (G__BIT_ISPOINTER|G__BIT_ISREFERENCE)) return false;
+
+      CompiledMember_t member;
+      member.fName = m.Name();
+      member.fLength = 0;
+      member.fVector = false;
+      const char *type = CompiledStreamerType(*m.Type());
+      if (type) {
+         member.fType = type;
+         if (m.Property() & G__BIT_ISARRAY) {
+            member.fLength = 1;
+            for (int dim = 0; dim < m.ArrayDim(); ++dim) member.fLength *= m.MaxIndex(dim);
+         }
+      } else if (IsSTLContainer(m) == kVector && !(m.Property() & G__BIT_ISARRAY)) {
+         type = CompiledStreamerType(TemplateArg(m));
+         if (!type || !strcmp(type, "bool")) return false;
+         member.fType = type;
+         member.fVector = true;
+      } else {
+         return false;
+      }
+      members.push_back(member);
+   }
+   return true;
+}
+
+//______________________________________________________________________________
+void WriteCompiledStreamer(G__ClassInfo &cl, const string &classname, const string &mappedname)
+{
+   // Write the streamer compiled for the current layout of the class and
+   // its initialization function. The streamer produces the same bytes as
+   // the StreamerInfo of the class and is used by TBufferFile instead of
+   // the StreamerInfo actions when the on file layout is the in-memory one.
+   // The data members are accessed through their offsets, so that private
+   // members can be streamed without a shadow class. The offsets need the
+   // dictionary: they are set by the initialization function, registered
+   // by GenerateInitInstance and run once by the TClass under the CINT lock
+   // (see TClass::SetCompiledStreamerInit).
+
+   std::vector<CompiledMember_t> members;
+   bool tobject;
+   if (!GetCompiledStreamerMembers(cl, members, tobject)) return;
+
+   size_t nmembers = members.size();
+   bool hasVector = false;
+   size_t i;
+   for (i = 0; i < nmembers; ++i) {
+      if (members[i].fVector) hasVector = true;
+   }
+
+   (*dictSrcOut) << "   // Data used by the streamer compiled for the current layout of the class." << std::endl
+                 << "   static TClass *compiledClass_" << mappedname.c_str() << " = 0;" << std::endl;
+   if (nmembers) {
+      (*dictSrcOut) << "   static Long_t compiledOffset_" << mappedname.c_str() << "[" << nmembers << "];" << std::endl;
+   }
+   if (hasVector) {
+      (*dictSrcOut) << "   static TClass *compiledSTLClass_" << mappedname.c_str() << "[" << nmembers << "];" << std::endl
+                    << "   static TClass *compiledInfoClass_" << mappedname.c_str() << " = 0;" << std::endl;
+   }
+
+   (*dictSrcOut) << "   // Streamer compiled for the current layout of the class." << std::endl
+                 << "   static void compiledStreamer_" << mappedname.c_str() << "(TBuffer &R__b, void *obj) {" << std::endl;
+   if (nmembers) {
+      (*dictSrcOut) << "      char *R__p = (char*)obj;" << std::endl
+                    << "      const Long_t *R__offset = compiledOffset_" << mappedname.c_str() << ";" << std::endl;
+   }
+   if (hasVector) {
+      (*dictSrcOut) << "      TClass **R__stlcl = compiledSTLClass_" << mappedname.c_str() << ";" << std::endl;
+   }
+
+   for (int rwmode = 0; rwmode < 2; ++rwmode) {
+      if (rwmode == 0) {
+         (*dictSrcOut) << "      if (R__b.IsReading()) {" << std::endl;
+      } else {
+         (*dictSrcOut) << "      } else {" << std::endl;
+      }
+      if (tobject) {
+         (*dictSrcOut) << "         if (!compiledClass_" << mappedname.c_str() << "->CanIgnoreTObjectStreamer()) ((::TObject*)(" << classname.c_str() << "*)obj)->::TObject::Streamer(R__b);" << std::endl;
+      }
+      for (i = 0; i < nmembers; ++i) {
+         const CompiledMember_t &member = members[i];
+         const char *type = member.fType.c_str();
+         if (member.fVector) {
+            if (rwmode == 0) {
+               (*dictSrcOut) << "         {" << std::endl
+                             << "            UInt_t R__s, R__c;" << std::endl
+                             << "            R__b.ReadVersion(&R__s, &R__c, R__stlcl[" << i << "]);" << std::endl
+                             << "            R__stlcl[" << i << "]->Streamer(R__p + R__offset[" << i << "], R__b);" << std::endl
+                             << "            R__b.CheckByteCount(R__s, R__c, R__stlcl[" << i << "]);" << std::endl
+                             << "         }" << std::endl;
+            } else {
+               (*dictSrcOut) << "         {" << std::endl
+                             << "            UInt_t R__c = R__b.WriteVersion(compiledInfoClass_" << mappedname.c_str() << ", kTRUE);" << std::endl
+                             << "            R__stlcl[" << i << "]->Streamer(R__p + R__offset[" << i << "], R__b);" << std::endl
+                             << "            R__b.SetByteCount(R__c, kTRUE);" << std::endl
+                             << "         }" << std::endl;
+            }
+         } else if (member.fLength) {
+            (*dictSrcOut) << "         R__b." << (rwmode == 0 ? "ReadFastArray" : "WriteFastArray")
+                          << "((" << type << "*)(R__p + R__offset[" << i << "]), " << member.fLength << ");" << std::endl;
+         } else {
+            (*dictSrcOut) << "         R__b " << (rwmode == 0 ? ">>" : "<<")
+                          << " *(" << type << "*)(R__p + R__offset[" << i << "]);" << std::endl;
+         }
+      }
+   }
+   (*dictSrcOut) << "      }" << std::endl
+                 << "   }" << std::endl;
+
+   (*dictSrcOut) << "   // Initialization of the compiled streamer, run once by TClass::GetCompiledStreamerFunc." << std::endl
+                 << "   static ClassStreamerFunc_t compiledStreamerInit_" << mappedname.c_str() << "(TClass *R__cl) {" << std::endl
+                 << "      compiledClass_" << mappedname.c_str() << " = R__cl;" << std::endl;
+   for (i = 0; i < nmembers; ++i) {
+      (*dictSrcOut) << "      compiledOffset_" << mappedname.c_str() << "[" << i << "] = R__cl->GetDataMemberOffset(\"" << members[i].fName.c_str() << "\");" << std::endl;
+      if (members[i].fVector) {
+         (*dictSrcOut) << "      compiledSTLClass_" << mappedname.c_str() << "[" << i << "] = TClass::GetClass(\"vector<" << members[i].fType.c_str() << ">\");" << std::endl;
+      }
+   }
+   if (hasVector) {
+      (*dictSrcOut) << "      compiledInfoClass_" << mappedname.c_str() << " = TClass::GetClass(\"TStreamerInfo\");" << std::endl;
+   }
+   (*dictSrcOut) << "      return &compiledStreamer_" << mappedname.c_str() << ";" << std::endl
+                 << "   }" << std::endl;
+}
+
 //______________________________________________________________________________
 void WriteAuxFunctions(G__ClassInfo &cl)
 {
@@ -1849,6 +2060,8 @@ void WriteAuxFunctions(G__ClassInfo &cl)
       << "   }" << std::endl;
    }
 
+   WriteCompiledStreamer(cl, classname, mappedname);
+
    if (HasNewMerge(cl)) {
       (*dictSrcOut) << "   // Wrapper around the merge function." << std::endl
       << "   static Long64_t merge_" << mappedname.c_str() << "(void *obj,TCollection *coll,TFileMergeInfo *info) {" << std::endl
@@ -2490,6 +2703,12 @@ void WriteClassInit(G__ClassInfo &cl)
    if (HasCustomStreamerMemberFunction(cl)) {
       (*dictSrcOut)<< "   static void streamer_" << mappedname.c_str() << "(TBuffer &buf, void *obj);" << std::endl;
    }
+   std::vector<CompiledMember_t> compiledMembers;
+   bool compiledTObject;
+   bool compiledStreamer = GetCompiledStreamerMembers(cl, compiledMembers, compiledTObject);
+   if (compiledStreamer) {
+      (*dictSrcOut)<< "   static ClassStreamerFunc_t compiledStreamerInit_" << mappedname.c_str() << "(TClass *cl);" << std::endl;
+   }
    if (HasNewMerge(cl) || HasOldMerge(cl)) {
       (*dictSrcOut)<< "   static Long64_t merge_" << mappedname.c_str() << "(void *obj, TCollection *coll,TFileMergeInfo *info);" << std::endl;
    }
@@ -2688,6 +2907,9 @@ void WriteClassInit(G__ClassInfo &cl)
       // We have a custom member function streamer or an older (not StreamerInfo based) automatic streamer.
       (*dictSrcOut) << "      instance.SetStreamerFunc(&streamer_" << mappedname.c_str() << ");" << std::endl;
    }
+   if (compiledStreamer) {
+      (*dictSrcOut) << "      instance.SetCompiledStreamerInit(&compiledStreamerInit_" << mappedname.c_str() << ");" << std::endl;
+   }
    if (HasNewMerge(cl) || HasOldMerge(cl)) {
       (*dictSrcOut) << "      instance.SetMerge(&merge_" << mappedname.c_str() << ");" << std::endl;
    }
@@ -4310,6 +4532,10 @@ int main(int argc, char **argv)
 
          longheadername = 1;
          ic++;
+      } else if (!strcmp(argv[ic], "--compiled-streamers")) {
+
+         gCompiledStreamers = true;
+         ic++;
       } else if (!strncmp(argv[ic],libprefix,strlen(libprefix))) {
 
          gLiblistPrefix = argv[ic]+strlen(libprefix);
@@ -4526,6 +4752,14 @@ int main(int argc, char **argv)
                continue;
             }
 
+            // The option --compiled-streamers is also accepted among the
+            // CINT flags, where ROOT_GENERATE_DICTIONARY puts its OPTIONS.
+            if (!strcmp(argv[ic], "--compiled-streamers")) {
+               gCompiledStreamers = true;
+               ++ic;
+               continue;
+            }
+
             if (strcmp("+P", argv[ic]) == 0 ||
                 strcmp("+V", argv[ic]) == 0 ||
                 strcmp("+STUB", argv[ic]) == 0) {
@@ -4696,6 +4930,13 @@ int main(int argc, char **argv)
    iv = 0;
    il = 0;
 
+   if (gCompiledStreamers && use_preprocessor) {
+      // The compiled streamers are only generated from the headers as
+      // parsed by CINT itself, not from the bundle of preprocessed headers.
+      Warning(0, "%s: --compiled-streamers is not supported with -p and is ignored\n", argv[0]);
+      gCompiledStreamers = false;
+   }
+
    std::list<std::string> includedFilesForBundle;
    string esc_arg;
    bool insertedBundle = false;
@@ -133,6 +133,8 @@ public:
 private:
 
    const char*       ParseGDML(TXMLEngine* gdml, XMLNodePointer_t node) ;
+   const char*       ParseGDMLStream(TXMLEngine* gdml, XMLDocPointer_t doc, XMLNodePointer_t node);
+   XMLNodePointer_t  ReadMainNode(TXMLEngine* gdml, XMLDocPointer_t doc);
    TString           GetScale(const char* unit);
    double            Evaluate(const char* evalline);
    const char*       NameShort(const char* name);
@@ -119,29 +119,28 @@ ClassImp(TGDMLParse)
 TGeoVolume* TGDMLParse::GDMLReadFile(const char* filename)
 {
    //creates the new instance of the XMLEngine called 'gdml', using the filename >>
-   //then parses the file and creates the DOM tree. Then passes the DOM to the
-   //next function to translate it.
+   //then opens the file in streaming mode. The DOM tree is built and translated
+   //element by element, so that the complete file is never kept in memory.
 
    // First create engine
    TXMLEngine* gdml = new TXMLEngine;
    gdml->SetSkipComments(kTRUE);
 
-   // Now try to parse xml file
-   XMLDocPointer_t gdmldoc = gdml->ParseFile(filename);
-   if (gdmldoc == 0) {
+   // Now try to open xml file
+   XMLDocPointer_t gdmldoc = gdml->OpenStream(filename);
+   XMLNodePointer_t mainnode = ReadMainNode(gdml, gdmldoc);
+   if (mainnode == 0) {
+      gdml->FreeDoc(gdmldoc);
       delete gdml;
       return 0;
    } else {
 
-      // take access to main node
-      XMLNodePointer_t mainnode = gdml->DocGetRootElement(gdmldoc);
-
       fFileEngine[fFILENO] = gdml;
       fStartFile = filename;
       fCurrentFile = filename;
 
-      // display recursively all nodes and subnodes
-      ParseGDML(gdml, mainnode);
+      // read and translate all nodes and subnodes
+      ParseGDMLStream(gdml, gdmldoc, mainnode);
 
       // Release memory before exit
       gdml->FreeDoc(gdmldoc);
@@ -303,6 +302,50 @@ const char* TGDMLParse::ParseGDML(TXMLEngine* gdml, XMLNodePointer_t node)
 
 }
 
+//________________________________________________________________
+XMLNodePointer_t TGDMLParse::ReadMainNode(TXMLEngine* gdml, XMLDocPointer_t doc)
+{
+   //reads the xml prolog of the document, opened in streaming mode, and the
+   //start of the main 'gdml' node. Returns 0 if file cannot be read.
+
+   if (doc == 0) return 0;
+
+   XMLNodePointer_t mainnode = 0;
+   while ((mainnode = gdml->ReadNextNode(doc, 0, kFALSE)) != 0)
+      if (!gdml->IsEmptyNode(mainnode)) break;
+
+   return mainnode;
+}
+
+//________________________________________________________________
+const char* TGDMLParse::ParseGDMLStream(TXMLEngine* gdml, XMLDocPointer_t doc, XMLNodePointer_t node)
+{
+   //reads the child nodes of the given node one by one from the document, opened
+   //in streaming mode. The sections of the file (define, materials, solids,
+   //structure) are read incrementally as well, while every other element is read
+   //together with its subnodes, translated by ParseGDML and then released.
+
+   XMLNodePointer_t child = 0;
+   while ((child = gdml->ReadNextNode(doc, node, kFALSE)) != 0) {
+      const char* name = gdml->GetNodeName(child);
+      if (((strcmp(name, "define")) == 0) || ((strcmp(name, "materials")) == 0) ||
+          ((strcmp(name, "solids")) == 0) || ((strcmp(name, "structure")) == 0)) {
+         ParseGDMLStream(gdml, doc, child);
+      } else {
+         // read the element with all its subnodes
+         while (gdml->ReadNextNode(doc, child, kTRUE) != 0) {}
+         if (gdml->IsStreamError(doc)) {
+            gdml->UnlinkFreeNode(child);
+            break;
+         }
+         ParseGDML(gdml, child);
+      }
+      gdml->UnlinkFreeNode(child);
+   }
+
+   return fWorldName;
+}
+
 //____________________________________________________________
 double TGDMLParse::Evaluate(const char* evalline)
 {
@@ -1100,12 +1143,12 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine* gdml, XMLNodePointer_t node)
                TXMLEngine* gdml2 = new TXMLEngine;
                gdml2->SetSkipComments(kTRUE);
 
-               XMLDocPointer_t filedoc1 = gdml2->ParseFile(fCurrentFile);
-               if (filedoc1 == 0) {
+               XMLDocPointer_t filedoc1 = gdml2->OpenStream(fCurrentFile);
+               // take access to main node
+               XMLNodePointer_t mainnode2 = ReadMainNode(gdml2, filedoc1);
+               if (mainnode2 == 0) {
                   Fatal("VolProcess", "Bad filename given %s", fCurrentFile);
                }
-               // take access to main node
-               XMLNodePointer_t mainnode2 = gdml2->DocGetRootElement(filedoc1);
                //increase depth counter + add DOM pointer
                fFILENO = fFILENO + 1;
                fFileEngine[fFILENO] = gdml2;
@@ -1113,7 +1156,7 @@ XMLNodePointer_t TGDMLParse::VolProcess(TXMLEngine* gdml, XMLNodePointer_t node)
                if (ffilemap.find(fCurrentFile) != ffilemap.end()) {
                   volref = ffilemap[fCurrentFile];
                } else {
-                  volref = ParseGDML(gdml2, mainnode2);
+                  volref = ParseGDMLStream(gdml2, filedoc1, mainnode2);
                   ffilemap[fCurrentFile] = volref;
                }
 
@@ -51,6 +51,9 @@ public:
    virtual void          ComputeNormal(Double_t *point, Double_t *dir, Double_t *norm);
    virtual Bool_t        Contains(Double_t *point) const;
    static  Bool_t        Contains(const Double_t *point, Double_t dx, Double_t dy, Double_t dz, const Double_t *origin);
+   virtual void          Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const;
+   static  void          Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize,
+                                   Double_t dx, Double_t dy, Double_t dz, const Double_t *origin);
    virtual Bool_t        CouldBeCrossed(Double_t *point, Double_t *dir) const;
    virtual Int_t         DistancetoPrimitive(Int_t px, Int_t py);
    virtual Double_t      DistFromInside(Double_t *point, Double_t *dir, Int_t iact=1, 
@@ -61,6 +64,14 @@ public:
                                    Double_t step=TGeoShape::Big(), Double_t *safe=0) const;
    static  Double_t      DistFromOutside(const Double_t *point,const Double_t *dir, 
                                    Double_t dx, Double_t dy, Double_t dz, const Double_t *origin, Double_t stepmax=TGeoShape::Big());
+   virtual void          DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                   Int_t vecsize, const Double_t *step=0) const;
+   static  void          DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize,
+                                   Double_t dx, Double_t dy, Double_t dz, const Double_t *origin);
+   virtual void          DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                   Int_t vecsize, const Double_t *step=0) const;
+   static  void          DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize,
+                                   Double_t dx, Double_t dy, Double_t dz, const Double_t *origin, const Double_t *stepmax=0);
    virtual TGeoVolume   *Divide(TGeoVolume *voldiv, const char *divname, Int_t iaxis, Int_t ndiv, 
                                 Double_t start, Double_t step);
    virtual const char   *GetAxisName(Int_t iaxis) const;
@@ -85,6 +96,7 @@ public:
    virtual Bool_t        IsNullBox() const {return ((fDX<1.E-16)&&(fDY<1.E-16)&&(fDZ<1.E-16))?kTRUE:kFALSE;}
    virtual TBuffer3D    *MakeBuffer3D() const;
    virtual Double_t      Safety(Double_t *point, Bool_t in=kTRUE) const;
+   virtual void          Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const;
    virtual void          SavePrimitive(ostream &out, Option_t *option = "");
    void                  SetBoxDimensions(Double_t dx, Double_t dy, Double_t dz, Double_t *origin=0);
    virtual void          SetDimensions(Double_t *param);
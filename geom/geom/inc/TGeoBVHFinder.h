@@ -0,0 +1,100 @@
+// @(#)root/geom:$Id$
+// Author: agent   18/10/26
+
+/*************************************************************************
+ * Copyright (C) 1995-2012, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TGeoBVHFinder
+#define ROOT_TGeoBVHFinder
+
+#ifndef ROOT_TGeoVoxelFinder
+#include "TGeoVoxelFinder.h"
+#endif
+
+/*************************************************************************
+ * TGeoBVHFinder - bounding volume hierarchy of the daughters of a volume
+ *
+ *************************************************************************/
+
+class TGeoBVHFinder : public TGeoVoxelFinder
+{
+public:
+   struct BVHThreadData_t
+   {
+      Int_t          *fStack;         //! traversal stack
+      Double_t       *fDist;          //! distances of the candidates (sorted)
+      Int_t           fStackSize;     //! size of fStack
+      Int_t           fDistSize;      //! size of fDist
+      Long64_t        fNqueries;      //! number of queries
+      Long64_t        fNvisited;      //! number of BVH nodes visited
+      Long64_t        fNchecked;      //! number of candidates returned
+
+      BVHThreadData_t();
+      ~BVHThreadData_t();
+      void            Reserve(Int_t nstack, Int_t ndist);
+   };
+   BVHThreadData_t& GetBVHThreadData(Int_t tid=0) const;
+   virtual void     ClearThreadData() const;
+   virtual void     CreateThreadData(Int_t nthreads) const;
+
+protected:
+   Int_t             fNnodes;         //! number of BVH nodes
+   Int_t             fNleaves;        //! number of leaves
+   Int_t             fDepth;          //! maximum depth of the tree
+   Double_t          fCost;           //! SAH cost of the tree
+   Double_t          fBuildTime;      //! build time in seconds
+   Double_t         *fNodeBox;        //! [6*fNnodes] xmin,ymin,zmin,xmax,ymax,zmax of nodes
+   Int_t            *fNodeFirst;      //! [fNnodes] first child (internal node) or first primitive (leaf)
+   Int_t            *fNodeCount;      //! [fNnodes] number of primitives in leaf, 0 for internal nodes
+   Int_t            *fPrims;          //! daughter indices ordered by leaf
+
+   mutable std::vector<BVHThreadData_t*> fBVHThreadData; //!
+   mutable Int_t                         fBVHThreadSize; //!
+   mutable Int_t                         fBVHThreadPrealloc; //! number of threads with preallocated data
+
+   static Int_t      fgAutoThreshold; // minimum number of daughters for automatic selection
+   static Int_t      fgMaxLeafSize;   // maximum number of daughters per leaf
+
+   TGeoBVHFinder(const TGeoBVHFinder&);
+   TGeoBVHFinder& operator=(const TGeoBVHFinder&);
+
+   void              BuildBVH();
+   Int_t             BuildNode(Int_t inode, Int_t first, Int_t count, Int_t depth,
+                               const Double_t *bmin, const Double_t *bmax, const Double_t *centroid);
+   void              CheckBVH();
+   void              SortCandidates(Int_t ncand, Int_t *list, Double_t *dist) const;
+
+public :
+   TGeoBVHFinder();
+   TGeoBVHFinder(TGeoVolume *vol);
+   virtual ~TGeoBVHFinder();
+
+   virtual Double_t    Efficiency();
+   virtual Int_t      *GetCheckList(Double_t *point, Int_t &nelem, Int_t tid=0);
+   virtual Int_t      *GetNextCandidates(Double_t *point, Int_t &ncheck, Int_t tid=0);
+   virtual Int_t      *GetNextVoxel(Double_t *point, Double_t *dir, Int_t &ncheck, Int_t tid=0);
+   Int_t              *GetRayCandidates(Double_t *point, Double_t *dir, Double_t stepmax, Int_t &ncheck, Int_t tid=0);
+   Int_t              *GetSafetyCandidates(Double_t *point, Double_t safmax, Int_t &ncheck, Int_t tid=0);
+   const Double_t     *GetCandidateDistances(Int_t tid=0) const {return GetBVHThreadData(tid).fDist;}
+   Int_t               GetNnodes() const {return fNnodes;}
+   Int_t               GetDepth() const  {return fDepth;}
+   virtual Bool_t      IsBVH() const {return kTRUE;}
+   virtual void        Print(Option_t *option="") const;
+   void                ResetStatistics();
+   virtual void        SortCrossedVoxels(Double_t *point, Double_t *dir, Int_t tid=0);
+   virtual void        Voxelize(Option_t *option="");
+
+   static Int_t        GetAutoThreshold() {return fgAutoThreshold;}
+   static void         SetAutoThreshold(Int_t ndaughters) {fgAutoThreshold = ndaughters;}
+   static Int_t        GetMaxLeafSize() {return fgMaxLeafSize;}
+   static void         SetMaxLeafSize(Int_t nleaf) {fgMaxLeafSize = (nleaf>0)?nleaf:1;}
+
+   ClassDef(TGeoBVHFinder, 1)                // bounding volume hierarchy finder
+};
+
+#endif
@@ -17,6 +17,12 @@
 #include "TGeoNode.h"
 #endif
 
+#ifndef ROOT_TExMap
+#include "TExMap.h"
+#endif
+
+#include <string>
+
 // forward declarations
 class TGeoManager;
 class TGeoHMatrix;
@@ -132,6 +138,55 @@ public:
    ClassDef(TGeoNodeCache, 0)        // cache of reusable physical nodes
 };
 
-#endif
+/////////////////////////////////////////////////////////////////////////////
+//                                                                         //
+// TGeoStateCache - bounded LRU cache of navigation states keyed by path   //
+//                                                                         //
+/////////////////////////////////////////////////////////////////////////////
 
+class TGeoStateCache : public TObject
+{
+private:
+   Int_t                 fCapacity;         // maximum number of cached states
+   Int_t                 fMaxLevels;        // maximum depth of a cached state
+   Int_t                 fSize;             // number of cached states
+   Int_t                 fHead;             // most recently used slot
+   Int_t                 fTail;             // least recently used slot
+   Int_t                 fGeneration;       // incremented by Invalidate()
+   Int_t                 fStatesGeneration; // value of fGeneration when the states were cached
+   Int_t                *fPrev;             //! [fCapacity] previous slot in LRU order
+   Int_t                *fNext;             //! [fCapacity] next slot in LRU order
+   TGeoCacheState      **fStates;           //! [fCapacity] cached states
+   std::string          *fKeys;             //! [fCapacity] keys of the cached states
+   ULong64_t            *fHashes;           //! [fCapacity] hashes of the keys
+   TExMap                fMap;              //! key hash -> slot+1
+   Long64_t              fNhits;            // number of successful lookups
+   Long64_t              fNmisses;          // number of failed lookups
+   Long64_t              fNevicted;         // number of states evicted
+
+   TGeoStateCache(const TGeoStateCache&); // Not implemented
+   TGeoStateCache& operator=(const TGeoStateCache&); // Not implemented
+
+   void                  Touch(Int_t slot);
+   void                  Unlink(Int_t slot);
 
+public:
+   TGeoStateCache();
+   TGeoStateCache(Int_t capacity, Int_t maxlevels);
+   virtual ~TGeoStateCache();
+
+   virtual void          Clear(Option_t *option="");
+   TGeoCacheState       *Find(const char *key, Int_t len, ULong64_t hash);
+   TGeoCacheState       *Insert(const char *key, Int_t len, ULong64_t hash);
+   Int_t                 GetCapacity() const {return fCapacity;}
+   Int_t                 GetSize() const     {return fSize;}
+   Long64_t              GetNhits() const    {return fNhits;}
+   Long64_t              GetNmisses() const  {return fNmisses;}
+   virtual void          Print(Option_t *option="") const;
+   static ULong64_t      Hash(const char *key, Int_t len);
+   void                  Invalidate()        {fGeneration++;}
+
+   ClassDef(TGeoStateCache, 0)       // LRU cache of navigation states
+};
+
+#endif
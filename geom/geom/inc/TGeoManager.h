@@ -128,6 +128,8 @@ private :
    Int_t                *fKeyPNEId;         //[fSizePNEId] array of uid values for PN entries
    Int_t                *fValuePNEId;       //[fSizePNEId] array of pointers to PN entries with ID's
    Bool_t                fMultiThread;      //! Flag for multi-threading
+   Int_t                 fMaxThreads;       //! Number of threads for which thread data is preallocated
+   Int_t                 fNavigatorsTag;    //! Unique tag of the navigator arrays, changed when they are cleared
 //--- private methods
 
    Bool_t                IsLoopingVolumes() const     {return fLoopVolumes;}
@@ -424,6 +426,7 @@ public:
    void                   ClearShape(const TGeoShape *shape);
    void                   ClearTracks() {fTracks->Delete(); fNtracks=0;}
    void                   ClearNavigators();
+   void                   InvalidateStateCaches();
    void                   RemoveMaterial(Int_t index);
    void                   RemoveNavigator(const TGeoNavigator *nav);
    void                   ResetUserData();
@@ -442,6 +445,8 @@ public:
    void                   SetAllIndex();
    void                   SetMultiThread(Bool_t flag=kTRUE) {fMultiThread = flag;}
    Bool_t                 IsMultiThread() const {return fMultiThread;}
+   void                   SetMaxThreads(Int_t nthreads);
+   Int_t                  GetMaxThreads() const {return fMaxThreads;}
    static void            SetNavigatorsLock(Bool_t flag) {fgLockNavigators = flag;}
    static Int_t           ThreadId();
    static Int_t           GetNumThreads() {return fgNumThreads;}
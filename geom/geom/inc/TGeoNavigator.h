@@ -45,6 +45,8 @@ protected:
                                            Int_t ncheck, Int_t *result);
    TGeoNode             *CrossDivisionCell();
    void                  SafetyOverlaps();
+   Double_t             *GetBasketBuffer(Int_t size);
+   Int_t                *GetBasketIndex(Int_t size);
 
 private :
    Double_t              fStep;             //! step to be done from current point and direction
@@ -63,6 +65,10 @@ private :
    Int_t                 fOverlapSize;      //! current size of fOverlapClusters
    Int_t                 fOverlapMark;      //! current recursive position in fOverlapClusters
    Int_t                *fOverlapClusters;  //! internal array for overlaps
+   Int_t                 fBasketSize;       //! current size of fBasketBuffer
+   Int_t                 fBasketIndexSize;  //! current size of fBasketIndex
+   Double_t             *fBasketBuffer;     //! work array for FindNextBoundary_v
+   Int_t                *fBasketIndex;      //! work array of indices for FindNextBoundary_v
    Bool_t                fSearchOverlaps;   //! flag set when an overlapping cluster is searched
    Bool_t                fCurrentOverlapping; //! flags the type of the current node
    Bool_t                fStartSafe;        //! flag a safe start for point classification
@@ -83,6 +89,8 @@ private :
    TGeoNode             *fNextNode;         //! next node that will be crossed
    TGeoNode             *fForcedNode;       //! current point is supposed to be inside this node
    TGeoCacheState       *fBackupState;      //! backup state
+   TGeoCacheState       *fBasketBackup;     //! spare backup state used by FindNextBoundary_v
+   TGeoStateCache       *fStateCache;       //! LRU cache of states visited by cd()
    TGeoHMatrix          *fCurrentMatrix;    //! current stored global matrix
    TGeoHMatrix          *fGlobalMatrix;     //! current pointer to cached global matrix
    TGeoHMatrix          *fDivMatrix;        //! current local matrix of the selected division cell
@@ -108,6 +116,8 @@ public :
    //--- geometry queries
    TGeoNode              *CrossBoundaryAndLocate(Bool_t downwards, TGeoNode *skipnode);
    TGeoNode              *FindNextBoundary(Double_t stepmax=TGeoShape::Big(),const char *path="", Bool_t frombdr=kFALSE);
+   void                   FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs,
+                                             const Double_t *stepmax, Double_t *step, Int_t *idaughter);
    TGeoNode              *FindNextDaughterBoundary(Double_t *point, Double_t *dir, Int_t &idaughter, Bool_t compmatrix=kFALSE);
    TGeoNode              *FindNextBoundaryAndStep(Double_t stepmax=TGeoShape::Big(), Bool_t compsafe=kFALSE);
    TGeoNode              *FindNode(Bool_t safe_start=kTRUE);
@@ -151,6 +161,8 @@ public :
    //--- modeler state getters/setters
    void                   DoBackupState();
    void                   DoRestoreState();
+   void                   CacheState(const char *key, Int_t len, ULong64_t hash);
+   Bool_t                 RestoreCachedState(const char *key, Int_t len, ULong64_t hash);
    Int_t                  GetNodeId() const           {return fCache->GetNodeId();}
    Int_t                  GetNextDaughterIndex() const {return fNextDaughterIndex;}
    TGeoNode              *GetNextNode() const         {return fNextNode;}
@@ -193,6 +205,8 @@ public :
    void                   MasterToTop(const Double_t *master, Double_t *top) const;
    void                   TopToMaster(const Double_t *top, Double_t *master) const;
    TGeoNodeCache         *GetCache() const         {return fCache;}
+   TGeoStateCache        *GetStateCache() const    {return fStateCache;}
+   void                   SetStateCacheSize(Int_t nstates);
 //   void                   SetCache(const TGeoNodeCache *cache) {fCache = (TGeoNodeCache*)cache;}
    //--- stack manipulation
    Int_t                  PushPath(Int_t startlevel=0) {return fCache->PushState(fCurrentOverlapping, startlevel, fNmany);}
@@ -81,6 +81,7 @@ protected :
 
 public:
    virtual void  ClearThreadData() const;
+   virtual void  CreateThreadData(Int_t nthreads) const;
 
 public:
    enum EGeoVolumeTypes {
@@ -144,6 +145,7 @@ public:
    Bool_t          IsSelected() const  {return TObject::TestBit(kVolumeSelected);}
    Bool_t          IsCylVoxels() const {return TObject::TestBit(kVoxelsCyl);}
    Bool_t          IsXYZVoxels() const {return TObject::TestBit(kVoxelsXYZ);}
+   Bool_t          IsUsingBVH() const  {return TGeoAtt::TestAttBit(kUseBVH);}
    Bool_t          IsTopVolume() const;
    Bool_t          IsValid() const {return fShape->IsValid();}
    virtual Bool_t  IsVisible() const {return TGeoAtt::IsVisible();}
@@ -209,6 +211,7 @@ public:
    void            SetCylVoxels(Bool_t flag=kTRUE) {TObject::SetBit(kVoxelsCyl, flag); TObject::SetBit(kVoxelsXYZ, !flag);}
    void            SetNodes(TObjArray *nodes) {fNodes = nodes; TObject::SetBit(kVolumeImportNodes);}
    void            SetShape(const TGeoShape *shape);
+   void            SetUseBVH(Bool_t flag=kTRUE);
    void            SetTransparency(Char_t transparency=0) {if (fMedium) fMedium->GetMaterial()->SetTransparency(transparency);} // *MENU*
    void            SetField(TObject *field)          {fField = field;}
    void            SetOption(const char *option);
@@ -310,10 +313,12 @@ public:
 
    ThreadData_t& GetThreadData()   const;
    virtual void  ClearThreadData() const;
+   virtual void  CreateThreadData(Int_t nthreads) const;
 
 protected:
    mutable std::vector<ThreadData_t*> fThreadData; //! Thread specific data vector
    mutable Int_t                      fThreadSize; //! Thread vector size
+   mutable Int_t                      fThreadPrealloc; //! Number of threads with preallocated data
 
 public:
    TGeoVolumeAssembly();
@@ -46,7 +46,8 @@ enum EVoxelsType {
       ~ThreadData_t();
    };
    ThreadData_t& GetThreadData(Int_t tid=0)   const;
-   void          ClearThreadData() const;
+   virtual void  ClearThreadData() const;
+   virtual void  CreateThreadData(Int_t nthreads) const;
 
 protected:
    TGeoVolume      *fVolume;          // volume to which applies
@@ -87,6 +88,7 @@ protected:
 
    mutable std::vector<ThreadData_t*> fThreadData; //!
    mutable Int_t                      fThreadSize; //!
+   mutable Int_t                      fThreadPrealloc; //! Number of threads with preallocated data
 
    TGeoVoxelFinder(const TGeoVoxelFinder&);
    TGeoVoxelFinder& operator=(const TGeoVoxelFinder&);
@@ -134,6 +136,7 @@ public :
 //   virtual Bool_t      GetNextIndices(Double_t *point, Double_t *dir);
    virtual Int_t      *GetNextCandidates(Double_t *point, Int_t &ncheck, Int_t tid=0); 
    virtual void        FindOverlaps(Int_t inode) const;
+   virtual Bool_t      IsBVH() const {return kFALSE;}
    Bool_t              IsInvalid() const {return TObject::TestBit(kGeoInvalidVoxels);}
    Bool_t              NeedRebuild() const {return TObject::TestBit(kGeoRebuildVoxels);}
    Double_t           *GetBoxes() const {return fBoxes;}
@@ -298,6 +298,34 @@ Bool_t TGeoBBox::Contains(const Double_t *point, Double_t dx, Double_t dy, Doubl
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+void TGeoBBox::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+// Test if the vecsize points (SoA layout) are inside this box.
+   if (IsA() != TGeoBBox::Class()) {
+      TGeoShape::Contains_v(points, inside, vecsize);
+      return;
+   }
+   TGeoBBox::Contains_v(points, inside, vecsize, fDX, fDY, fDZ, fOrigin);
+}
+
+//_____________________________________________________________________________
+void TGeoBBox::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize,
+                          Double_t dx, Double_t dy, Double_t dz, const Double_t *origin)
+{
+// Test if the vecsize points (SoA layout) are inside the box with the given
+// half-lengths and origin. The loop has no branches so that it can be
+// vectorized by the compiler.
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   for (Int_t i=0; i<vecsize; i++) {
+      inside[i] = (TMath::Abs(x[i]-origin[0]) <= dx) &
+                  (TMath::Abs(y[i]-origin[1]) <= dy) &
+                  (TMath::Abs(z[i]-origin[2]) <= dz);
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoBBox::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Double_t step, Double_t *safe) const
 {
@@ -362,6 +390,45 @@ Double_t TGeoBBox::DistFromInside(const Double_t *point,const Double_t *dir,
    return smin;
 }
 
+//_____________________________________________________________________________
+void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize inside points to the surface of the box
+// (points and directions in SoA layout).
+   if (IsA() != TGeoBBox::Class()) {
+      TGeoShape::DistFromInside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   TGeoBBox::DistFromInside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin);
+}
+
+//_____________________________________________________________________________
+void TGeoBBox::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize,
+                                Double_t dx, Double_t dy, Double_t dz, const Double_t *origin)
+{
+// Compute distances from vecsize inside points to the surface of the box with
+// the given half-lengths and origin. Same results as the scalar static
+// DistFromInside(), but written without early returns so that the loop can
+// be vectorized.
+   const Double_t par[3] = {dx, dy, dz};
+   const Double_t big = TGeoShape::Big();
+   Int_t i, j;
+   for (i=0; i<vecsize; i++) dists[i] = big;
+   for (j=0; j<3; j++) {
+      const Double_t *p = points + j*vecsize;
+      const Double_t *d = dirs + j*vecsize;
+      const Double_t o = origin[j];
+      const Double_t h = par[j];
+      for (i=0; i<vecsize; i++) {
+         Double_t pt = p[i] - o;
+         Double_t s = (d[i]>0) ? (h-pt)/d[i] : ((d[i]<0) ? (-h-pt)/d[i] : big);
+         dists[i] = (s < dists[i]) ? s : dists[i];
+      }
+   }
+   for (i=0; i<vecsize; i++) dists[i] = (dists[i] < 0) ? 0. : dists[i];
+}
+
 //_____________________________________________________________________________
 Double_t TGeoBBox::DistFromOutside(Double_t *point, Double_t *dir, Int_t iact, Double_t step, Double_t *safe) const
 {
@@ -468,6 +535,90 @@ Double_t TGeoBBox::DistFromOutside(const Double_t *point,const Double_t *dir,
    return TGeoShape::Big();
 }
 
+//_____________________________________________________________________________
+void TGeoBBox::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                 Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize outside points to the surface of the box
+// (points and directions in SoA layout). As for the scalar method, points
+// actually inside the box get 0 unless they are exiting through the closest
+// face, in which case TGeoShape::Big() is returned.
+// For derived shapes without their own vector method, the tracks are first
+// tested against the bounding box and the scalar DistFromOutside() is only
+// called for the ones hitting it. Shapes computing their bounding box on
+// demand (assemblies) have to make it valid before calling this.
+   if (IsA() != TGeoBBox::Class()) {
+      TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin, step);
+      Double_t pt[3], dir[3];
+      for (Int_t i=0; i<vecsize; i++) {
+         if (dists[i] >= TGeoShape::Big()) continue;
+         pt[0] = points[i];
+         pt[1] = points[vecsize+i];
+         pt[2] = points[2*vecsize+i];
+         dir[0] = dirs[i];
+         dir[1] = dirs[vecsize+i];
+         dir[2] = dirs[2*vecsize+i];
+         dists[i] = DistFromOutside(pt, dir, 3, step ? step[i] : TGeoShape::Big());
+      }
+      return;
+   }
+   TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin, step);
+   const Double_t par[3] = {fDX, fDY, fDZ};
+   Double_t saf, ss;
+   Int_t i, j, jmax;
+   for (i=0; i<vecsize; i++) {
+      if (dists[i] > 0) continue;
+      ss = -TGeoShape::Big();
+      jmax = 0;
+      for (j=0; j<3; j++) {
+         saf = TMath::Abs(points[j*vecsize+i]-fOrigin[j]) - par[j];
+         if (saf > ss) {
+            ss = saf;
+            jmax = j;
+         }
+      }
+      if (ss > 0) continue;
+      if ((points[jmax*vecsize+i]-fOrigin[jmax])*dirs[jmax*vecsize+i] > 0) dists[i] = TGeoShape::Big();
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoBBox::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists, Int_t vecsize,
+                                 Double_t dx, Double_t dy, Double_t dz, const Double_t *origin, const Double_t *stepmax)
+{
+// Compute distances from vecsize outside points to the box with the given
+// half-lengths and origin using the slab method. Points inside the box get 0,
+// like in the scalar static DistFromOutside(); tracks missing the box or
+// farther than stepmax[i] get TGeoShape::Big(). Used also as a cheap
+// bounding box pre-filter for a basket of tracks.
+   const Double_t par[3] = {dx, dy, dz};
+   const Double_t big = TGeoShape::Big();
+   Double_t pt, d, inv, t1, t2, lo, hi, tmin, tmax, smax, s;
+   Bool_t par0, in;
+   Int_t i, j;
+   for (i=0; i<vecsize; i++) {
+      tmin = -big;
+      tmax = big;
+      for (j=0; j<3; j++) {
+         pt = points[j*vecsize+i] - origin[j];
+         d = dirs[j*vecsize+i];
+         // parallel to the slab: either always in or never in
+         par0 = (d == 0);
+         in = (TMath::Abs(pt) <= par[j]);
+         inv = par0 ? 0. : 1./d;
+         t1 = par0 ? (in ? -big : big) : (-par[j]-pt)*inv;
+         t2 = par0 ? (in ?  big : -big) : (par[j]-pt)*inv;
+         lo = (t1 < t2) ? t1 : t2;
+         hi = (t1 < t2) ? t2 : t1;
+         tmin = (lo > tmin) ? lo : tmin;
+         tmax = (hi < tmax) ? hi : tmax;
+      }
+      smax = stepmax ? stepmax[i] : big;
+      s = (tmin > 0) ? tmin : 0.;
+      dists[i] = ((tmin <= tmax) & (tmax > 0) & (s < smax)) ? s : big;
+   }
+}
+
 //_____________________________________________________________________________
 const char *TGeoBBox::GetAxisName(Int_t iaxis) const
 {
@@ -796,6 +947,28 @@ Double_t TGeoBBox::Safety(Double_t *point, Bool_t in) const
    return safe;
 }
 
+//_____________________________________________________________________________
+void TGeoBBox::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+// Compute the safe distances of vecsize points (SoA layout) to the box.
+   if (IsA() != TGeoBBox::Class()) {
+      TGeoShape::Safety_v(points, inside, safe, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   Double_t sx, sy, sz, m;
+   for (Int_t i=0; i<vecsize; i++) {
+      sx = TMath::Abs(x[i]-fOrigin[0]) - fDX;
+      sy = TMath::Abs(y[i]-fOrigin[1]) - fDY;
+      sz = TMath::Abs(z[i]-fOrigin[2]) - fDZ;
+      m = (sx > sy) ? sx : sy;
+      m = (sz > m) ? sz : m;
+      safe[i] = inside[i] ? -m : m;
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoBBox::SavePrimitive(ostream &out, Option_t * /*option*/ /*= ""*/)
 {
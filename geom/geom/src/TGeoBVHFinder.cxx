@@ -0,0 +1,746 @@
+// @(#)root/geom:$Id$
+// Author: agent   18/10/26
+
+/*************************************************************************
+ * Copyright (C) 1995-2012, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+// TGeoBVHFinder - bounding volume hierarchy of the daughters of a volume
+//
+// Alternative to the slice voxels of TGeoVoxelFinder for volumes having
+// many daughters with overlapping extents along the three axes (e.g. the
+// cells of a calorimeter module), for which the candidate lists of the
+// slices become very long. The bounding boxes of the daughters (computed
+// in the mother frame by TGeoVoxelFinder::BuildVoxelLimits) are organized
+// in a binary tree built with the surface area heuristic (SAH) on 16 bins
+// per axis. The tree is queried for:
+//  - the daughters whose box contains a point (GetCheckList, used by
+//    TGeoNavigator::FindNode),
+//  - the daughters whose box is crossed by a ray within a maximum step,
+//    sorted by distance (GetRayCandidates, used by FindNextBoundary),
+//  - the daughters whose box is closer than a given safety, sorted by
+//    distance (GetSafetyCandidates, used by TGeoNavigator::Safety).
+// The finder derives from TGeoVoxelFinder, so all the users of the voxels
+// work unchanged. It is selected per volume with TGeoVolume::SetUseBVH() or
+// automatically for all volumes having at least the number of daughters
+// given by TGeoBVHFinder::SetAutoThreshold(). Build and query statistics
+// are printed by Print().
+////////////////////////////////////////////////////////////////////////////////
+
+#include "TGeoBVHFinder.h"
+
+#include "TMath.h"
+#include "TThread.h"
+#include "TStopwatch.h"
+#include "TGeoManager.h"
+#include "TGeoVolume.h"
+#include "TGeoBBox.h"
+
+ClassImp(TGeoBVHFinder)
+
+Int_t TGeoBVHFinder::fgAutoThreshold = 0;
+Int_t TGeoBVHFinder::fgMaxLeafSize   = 4;
+
+static const Int_t kBVHBins = 16;
+
+//______________________________________________________________________________
+static Double_t BVHBoxArea(const Double_t *bmin, const Double_t *bmax)
+{
+   // Half of the surface of an axis aligned box.
+
+   Double_t dx = bmax[0]-bmin[0];
+   Double_t dy = bmax[1]-bmin[1];
+   Double_t dz = bmax[2]-bmin[2];
+   if (dx<0 || dy<0 || dz<0) return 0.;
+   return dx*dy + dy*dz + dz*dx;
+}
+
+//______________________________________________________________________________
+static Bool_t BVHRayBox(const Double_t *bmin, const Double_t *bmax, const Double_t *point,
+                        const Double_t *dir, const Double_t *invdir, Double_t stepmax, Double_t &tnear)
+{
+   // Slab test of a ray against an axis aligned box. Returns kTRUE if the box
+   // is crossed at a distance smaller than stepmax; tnear is 0 if the point is
+   // inside the box.
+
+   Double_t tmin = 0.;
+   Double_t tmax = stepmax;
+   Double_t t1, t2;
+   for (Int_t i=0; i<3; i++) {
+      if (dir[i] == 0) {
+         if (point[i] < bmin[i] || point[i] > bmax[i]) return kFALSE;
+         continue;
+      }
+      t1 = (bmin[i]-point[i])*invdir[i];
+      t2 = (bmax[i]-point[i])*invdir[i];
+      if (t1 > t2) {
+         Double_t t = t1;
+         t1 = t2;
+         t2 = t;
+      }
+      if (t1 > tmin) tmin = t1;
+      if (t2 < tmax) tmax = t2;
+      if (tmin > tmax) return kFALSE;
+   }
+   tnear = tmin;
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+static Double_t BVHBoxDist2(const Double_t *bmin, const Double_t *bmax, const Double_t *point)
+{
+   // Squared distance from a point to an axis aligned box (0 if inside).
+
+   Double_t d2 = 0.;
+   Double_t d;
+   for (Int_t i=0; i<3; i++) {
+      if (point[i] < bmin[i])      d = bmin[i]-point[i];
+      else if (point[i] > bmax[i]) d = point[i]-bmax[i];
+      else continue;
+      d2 += d*d;
+   }
+   return d2;
+}
+
+//______________________________________________________________________________
+TGeoBVHFinder::BVHThreadData_t::BVHThreadData_t() :
+   fStack(0), fDist(0), fStackSize(0), fDistSize(0), fNqueries(0), fNvisited(0), fNchecked(0)
+{
+   // Constructor.
+}
+
+//______________________________________________________________________________
+TGeoBVHFinder::BVHThreadData_t::~BVHThreadData_t()
+{
+   // Destructor.
+
+   delete [] fStack;
+   delete [] fDist;
+}
+
+//______________________________________________________________________________
+void TGeoBVHFinder::BVHThreadData_t::Reserve(Int_t nstack, Int_t ndist)
+{
+   // Make the traversal stack and the distance array large enough for a tree
+   // of depth nstack-2 and ndist daughters.
+
+   if (nstack > fStackSize) {
+      delete [] fStack;
+      fStack = new Int_t[nstack];
+      fStackSize = nstack;
+   }
+   if (ndist > fDistSize) {
+      delete [] fDist;
+      fDist = new Double_t[ndist];
+      fDistSize = ndist;
+   }
+}
+
+//______________________________________________________________________________
+TGeoBVHFinder::BVHThreadData_t& TGeoBVHFinder::GetBVHThreadData(Int_t tid) const
+{
+   // Traversal stack and candidate distances of thread tid. Lock-free when
+   // the data was preallocated with CreateThreadData(): the vector is then
+   // never resized. Otherwise the data is created under lock.
+
+   if (tid < fBVHThreadPrealloc) return *fBVHThreadData[tid];
+   TThread::Lock();
+   if (fBVHThreadPrealloc && tid >= fBVHThreadSize)
+   {
+      TThread::UnLock();
+      Fatal("GetBVHThreadData", "thread %d beyond the %d threads declared with TGeoManager::SetMaxThreads",
+            tid, fBVHThreadPrealloc);
+   }
+   if (tid >= fBVHThreadSize)
+   {
+      fBVHThreadData.resize(tid + 1);
+      fBVHThreadSize = tid + 1;
+   }
+   if (fBVHThreadData[tid] == 0)
+   {
+      fBVHThreadData[tid] = new BVHThreadData_t;
+      fBVHThreadData[tid]->Reserve(fDepth+2, fVolume->GetNdaughters());
+   }
+   TThread::UnLock();
+   return *fBVHThreadData[tid];
+}
+
+//______________________________________________________________________________
+void TGeoBVHFinder::ClearThreadData() const
+{
+   // Delete the thread data of the voxels and of the tree.
+
+   TThread::Lock();
+   TGeoVoxelFinder::ClearThreadData();
+   std::vector<BVHThreadData_t*>::iterator i = fBVHThreadData.begin();
+   while (i != fBVHThreadData.end())
+   {
+      delete *i;
+      ++i;
+   }
+   fBVHThreadData.clear();
+   fBVHThreadSize = 0;
+   fBVHThreadPrealloc = 0;
+   TThread::UnLock();
+}
+
+//______________________________________________________________________________
+void TGeoBVHFinder::CreateThreadData(Int_t nthreads) const
+{
+   // Preallocate the thread data for nthreads threads. Must be called before
+   // the navigation threads are started.
+
+   TThread::Lock();
+   TGeoVoxelFinder::CreateThreadData(nthreads);
+   if (fNnodes)
+   {
+      fBVHThreadPrealloc = 0;
+      if (nthreads > fBVHThreadSize)
+      {
+         fBVHThreadData.resize(nthreads, 0);
+         fBVHThreadSize = nthreads;
+      }
+      for (Int_t tid=0; tid<fBVHThreadSize; tid++) GetBVHThreadData(tid);
+      fBVHThreadPrealloc = fBVHThreadSize;
+   }
+   TThread::UnLock();
+}
+
+//_____________________________________________________________________________
+TGeoBVHFinder::TGeoBVHFinder()
+              :TGeoVoxelFinder()
+{
+// Default constructor
+   fNnodes    = 0;
+   fNleaves   = 0;
+   fDepth     = 0;
+   fCost      = 0.;
+   fBuildTime = 0.;
+   fNodeBox   = 0;
+   fNodeFirst = 0;
+   fNodeCount = 0;
+   fPrims     = 0;
+   fBVHThreadSize = 0;
+   fBVHThreadPrealloc = 0;
+}
+
+//_____________________________________________________________________________
+TGeoBVHFinder::TGeoBVHFinder(TGeoVolume *vol)
+              :TGeoVoxelFinder(vol)
+{
+// Constructor for a given volume. The tree is built by Voxelize().
+   fNnodes    = 0;
+   fNleaves   = 0;
+   fDepth     = 0;
+   fCost      = 0.;
+   fBuildTime = 0.;
+   fNodeBox   = 0;
+   fNodeFirst = 0;
+   fNodeCount = 0;
+   fPrims     = 0;
+   fBVHThreadSize = 0;
+   fBVHThreadPrealloc = 0;
+}
+
+//_____________________________________________________________________________
+TGeoBVHFinder::~TGeoBVHFinder()
+{
+// Destructor
+   delete [] fNodeBox;
+   delete [] fNodeFirst;
+   delete [] fNodeCount;
+   delete [] fPrims;
+   TGeoBVHFinder::ClearThreadData();
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::BuildBVH()
+{
+// Build the tree from the bounding boxes of the daughters (fBoxes).
+   TStopwatch timer;
+   timer.Start();
+   delete [] fNodeBox;
+   delete [] fNodeFirst;
+   delete [] fNodeCount;
+   delete [] fPrims;
+   fNodeBox   = 0;
+   fNodeFirst = 0;
+   fNodeCount = 0;
+   fPrims     = 0;
+   fNnodes    = 0;
+   fNleaves   = 0;
+   fDepth     = 0;
+   fCost      = 0.;
+   Int_t nd = fVolume->GetNdaughters();
+   if (!nd || !fBoxes) return;
+   Double_t *bmin = new Double_t[9*nd];
+   Double_t *bmax = bmin + 3*nd;
+   Double_t *centroid = bmax + 3*nd;
+   Int_t id, i;
+   for (id=0; id<nd; id++) {
+      for (i=0; i<3; i++) {
+         bmin[3*id+i] = fBoxes[6*id+3+i] - fBoxes[6*id+i];
+         bmax[3*id+i] = fBoxes[6*id+3+i] + fBoxes[6*id+i];
+         centroid[3*id+i] = fBoxes[6*id+3+i];
+      }
+   }
+   fPrims = new Int_t[nd];
+   for (id=0; id<nd; id++) fPrims[id] = id;
+   Int_t maxnodes = 2*nd-1;
+   fNodeBox   = new Double_t[6*maxnodes];
+   fNodeFirst = new Int_t[maxnodes];
+   fNodeCount = new Int_t[maxnodes];
+   fNnodes = 1;
+   BuildNode(0, 0, nd, 0, bmin, bmax, centroid);
+   delete [] bmin;
+   // normalize the cost to the area of the root node
+   Double_t aroot = BVHBoxArea(&fNodeBox[0], &fNodeBox[3]);
+   if (aroot > 0) fCost /= aroot;
+   timer.Stop();
+   fBuildTime = timer.RealTime();
+}
+
+//_____________________________________________________________________________
+Int_t TGeoBVHFinder::BuildNode(Int_t inode, Int_t first, Int_t count, Int_t depth,
+                               const Double_t *bmin, const Double_t *bmax, const Double_t *centroid)
+{
+// Build recursively the node inode containing the daughters fPrims[first]
+// to fPrims[first+count-1]. The split minimizes the surface area heuristic
+// evaluated on kBVHBins bins of the centroids along each axis. Returns the
+// number of nodes in the subtree.
+   Double_t *box = &fNodeBox[6*inode];
+   Double_t cmin[3], cmax[3];
+   Int_t i, j, id;
+   for (j=0; j<3; j++) {
+      box[j]   =  TGeoShape::Big();
+      box[j+3] = -TGeoShape::Big();
+      cmin[j]  =  TGeoShape::Big();
+      cmax[j]  = -TGeoShape::Big();
+   }
+   for (i=first; i<first+count; i++) {
+      id = fPrims[i];
+      for (j=0; j<3; j++) {
+         if (bmin[3*id+j] < box[j])   box[j]   = bmin[3*id+j];
+         if (bmax[3*id+j] > box[j+3]) box[j+3] = bmax[3*id+j];
+         if (centroid[3*id+j] < cmin[j]) cmin[j] = centroid[3*id+j];
+         if (centroid[3*id+j] > cmax[j]) cmax[j] = centroid[3*id+j];
+      }
+   }
+   if (depth > fDepth) fDepth = depth;
+   Double_t area = BVHBoxArea(&box[0], &box[3]);
+   if (count <= fgMaxLeafSize) {
+      fNodeFirst[inode] = first;
+      fNodeCount[inode] = count;
+      fNleaves++;
+      fCost += area*count;
+      return 1;
+   }
+   // binned SAH: find the best axis and bin boundary
+   Int_t    bestaxis = -1;
+   Int_t    bestbin  = -1;
+   Double_t bestcost = TGeoShape::Big();
+   Int_t    bincount[kBVHBins];
+   Double_t binmin[3*kBVHBins], binmax[3*kBVHBins];
+   Double_t rightarea[kBVHBins];
+   Int_t    rightcount[kBVHBins];
+   Int_t b, axis;
+   for (axis=0; axis<3; axis++) {
+      Double_t extent = cmax[axis]-cmin[axis];
+      if (extent <= TGeoShape::Tolerance()) continue;
+      Double_t scale = kBVHBins/extent;
+      for (b=0; b<kBVHBins; b++) {
+         bincount[b] = 0;
+         for (j=0; j<3; j++) {
+            binmin[3*b+j] =  TGeoShape::Big();
+            binmax[3*b+j] = -TGeoShape::Big();
+         }
+      }
+      for (i=first; i<first+count; i++) {
+         id = fPrims[i];
+         b = (Int_t)((centroid[3*id+axis]-cmin[axis])*scale);
+         if (b >= kBVHBins) b = kBVHBins-1;
+         bincount[b]++;
+         for (j=0; j<3; j++) {
+            if (bmin[3*id+j] < binmin[3*b+j]) binmin[3*b+j] = bmin[3*id+j];
+            if (bmax[3*id+j] > binmax[3*b+j]) binmax[3*b+j] = bmax[3*id+j];
+         }
+      }
+      // sweep from the right to get the areas of the right partitions
+      Double_t rmin[3], rmax[3];
+      Int_t nright = 0;
+      for (j=0; j<3; j++) {
+         rmin[j] =  TGeoShape::Big();
+         rmax[j] = -TGeoShape::Big();
+      }
+      for (b=kBVHBins-1; b>0; b--) {
+         nright += bincount[b];
+         for (j=0; j<3; j++) {
+            if (binmin[3*b+j] < rmin[j]) rmin[j] = binmin[3*b+j];
+            if (binmax[3*b+j] > rmax[j]) rmax[j] = binmax[3*b+j];
+         }
+         rightcount[b] = nright;
+         rightarea[b]  = BVHBoxArea(rmin, rmax);
+      }
+      // sweep from the left and evaluate the cost of each split
+      Double_t lmin[3], lmax[3];
+      Int_t nleft = 0;
+      for (j=0; j<3; j++) {
+         lmin[j] =  TGeoShape::Big();
+         lmax[j] = -TGeoShape::Big();
+      }
+      for (b=0; b<kBVHBins-1; b++) {
+         nleft += bincount[b];
+         for (j=0; j<3; j++) {
+            if (binmin[3*b+j] < lmin[j]) lmin[j] = binmin[3*b+j];
+            if (binmax[3*b+j] > lmax[j]) lmax[j] = binmax[3*b+j];
+         }
+         if (!nleft || !rightcount[b+1]) continue;
+         Double_t cost = BVHBoxArea(lmin, lmax)*nleft + rightarea[b+1]*rightcount[b+1];
+         if (cost < bestcost) {
+            bestcost = cost;
+            bestaxis = axis;
+            bestbin  = b;
+         }
+      }
+   }
+   // cost of traversing the node (1) relative to intersecting one box (1)
+   Double_t leafcost = area*count;
+   if (bestaxis >= 0) bestcost += area;
+   if (bestaxis < 0 || (bestcost >= leafcost && count <= 4*fgMaxLeafSize)) {
+      if (bestaxis < 0 && count > 4*fgMaxLeafSize) {
+         // all centroids are identical: split in the middle of the list
+         bestbin = -1;
+      } else {
+         fNodeFirst[inode] = first;
+         fNodeCount[inode] = count;
+         fNleaves++;
+         fCost += leafcost;
+         return 1;
+      }
+   }
+   Int_t mid = first + count/2;
+   if (bestaxis >= 0) {
+      // partition the daughters according to the bin of their centroid
+      Double_t scale = kBVHBins/(cmax[bestaxis]-cmin[bestaxis]);
+      Int_t left = first;
+      Int_t right = first+count-1;
+      while (left <= right) {
+         id = fPrims[left];
+         b = (Int_t)((centroid[3*id+bestaxis]-cmin[bestaxis])*scale);
+         if (b >= kBVHBins) b = kBVHBins-1;
+         if (b <= bestbin) {
+            left++;
+         } else {
+            fPrims[left] = fPrims[right];
+            fPrims[right] = id;
+            right--;
+         }
+      }
+      if (left > first && left < first+count) mid = left;
+   }
+   Int_t child = fNnodes;
+   fNnodes += 2;
+   fNodeFirst[inode] = child;
+   fNodeCount[inode] = 0;
+   fCost += area;
+   Int_t nnodes = 1;
+   nnodes += BuildNode(child,   first, mid-first,       depth+1, bmin, bmax, centroid);
+   nnodes += BuildNode(child+1, mid,   first+count-mid, depth+1, bmin, bmax, centroid);
+   return nnodes;
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::CheckBVH()
+{
+// Make sure the tree is built and up to date.
+   if (NeedRebuild() || !fNnodes) {
+      Voxelize();
+      fVolume->FindOverlaps();
+   }
+}
+
+//_____________________________________________________________________________
+Double_t TGeoBVHFinder::Efficiency()
+{
+// Print the statistics and return the average fraction of daughters that
+// did not need to be checked per query.
+   CheckBVH();
+   Print();
+   Long64_t nqueries = 0;
+   Long64_t nchecked = 0;
+   for (Int_t tid=0; tid<fBVHThreadSize; tid++) {
+      if (!fBVHThreadData[tid]) continue;
+      nqueries += fBVHThreadData[tid]->fNqueries;
+      nchecked += fBVHThreadData[tid]->fNchecked;
+   }
+   Int_t nd = fVolume->GetNdaughters();
+   if (!nqueries || !nd) return 1.;
+   return 1. - Double_t(nchecked)/(Double_t(nqueries)*nd);
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetCheckList(Double_t *point, Int_t &nelem, Int_t tid)
+{
+// Get the list of daughter indices for which point is inside their bounding
+// box, in increasing order.
+   CheckBVH();
+   ThreadData_t& td = GetThreadData(tid);
+   BVHThreadData_t& bd = GetBVHThreadData(tid);
+   bd.fNqueries++;
+   Int_t ncand = 0;
+   Int_t nstack = 0;
+   Int_t inode, i, id;
+   const Double_t *box;
+   bd.fStack[nstack++] = 0;
+   while (nstack) {
+      inode = bd.fStack[--nstack];
+      bd.fNvisited++;
+      box = &fNodeBox[6*inode];
+      if (point[0]<box[0] || point[0]>box[3] ||
+          point[1]<box[1] || point[1]>box[4] ||
+          point[2]<box[2] || point[2]>box[5]) continue;
+      if (fNodeCount[inode]) {
+         for (i=fNodeFirst[inode]; i<fNodeFirst[inode]+fNodeCount[inode]; i++) {
+            id = fPrims[i];
+            if (TMath::Abs(point[0]-fBoxes[6*id+3]) > fBoxes[6*id])   continue;
+            if (TMath::Abs(point[1]-fBoxes[6*id+4]) > fBoxes[6*id+1]) continue;
+            if (TMath::Abs(point[2]-fBoxes[6*id+5]) > fBoxes[6*id+2]) continue;
+            td.fCheckList[ncand++] = id;
+         }
+      } else {
+         bd.fStack[nstack++] = fNodeFirst[inode]+1;
+         bd.fStack[nstack++] = fNodeFirst[inode];
+      }
+   }
+   // same ordering as for the slice voxels
+   for (i=1; i<ncand; i++) {
+      id = td.fCheckList[i];
+      Int_t k = i-1;
+      while (k>=0 && td.fCheckList[k]>id) {
+         td.fCheckList[k+1] = td.fCheckList[k];
+         k--;
+      }
+      td.fCheckList[k+1] = id;
+   }
+   td.fNcandidates = ncand;
+   bd.fNchecked += ncand;
+   nelem = ncand;
+   if (!ncand) return 0;
+   return td.fCheckList;
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetNextCandidates(Double_t * /*point*/, Int_t &ncheck, Int_t /*tid*/)
+{
+// All the candidates crossed by a ray are returned in one go by
+// GetNextVoxel(), so there is no next voxel.
+   ncheck = 0;
+   return 0;
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetNextVoxel(Double_t * /*point*/, Double_t * /*dir*/, Int_t &ncheck, Int_t tid)
+{
+// Return the list of daughters crossed by the ray given to SortCrossedVoxels(),
+// sorted by distance, at the first call and nothing afterwards.
+   ThreadData_t& td = GetThreadData(tid);
+   ncheck = 0;
+   if (td.fCurrentVoxel) return 0;
+   td.fCurrentVoxel++;
+   ncheck = td.fNcandidates;
+   if (!ncheck) return 0;
+   return td.fCheckList;
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetRayCandidates(Double_t *point, Double_t *dir, Double_t stepmax, Int_t &ncheck, Int_t tid)
+{
+// Get the list of daughters whose bounding box is crossed by the ray
+// (point, dir) at a distance smaller than stepmax. The list is sorted by
+// increasing distance to the boxes, which are returned by
+// GetCandidateDistances(); the caller can stop checking the daughters as soon
+// as this distance exceeds the current step.
+   CheckBVH();
+   ThreadData_t& td = GetThreadData(tid);
+   BVHThreadData_t& bd = GetBVHThreadData(tid);
+   bd.fNqueries++;
+   td.fCurrentVoxel = 0;
+   Double_t invdir[3];
+   Int_t i, id;
+   for (i=0; i<3; i++) invdir[i] = (dir[i] != 0) ? 1./dir[i] : TGeoShape::Big();
+   Int_t ncand = 0;
+   Int_t nstack = 0;
+   Int_t inode;
+   Double_t tnear, pmin[3], pmax[3];
+   bd.fStack[nstack++] = 0;
+   while (nstack) {
+      inode = bd.fStack[--nstack];
+      bd.fNvisited++;
+      if (!BVHRayBox(&fNodeBox[6*inode], &fNodeBox[6*inode+3], point, dir, invdir, stepmax, tnear)) continue;
+      if (fNodeCount[inode]) {
+         for (i=fNodeFirst[inode]; i<fNodeFirst[inode]+fNodeCount[inode]; i++) {
+            id = fPrims[i];
+            pmin[0] = fBoxes[6*id+3]-fBoxes[6*id];
+            pmin[1] = fBoxes[6*id+4]-fBoxes[6*id+1];
+            pmin[2] = fBoxes[6*id+5]-fBoxes[6*id+2];
+            pmax[0] = fBoxes[6*id+3]+fBoxes[6*id];
+            pmax[1] = fBoxes[6*id+4]+fBoxes[6*id+1];
+            pmax[2] = fBoxes[6*id+5]+fBoxes[6*id+2];
+            if (!BVHRayBox(pmin, pmax, point, dir, invdir, stepmax, tnear)) continue;
+            td.fCheckList[ncand] = id;
+            bd.fDist[ncand++] = tnear;
+         }
+      } else {
+         bd.fStack[nstack++] = fNodeFirst[inode]+1;
+         bd.fStack[nstack++] = fNodeFirst[inode];
+      }
+   }
+   SortCandidates(ncand, td.fCheckList, bd.fDist);
+   td.fNcandidates = ncand;
+   bd.fNchecked += ncand;
+   ncheck = ncand;
+   if (!ncand) return 0;
+   return td.fCheckList;
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoBVHFinder::GetSafetyCandidates(Double_t *point, Double_t safmax, Int_t &ncheck, Int_t tid)
+{
+// Get the list of daughters whose bounding box is closer to point than
+// safmax, sorted by increasing distance (see GetCandidateDistances()).
+   CheckBVH();
+   ThreadData_t& td = GetThreadData(tid);
+   BVHThreadData_t& bd = GetBVHThreadData(tid);
+   bd.fNqueries++;
+   Double_t saf2 = safmax*safmax;
+   Int_t ncand = 0;
+   Int_t nstack = 0;
+   Int_t inode, i, id;
+   Double_t d2, pmin[3], pmax[3];
+   bd.fStack[nstack++] = 0;
+   while (nstack) {
+      inode = bd.fStack[--nstack];
+      bd.fNvisited++;
+      if (BVHBoxDist2(&fNodeBox[6*inode], &fNodeBox[6*inode+3], point) >= saf2) continue;
+      if (fNodeCount[inode]) {
+         for (i=fNodeFirst[inode]; i<fNodeFirst[inode]+fNodeCount[inode]; i++) {
+            id = fPrims[i];
+            pmin[0] = fBoxes[6*id+3]-fBoxes[6*id];
+            pmin[1] = fBoxes[6*id+4]-fBoxes[6*id+1];
+            pmin[2] = fBoxes[6*id+5]-fBoxes[6*id+2];
+            pmax[0] = fBoxes[6*id+3]+fBoxes[6*id];
+            pmax[1] = fBoxes[6*id+4]+fBoxes[6*id+1];
+            pmax[2] = fBoxes[6*id+5]+fBoxes[6*id+2];
+            d2 = BVHBoxDist2(pmin, pmax, point);
+            if (d2 >= saf2) continue;
+            td.fCheckList[ncand] = id;
+            bd.fDist[ncand++] = TMath::Sqrt(d2);
+         }
+      } else {
+         bd.fStack[nstack++] = fNodeFirst[inode]+1;
+         bd.fStack[nstack++] = fNodeFirst[inode];
+      }
+   }
+   SortCandidates(ncand, td.fCheckList, bd.fDist);
+   td.fNcandidates = ncand;
+   bd.fNchecked += ncand;
+   ncheck = ncand;
+   if (!ncand) return 0;
+   return td.fCheckList;
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::Print(Option_t *) const
+{
+// Print the build and query statistics of the tree.
+   Int_t nd = fVolume->GetNdaughters();
+   printf("BVH of volume %s: %d daughters\n", fVolume->GetName(), nd);
+   if (!fNnodes) {
+      printf("   not built\n");
+      return;
+   }
+   printf("   nodes: %d  leaves: %d  depth: %d  daughters/leaf: %g\n",
+          fNnodes, fNleaves, fDepth, Double_t(nd)/fNleaves);
+   printf("   SAH cost: %g  build time: %g ms\n", fCost, 1000.*fBuildTime);
+   Long64_t nqueries = 0;
+   Long64_t nvisited = 0;
+   Long64_t nchecked = 0;
+   for (Int_t tid=0; tid<fBVHThreadSize; tid++) {
+      if (!fBVHThreadData[tid]) continue;
+      nqueries += fBVHThreadData[tid]->fNqueries;
+      nvisited += fBVHThreadData[tid]->fNvisited;
+      nchecked += fBVHThreadData[tid]->fNchecked;
+   }
+   if (!nqueries) return;
+   printf("   queries: %lld  nodes visited/query: %g  candidates/query: %g\n",
+          nqueries, Double_t(nvisited)/nqueries, Double_t(nchecked)/nqueries);
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::ResetStatistics()
+{
+// Reset the query counters of all threads.
+   for (Int_t tid=0; tid<fBVHThreadSize; tid++) {
+      if (!fBVHThreadData[tid]) continue;
+      fBVHThreadData[tid]->fNqueries = 0;
+      fBVHThreadData[tid]->fNvisited = 0;
+      fBVHThreadData[tid]->fNchecked = 0;
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::SortCandidates(Int_t ncand, Int_t *list, Double_t *dist) const
+{
+// Sort the candidates by increasing distance (insertion sort, the lists
+// are short and often almost sorted).
+   Int_t i, k, id;
+   Double_t d;
+   for (i=1; i<ncand; i++) {
+      id = list[i];
+      d  = dist[i];
+      k  = i-1;
+      while (k>=0 && dist[k]>d) {
+         list[k+1] = list[k];
+         dist[k+1] = dist[k];
+         k--;
+      }
+      list[k+1] = id;
+      dist[k+1] = d;
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::SortCrossedVoxels(Double_t *point, Double_t *dir, Int_t tid)
+{
+// Collect all daughters crossed by the ray, to be returned by GetNextVoxel().
+   Int_t ncheck;
+   GetRayCandidates(point, dir, TGeoShape::Big(), ncheck, tid);
+}
+
+//_____________________________________________________________________________
+void TGeoBVHFinder::Voxelize(Option_t * /*option*/)
+{
+// Compute the bounding boxes of the daughters and build the tree.
+   if (fVolume->IsAssembly()) fVolume->GetShape()->ComputeBBox();
+   Int_t nd = fVolume->GetNdaughters();
+   TGeoVolume *vd;
+   for (Int_t i=0; i<nd; i++) {
+      vd = fVolume->GetNode(i)->GetVolume();
+      if (vd->IsAssembly()) vd->GetShape()->ComputeBBox();
+   }
+   BuildVoxelLimits();
+   BuildBVH();
+   // The rebuilt tree may be deeper or have more daughters than the one the
+   // existing thread buffers were sized for.
+   TThread::Lock();
+   for (Int_t tid=0; tid<fBVHThreadSize; tid++) {
+      if (fBVHThreadData[tid]) fBVHThreadData[tid]->Reserve(fDepth+2, nd);
+   }
+   TThread::UnLock();
+   SetNeedRebuild(kFALSE);
+}
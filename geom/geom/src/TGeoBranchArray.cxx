@@ -274,7 +274,20 @@ void TGeoBranchArray::Sort(Int_t n, TGeoBranchArray **array, Int_t *index, Bool_
 //______________________________________________________________________________
 void TGeoBranchArray::UpdateNavigator(TGeoNavigator *nav) const
 {
-// Update the navigator to reflect the branch.
+// Update the navigator to reflect the branch. If the navigator has a state
+// cache, a branch already visited is restored from it.
+   // The key starts with a null character so that it never matches a path.
+   char key[256];
+   Int_t len = 1 + fLevel*sizeof(UShort_t);
+   Bool_t cached = (nav->GetStateCache() && len <= 256);
+   ULong64_t hash = 0;
+   if (cached) {
+      key[0] = 0;
+      if (fLevel) memcpy(key+1, fArray, fLevel*sizeof(UShort_t));
+      hash = TGeoStateCache::Hash(key, len);
+      if (nav->RestoreCachedState(key, len, hash)) return;
+   }
    nav->CdTop();
    for (Int_t i=0; i<fLevel; i++) nav->CdDown(fArray[i]);
+   if (cached) nav->CacheState(key, len, hash);
 }
@@ -25,6 +25,7 @@
 #include "TGeoMatrix.h"
 #include "TGeoVolume.h"
 #include "TGeoCache.h"
+#include "TMath.h"
 
 const Int_t kN3 = 3*sizeof(Double_t);
 
@@ -526,3 +527,175 @@ Bool_t TGeoCacheState::GetState(Int_t &level, Int_t &nmany, Double_t *point) con
    if (point) memcpy(point, fPoint, 3*sizeof(Double_t));
    return fOverlapping;
 }
+
+ClassImp(TGeoStateCache)
+
+/*************************************************************************
+* TGeoStateCache - bounded cache of navigation states keyed by a path or
+*   by a branch of daughter indices. Restoring a cached state copies the
+*   node branch and the global matrices into the node cache instead of
+*   descending the tree from the top node. When full, the least recently
+*   used state is recycled. The states are found through a TExMap keyed
+*   by the hash of the key, computed once by the caller (see Hash()), and
+*   the key itself is compared only for the candidate slot. Each cache is
+*   used by a single navigator; Invalidate() drops its states, and is
+*   called for all the navigators by TGeoManager::InvalidateStateCaches()
+*   whenever node matrices change (e.g. alignment).
+*************************************************************************/
+
+//_____________________________________________________________________________
+TGeoStateCache::TGeoStateCache()
+{
+// Default ctor.
+   fCapacity   = 0;
+   fMaxLevels  = 0;
+   fSize       = 0;
+   fHead       = -1;
+   fTail       = -1;
+   fGeneration = 0;
+   fStatesGeneration = 0;
+   fPrev       = 0;
+   fNext       = 0;
+   fStates     = 0;
+   fKeys       = 0;
+   fHashes     = 0;
+   fNhits      = 0;
+   fNmisses    = 0;
+   fNevicted   = 0;
+}
+
+//_____________________________________________________________________________
+TGeoStateCache::TGeoStateCache(Int_t capacity, Int_t maxlevels)
+               :fMap(2*((capacity>0)?capacity:1))
+{
+// Ctor for a cache of at most CAPACITY states having at most MAXLEVELS levels.
+   fCapacity   = (capacity>0)?capacity:1;
+   fMaxLevels  = maxlevels;
+   fSize       = 0;
+   fHead       = -1;
+   fTail       = -1;
+   fGeneration = 0;
+   fStatesGeneration = 0;
+   fPrev       = new Int_t[fCapacity];
+   fNext       = new Int_t[fCapacity];
+   fStates     = new TGeoCacheState*[fCapacity];
+   fKeys       = new std::string[fCapacity];
+   fHashes     = new ULong64_t[fCapacity];
+   for (Int_t i=0; i<fCapacity; i++) {
+      fPrev[i] = fNext[i] = -1;
+      fStates[i] = 0;
+      fHashes[i] = 0;
+   }
+   fNhits      = 0;
+   fNmisses    = 0;
+   fNevicted   = 0;
+}
+
+//_____________________________________________________________________________
+TGeoStateCache::~TGeoStateCache()
+{
+// Dtor.
+   if (fStates) {
+      for (Int_t i=0; i<fCapacity; i++) delete fStates[i];
+      delete [] fStates;
+   }
+   delete [] fPrev;
+   delete [] fNext;
+   delete [] fKeys;
+   delete [] fHashes;
+}
+
+//_____________________________________________________________________________
+void TGeoStateCache::Clear(Option_t *)
+{
+// Forget all cached states. The state objects are kept for reuse.
+   fMap.Delete();
+   for (Int_t i=0; i<fSize; i++) {
+      fKeys[i].clear();
+      fPrev[i] = fNext[i] = -1;
+   }
+   fSize = 0;
+   fHead = fTail = -1;
+   fStatesGeneration = fGeneration;
+}
+
+//_____________________________________________________________________________
+ULong64_t TGeoStateCache::Hash(const char *key, Int_t len)
+{
+// Hash of a key, to be passed to Find() and Insert().
+   return TMath::Hash(key, len);
+}
+
+//_____________________________________________________________________________
+void TGeoStateCache::Unlink(Int_t slot)
+{
+// Remove a slot from the LRU list.
+   if (fPrev[slot]>=0) fNext[fPrev[slot]] = fNext[slot];
+   else                fHead = fNext[slot];
+   if (fNext[slot]>=0) fPrev[fNext[slot]] = fPrev[slot];
+   else                fTail = fPrev[slot];
+   fPrev[slot] = fNext[slot] = -1;
+}
+
+//_____________________________________________________________________________
+void TGeoStateCache::Touch(Int_t slot)
+{
+// Make a slot the most recently used one.
+   if (slot == fHead) return;
+   if (fPrev[slot]>=0 || fNext[slot]>=0 || slot==fTail) Unlink(slot);
+   fNext[slot] = fHead;
+   fPrev[slot] = -1;
+   if (fHead>=0) fPrev[fHead] = slot;
+   fHead = slot;
+   if (fTail<0) fTail = slot;
+}
+
+//_____________________________________________________________________________
+TGeoCacheState *TGeoStateCache::Find(const char *key, Int_t len, ULong64_t hash)
+{
+// Return the state cached for this key, of the given hash, or 0 if not found.
+   if (fStatesGeneration != fGeneration) Clear();
+   Int_t slot = (Int_t)fMap.GetValue(hash, (Long64_t)hash) - 1;
+   if (slot<0 || (Int_t)fKeys[slot].size()!=len || memcmp(fKeys[slot].data(), key, len)) {
+      fNmisses++;
+      return 0;
+   }
+   fNhits++;
+   Touch(slot);
+   return fStates[slot];
+}
+
+//_____________________________________________________________________________
+TGeoCacheState *TGeoStateCache::Insert(const char *key, Int_t len, ULong64_t hash)
+{
+// Return a state to be filled for this key, of the given hash, recycling the
+// least recently used one if the cache is full. A key having the same hash
+// as a cached one replaces it.
+   if (fStatesGeneration != fGeneration) Clear();
+   Int_t slot = (Int_t)fMap.GetValue(hash, (Long64_t)hash) - 1;
+   if (slot<0) {
+      if (fSize < fCapacity) {
+         slot = fSize++;
+      } else {
+         slot = fTail;
+         Unlink(slot);
+         fMap.Remove(fHashes[slot], (Long64_t)fHashes[slot]);
+         fNevicted++;
+      }
+      fHashes[slot] = hash;
+      fMap.Add(hash, (Long64_t)hash, slot+1);
+   }
+   fKeys[slot].assign(key, len);
+   if (!fStates[slot]) fStates[slot] = new TGeoCacheState(fMaxLevels);
+   Touch(slot);
+   return fStates[slot];
+}
+
+//_____________________________________________________________________________
+void TGeoStateCache::Print(Option_t *) const
+{
+// Print cache statistics.
+   Long64_t nlookups = fNhits+fNmisses;
+   printf("TGeoStateCache: %d/%d states, %lld lookups, hit rate %g%%, %lld evicted\n",
+          fSize, fCapacity, nlookups, (nlookups>0)?100.*fNhits/nlookups:0., fNevicted);
+}
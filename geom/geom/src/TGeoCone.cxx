@@ -251,6 +251,28 @@ Bool_t TGeoCone::Contains(Double_t *point) const
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+void TGeoCone::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+// Test if the vecsize points (SoA layout) are inside this cone. Branch-free
+// loop so that the compiler can vectorize it.
+   if (IsA() != TGeoCone::Class()) {
+      TGeoShape::Contains_v(points, inside, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t invdz = 0.5/fDz;
+   Double_t r2, rl, rh;
+   for (Int_t i=0; i<vecsize; i++) {
+      r2 = x[i]*x[i]+y[i]*y[i];
+      rl = (fRmin2*(z[i]+fDz)+fRmin1*(fDz-z[i]))*invdz;
+      rh = (fRmax2*(z[i]+fDz)+fRmax1*(fDz-z[i]))*invdz;
+      inside[i] = (TMath::Abs(z[i]) <= fDz) & (r2 >= rl*rl) & (r2 <= rh*rh);
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoCone::DistFromInsideS(Double_t *point, Double_t *dir, Double_t dz,
                               Double_t rmin1, Double_t rmax1, Double_t rmin2, Double_t rmax2)
@@ -337,6 +359,29 @@ Double_t TGeoCone::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Do
    return TGeoCone::DistFromInsideS(point, dir, fDz, fRmin1, fRmax1, fRmin2, fRmax2);
 }
 
+//_____________________________________________________________________________
+void TGeoCone::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize inside points to the surface of the cone
+// (points and directions in SoA layout), calling DistFromInsideS() directly
+// for each track.
+   if (IsA() != TGeoCone::Class()) {
+      TGeoShape::DistFromInside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = TGeoCone::DistFromInsideS(pt, dir, fDz, fRmin1, fRmax1, fRmin2, fRmax2);
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoCone::DistFromOutsideS(Double_t *point, Double_t *dir, Double_t dz,
                              Double_t rmin1, Double_t rmax1, Double_t rmin2, Double_t rmax2)
@@ -484,6 +529,32 @@ Double_t TGeoCone::DistFromOutside(Double_t *point, Double_t *dir, Int_t iact, D
    return TGeoCone::DistFromOutsideS(point, dir, fDz, fRmin1, fRmax1, fRmin2, fRmax2);
 }
 
+//_____________________________________________________________________________
+void TGeoCone::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                 Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize outside points to the surface of the cone
+// (points and directions in SoA layout). The bounding box is checked for all
+// the tracks in one loop, then DistFromOutsideS() is called for the tracks
+// crossing it within step[i].
+   if (IsA() != TGeoCone::Class()) {
+      TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin, step);
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      if (dists[i] >= TGeoShape::Big()) continue;
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = TGeoCone::DistFromOutsideS(pt, dir, fDz, fRmin1, fRmax1, fRmin2, fRmax2);
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoCone::DistToCone(Double_t *point, Double_t *dir, Double_t dz, Double_t r1, Double_t r2,
                               Double_t &b, Double_t &delta)
@@ -869,6 +940,36 @@ Double_t TGeoCone::Safety(Double_t *point, Bool_t in) const
 */
 }
 
+//_____________________________________________________________________________
+void TGeoCone::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+// Compute the safe distances of vecsize points (SoA layout) to this cone.
+   if (IsA() != TGeoCone::Class()) {
+      TGeoShape::Safety_v(points, inside, safe, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t ro1 = 0.5*(fRmin1+fRmin2);
+   const Double_t tg1 = 0.5*(fRmin2-fRmin1)/fDz;
+   const Double_t cr1 = 1./TMath::Sqrt(1.+tg1*tg1);
+   const Double_t ro2 = 0.5*(fRmax1+fRmax2);
+   const Double_t tg2 = 0.5*(fRmax2-fRmax1)/fDz;
+   const Double_t cr2 = 1./TMath::Sqrt(1.+tg2*tg2);
+   const Bool_t hasrmin = (ro1>0);
+   Double_t r, saf, safrmin, safrmax;
+   for (Int_t i=0; i<vecsize; i++) {
+      r = TMath::Sqrt(x[i]*x[i]+y[i]*y[i]);
+      saf = fDz-TMath::Abs(z[i]);
+      safrmin = hasrmin ? (r-tg1*z[i]-ro1)*cr1 : TGeoShape::Big();
+      safrmax = (tg2*z[i]+ro2-r)*cr2;
+      saf = (safrmin < saf) ? safrmin : saf;
+      saf = (safrmax < saf) ? safrmax : saf;
+      safe[i] = inside[i] ? saf : -saf;
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoCone::SafetyS(Double_t *point, Bool_t in, Double_t dz, Double_t rmin1, Double_t rmax1,
                            Double_t rmin2, Double_t rmax2, Int_t skipz)
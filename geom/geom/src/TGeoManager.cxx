@@ -329,6 +329,28 @@ Int_t  TGeoManager::fgVerboseLevel = 1;
 Int_t  TGeoManager::fgNumThreads   = 0;
 TGeoManager::ThreadsMap_t TGeoManager::fgThreadId;
 
+// Thread local caches of the thread ordinal number and of the navigator array
+// of the calling thread. They avoid the map lookups and the global lock on the
+// navigation hot path. The cached navigator array is valid only as long as
+// its tag matches the fNavigatorsTag of the manager.
+#ifdef R__TLS
+static R__TLS Int_t               gTlsThreadId   = -1;
+static R__TLS Int_t               gTlsNavTag     = 0;
+static R__TLS TGeoNavigatorArray *gTlsNavigators = 0;
+#endif
+static Int_t gNavigatorsTag = 0;
+
+//______________________________________________________________________________
+static Int_t NewNavigatorsTag()
+{
+   // Return a new unique tag for a set of navigator arrays.
+
+   TThread::Lock();
+   Int_t tag = ++gNavigatorsTag;
+   TThread::UnLock();
+   return tag;
+}
+
 //______________________________________________________________________________
 TGeoManager::ThreadData_t::ThreadData_t() :
    fIntSize(0), fDblSize(0), fIntBuffer(0), fDblBuffer(0)
@@ -349,7 +371,16 @@ TGeoManager::ThreadData_t::~ThreadData_t()
 TGeoManager::ThreadData_t& TGeoManager::GetThreadData() const
 {
    Int_t tid = TGeoManager::ThreadId();
+   // Lock-free when the data was preallocated with SetMaxThreads(): the
+   // vector is then never resized. Otherwise the data is created under lock.
+   if (tid < fMaxThreads) return *fThreadData[tid];
    TThread::Lock();
+   if (fMaxThreads && tid >= fThreadSize)
+   {
+      TThread::UnLock();
+      Fatal("GetThreadData", "thread %d beyond the %d threads declared with SetMaxThreads",
+            tid, fMaxThreads);
+   }
    if (tid >= fThreadSize)
    {
       fThreadData.resize(tid + 1);
@@ -447,6 +478,8 @@ TGeoManager::TGeoManager()
       fKeyPNEId = 0;
       fValuePNEId = 0;
       fMultiThread = kFALSE;
+      fMaxThreads = 0;
+      fNavigatorsTag = NewNavigatorsTag();
       ClearThreadsMap();
       fThreadSize = 0;
    } else {
@@ -541,6 +574,8 @@ void TGeoManager::Init()
    fKeyPNEId = 0;
    fValuePNEId = 0;
    fMultiThread = kFALSE;
+   fMaxThreads = 0;
+   fNavigatorsTag = NewNavigatorsTag();
    ClearThreadsMap();
    fThreadSize = 0;
 }
@@ -609,6 +644,8 @@ TGeoManager::TGeoManager(const TGeoManager& gm) :
   fKeyPNEId(0),
   fValuePNEId(0),
   fMultiThread(kFALSE),
+  fMaxThreads(0),
+  fNavigatorsTag(NewNavigatorsTag()),
   fThreadSize(0)
 {
    //copy constructor
@@ -686,6 +723,7 @@ TGeoManager& TGeoManager::operator=(const TGeoManager& gm)
       fKeyPNEId = 0;
       fValuePNEId = 0;
       fMultiThread = kFALSE;
+      fMaxThreads = 0;
       ClearThreadsMap();
       ClearThreadData();
    }
@@ -860,6 +898,12 @@ TGeoNavigator *TGeoManager::AddNavigator()
       fNavigators.insert(NavigatorsMap_t::value_type(threadId, array));
    }
    TGeoNavigator *nav = array->AddNavigator();
+#ifdef R__TLS
+   if (fMultiThread) {
+      gTlsNavTag = fNavigatorsTag;
+      gTlsNavigators = array;
+   }
+#endif
    if (fMultiThread) TThread::UnLock();
    return nav;
 }   
@@ -869,21 +913,37 @@ TGeoNavigator *TGeoManager::GetCurrentNavigator() const
 {
 // Returns current navigator for the calling thread.
    if (!fMultiThread) return fCurrentNavigator;
-   Long_t threadId = TThread::SelfId();
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
+   TGeoNavigatorArray *array = GetListOfNavigators();
+   if (!array) return 0;
    return array->GetCurrentNavigator();
 }
 
 //_____________________________________________________________________________
 TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 {
-// Get list of navigators for the calling thread.
-   Long_t threadId = (fMultiThread)?TThread::SelfId():999;
+// Get list of navigators for the calling thread. In multi-threaded mode the
+// array is cached in thread local storage, so that the map of navigators is
+// searched (under lock) only the first time a thread asks for it.
+   if (!fMultiThread) {
+      NavigatorsMap_t::const_iterator it = fNavigators.find(999);
+      if (it == fNavigators.end()) return 0;
+      return it->second;
+   }
+#ifdef R__TLS
+   if (gTlsNavTag == fNavigatorsTag) return gTlsNavigators;
+#endif
+   TGeoNavigatorArray *array = 0;
+   Long_t threadId = TThread::SelfId();
+   TThread::Lock();
    NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) return 0;
-   TGeoNavigatorArray *array = it->second;
+   if (it != fNavigators.end()) array = it->second;
+   TThread::UnLock();
+#ifdef R__TLS
+   if (array) {
+      gTlsNavTag = fNavigatorsTag;
+      gTlsNavigators = array;
+   }
+#endif
    return array;
 }
 
@@ -891,16 +951,16 @@ TGeoNavigatorArray *TGeoManager::GetListOfNavigators() const
 Bool_t TGeoManager::SetCurrentNavigator(Int_t index)
 {
 // Switch to another existing navigator for the calling thread.
-   Long_t threadId = (fMultiThread)?TThread::SelfId():999;
-   NavigatorsMap_t::const_iterator it = fNavigators.find(threadId);
-   if (it == fNavigators.end()) {
+   TGeoNavigatorArray *array = GetListOfNavigators();
+   if (!array) {
+      Long_t threadId = (fMultiThread)?TThread::SelfId():999;
       Error("SetCurrentNavigator", "No navigator defined for thread %ld\n", threadId);
       return kFALSE;
    }   
-   TGeoNavigatorArray *array = it->second;
    TGeoNavigator *nav = array->SetCurrentNavigator(index);
    if (!nav) {
-      Error("SetCurrentNavigator", "Navigator %d not existing for thread %ld\n", index, threadId);
+      Error("SetCurrentNavigator", "Navigator %d not existing for thread %ld\n", index,
+            (fMultiThread)?TThread::SelfId():999L);
       return kFALSE;
    }
    if (!fMultiThread) fCurrentNavigator = nav;
@@ -919,6 +979,26 @@ void TGeoManager::ClearNavigators()
       if (arr) delete arr;
    }
    fNavigators.clear();   
+   // invalidate the navigator arrays cached by the threads
+   fNavigatorsTag = NewNavigatorsTag();
+   if (fMultiThread) TThread::UnLock();
+}
+
+//_____________________________________________________________________________
+void TGeoManager::InvalidateStateCaches()
+{
+// Drop the states cached by all the navigators (see
+// TGeoNavigator::SetStateCacheSize), to be called when node matrices change.
+   if (fMultiThread) TThread::Lock();
+   for (NavigatorsMap_t::iterator it = fNavigators.begin();
+        it != fNavigators.end(); it++) {
+      TGeoNavigatorArray *arr = (*it).second;
+      if (!arr) continue;
+      for (Int_t i=0; i<arr->GetEntriesFast(); i++) {
+         TGeoNavigator *nav = (TGeoNavigator*)arr->At(i);
+         if (nav && nav->GetStateCache()) nav->GetStateCache()->Invalidate();
+      }
+   }
    if (fMultiThread) TThread::UnLock();
 }
 
@@ -933,6 +1013,7 @@ void TGeoManager::RemoveNavigator(const TGeoNavigator *nav)
       if (arr) {
          if ((TGeoNavigator*)arr->Remove((TObject*)nav)) {
             delete nav;
+            if (fMultiThread) TThread::UnLock();
             return;
          }
       }   
@@ -959,6 +1040,19 @@ Int_t TGeoManager::ThreadId()
 // manage data which is pspecific for a given thread.
    Int_t tid = 0;
    if (gGeoManager && !gGeoManager->IsMultiThread()) return 0;
+#ifdef R__TLS
+   // Fast path: the ordinal number is kept in thread local storage. New
+   // threads get the next number with an atomic increment where available.
+   if (gTlsThreadId >= 0) return gTlsThreadId;
+#if defined(__GNUC__)
+   tid = __sync_fetch_and_add(&fgNumThreads, 1);
+#else
+   TThread::Lock();
+   tid = fgNumThreads++;
+   TThread::UnLock();
+#endif
+   gTlsThreadId = tid;
+#else
    Long_t selfId = TThread::SelfId();
    TGeoManager::ThreadsMapIt_t it = fgThreadId.find(selfId);
    if (it != fgThreadId.end()) return it->second;
@@ -967,8 +1061,36 @@ Int_t TGeoManager::ThreadId()
    fgThreadId[selfId] = fgNumThreads;
    tid = fgNumThreads++;
    TThread::UnLock();
+#endif
    return tid;
 }   
+
+//_____________________________________________________________________________
+void TGeoManager::SetMaxThreads(Int_t nthreads)
+{
+// Preallocate the thread specific data of the manager and of all volumes
+// (voxel check lists, assembly states) for nthreads threads. After this call
+// threads having ordinal numbers below nthreads never take the global lock
+// to access their data. Must be called before starting the worker threads:
+// the vectors of thread data are not resized afterwards, so a thread with an
+// ordinal number beyond nthreads is a fatal error.
+   if (nthreads <= 0) return;
+   TThread::Lock();
+   fMaxThreads = 0;
+   if (fThreadSize < nthreads) {
+      fThreadData.resize(nthreads, 0);
+      fThreadSize = nthreads;
+   }
+   for (Int_t tid=0; tid<fThreadSize; tid++) {
+      if (!fThreadData[tid]) fThreadData[tid] = new ThreadData_t;
+   }
+   fMaxThreads = fThreadSize;
+   TThread::UnLock();
+   if (!fVolumes) return;
+   TIter next(fVolumes);
+   TGeoVolume *vol;
+   while ((vol=(TGeoVolume*)next())) vol->CreateThreadData(nthreads);
+}
    
 //_____________________________________________________________________________
 void TGeoManager::Browse(TBrowser *b)
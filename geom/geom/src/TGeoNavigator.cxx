@@ -29,10 +29,12 @@
 
 #include "TGeoManager.h"
 #include "TGeoMatrix.h"
+#include "TGeoBBox.h"
 #include "TGeoNode.h"
 #include "TGeoVolume.h"
 #include "TGeoPatternFinder.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHFinder.h"
 #include "TMath.h"
 
 #include "TGeoNavigator.h"
@@ -55,6 +57,10 @@ TGeoNavigator::TGeoNavigator()
                fOverlapSize(0),
                fOverlapMark(0),
                fOverlapClusters(0),
+               fBasketSize(0),
+               fBasketIndexSize(0),
+               fBasketBuffer(0),
+               fBasketIndex(0),
                fSearchOverlaps(kFALSE),
                fCurrentOverlapping(kFALSE),
                fStartSafe(kFALSE),
@@ -75,6 +81,8 @@ TGeoNavigator::TGeoNavigator()
                fNextNode(0),
                fForcedNode(0),
                fBackupState(0),
+               fBasketBackup(0),
+               fStateCache(0),
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
@@ -104,6 +112,10 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
                fOverlapSize(1000),
                fOverlapMark(0),
                fOverlapClusters(0),
+               fBasketSize(0),
+               fBasketIndexSize(0),
+               fBasketBuffer(0),
+               fBasketIndex(0),
                fSearchOverlaps(kFALSE),
                fCurrentOverlapping(kFALSE),
                fStartSafe(kTRUE),
@@ -124,6 +136,8 @@ TGeoNavigator::TGeoNavigator(TGeoManager* geom)
                fNextNode(0),
                fForcedNode(0),
                fBackupState(0),
+               fBasketBackup(0),
+               fStateCache(0),
                fCurrentMatrix(0),
                fGlobalMatrix(0),
                fDivMatrix(0),
@@ -162,6 +176,10 @@ TGeoNavigator::TGeoNavigator(const TGeoNavigator& gm)
                fOverlapSize(gm.fOverlapSize),
                fOverlapMark(gm.fOverlapMark),
                fOverlapClusters(gm.fOverlapClusters),
+               fBasketSize(0),
+               fBasketIndexSize(0),
+               fBasketBuffer(0),
+               fBasketIndex(0),
                fSearchOverlaps(gm.fSearchOverlaps),
                fCurrentOverlapping(gm.fCurrentOverlapping),
                fStartSafe(gm.fStartSafe),
@@ -182,6 +200,8 @@ TGeoNavigator::TGeoNavigator(const TGeoNavigator& gm)
                fNextNode(gm.fNextNode),
                fForcedNode(gm.fForcedNode),
                fBackupState(gm.fBackupState),
+               fBasketBackup(0),
+               fStateCache(0),
                fCurrentMatrix(gm.fCurrentMatrix),
                fGlobalMatrix(gm.fGlobalMatrix),
                fPath(gm.fPath)               
@@ -236,6 +256,15 @@ TGeoNavigator& TGeoNavigator::operator=(const TGeoNavigator& gm)
       fNextNode = gm.fNextNode;
       fForcedNode = gm.fForcedNode;
       fBackupState = gm.fBackupState;
+      // work arrays are not shared
+      if (fBasketBuffer) delete [] fBasketBuffer;
+      if (fBasketIndex) delete [] fBasketIndex;
+      if (fBasketBackup) delete fBasketBackup;
+      fBasketSize = 0;
+      fBasketIndexSize = 0;
+      fBasketBuffer = 0;
+      fBasketIndex = 0;
+      fBasketBackup = 0;
       fCurrentMatrix = gm.fCurrentMatrix;
       fGlobalMatrix = gm.fGlobalMatrix;
       fPath = gm.fPath;
@@ -259,7 +288,11 @@ TGeoNavigator::~TGeoNavigator()
 // Destructor.
    if (fCache) delete fCache;
    if (fBackupState) delete fBackupState;
+   if (fStateCache) delete fStateCache;
    if (fOverlapClusters) delete [] fOverlapClusters;
+   if (fBasketBuffer) delete [] fBasketBuffer;
+   if (fBasketIndex) delete [] fBasketIndex;
+   if (fBasketBackup) delete fBasketBackup;
 }
    
 //_____________________________________________________________________________
@@ -287,8 +320,12 @@ void TGeoNavigator::BuildCache(Bool_t /*dummy*/, Bool_t nodeid)
 Bool_t TGeoNavigator::cd(const char *path)
 {
 // Browse the tree of nodes starting from top node according to pathname.
-// Changes the path accordingly.
-   if (!strlen(path)) return kFALSE;
+// Changes the path accordingly. If a state cache is enabled (see
+// SetStateCacheSize) a path already visited is restored without descending.
+   Int_t len = strlen(path);
+   if (!len) return kFALSE;
+   ULong64_t hash = fStateCache ? TGeoStateCache::Hash(path, len) : 0;
+   if (fStateCache && RestoreCachedState(path, len, hash)) return kTRUE;
    CdTop();
    TString spath = path;
    TGeoVolume *vol;
@@ -320,6 +357,7 @@ Bool_t TGeoNavigator::cd(const char *path)
       CdDown(fCurrentNode->GetVolume()->GetIndex(node));
       ind1 = ind2;
    }
+   if (fStateCache) CacheState(path, len, hash);
    return kTRUE;
 }
 
@@ -899,6 +937,254 @@ TGeoNode *TGeoNavigator::FindNextBoundary(Double_t stepmax, const char *path, Bo
    return fNextNode;
 }
 
+//_____________________________________________________________________________
+void TGeoNavigator::FindNextBoundary_v(Int_t ntracks, const Double_t *points, const Double_t *dirs,
+                                       const Double_t *stepmax, Double_t *step, Int_t *idaughter)
+{
+// Find the distances to the next boundary for a basket of ntracks tracks, all
+// located in the current node. Points and directions are given in the master
+// frame in SoA layout: points[i], points[ntracks+i] and points[2*ntracks+i]
+// are the coordinates of track i. On output step[i] is the distance to the
+// next boundary, limited to stepmax[i], and idaughter[i] is the index of the
+// daughter node being entered, -1 if the track exits the current node or -2
+// if the step is limited by stepmax[i].
+// The candidate daughters of each track are taken from the voxels (or the
+// bounding volume hierarchy) of the current volume, like in the scalar
+// FindNextDaughterBoundary(). The tracks are then grouped per daughter and
+// each shape is queried once through its vector methods. Unlike the scalar
+// FindNextBoundary(), no safety is computed. Volumes with overlaps, divisions
+// or assemblies are handled by calling FindNextBoundary() for each track.
+// In all cases the state of the navigator (current point and path, fStep,
+// fNextNode, ...) is the same on output as on input.
+// The work arrays are owned by the navigator and grow to the largest basket.
+   if (ntracks <= 0) return;
+   Int_t i, j, id;
+   TGeoVolume *vol = fCurrentNode->GetVolume();
+   Int_t nd = vol->GetNdaughters();
+   if (fGeometry->IsActivityEnabled() && !vol->IsActiveDaughters()) nd = 0;
+   Bool_t scalar = fIsOutside || fNmany || vol->IsAssembly() || vol->GetFinder();
+   for (id=0; id<nd && !scalar; id++) {
+      TGeoNode *node = vol->GetNode(id);
+      if (node->IsOffset() || node->IsOverlapping() || node->GetVolume()->IsAssembly()) scalar = kTRUE;
+   }
+   // state modified by FindNextBoundary() or by the voxel search
+   Double_t point[3], dir[3], lastpoint[3];
+   memcpy(point, fPoint, kN3);
+   memcpy(dir, fDirection, kN3);
+   memcpy(lastpoint, fLastPoint, kN3);
+   Double_t oldstep = fStep;
+   Double_t oldsafety = fSafety;
+   Double_t oldlastsafety = fLastSafety;
+   TGeoNode *nextnode = fNextNode;
+   TGeoNode *forcednode = fForcedNode;
+   Int_t nextindex = fNextDaughterIndex;
+   Bool_t entering = fIsStepEntering;
+   Bool_t exiting = fIsStepExiting;
+   Bool_t onboundary = fIsOnBoundary;
+   if (scalar) {
+      TGeoHMatrix matrix;
+      if (fCurrentMatrix) matrix.CopyFrom(fCurrentMatrix);
+      // FindNextBoundary() may change the path and the backup state for MANY nodes
+      Bool_t swapped = (fBackupState != 0);
+      if (swapped) {
+         if (!fBasketBackup) {
+            Int_t nlevel = fGeometry->GetMaxLevel();
+            if (nlevel<=0) nlevel = 100;
+            fBasketBackup = new TGeoCacheState(nlevel+1);
+         }
+         TGeoCacheState *backup = fBackupState;
+         fBackupState = fBasketBackup;
+         fBasketBackup = backup;
+      }
+      for (i=0; i<ntracks; i++) {
+         fPoint[0] = points[i];
+         fPoint[1] = points[ntracks+i];
+         fPoint[2] = points[2*ntracks+i];
+         fDirection[0] = dirs[i];
+         fDirection[1] = dirs[ntracks+i];
+         fDirection[2] = dirs[2*ntracks+i];
+         PushPath();
+         FindNextBoundary(stepmax[i]);
+         PopPath();
+         step[i] = fStep;
+         idaughter[i] = (fNextDaughterIndex < -1) ? -2 : fNextDaughterIndex;
+      }
+      if (swapped) {
+         TGeoCacheState *backup = fBackupState;
+         fBackupState = fBasketBackup;
+         fBasketBackup = backup;
+      }
+      if (fCurrentMatrix) fCurrentMatrix->CopyFrom(&matrix);
+   } else {
+      // work arrays: local points and directions, compacted tracks and distances
+      Double_t *lpts  = GetBasketBuffer(14*ntracks);
+      Double_t *ldirs = lpts  + 3*ntracks;
+      Double_t *cpts  = ldirs + 3*ntracks;
+      Double_t *cdirs = cpts  + 3*ntracks;
+      Double_t *cstep = cdirs + 3*ntracks;
+      Double_t *dist  = cstep + ntracks;
+      Double_t pt[3], lpt[3], ldir[3];
+      // transform to the frame of the current volume
+      for (i=0; i<ntracks; i++) {
+         pt[0] = points[i];
+         pt[1] = points[ntracks+i];
+         pt[2] = points[2*ntracks+i];
+         fGlobalMatrix->MasterToLocal(pt, lpt);
+         lpts[i] = lpt[0];
+         lpts[ntracks+i] = lpt[1];
+         lpts[2*ntracks+i] = lpt[2];
+         pt[0] = dirs[i];
+         pt[1] = dirs[ntracks+i];
+         pt[2] = dirs[2*ntracks+i];
+         fGlobalMatrix->MasterToLocalVect(pt, lpt);
+         ldirs[i] = lpt[0];
+         ldirs[ntracks+i] = lpt[1];
+         ldirs[2*ntracks+i] = lpt[2];
+      }
+      // distance to exit the current volume
+      vol->GetShape()->DistFromInside_v(lpts, ldirs, dist, ntracks, stepmax);
+      for (i=0; i<ntracks; i++) {
+         if (dist[i] < stepmax[i]-gTolerance) {
+            step[i] = dist[i];
+            idaughter[i] = -1;
+         } else {
+            step[i] = stepmax[i];
+            idaughter[i] = -2;
+         }
+      }
+      // candidate daughters of each track, stored as (daughter, track) pairs
+      TGeoVoxelFinder *voxels = vol->GetVoxels();
+      Int_t npairs = 0;
+      Int_t ncheck;
+      Int_t *pairs, *vlist;
+      for (i=0; i<ntracks && nd; i++) {
+         pairs = GetBasketIndex(2*(npairs+nd));
+         lpt[0] = lpts[i];
+         lpt[1] = lpts[ntracks+i];
+         lpt[2] = lpts[2*ntracks+i];
+         ldir[0] = ldirs[i];
+         ldir[1] = ldirs[ntracks+i];
+         ldir[2] = ldirs[2*ntracks+i];
+         if (nd<5 || !voxels) {
+            for (id=0; id<nd; id++) {
+               if (voxels && voxels->IsSafeVoxel(lpt, id, step[i])) continue;
+               pairs[2*npairs] = id;
+               pairs[2*npairs+1] = i;
+               npairs++;
+            }
+            continue;
+         }
+         // the voxel search uses the current step of the navigator
+         fStep = step[i];
+         ncheck = 0;
+         if (voxels->IsBVH()) {
+            ((TGeoBVHFinder*)voxels)->GetRayCandidates(lpt, ldir, fStep, ncheck, fThreadId);
+         } else {
+            voxels->SortCrossedVoxels(lpt, ldir, fThreadId);
+         }
+         // each daughter is returned only once per track
+         while ((vlist=voxels->GetNextVoxel(lpt, ldir, ncheck, fThreadId))) {
+            for (j=0; j<ncheck; j++) {
+               pairs[2*npairs] = vlist[j];
+               pairs[2*npairs+1] = i;
+               npairs++;
+            }
+         }
+      }
+      // group the tracks per daughter
+      pairs = GetBasketIndex(3*npairs+nd+1);
+      Int_t *first = pairs + 2*npairs;
+      Int_t *order = first + nd + 1;
+      memset(first, 0, (nd+1)*sizeof(Int_t));
+      for (j=0; j<npairs; j++) first[pairs[2*j]+1]++;
+      for (id=0; id<nd; id++) first[id+1] += first[id];
+      for (j=0; j<npairs; j++) order[first[pairs[2*j]]++] = pairs[2*j+1];
+      // distances to the daughters (first[id] is now the end of the tracks of id)
+      Int_t ncand, k;
+      Int_t start = 0;
+      for (id=0; id<nd; id++) {
+         ncand = first[id]-start;
+         if (!ncand) continue;
+         TGeoNode *node = vol->GetNode(id);
+         if (fGeometry->IsActivityEnabled() && !node->GetVolume()->IsActive()) {
+            start = first[id];
+            continue;
+         }
+         TGeoMatrix *mat = node->GetMatrix();
+         for (k=0; k<ncand; k++) {
+            i = order[start+k];
+            pt[0] = lpts[i];
+            pt[1] = lpts[ntracks+i];
+            pt[2] = lpts[2*ntracks+i];
+            mat->MasterToLocal(pt, lpt);
+            cpts[k]         = lpt[0];
+            cpts[ncand+k]   = lpt[1];
+            cpts[2*ncand+k] = lpt[2];
+            pt[0] = ldirs[i];
+            pt[1] = ldirs[ntracks+i];
+            pt[2] = ldirs[2*ntracks+i];
+            mat->MasterToLocalVect(pt, lpt);
+            cdirs[k]         = lpt[0];
+            cdirs[ncand+k]   = lpt[1];
+            cdirs[2*ncand+k] = lpt[2];
+            cstep[k] = step[i];
+         }
+         node->GetVolume()->GetShape()->DistFromOutside_v(cpts, cdirs, dist, ncand, cstep);
+         for (k=0; k<ncand; k++) {
+            i = order[start+k];
+            if (dist[k] < step[i]-gTolerance) {
+               step[i] = dist[k];
+               idaughter[i] = id;
+            }
+         }
+         start = first[id];
+      }
+   }
+   memcpy(fPoint, point, kN3);
+   memcpy(fDirection, dir, kN3);
+   memcpy(fLastPoint, lastpoint, kN3);
+   fStep = oldstep;
+   fSafety = oldsafety;
+   fLastSafety = oldlastsafety;
+   fNextNode = nextnode;
+   fForcedNode = forcednode;
+   fNextDaughterIndex = nextindex;
+   fIsStepEntering = entering;
+   fIsStepExiting = exiting;
+   fIsOnBoundary = onboundary;
+}
+
+//_____________________________________________________________________________
+Double_t *TGeoNavigator::GetBasketBuffer(Int_t size)
+{
+// Return the work array of FindNextBoundary_v with at least size elements.
+// The content is not preserved when the array grows.
+   if (size > fBasketSize) {
+      if (fBasketBuffer) delete [] fBasketBuffer;
+      fBasketSize = TMath::Max(size, 2*fBasketSize);
+      fBasketBuffer = new Double_t[fBasketSize];
+   }
+   return fBasketBuffer;
+}
+
+//_____________________________________________________________________________
+Int_t *TGeoNavigator::GetBasketIndex(Int_t size)
+{
+// Return the work array of indices of FindNextBoundary_v with at least size
+// elements. The content is preserved when the array grows.
+   if (size > fBasketIndexSize) {
+      Int_t newsize = TMath::Max(size, 2*fBasketIndexSize);
+      Int_t *index = new Int_t[newsize];
+      if (fBasketIndex) {
+         memcpy(index, fBasketIndex, fBasketIndexSize*sizeof(Int_t));
+         delete [] fBasketIndex;
+      }
+      fBasketIndex = index;
+      fBasketIndexSize = newsize;
+   }
+   return fBasketIndex;
+}
+
 //_____________________________________________________________________________
 TGeoNode *TGeoNavigator::FindNextDaughterBoundary(Double_t *point, Double_t *dir, Int_t &idaughter, Bool_t compmatrix)
 {
@@ -1025,9 +1311,19 @@ TGeoNode *TGeoNavigator::FindNextDaughterBoundary(Double_t *point, Double_t *dir
    Int_t ncheck = 0;
    Int_t sumchecked = 0;
    Int_t *vlist = 0;
-   voxels->SortCrossedVoxels(point, dir, fThreadId);
+   const Double_t *vdist = 0;
+   if (voxels->IsBVH()) {
+      // the hierarchy returns only the daughters crossed within the proposed
+      // step, sorted by distance to their bounding box
+      TGeoBVHFinder *bvh = (TGeoBVHFinder*)voxels;
+      bvh->GetRayCandidates(point, dir, fStep, ncheck, fThreadId);
+      vdist = bvh->GetCandidateDistances(fThreadId);
+   } else {   
+      voxels->SortCrossedVoxels(point, dir, fThreadId);
+   }   
    while ((sumchecked<nd) && (vlist=voxels->GetNextVoxel(point, dir, ncheck, fThreadId))) {
       for (i=0; i<ncheck; i++) {
+         if (vdist && vdist[i]>=fStep) break;
          current = vol->GetNode(vlist[i]);
          if (fGeometry->IsActivityEnabled() && !current->GetVolume()->IsActive()) continue;
          current->cd();
@@ -1604,6 +1900,27 @@ Double_t TGeoNavigator::Safety(Bool_t inside)
       }
    }      
 
+   //---> check only the daughters closer than the current safety, nearest first
+   if (voxels->IsBVH()) {
+      Int_t ncheck = 0;
+      TGeoBVHFinder *bvh = (TGeoBVHFinder*)voxels;
+      Int_t *vlist = bvh->GetSafetyCandidates(point, fSafety, ncheck, fThreadId);
+      const Double_t *vdist = bvh->GetCandidateDistances(fThreadId);
+      for (Int_t i=0; i<ncheck; i++) {
+         if (vdist[i] >= fSafety) break;
+         node = (TGeoNode*)nodes->UncheckedAt(vlist[i]);
+         safe = node->Safety(point, kFALSE);
+         if (safe<gTolerance) {
+            fSafety=0;
+            fIsOnBoundary = kTRUE;
+            return fSafety;
+         }
+         if (safe<fSafety) fSafety = safe;
+      }
+      if (fNmany  && !inside) SafetyOverlaps();
+      return fSafety;
+   }
+
    //---> check fast unsafe voxels
    Double_t *boxes = voxels->GetBoxes();
    for (id=0; id<nd; id++) {
@@ -2325,6 +2642,56 @@ void TGeoNavigator::DoBackupState()
    if (fBackupState) fBackupState->SetState(fLevel,0, fNmany, fCurrentOverlapping);
 }
 
+//_____________________________________________________________________________
+void TGeoNavigator::CacheState(const char *key, Int_t len, ULong64_t hash)
+{
+// Store the current state in the state cache under the given key, of hash
+// TGeoStateCache::Hash(key, len).
+   if (!fStateCache || !fCache) return;
+   TGeoCacheState *state = fStateCache->Insert(key, len, hash);
+   state->SetState(fLevel, 0, fNmany, fCurrentOverlapping);
+}
+
+//_____________________________________________________________________________
+Bool_t TGeoNavigator::RestoreCachedState(const char *key, Int_t len, ULong64_t hash)
+{
+// Restore the state stored under the given key, of hash
+// TGeoStateCache::Hash(key, len), if any. The node branch and the global
+// matrices are copied from the cache, so no matrix is recomputed.
+   if (!fStateCache || !fCache) return kFALSE;
+   TGeoCacheState *state = fStateCache->Find(key, len, hash);
+   if (!state) return kFALSE;
+   if (fCurrentOverlapping) fLastNode = fCurrentNode;
+   fCurrentOverlapping = fCache->RestoreState(fNmany, state);
+   fCurrentNode = fCache->GetNode();
+   fGlobalMatrix = fCache->GetCurrentMatrix();
+   fLevel = fCache->GetLevel();
+   // division cells need their finder to point to the right cell
+   for (Int_t up=0; up<fLevel; up++) {
+      TGeoNode *node = fCache->GetMother(up);
+      if (node->IsOffset()) node->cd();
+   }
+   return kTRUE;
+}
+
+//_____________________________________________________________________________
+void TGeoNavigator::SetStateCacheSize(Int_t nstates)
+{
+// Enable a cache of the last NSTATES states reached by cd(path) or by
+// TGeoBranchArray::UpdateNavigator(), so that going back to one of them
+// copies the cached node branch and global matrices instead of descending
+// from the top. A value of 0 disables the cache. The caches must be reset
+// with TGeoManager::InvalidateStateCaches() if node matrices are changed.
+   if (fStateCache) {
+      delete fStateCache;
+      fStateCache = 0;
+   }
+   if (nstates <= 0) return;
+   Int_t nlevel = fGeometry->GetMaxLevel();
+   if (nlevel<=0) nlevel = 100;
+   fStateCache = new TGeoStateCache(nstates, nlevel+1);
+}
+
 //_____________________________________________________________________________
 void TGeoNavigator::DoRestoreState()
 {
@@ -2400,6 +2767,7 @@ void TGeoNavigator::ResetAll()
       delete fBackupState;
       fCache = 0;
       BuildCache(dummy,nodeid);
+      if (fStateCache) SetStateCacheSize(fStateCache->GetCapacity());
    }
 }
 
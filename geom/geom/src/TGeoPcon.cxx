@@ -375,6 +375,64 @@ Bool_t TGeoPcon::Contains(Double_t *point) const
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+void TGeoPcon::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+// Test if the vecsize points (SoA layout) are inside this shape. The points
+// are processed in blocks: the Z section of each point is found first, then
+// the radial and phi tests are done for the whole block in a loop without
+// branches.
+   if (IsA() != TGeoPcon::Class()) {
+      TGeoShape::Contains_v(points, inside, vecsize);
+      return;
+   }
+   const Int_t kBlock = 64;
+   Int_t isec[kBlock];
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Bool_t fullphi = TGeoShape::IsSameWithinTolerance(fDphi,360);
+   Int_t i, ib, nb, izl, izh, izt;
+   Double_t r2, dz, dz1, rmin, rmax, phi, ddp;
+   Bool_t inz, same, inphi;
+   for (Int_t start=0; start<vecsize; start+=kBlock) {
+      nb = TMath::Min(kBlock, vecsize-start);
+      // binary search of the Z section
+      for (ib=0; ib<nb; ib++) {
+         i = start+ib;
+         izl = 0;
+         izh = fNz-1;
+         izt = (fNz-1)/2;
+         while ((izh-izl)>1) {
+            if (z[i] > fZ[izt]) izl = izt;
+            else izh = izt;
+            izt = (izl+izh)>>1;
+         }
+         isec[ib] = izl;
+      }
+      // radial and phi tests
+      for (ib=0; ib<nb; ib++) {
+         i = start+ib;
+         izl = isec[ib];
+         izh = izl+1;
+         inz = (z[i]>=fZ[0]) & (z[i]<=fZ[fNz-1]);
+         r2 = x[i]*x[i]+y[i]*y[i];
+         dz = fZ[izh] - fZ[izl];
+         dz1 = z[i] - fZ[izl];
+         same = TGeoShape::IsSameWithinTolerance(fZ[izl],fZ[izh]) & TGeoShape::IsSameWithinTolerance(z[i],fZ[izl]);
+         if (same) dz = 1.;
+         rmin = same ? TMath::Min(fRmin[izl], fRmin[izh]) : (fRmin[izl]*(dz-dz1)+fRmin[izh]*dz1)/dz;
+         rmax = same ? TMath::Max(fRmax[izl], fRmax[izh]) : (fRmax[izl]*(dz-dz1)+fRmax[izh]*dz1)/dz;
+         phi = TMath::ATan2(y[i], x[i]) * TMath::RadToDeg();
+         phi += (phi < 0) ? 360. : 0.;
+         ddp = phi-fPhi1;
+         ddp += (ddp < 0) ? 360. : 0.;
+         inphi = fullphi | (r2<1E-10) | (ddp<=fDphi);
+         inside[i] = inz & (r2>=rmin*rmin) & (r2<=rmax*rmax) & inphi;
+      }
+   }
+}
+
 //_____________________________________________________________________________
 Int_t TGeoPcon::DistancetoPrimitive(Int_t px, Int_t py)
 {
@@ -460,6 +518,29 @@ Double_t TGeoPcon::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Do
    return snxt;
 }
 
+//_____________________________________________________________________________
+void TGeoPcon::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize inside points to the surface of the
+// polycone (points and directions in SoA layout). The scalar method is
+// called directly for each track.
+   if (IsA() != TGeoPcon::Class()) {
+      TGeoShape::DistFromInside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = TGeoPcon::DistFromInside(pt, dir, 3, step ? step[i] : TGeoShape::Big());
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoPcon::DistToSegZ(Double_t *point, Double_t *dir, Int_t &iz, Double_t c1, Double_t s1, 
                               Double_t c2, Double_t s2, Double_t cfio, Double_t sfio, Double_t cdfi) const
@@ -559,6 +640,32 @@ Double_t TGeoPcon::DistFromOutside(Double_t *point, Double_t *dir, Int_t iact, D
    return DistToSegZ(point,dir,ifirst, c1,s1,c2,s2,cfio,sfio,cdfi);
 }
 
+//_____________________________________________________________________________
+void TGeoPcon::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                 Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize outside points to the surface of the
+// polycone (points and directions in SoA layout). The bounding box is checked
+// for all the tracks in one loop, then the scalar method is called for the
+// tracks crossing it within step[i].
+   if (IsA() != TGeoPcon::Class()) {
+      TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin, step);
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      if (dists[i] >= TGeoShape::Big()) continue;
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = TGeoPcon::DistFromOutside(pt, dir, 3, step ? step[i] : TGeoShape::Big());
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoPcon::DefineSection(Int_t snum, Double_t z, Double_t rmin, Double_t rmax)
 {
@@ -1118,6 +1225,24 @@ Double_t TGeoPcon::Safety(Double_t *point, Bool_t in) const
    return safmin;
 }
 
+//_____________________________________________________________________________
+void TGeoPcon::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+// Compute the safe distances of vecsize points (SoA layout) to the polycone,
+// calling the scalar method directly for each point.
+   if (IsA() != TGeoPcon::Class()) {
+      TGeoShape::Safety_v(points, inside, safe, vecsize);
+      return;
+   }
+   Double_t pt[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      safe[i] = TGeoPcon::Safety(pt, inside[i]);
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoPcon::SavePrimitive(ostream &out, Option_t * /*option*/ /*= ""*/)
 {
@@ -254,6 +254,8 @@ void TGeoPhysicalNode::Align(TGeoMatrix *newmat, TGeoShape *newshape, Bool_t che
    }
    // Clean current matrices from cache
    gGeoManager->CdTop();
+   // States cached by the navigators hold the old global matrices
+   gGeoManager->InvalidateStateCaches();
    SetAligned(kTRUE);
 }
 
@@ -194,6 +194,75 @@ TGeoShape::~TGeoShape()
    if (gGeoManager) gGeoManager->GetListOfShapes()->Remove(this);
 }
 
+//_____________________________________________________________________________
+void TGeoShape::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+// Test if the vecsize points are inside this shape. Like for all the vector
+// methods, the points are given in SoA layout: points[i], points[vecsize+i]
+// and points[2*vecsize+i] are the coordinates of point i.
+// This default implementation calls Contains() for each point; shapes may
+// override it with a loop that the compiler can vectorize.
+   Double_t pt[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      inside[i] = Contains(pt);
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoShape::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                 Int_t vecsize, const Double_t *step) const
+{
+// Compute the distances from vecsize inside points to the surface of the shape
+// along the given directions (points and directions in SoA layout). If the
+// array step is given, step[i] is the maximum distance of interest for track i.
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = DistFromInside(pt, dir, 3, step ? step[i] : TGeoShape::Big());
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoShape::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                  Int_t vecsize, const Double_t *step) const
+{
+// Compute the distances from vecsize outside points to the surface of the shape
+// along the given directions (points and directions in SoA layout). If the
+// array step is given, step[i] is the maximum distance of interest for track i.
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = DistFromOutside(pt, dir, 3, step ? step[i] : TGeoShape::Big());
+   }
+}
+
+//_____________________________________________________________________________
+void TGeoShape::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+// Compute the safe distances of vecsize points (SoA layout) to the shape;
+// inside[i] tells if point i is inside.
+   Double_t pt[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      safe[i] = Safety(pt, inside[i]);
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoShape::CheckShape(Int_t testNo, Int_t nsamples, Option_t *option)
 {
@@ -308,6 +308,17 @@ Double_t TGeoShapeAssembly::DistFromOutside(Double_t *point, Double_t *dir, Int_
    return TGeoShape::Big();      
 }
    
+//_____________________________________________________________________________
+void TGeoShapeAssembly::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                          Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize outside points to the assembly. The bounding
+// box used by TGeoBBox::DistFromOutside_v to pre-filter the tracks is computed
+// on demand, so it has to be made valid first.
+   if (!fBBoxOK) ((TGeoShapeAssembly*)this)->ComputeBBox();
+   TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, step);
+}
+
 //_____________________________________________________________________________
 TGeoVolume *TGeoShapeAssembly::Divide(TGeoVolume * /*voldiv*/, const char *divname, Int_t /*iaxis*/, Int_t /*ndiv*/, 
                              Double_t /*start*/, Double_t /*step*/) 
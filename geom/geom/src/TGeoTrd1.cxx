@@ -185,6 +185,26 @@ Bool_t TGeoTrd1::Contains(Double_t *point) const
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+void TGeoTrd1::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+// Test if the vecsize points (SoA layout) are inside this shape. Branch-free
+// loop so that the compiler can vectorize it.
+   if (IsA() != TGeoTrd1::Class()) {
+      TGeoShape::Contains_v(points, inside, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t invdz = 0.5/fDz;
+   Double_t dx;
+   for (Int_t i=0; i<vecsize; i++) {
+      dx = (fDx2*(z[i]+fDz)+fDx1*(fDz-z[i]))*invdz;
+      inside[i] = (TMath::Abs(z[i]) <= fDz) & (TMath::Abs(y[i]) <= fDy) & (TMath::Abs(x[i]) <= dx);
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoTrd1::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Double_t step, Double_t *safe) const
 {
@@ -237,6 +257,46 @@ Double_t TGeoTrd1::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Do
    return snxt;
 }
 
+//_____________________________________________________________________________
+void TGeoTrd1::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize inside points to the surface of the trd1
+// (points and directions in SoA layout). Same results as the scalar method,
+// but all the faces are evaluated and the minimum is selected, so that the
+// loop has no branches and can be vectorized by the compiler.
+   if (IsA() != TGeoTrd1::Class()) {
+      TGeoShape::DistFromInside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t *dx = dirs;
+   const Double_t *dy = dirs+vecsize;
+   const Double_t *dz = dirs+2*vecsize;
+   const Double_t big = TGeoShape::Big();
+   const Double_t fx = 0.5*(fDx1-fDx2)/fDz;
+   Double_t distx, cn1, cn2, sx1, sx2, sy, sz, s;
+   Bool_t zero;
+   for (Int_t i=0; i<vecsize; i++) {
+      distx = 0.5*(fDx1+fDx2)-fx*z[i];
+      // Z and Y planes
+      sz = (dz[i]!=0) ? (((dz[i]>0) ? fDz : -fDz)-z[i])/dz[i] : big;
+      sy = (dy[i]!=0) ? (((dy[i]>0) ? fDy : -fDy)-y[i])/dy[i] : big;
+      // X facettes, only the ones the track is moving to
+      cn1 = -dx[i]+fx*dz[i];
+      cn2 =  dx[i]+fx*dz[i];
+      sx1 = (cn1>0) ? (x[i]+distx)/cn1 : big;
+      sx2 = (cn2>0) ? (distx-x[i])/cn2 : big;
+      zero = (sz<=0) | (sy<=0) | ((cn1>0) & (x[i]+distx<=0)) | ((cn2>0) & (distx-x[i]<=0));
+      s = (sx1 < sx2) ? sx1 : sx2;
+      s = (sy < s) ? sy : s;
+      s = (sz < s) ? sz : s;
+      dists[i] = zero ? 0. : s;
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoTrd1::GetVisibleCorner(Double_t *point, Double_t *vertex, Double_t *normals) const
 {
@@ -411,6 +471,32 @@ Double_t TGeoTrd1::DistFromOutside(Double_t *point, Double_t *dir, Int_t iact, D
    return 0.0;
 }
 
+//_____________________________________________________________________________
+void TGeoTrd1::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                 Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize outside points to the surface of the trd1
+// (points and directions in SoA layout). The bounding box is checked for all
+// the tracks in one loop, then the scalar method is called for the tracks
+// crossing it within step[i].
+   if (IsA() != TGeoTrd1::Class()) {
+      TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin, step);
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      if (dists[i] >= TGeoShape::Big()) continue;
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = TGeoTrd1::DistFromOutside(pt, dir, 3, step ? step[i] : TGeoShape::Big());
+   }
+}
+
 //_____________________________________________________________________________
 TGeoVolume *TGeoTrd1::Divide(TGeoVolume *voldiv, const char *divname, Int_t iaxis, Int_t ndiv, 
                              Double_t start, Double_t step) 
@@ -618,6 +704,31 @@ Double_t TGeoTrd1::Safety(Double_t *point, Bool_t in) const
    return saf[TMath::LocMax(3,saf)];
 }
 
+//_____________________________________________________________________________
+void TGeoTrd1::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+// Compute the safe distances of vecsize points (SoA layout) to this shape.
+   if (IsA() != TGeoTrd1::Class()) {
+      TGeoShape::Safety_v(points, inside, safe, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t fx = 0.5*(fDx1-fDx2)/fDz;
+   const Double_t calf = 1./TMath::Sqrt(1.0+fx*fx);
+   Double_t saf, safx, safy, distx;
+   for (Int_t i=0; i<vecsize; i++) {
+      saf = fDz-TMath::Abs(z[i]);
+      distx = 0.5*(fDx1+fDx2)-fx*z[i];
+      safx = (distx<0) ? TGeoShape::Big() : (distx-TMath::Abs(x[i]))*calf;
+      safy = fDy-TMath::Abs(y[i]);
+      saf = (safx < saf) ? safx : saf;
+      saf = (safy < saf) ? safy : saf;
+      safe[i] = inside[i] ? saf : -saf;
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoTrd1::SavePrimitive(ostream &out, Option_t * /*option*/ /*= ""*/)
 {
@@ -196,6 +196,27 @@ Bool_t TGeoTrd2::Contains(Double_t *point) const
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+void TGeoTrd2::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+// Test if the vecsize points (SoA layout) are inside this shape. Branch-free
+// loop so that the compiler can vectorize it.
+   if (IsA() != TGeoTrd2::Class()) {
+      TGeoShape::Contains_v(points, inside, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t invdz = 0.5/fDz;
+   Double_t dx, dy;
+   for (Int_t i=0; i<vecsize; i++) {
+      dx = (fDx2*(z[i]+fDz)+fDx1*(fDz-z[i]))*invdz;
+      dy = (fDy2*(z[i]+fDz)+fDy1*(fDz-z[i]))*invdz;
+      inside[i] = (TMath::Abs(z[i]) <= fDz) & (TMath::Abs(y[i]) <= dy) & (TMath::Abs(x[i]) <= dx);
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoTrd2::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Double_t step, Double_t *safe) const
 {
@@ -258,6 +279,53 @@ Double_t TGeoTrd2::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Do
    return snxt;
 }
 
+//_____________________________________________________________________________
+void TGeoTrd2::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize inside points to the surface of the trd2
+// (points and directions in SoA layout). Same results as the scalar method,
+// but all the faces are evaluated and the minimum is selected, so that the
+// loop has no branches and can be vectorized by the compiler.
+   if (IsA() != TGeoTrd2::Class()) {
+      TGeoShape::DistFromInside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t *dx = dirs;
+   const Double_t *dy = dirs+vecsize;
+   const Double_t *dz = dirs+2*vecsize;
+   const Double_t big = TGeoShape::Big();
+   const Double_t fx = 0.5*(fDx1-fDx2)/fDz;
+   const Double_t fy = 0.5*(fDy1-fDy2)/fDz;
+   Double_t distx, disty, cn1, cn2, cn3, cn4, sx1, sx2, sy1, sy2, sz, s;
+   Bool_t zero;
+   for (Int_t i=0; i<vecsize; i++) {
+      distx = 0.5*(fDx1+fDx2)-fx*z[i];
+      disty = 0.5*(fDy1+fDy2)-fy*z[i];
+      // Z planes
+      sz = (dz[i]!=0) ? (((dz[i]>0) ? fDz : -fDz)-z[i])/dz[i] : big;
+      // X and Y facettes, only the ones the track is moving to
+      cn1 = -dx[i]+fx*dz[i];
+      cn2 =  dx[i]+fx*dz[i];
+      cn3 = -dy[i]+fy*dz[i];
+      cn4 =  dy[i]+fy*dz[i];
+      sx1 = (cn1>0) ? (x[i]+distx)/cn1 : big;
+      sx2 = (cn2>0) ? (distx-x[i])/cn2 : big;
+      sy1 = (cn3>0) ? (y[i]+disty)/cn3 : big;
+      sy2 = (cn4>0) ? (disty-y[i])/cn4 : big;
+      zero = (sz<=0) | ((cn1>0) & (x[i]+distx<=0)) | ((cn2>0) & (distx-x[i]<=0)) |
+             ((cn3>0) & (y[i]+disty<=0)) | ((cn4>0) & (disty-y[i]<=0));
+      s = (sx1 < sx2) ? sx1 : sx2;
+      s = (sy1 < s) ? sy1 : s;
+      s = (sy2 < s) ? sy2 : s;
+      s = (sz < s) ? sz : s;
+      dists[i] = zero ? 0. : s;
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoTrd2::DistFromOutside(Double_t *point, Double_t *dir, Int_t iact, Double_t step, Double_t *safe) const
 {
@@ -377,6 +445,32 @@ Double_t TGeoTrd2::DistFromOutside(Double_t *point, Double_t *dir, Int_t iact, D
    return 0.0;      
 }
 
+//_____________________________________________________________________________
+void TGeoTrd2::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                 Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize outside points to the surface of the trd2
+// (points and directions in SoA layout). The bounding box is checked for all
+// the tracks in one loop, then the scalar method is called for the tracks
+// crossing it within step[i].
+   if (IsA() != TGeoTrd2::Class()) {
+      TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin, step);
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      if (dists[i] >= TGeoShape::Big()) continue;
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = TGeoTrd2::DistFromOutside(pt, dir, 3, step ? step[i] : TGeoShape::Big());
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoTrd2::GetAxisRange(Int_t iaxis, Double_t &xlo, Double_t &xhi) const
 {
@@ -644,6 +738,34 @@ Double_t TGeoTrd2::Safety(Double_t *point, Bool_t in) const
    return saf[TMath::LocMax(3,saf)];
 }
 
+//_____________________________________________________________________________
+void TGeoTrd2::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+// Compute the safe distances of vecsize points (SoA layout) to this shape.
+   if (IsA() != TGeoTrd2::Class()) {
+      TGeoShape::Safety_v(points, inside, safe, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t fx = 0.5*(fDx1-fDx2)/fDz;
+   const Double_t fy = 0.5*(fDy1-fDy2)/fDz;
+   const Double_t calfx = 1./TMath::Sqrt(1.0+fx*fx);
+   const Double_t calfy = 1./TMath::Sqrt(1.0+fy*fy);
+   Double_t saf, safx, safy, distx, disty;
+   for (Int_t i=0; i<vecsize; i++) {
+      saf = fDz-TMath::Abs(z[i]);
+      distx = 0.5*(fDx1+fDx2)-fx*z[i];
+      safx = (distx<0) ? TGeoShape::Big() : (distx-TMath::Abs(x[i]))*calfx;
+      disty = 0.5*(fDy1+fDy2)-fy*z[i];
+      safy = (disty<0) ? TGeoShape::Big() : (disty-TMath::Abs(y[i]))*calfy;
+      saf = (safx < saf) ? safx : saf;
+      saf = (safy < saf) ? safy : saf;
+      safe[i] = inside[i] ? saf : -saf;
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoTrd2::SavePrimitive(ostream &out, Option_t * /*option*/ /*= ""*/)
 {
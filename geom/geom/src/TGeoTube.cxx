@@ -239,6 +239,27 @@ Bool_t TGeoTube::Contains(Double_t *point) const
    return kTRUE;
 }
 
+//_____________________________________________________________________________
+void TGeoTube::Contains_v(const Double_t *points, Bool_t *inside, Int_t vecsize) const
+{
+// Test if the vecsize points (SoA layout) are inside this tube. Branch-free
+// loop so that the compiler can vectorize it.
+   if (IsA() != TGeoTube::Class()) {
+      TGeoShape::Contains_v(points, inside, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t rmin2 = fRmin*fRmin;
+   const Double_t rmax2 = fRmax*fRmax;
+   Double_t r2;
+   for (Int_t i=0; i<vecsize; i++) {
+      r2 = x[i]*x[i]+y[i]*y[i];
+      inside[i] = (TMath::Abs(z[i]) <= fDz) & (r2 >= rmin2) & (r2 <= rmax2);
+   }
+}
+
 //_____________________________________________________________________________
 Int_t TGeoTube::DistancetoPrimitive(Int_t px, Int_t py)
 {
@@ -309,6 +330,63 @@ Double_t TGeoTube::DistFromInside(Double_t *point, Double_t *dir, Int_t iact, Do
    return DistFromInsideS(point, dir, fRmin, fRmax, fDz);
 }
 
+//_____________________________________________________________________________
+void TGeoTube::DistFromInside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize inside points to the surface of the tube
+// (points and directions in SoA layout). Same results as DistFromInsideS(),
+// but all the cases are evaluated and selected at the end, so that the loop
+// has no branches and can be vectorized by the compiler.
+   if (IsA() != TGeoTube::Class()) {
+      TGeoShape::DistFromInside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Double_t *dx = dirs;
+   const Double_t *dy = dirs+vecsize;
+   const Double_t *dz = dirs+2*vecsize;
+   const Double_t big = TGeoShape::Big();
+   const Double_t tol = TGeoShape::Tolerance();
+   const Double_t rmin2 = fRmin*fRmin;
+   const Double_t rmax2 = fRmax*fRmax;
+   const Bool_t hasrmin = (fRmin>0);
+   Double_t sz, nsq, ninv, rsq, rdotn, b, d, sr1, sr2, s;
+   Bool_t zout, rpar, inmin, onmin, hitmin, onmax, hitmax;
+   for (Int_t i=0; i<vecsize; i++) {
+      // Z planes
+      sz = (dz[i]!=0) ? (((dz[i]>0) ? fDz : -fDz)-z[i])/dz[i] : big;
+      zout = (dz[i]!=0) & (sz<=0);
+      // direction parallel to the tube axis
+      nsq = dx[i]*dx[i]+dy[i]*dy[i];
+      rpar = (nsq<tol);
+      ninv = rpar ? 0. : 1./nsq;
+      rsq = x[i]*x[i]+y[i]*y[i];
+      rdotn = x[i]*dx[i]+y[i]*dy[i];
+      b = rdotn*ninv;
+      // inner cylinder (first solution)
+      inmin = (rsq <= rmin2+tol);
+      onmin = hasrmin & inmin & (rdotn<0);
+      d = b*b-(rsq-rmin2)*ninv;
+      sr1 = -b-TMath::Sqrt((d>0) ? d : 0.);
+      hitmin = hasrmin & !inmin & (rdotn<0) & (d>0) & (sr1>0);
+      // outer cylinder (second solution)
+      onmax = (rsq >= rmax2-tol) & (rdotn>=0);
+      d = b*b-(rsq-rmax2)*ninv;
+      sr2 = -b+TMath::Sqrt((d>0) ? d : 0.);
+      hitmax = (d>0) & (sr2>0);
+      // select in reverse order of precedence of the scalar code
+      s = hitmax ? ((sr2<sz) ? sr2 : sz) : 0.;
+      s = onmax ? 0. : s;
+      s = hitmin ? ((sr1<sz) ? sr1 : sz) : s;
+      s = onmin ? 0. : s;
+      s = rpar ? sz : s;
+      dists[i] = zout ? 0. : s;
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoTube::DistFromOutsideS(Double_t *point, Double_t *dir, Double_t rmin, Double_t rmax, Double_t dz)
 {
@@ -414,6 +492,32 @@ Double_t TGeoTube::DistFromOutside(Double_t *point, Double_t *dir, Int_t iact, D
    return DistFromOutsideS(point, dir, fRmin, fRmax, fDz);
 }
 
+//_____________________________________________________________________________
+void TGeoTube::DistFromOutside_v(const Double_t *points, const Double_t *dirs, Double_t *dists,
+                                 Int_t vecsize, const Double_t *step) const
+{
+// Compute distances from vecsize outside points to the surface of the tube
+// (points and directions in SoA layout). The bounding box is checked for all
+// the tracks in one loop, then DistFromOutsideS() is called for the tracks
+// crossing it within step[i].
+   if (IsA() != TGeoTube::Class()) {
+      TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, step);
+      return;
+   }
+   TGeoBBox::DistFromOutside_v(points, dirs, dists, vecsize, fDX, fDY, fDZ, fOrigin, step);
+   Double_t pt[3], dir[3];
+   for (Int_t i=0; i<vecsize; i++) {
+      if (dists[i] >= TGeoShape::Big()) continue;
+      pt[0] = points[i];
+      pt[1] = points[vecsize+i];
+      pt[2] = points[2*vecsize+i];
+      dir[0] = dirs[i];
+      dir[1] = dirs[vecsize+i];
+      dir[2] = dirs[2*vecsize+i];
+      dists[i] = DistFromOutsideS(pt, dir, fRmin, fRmax, fDz);
+   }
+}
+
 //_____________________________________________________________________________
 void TGeoTube::DistToTube(Double_t rsq, Double_t nsq, Double_t rdotn, Double_t radius, Double_t &b, Double_t &delta)
 {
@@ -819,6 +923,30 @@ Double_t TGeoTube::Safety(Double_t *point, Bool_t in) const
 #endif
 }
 
+//_____________________________________________________________________________
+void TGeoTube::Safety_v(const Double_t *points, const Bool_t *inside, Double_t *safe, Int_t vecsize) const
+{
+// Compute the safe distances of vecsize points (SoA layout) to this tube.
+   if (IsA() != TGeoTube::Class()) {
+      TGeoShape::Safety_v(points, inside, safe, vecsize);
+      return;
+   }
+   const Double_t *x = points;
+   const Double_t *y = points+vecsize;
+   const Double_t *z = points+2*vecsize;
+   const Bool_t hasrmin = (fRmin>1E-10);
+   Double_t r, saf, safrmin, safrmax;
+   for (Int_t i=0; i<vecsize; i++) {
+      r = TMath::Sqrt(x[i]*x[i]+y[i]*y[i]);
+      saf = fDz-TMath::Abs(z[i]);
+      safrmin = hasrmin ? r-fRmin : TGeoShape::Big();
+      safrmax = fRmax-r;
+      saf = (safrmin < saf) ? safrmin : saf;
+      saf = (safrmax < saf) ? safrmax : saf;
+      safe[i] = inside[i] ? saf : -saf;
+   }
+}
+
 //_____________________________________________________________________________
 Double_t TGeoTube::SafetyS(Double_t *point, Bool_t in, Double_t rmin, Double_t rmax, Double_t dz, Int_t skipz)
 {
@@ -355,6 +355,7 @@
 #include "TGeoScaledShape.h"
 #include "TGeoCompositeShape.h"
 #include "TGeoVoxelFinder.h"
+#include "TGeoBVHFinder.h"
 
 ClassImp(TGeoVolume)
 
@@ -366,6 +367,14 @@ void TGeoVolume::ClearThreadData() const
    if (fShape)  fShape->ClearThreadData();
 }   
 
+//______________________________________________________________________________
+void TGeoVolume::CreateThreadData(Int_t nthreads) const
+{
+   // Preallocate the thread specific navigation data for nthreads threads.
+
+   if (fVoxels) fVoxels->CreateThreadData(nthreads);
+}   
+
 //_____________________________________________________________________________
 TGeoVolume::TGeoVolume()
 { 
@@ -1746,6 +1755,15 @@ void TGeoVolume::SetCurrentPoint(Double_t x, Double_t y, Double_t z)
    fGeoManager->SetCurrentPoint(x,y,z);
 }
 
+//_____________________________________________________________________________
+void TGeoVolume::SetUseBVH(Bool_t flag)
+{
+// Use a bounding volume hierarchy (TGeoBVHFinder) instead of the slice voxels
+// to find the daughters of this volume. Existing voxels are rebuilt.
+   SetAttBit(kUseBVH, flag);
+   if (fVoxels && fVoxels->IsBVH() != flag) Voxelize("");
+}
+
 //_____________________________________________________________________________
 void TGeoVolume::SetShape(const TGeoShape *shape)
 {
@@ -2102,8 +2120,12 @@ void TGeoVolume::Voxelize(Option_t *option)
       if (!TObject::TestBit(kVolumeClone)) delete fVoxels;
       fVoxels = 0;
    }   
-   // Create the voxels structure
-   fVoxels = new TGeoVoxelFinder(this);
+   // Create the voxels structure, or a bounding volume hierarchy if requested
+   // for this volume or if it has many daughters
+   if (IsUsingBVH() || (TGeoBVHFinder::GetAutoThreshold()>0 && nd>=TGeoBVHFinder::GetAutoThreshold()))
+      fVoxels = new TGeoBVHFinder(this);
+   else
+      fVoxels = new TGeoVoxelFinder(this);
    fVoxels->Voxelize(option);
    if (fVoxels) {
       if (fVoxels->IsInvalid()) {
@@ -2478,7 +2500,16 @@ TGeoVolumeAssembly::ThreadData_t::~ThreadData_t()
 TGeoVolumeAssembly::ThreadData_t& TGeoVolumeAssembly::GetThreadData() const
 {
    Int_t tid = TGeoManager::ThreadId();
+   // Lock-free when the data was preallocated with CreateThreadData(): the
+   // vector is then never resized. Otherwise the data is created under lock.
+   if (tid < fThreadPrealloc) return *fThreadData[tid];
    TThread::Lock();
+   if (fThreadPrealloc && tid >= fThreadSize)
+   {
+      TThread::UnLock();
+      Fatal("GetThreadData", "thread %d beyond the %d threads declared with TGeoManager::SetMaxThreads",
+            tid, fThreadPrealloc);
+   }
    if (tid >= fThreadSize)
    {
       fThreadData.resize(tid + 1);
@@ -2505,6 +2536,29 @@ void TGeoVolumeAssembly::ClearThreadData() const
    }
    fThreadData.clear();
    fThreadSize = 0;
+   fThreadPrealloc = 0;
+   TThread::UnLock();
+}
+
+//______________________________________________________________________________
+void TGeoVolumeAssembly::CreateThreadData(Int_t nthreads) const
+{
+   // Preallocate the current/next node indices for nthreads threads.
+   // Must be called before the navigation threads are started.
+
+   TThread::Lock();
+   TGeoVolume::CreateThreadData(nthreads);
+   fThreadPrealloc = 0;
+   if (nthreads > fThreadSize)
+   {
+      fThreadData.resize(nthreads, 0);
+      fThreadSize = nthreads;
+   }
+   for (Int_t tid=0; tid<fThreadSize; tid++)
+   {
+      if (fThreadData[tid] == 0) fThreadData[tid] = new ThreadData_t;
+   }
+   fThreadPrealloc = fThreadSize;
    TThread::UnLock();
 }
 
@@ -2538,6 +2592,7 @@ TGeoVolumeAssembly::TGeoVolumeAssembly()
 {
 // Default constructor
    fThreadSize = 0;
+   fThreadPrealloc = 0;
 }
 
 //_____________________________________________________________________________
@@ -2551,6 +2606,7 @@ TGeoVolumeAssembly::TGeoVolumeAssembly(const char *name)
    fShape = new TGeoShapeAssembly(this);
    if (fGeoManager) fNumber = fGeoManager->AddVolume(this);
    fThreadSize = 0;
+   fThreadPrealloc = 0;
 }
 
 //_____________________________________________________________________________
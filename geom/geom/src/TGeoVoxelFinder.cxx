@@ -63,16 +63,23 @@ TGeoVoxelFinder::ThreadData_t::~ThreadData_t()
 TGeoVoxelFinder::ThreadData_t& TGeoVoxelFinder::GetThreadData(Int_t tid) const
 {
 //   Int_t tid = TGeoManager::ThreadId();
+   // Lock-free when the data was preallocated with CreateThreadData(): the
+   // vector is then never resized. Otherwise the data is created under lock.
+   if (tid < fThreadPrealloc) return *fThreadData[tid];
+   TThread::Lock();
+   if (fThreadPrealloc && tid >= fThreadSize)
+   {
+      TThread::UnLock();
+      Fatal("GetThreadData", "thread %d beyond the %d threads declared with TGeoManager::SetMaxThreads",
+            tid, fThreadPrealloc);
+   }
    if (tid >= fThreadSize)
    {
-      TThread::Lock();
       fThreadData.resize(tid + 1);
       fThreadSize = tid + 1;
-      TThread::UnLock();
    }
    if (fThreadData[tid] == 0)
    {
-      TThread::Lock();
       fThreadData[tid] = new ThreadData_t;
       ThreadData_t &td = *fThreadData[tid];
 
@@ -82,11 +89,30 @@ TGeoVoxelFinder::ThreadData_t& TGeoVoxelFinder::GetThreadData(Int_t tid) const
          td.fCheckList = new Int_t  [nd];
          td.fBits1     = new UChar_t[1 + ((nd-1)>>3)];
       }
-      TThread::UnLock();
    }
+   TThread::UnLock();
    return *fThreadData[tid];
 }
 
+//______________________________________________________________________________
+void TGeoVoxelFinder::CreateThreadData(Int_t nthreads) const
+{
+   // Preallocate the check lists for nthreads threads, so that GetThreadData()
+   // never needs to take the lock nor to resize the vector during navigation.
+   // Must be called before the navigation threads are started.
+
+   TThread::Lock();
+   fThreadPrealloc = 0;
+   if (nthreads > fThreadSize)
+   {
+      fThreadData.resize(nthreads, 0);
+      fThreadSize = nthreads;
+   }
+   for (Int_t tid=0; tid<fThreadSize; tid++) GetThreadData(tid);
+   fThreadPrealloc = fThreadSize;
+   TThread::UnLock();
+}
+
 //______________________________________________________________________________
 void TGeoVoxelFinder::ClearThreadData() const
 {
@@ -99,6 +125,7 @@ void TGeoVoxelFinder::ClearThreadData() const
    }
    fThreadData.clear();
    fThreadSize = 0;
+   fThreadPrealloc = 0;
    TThread::UnLock();
 }
 
@@ -142,6 +169,7 @@ TGeoVoxelFinder::TGeoVoxelFinder()
    fNsliceZ = 0;
    memset(fPriority, 0, 3*sizeof(Int_t));
    fThreadSize = 0;
+   fThreadPrealloc = 0;
    SetInvalid(kFALSE);
 }
 //_____________________________________________________________________________
@@ -188,6 +216,7 @@ TGeoVoxelFinder::TGeoVoxelFinder(TGeoVolume *vol)
    fNsliceZ = 0;
    memset(fPriority, 0, 3*sizeof(Int_t));
    fThreadSize = 0;
+   fThreadPrealloc = 0;
    SetNeedRebuild();
 }
 
@@ -233,6 +262,7 @@ TGeoVoxelFinder::TGeoVoxelFinder(const TGeoVoxelFinder& vf) :
       fPriority[i]=vf.fPriority[i];
    }
    fThreadSize = 0;
+   fThreadPrealloc = 0;
 }
 
 //_____________________________________________________________________________
@@ -278,6 +308,7 @@ TGeoVoxelFinder& TGeoVoxelFinder::operator=(const TGeoVoxelFinder& vf)
       fExtraY=vf.fExtraY;
       fExtraZ=vf.fExtraZ;
       fThreadSize = 0;
+      fThreadPrealloc = 0;
    } 
    return *this;
 }
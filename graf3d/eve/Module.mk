@@ -26,7 +26,7 @@ EVEDO     := $(EVEDO1) $(EVEDO2)
 EVEDH     := $(EVEDS:.cxx=.h)
 
 EVEH1     := TEveBrowser TEveChunkManager TEveCompound \
-             TEveElement TEveEventManager TEveGValuators \
+             TEveElement TEveEventManager TEveEventBuffer TEveGValuators \
              TEveGedEditor TEveMacro TEveManager TEvePad TEveParamList \
              TEveProjectionAxes TEveProjectionBases TEveProjectionManager \
              TEveProjections TEveScene TEveSelection TEveTrans TEveTreeTools \
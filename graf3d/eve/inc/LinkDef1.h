@@ -114,6 +114,9 @@
 // TEveEventManager
 #pragma link C++ class TEveEventManager+;
 
+// TEveEventBuffer
+#pragma link C++ class TEveEventBuffer+;
+
 // TEveTreeTools
 #pragma link C++ class TEveSelectorToEventList+;
 #pragma link C++ class TEvePointSelectorConsumer+;
@@ -0,0 +1,77 @@
+// @(#)root/eve:$Id$
+// Author: agent   18/10/26
+
+/*************************************************************************
+ * Copyright (C) 1995-2012, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TEveEventBuffer
+#define ROOT_TEveEventBuffer
+
+#include "TEveElement.h"
+
+#include "TQObject.h"
+#include "TTimer.h"
+
+#include <vector>
+
+class TVirtualMutex;
+class TEveProjectionManager;
+
+class TEveEventBuffer : public TQObject
+{
+private:
+   TEveEventBuffer(const TEveEventBuffer&);            // Not implemented
+   TEveEventBuffer& operator=(const TEveEventBuffer&); // Not implemented
+
+protected:
+   typedef std::vector<TEveProjectionManager*> vProjMgr_t;
+   typedef std::vector<TEveElement*>           vElement_t;
+   typedef std::vector<TEveElement*>::iterator vElement_i;
+
+   TEveElement      *fDestination;  // Parent of the displayed event.
+   vProjMgr_t        fProjMgrs;     // Projection managers receiving projected replicas.
+   vElement_t        fProjDests;    // Additional parents of projected replicas.
+
+   mutable TVirtualMutex *fMutex;   //! Protects the back buffer.
+
+   TEveElement      *fFront;        // Displayed event.
+   vElement_t        fFrontProj;    // Projected replicas of displayed event.
+   TEveElement      *fBack;         // Event built and waiting to be swapped in.
+   vElement_t        fBackProj;     // Projected replicas of waiting event.
+   TEveElement      *fBuilding;     // Event being built.
+   Bool_t            fBackReady;    // Back buffer is full.
+
+   TTimer            fSwapTimer;    // Timer for automatic swapping.
+
+public:
+   TEveEventBuffer(TEveElement* dest=0);
+   virtual ~TEveEventBuffer();
+
+   void         AddProjectionManager(TEveProjectionManager* mgr, TEveElement* dest=0);
+
+   TEveElement* GetDestination() const { return fDestination; }
+   TEveElement* GetFront()       const { return fFront; }
+
+   // Producer thread
+   Bool_t           IsBackFree() const;
+   Bool_t           WaitBackFree(Long_t maxms=-1) const;
+   TEveElementList* BeginBuild(const char* name, const char* title="");
+   void             EndBuild();
+
+   // GUI thread
+   Bool_t           IsBackReady() const;
+   virtual Bool_t   Swap();
+   void             StartAutoSwap(Long_t period=100);
+   void             StopAutoSwap();
+
+   void             Swapped(); // *SIGNAL*
+
+   ClassDef(TEveEventBuffer, 0); // Double-buffer for events built in a worker thread.
+};
+
+#endif
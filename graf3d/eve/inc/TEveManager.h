@@ -185,6 +185,11 @@ public:
    // Fine grained updates via stamping.
    void ElementStamped(TEveElement* element);
 
+   // Off-screen building of elements in a non-GUI thread.
+   static void   BeginOffScreenBuild();
+   static void   EndOffScreenBuild();
+   static Bool_t IsOffScreenBuild();
+
    // These are more like TEveManager stuff.
    TGListTree*     GetListTree() const;
    TGListTreeItem* AddToListTree(TEveElement* re, Bool_t open, TGListTree* lt=0);
@@ -38,6 +38,9 @@ protected:
    virtual Bool_t  ShouldImport(TEveElement* el);
    virtual void    UpdateDependentElsAndScenes(TEveElement* root);
 
+   void            ProjectOffScreenRecurse(TEveElement* el);
+   void            BBoxCheckRecurse(TEveElement* el);
+
 public:
    TEveProjectionManager(TEveProjection::EPType_e type=TEveProjection::kPT_Unknown);
    virtual ~TEveProjectionManager();
@@ -69,6 +72,9 @@ public:
    virtual TEveElement* SubImportElements(TEveElement* el, TEveElement* proj_parent);
    virtual Int_t        SubImportChildren(TEveElement* el, TEveElement* proj_parent);
 
+   virtual TEveElement* ImportElementsOffScreen(TEveElement* el);
+   virtual void         AttachImportedElements(TEveElement* new_el, TEveElement* ext_list=0);
+
    virtual void    ProjectChildren();
    virtual void    ProjectChildrenRecurse(TEveElement* el);
 
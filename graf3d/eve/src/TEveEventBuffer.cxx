@@ -0,0 +1,292 @@
+// @(#)root/eve:$Id$
+// Author: agent   18/10/26
+
+/*************************************************************************
+ * Copyright (C) 1995-2012, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "TEveEventBuffer.h"
+#include "TEveManager.h"
+#include "TEveScene.h"
+#include "TEveProjectionManager.h"
+
+#include "TVirtualMutex.h"
+#include "TSystem.h"
+
+//______________________________________________________________________________
+// TEveEventBuffer
+//
+// Double-buffer for event elements built in a producer (worker) thread
+// and displayed by the GUI thread.
+//
+// The producer calls BeginBuild(), fills the returned element list and
+// calls EndBuild(). The elements are built in off-screen mode (see
+// TEveManager::BeginOffScreenBuild()) and the projected replicas for all
+// registered projection managers are created and projected within
+// EndBuild(), still in the producer thread. The result is stored in the
+// back buffer.
+//
+// On the GUI thread Swap() replaces the displayed event (front buffer)
+// and its projected replicas with the ones from the back buffer in one
+// step and triggers a single redraw. Swap() can be called explicitly or
+// by a timer, see StartAutoSwap(). The signal Swapped() is emitted after
+// each swap.
+//
+// Only one event can be waiting in the back buffer; the producer should
+// wait with WaitBackFree() before building the next one:
+//
+//    void *producer(void *arg)
+//    {
+//       TEveEventBuffer *buf = (TEveEventBuffer*) arg;
+//       for (Int_t ev = 0; ev < nev; ++ev)
+//       {
+//          buf->WaitBackFree();
+//          TEveElementList *evl = buf->BeginBuild(Form("Event %d", ev));
+//          evl->AddElement(MakeTracks(ev));
+//          evl->AddElement(MakeHits(ev));
+//          buf->EndBuild();
+//       }
+//       return 0;
+//    }
+//
+//    TEveEventBuffer *buf = new TEveEventBuffer;
+//    buf->AddProjectionManager(rphi_mgr, rphi_event_scene);
+//    buf->StartAutoSwap();
+//    (new TThread(producer, buf))->Run();
+//
+// Projection parameters of the registered managers must not be changed
+// while an event is being built.
+
+ClassImp(TEveEventBuffer);
+
+//______________________________________________________________________________
+TEveEventBuffer::TEveEventBuffer(TEveElement* dest) :
+   TQObject(),
+   fDestination (dest),
+   fMutex       (0),
+   fFront       (0),
+   fBack        (0),
+   fBuilding    (0),
+   fBackReady   (kFALSE),
+   fSwapTimer   ()
+{
+   // Constructor. The displayed event is added to dest; if it is 0 the
+   // event scene of gEve is used, as soon as gEve exists.
+   // Must be called from the GUI thread.
+
+   if (fDestination == 0 && gEve)
+      fDestination = gEve->GetEventScene();
+
+   fSwapTimer.Connect("Timeout()", "TEveEventBuffer", this, "Swap()");
+}
+
+//______________________________________________________________________________
+TEveEventBuffer::~TEveEventBuffer()
+{
+   // Destructor. The displayed event stays in its destination, a waiting
+   // event is destroyed.
+   // The producer thread must not be building an event.
+
+   fSwapTimer.Stop();
+
+   if (fBack)
+   {
+      for (vElement_i i = fBackProj.begin(); i != fBackProj.end(); ++i)
+         if (*i) (*i)->Destroy();
+      fBack->Destroy();
+   }
+   delete fMutex;
+}
+
+//______________________________________________________________________________
+void TEveEventBuffer::AddProjectionManager(TEveProjectionManager* mgr, TEveElement* dest)
+{
+   // Register a projection manager. Projected replicas of each event are
+   // added to mgr and, if dest is not 0, also to dest.
+   // Must be called from the GUI thread before the producer is started.
+
+   fProjMgrs .push_back(mgr);
+   fProjDests.push_back(dest);
+   fFrontProj.push_back(0);
+}
+
+//______________________________________________________________________________
+Bool_t TEveEventBuffer::IsBackFree() const
+{
+   // Return true if the back buffer is free, i.e. the previous event has
+   // been swapped in.
+
+   R__LOCKGUARD2(fMutex);
+   return ! fBackReady;
+}
+
+//______________________________________________________________________________
+Bool_t TEveEventBuffer::WaitBackFree(Long_t maxms) const
+{
+   // Wait until the back buffer is free, at most maxms milliseconds if
+   // maxms is not negative. Returns true if the buffer is free.
+   // To be called from the producer thread.
+
+   Long_t waited = 0;
+   while ( ! IsBackFree())
+   {
+      if (maxms >= 0 && waited >= maxms)
+         return kFALSE;
+      gSystem->Sleep(10);
+      waited += 10;
+   }
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+TEveElementList* TEveEventBuffer::BeginBuild(const char* name, const char* title)
+{
+   // Start building a new event. Returns the top-level element of the
+   // event, to be filled by the caller until EndBuild() is called.
+   // The calling thread is put in off-screen build mode.
+
+   static const TEveException eh("TEveEventBuffer::BeginBuild ");
+
+   if (fBuilding)
+      throw eh + "an event is already being built.";
+
+   TEveManager::BeginOffScreenBuild();
+
+   TEveElementList *el = new TEveElementList(name, title);
+   fBuilding = el;
+   return el;
+}
+
+//______________________________________________________________________________
+void TEveEventBuffer::EndBuild()
+{
+   // Finish building of the event: create and project the replicas for
+   // all registered projection managers and put the event into the back
+   // buffer. A waiting event that has not been swapped in yet is
+   // replaced.
+
+   static const TEveException eh("TEveEventBuffer::EndBuild ");
+
+   if (fBuilding == 0)
+      throw eh + "no event is being built.";
+
+   vElement_t proj(fProjMgrs.size(), (TEveElement*) 0);
+   for (UInt_t i = 0; i < fProjMgrs.size(); ++i)
+      proj[i] = fProjMgrs[i]->ImportElementsOffScreen(fBuilding);
+
+   TEveElement *old     = 0;
+   vElement_t   old_proj;
+   {
+      R__LOCKGUARD2(fMutex);
+      if (fBackReady)
+      {
+         old = fBack;
+         old_proj.swap(fBackProj);
+      }
+      fBack = fBuilding;
+      fBackProj.swap(proj);
+      fBackReady = kTRUE;
+   }
+   fBuilding = 0;
+
+   if (old)
+   {
+      for (vElement_i i = old_proj.begin(); i != old_proj.end(); ++i)
+         if (*i) (*i)->Destroy();
+      old->Destroy();
+   }
+
+   TEveManager::EndOffScreenBuild();
+}
+
+//______________________________________________________________________________
+Bool_t TEveEventBuffer::IsBackReady() const
+{
+   // Return true if an event is waiting to be swapped in.
+
+   R__LOCKGUARD2(fMutex);
+   return fBackReady;
+}
+
+//______________________________________________________________________________
+Bool_t TEveEventBuffer::Swap()
+{
+   // Replace the displayed event with the one waiting in the back buffer.
+   // Returns false if there was no event waiting, or if there is no
+   // destination for it (no destination was given to the constructor and
+   // gEve does not exist); the event then stays in the back buffer.
+   // Must be called from the GUI thread.
+
+   if (fDestination == 0 && gEve)
+      fDestination = gEve->GetEventScene();
+   if (fDestination == 0)
+   {
+      ::Error("TEveEventBuffer::Swap", "no destination for the event.");
+      return kFALSE;
+   }
+
+   TEveElement *back = 0;
+   vElement_t   back_proj;
+   {
+      R__LOCKGUARD2(fMutex);
+      if ( ! fBackReady)
+         return kFALSE;
+      back = fBack;
+      back_proj.swap(fBackProj);
+      fBack      = 0;
+      fBackReady = kFALSE;
+   }
+
+   TEveManager::TRedrawDisabler redrawOff(gEve);
+
+   for (UInt_t i = 0; i < fFrontProj.size(); ++i)
+   {
+      if (fFrontProj[i]) fFrontProj[i]->Destroy();
+      fFrontProj[i] = 0;
+   }
+   if (fFront)
+      fFront->Destroy();
+
+   fFront = back;
+   fDestination->AddElement(fFront);
+
+   for (UInt_t i = 0; i < fProjMgrs.size() && i < back_proj.size(); ++i)
+   {
+      if (back_proj[i])
+         fProjMgrs[i]->AttachImportedElements(back_proj[i], fProjDests[i]);
+      fFrontProj[i] = back_proj[i];
+   }
+
+   Swapped();
+
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+void TEveEventBuffer::StartAutoSwap(Long_t period)
+{
+   // Check for a waiting event every period milliseconds and swap it in.
+   // Must be called from the GUI thread.
+
+   fSwapTimer.Start(period, kFALSE);
+}
+
+//______________________________________________________________________________
+void TEveEventBuffer::StopAutoSwap()
+{
+   // Stop automatic swapping.
+
+   fSwapTimer.Stop();
+}
+
+//______________________________________________________________________________
+void TEveEventBuffer::Swapped()
+{
+   // Emit signal Swapped(), after a new event has been swapped in.
+
+   Emit("Swapped()");
+}
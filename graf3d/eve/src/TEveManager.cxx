@@ -44,16 +44,36 @@
 #include "TPluginManager.h"
 #include "TPRegexp.h"
 #include "TClass.h"
+#include "TVirtualMutex.h"
 
 #include "Riostream.h"
 
 TEveManager* gEve = 0;
 
+// Off-screen build nesting level of the calling thread, see
+// BeginOffScreenBuild(). Without thread-local storage the level is shared
+// by all threads and changed under a lock.
+#ifdef R__TLS
+static R__TLS Int_t gOffScreenBuild = 0;
+#else
+static volatile Int_t gOffScreenBuild = 0;
+static TVirtualMutex *gOffScreenMutex = 0;
+#endif
+
 //______________________________________________________________________________
 // TEveManager
 //
 // Central aplication manager for Eve.
 // Manages elements, GUI, GL scenes and GL viewers.
+//
+// Elements not yet attached to any scene can be built in a non-GUI
+// thread between BeginOffScreenBuild() and EndOffScreenBuild(). In this
+// mode change notifications, stamps and redraw requests coming from the
+// calling thread are ignored, so that the GUI-side state of the manager
+// is not touched; the elements are announced to the framework when they
+// are added to a scene from the GUI thread. See TEveEventBuffer.
+// On platforms without thread-local storage the mode is global and also
+// suppresses notifications from the GUI thread while a build is running.
 
 ClassImp(TEveManager);
 
@@ -384,6 +404,8 @@ void TEveManager::RegisterRedraw3D()
 {
    // Register a request for 3D redraw.
 
+   if (gOffScreenBuild > 0) return;
+
    fRedrawTimer.Start(0, kTRUE);
    fTimerActive = kTRUE;
 }
@@ -461,6 +483,8 @@ void TEveManager::ElementChanged(TEveElement* element, Bool_t update_scenes, Boo
 
    static const TEveException eh("TEveElement::ElementChanged ");
 
+   if (gOffScreenBuild > 0) return;
+
    if (GetEditor()->GetModel() == element->GetEditorObject(eh))
       EditElement(element);
    TEveGedEditor::ElementChanged(element);
@@ -480,6 +504,8 @@ void TEveManager::ScenesChanged(TEveElement::List_t& scenes)
 {
    // Mark all scenes from the given list as changed.
 
+   if (gOffScreenBuild > 0) return;
+
    for (TEveElement::List_i s=scenes.begin(); s!=scenes.end(); ++s)
       ((TEveScene*)*s)->Changed();
 }
@@ -489,6 +515,8 @@ void TEveManager::ElementStamped(TEveElement* element)
 {
    // Mark element as changed -- it will be processed on next redraw.
 
+   if (gOffScreenBuild > 0) return;
+
    UInt_t slot;
    if (fStampedElements->GetValue((ULong64_t) element, (Long64_t) element, slot) == 0)
    {
@@ -496,6 +524,39 @@ void TEveManager::ElementStamped(TEveElement* element)
    }
 }
 
+//______________________________________________________________________________
+void TEveManager::BeginOffScreenBuild()
+{
+   // Enter off-screen build mode for the calling thread.
+   // Elements created and modified in this mode must not be attached to
+   // any scene or list-tree until EndOffScreenBuild() is called.
+   // Calls can be nested.
+
+#ifndef R__TLS
+   R__LOCKGUARD2(gOffScreenMutex);
+#endif
+   ++gOffScreenBuild;
+}
+
+//______________________________________________________________________________
+void TEveManager::EndOffScreenBuild()
+{
+   // Leave off-screen build mode for the calling thread.
+
+#ifndef R__TLS
+   R__LOCKGUARD2(gOffScreenMutex);
+#endif
+   if (gOffScreenBuild > 0) --gOffScreenBuild;
+}
+
+//______________________________________________________________________________
+Bool_t TEveManager::IsOffScreenBuild()
+{
+   // Return true if the calling thread is building elements off-screen.
+
+   return gOffScreenBuild > 0;
+}
+
 
 /******************************************************************************/
 // GUI interface
@@ -594,6 +655,9 @@ void TEveManager::PreDeleteElement(TEveElement* element)
 {
    // Called from TEveElement prior to its destruction so the
    // framework components (like object editor) can unreference it.
+   // This is also done during an off-screen build, as the element may
+   // have been shown before; it only removes references and does not
+   // request any redraw.
 
    if (GetEditor()->GetEveElement() == element)
       EditElement(0);
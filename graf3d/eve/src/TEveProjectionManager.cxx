@@ -206,7 +206,7 @@ TEveElement* TEveProjectionManager::ImportElementsRecurse(TEveElement* el,
 {
    // If el is TEveProjectable add projected instance else add plain
    // TEveElementList to parent. Call the same function on el's
-   // children.
+   // children. If parent is 0 the replica of el is not added anywhere.
    //
    // Returns the projected replica of el. Can be 0, if el and none of
    // its children are projectable.
@@ -235,7 +235,8 @@ TEveElement* TEveProjectionManager::ImportElementsRecurse(TEveElement* el,
       new_el->SetRnrSelf     (el->GetRnrSelf());
       new_el->SetRnrChildren (el->GetRnrChildren());
       new_el->SetPickable    (el->IsPickable());
-      parent->AddElement(new_el);
+      if (parent)
+         parent->AddElement(new_el);
 
       TEveCompound *cmpnd    = dynamic_cast<TEveCompound*>(el);
       TEveCompound *cmpnd_pr = dynamic_cast<TEveCompound*>(new_el);
@@ -348,6 +349,91 @@ Int_t TEveProjectionManager::SubImportChildren(TEveElement* el, TEveElement* pro
    return (Int_t) new_els.size();
 }
 
+//______________________________________________________________________________
+TEveElement* TEveProjectionManager::ImportElementsOffScreen(TEveElement* el)
+{
+   // Recursively create projected replicas of el and its children and
+   // apply the projection to them, without adding them to the manager.
+   //
+   // This can be called from a non-GUI thread, within an off-screen build
+   // (see TEveManager::BeginOffScreenBuild()), for elements not yet
+   // attached to any scene. The manager itself is not modified but the
+   // projection parameters must not be changed while this is running.
+   // The returned replica must be passed to AttachImportedElements()
+   // from the GUI thread.
+   //
+   // Returns the projected replica of el. Can be 0, if el and none of
+   // its children are projectable.
+
+   TEveElement* new_el = ImportElementsRecurse(el, 0);
+   if (new_el)
+   {
+      ProjectOffScreenRecurse(new_el);
+   }
+   return new_el;
+}
+
+//______________________________________________________________________________
+void TEveProjectionManager::AttachImportedElements(TEveElement* new_el,
+                                                   TEveElement* ext_list)
+{
+   // Add projected replicas created by ImportElementsOffScreen() to the
+   // manager, update its bounding-box and notify the scenes.
+   // If ext_list is not 0 the new element is also added to the list,
+   // as in ImportElements().
+   // Must be called from the GUI thread.
+
+   AddElement(new_el);
+
+   AssertBBox();
+   BBoxCheckRecurse(new_el);
+   AssertBBoxExtents(0.1);
+   StampTransBBox();
+
+   UpdateDependentElsAndScenes(new_el);
+
+   if (ext_list)
+      ext_list->AddElement(new_el);
+}
+
+//______________________________________________________________________________
+void TEveProjectionManager::ProjectOffScreenRecurse(TEveElement* el)
+{
+   // Project el and its children and compute their bounding-boxes.
+   // Unlike ProjectChildrenRecurse() the manager's bounding-box is not
+   // updated and no change notifications are sent.
+
+   TEveProjected* pted = dynamic_cast<TEveProjected*>(el);
+   if (pted)
+   {
+      pted->UpdateProjection();
+      TAttBBox* bb = dynamic_cast<TAttBBox*>(pted);
+      if (bb)
+         bb->AssertBBox();
+   }
+
+   for (List_i i=el->BeginChildren(); i!=el->EndChildren(); ++i)
+      ProjectOffScreenRecurse(*i);
+}
+
+//______________________________________________________________________________
+void TEveProjectionManager::BBoxCheckRecurse(TEveElement* el)
+{
+   // Extend the bounding-box with the bounding-boxes of projected el and
+   // its children.
+
+   TAttBBox* bb = dynamic_cast<TAttBBox*>(dynamic_cast<TEveProjected*>(el));
+   if (bb)
+   {
+      Float_t* b = bb->AssertBBox();
+      BBoxCheckPoint(b[0], b[2], b[4]);
+      BBoxCheckPoint(b[1], b[3], b[5]);
+   }
+
+   for (List_i i=el->BeginChildren(); i!=el->EndChildren(); ++i)
+      BBoxCheckRecurse(*i);
+}
+
 //______________________________________________________________________________
 void TEveProjectionManager::ProjectChildrenRecurse(TEveElement* el)
 {
@@ -96,6 +96,7 @@ public:
    virtual Short_t  QuantizeShapeLOD(Short_t shapeLOD, Short_t combiLOD) const;
    virtual void     Draw(TGLRnrCtx& rnrCtx) const;
    virtual void     DirectDraw(TGLRnrCtx& rnrCtx) const = 0; // Actual draw method (non DL cached)
+   virtual void     DrawInstances(TGLRnrCtx& rnrCtx, const TGLPhysicalShape* const* shapes, Int_t n) const;
 
    virtual void     DrawHighlight(TGLRnrCtx& rnrCtx, const TGLPhysicalShape* pshp, Int_t lvl=-1) const;
 
@@ -12,6 +12,7 @@
 #ifndef ROOT_TGLMarchingCubes
 #define ROOT_TGLMarchingCubes
 
+#include <utility>
 #include <vector>
 
 #ifndef ROOT_TH3
@@ -206,6 +207,12 @@ protected:
 
    void FetchDensities()const{}//Do nothing.
 
+   Bool_t IsThreadSafe()const
+   {
+      //Histogram's array can be read by several threads.
+      return kTRUE;
+   }
+
    ElementType_t GetData(UInt_t i, UInt_t j, UInt_t k)const
    {
       i += 1;
@@ -254,6 +261,12 @@ protected:
 
    void FetchDensities()const{}//Do nothing.
 
+   Bool_t IsThreadSafe()const
+   {
+      //TF3::Eval is not re-entrant.
+      return kFALSE;
+   }
+
    Double_t GetData(UInt_t i, UInt_t j, UInt_t k)const;
 
    const TF3 *fTF3;//TF3 data source.
@@ -420,12 +433,31 @@ public:
    typedef TF3EdgeSplitter Type_t;
 };
 
+/*
+Number of threads used by TMeshBuilder to polygonize slabs of
+the grid in parallel. 0 means "one thread per CPU", 1 switches
+the parallel build off. The initial value is taken from
+OpenGL.MarchingCubes.Threads in .rootrc (0 if not set).
+Data sources which can not be read concurrently (TF3) are
+always polygonized by one thread.
+*/
+UInt_t GetMeshBuilderThreads();
+void   SetMeshBuilderThreads(UInt_t nThreads);
+
 /*
 Mesh builder. Polygonizes scalar field - TH3, TF3 or
 something else (some density estimator as data-source).
 
 ValueType is Float_t or Double_t - the type of vertex'
 x,y,z components.
+
+Big grids are split along z into slabs, which are polygonized
+by several threads into separate meshes; slabs' meshes are
+stitched together (vertices on the common plane are shared).
+UpdateMesh re-polygonizes the data source from the last BuildMesh
+with a new iso level: min/max of each grid layer are cached and
+only layers of cells with min/max straddling the iso level are
+visited.
 */
 
 template<class DataSource, class ValueType>
@@ -442,6 +474,7 @@ private:
    using DataSourceBase_t::GetH;
    using DataSourceBase_t::GetD;
    using DataSourceBase_t::GetData;
+   using DataSourceBase_t::IsThreadSafe;
    using SplitterBase_t::SplitEdge;
 
    typedef typename DataSourceBase_t::ElementType_t ElementType_t;
@@ -452,14 +485,53 @@ private:
 
 public:
    TMeshBuilder(Bool_t averagedNormals, ValueType eps = 1e-7)
-      : fAvgNormals(averagedNormals), fMesh(0), fIso(), fEpsilon(eps)
+      : fAvgNormals(averagedNormals), fMesh(0), fIso(), fEpsilon(eps),
+        fHasSource(kFALSE), fRangesValid(kFALSE)
    {
    }
 
    void BuildMesh(const DataSource *src, const TGridGeometry<ValueType> &geom,
                   MeshType_t *mesh, ValueType iso);
+   //Data source must not be modified since the last BuildMesh.
+   void UpdateMesh(MeshType_t *mesh, ValueType iso);
 
 private:
+   /*
+   TMeshPiece - range of cell layers [fFirst, fLast) polygonized
+   into its own mesh. Ids on the bottom (edges 0-3 of the first
+   layer) and top (edges 4-7 of the last layer) planes are saved
+   to stitch adjacent pieces.
+   */
+   class TMeshPiece {
+   public:
+      TMeshPiece() : fFirst(0), fLast(0), fStitchBottom(kFALSE), fStitchTop(kFALSE)
+      {
+      }
+
+      UInt_t              fFirst;
+      UInt_t              fLast;
+      Bool_t              fStitchBottom;
+      Bool_t              fStitchTop;
+      MeshType_t          fMesh;
+      std::vector<UInt_t> fBottomIds;
+      std::vector<UInt_t> fTopIds;
+   };
+
+   /*
+   TPieceWorker - pieces [fBegin, fEnd) processed by one thread.
+   */
+   class TPieceWorker {
+   public:
+      TPieceWorker() : fBuilder(0), fPieces(0), fBegin(0), fEnd(0)
+      {
+      }
+
+      const TMeshBuilder *fBuilder;
+      TMeshPiece         *fPieces;
+      UInt_t              fBegin;
+      UInt_t              fEnd;
+      SliceType_t         fSlices[2];
+   };
 
    Bool_t      fAvgNormals;
    SliceType_t fSlices[2];
@@ -467,21 +539,36 @@ private:
    ValueType   fIso;
    ValueType   fEpsilon;
 
+   Bool_t                     fHasSource;   //BuildMesh was called, UpdateMesh can reuse the data source.
+   Bool_t                     fRangesValid; //fLayerMin/fLayerMax are filled for the current data source.
+   std::vector<ElementType_t> fLayerMin;    //Min value in each grid layer (nz == k).
+   std::vector<ElementType_t> fLayerMax;    //Max value in each grid layer.
+
+   void BuildLayers(Bool_t skipEmpty);
+   void BuildPieces(const std::vector<std::pair<UInt_t, UInt_t> > &runs, UInt_t nLayers,
+                    UInt_t nThreads);
+   void BuildPiece(TMeshPiece &piece, SliceType_t *slices)const;
+   void MergePieces(TMeshPiece *pieces, UInt_t nPieces)const;
+   void FindLayerRanges();
+   void SaveIds(const SliceType_t *slice, UInt_t firstEdge, std::vector<UInt_t> &ids)const;
+
+   static void *PieceThread(void *arg);
+
    void NextStep(UInt_t depth, const SliceType_t *prevSlice,
-                 SliceType_t *curr)const;
+                 SliceType_t *curr, MeshType_t *mesh)const;
 
-   void BuildFirstCube(SliceType_t *slice)const;
-   void BuildRow(SliceType_t *slice)const;
-   void BuildCol(SliceType_t *slice)const;
-   void BuildSlice(SliceType_t *slice)const;
+   void BuildFirstCube(UInt_t depth, SliceType_t *slice, MeshType_t *mesh)const;
+   void BuildRow(UInt_t depth, SliceType_t *slice, MeshType_t *mesh)const;
+   void BuildCol(UInt_t depth, SliceType_t *slice, MeshType_t *mesh)const;
+   void BuildSlice(UInt_t depth, SliceType_t *slice, MeshType_t *mesh)const;
    void BuildFirstCube(UInt_t depth, const SliceType_t *prevSlice,
-                       SliceType_t *slice)const;
+                       SliceType_t *slice, MeshType_t *mesh)const;
    void BuildRow(UInt_t depth, const SliceType_t *prevSlice,
-                 SliceType_t *slice)const;
+                 SliceType_t *slice, MeshType_t *mesh)const;
    void BuildCol(UInt_t depth, const SliceType_t *prevSlice,
-                 SliceType_t *slice)const;
+                 SliceType_t *slice, MeshType_t *mesh)const;
    void BuildSlice(UInt_t depth, const SliceType_t *prevSlice,
-                   SliceType_t *slice)const;
+                   SliceType_t *slice, MeshType_t *mesh)const;
 
    void BuildNormals()const;
 
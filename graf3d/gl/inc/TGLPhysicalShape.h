@@ -69,6 +69,8 @@ private:
    Bool_t                  fModified;     //! has been modified - retain across scene rebuilds
    EManip                  fManip;        //! permitted manipulation bitflags - see EManip
 
+   static Float_t          fgPixelLODSize; // projected size in pixels below which shapes are drawn as points
+
    // Methods
    void            UpdateBoundingBox();
    void            InitColor(const Float_t rgba[4]);
@@ -91,6 +93,9 @@ public:
    virtual void CalculateShapeLOD(TGLRnrCtx & rnrCtx, Float_t& pixSize, Short_t& shapeLOD) const;
    virtual void QuantizeShapeLOD (Short_t shapeLOD, Short_t combiLOD, Short_t& quantLOD) const;
 
+   static Float_t GetPixelLODSize()          { return fgPixelLODSize; }
+   static void    SetPixelLODSize(Float_t s) { fgPixelLODSize = s; }
+
    void SetupGLColors(TGLRnrCtx & rnrCtx, const Float_t* color=0) const;
    virtual void Draw(TGLRnrCtx & rnrCtx) const;
 
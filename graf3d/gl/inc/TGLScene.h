@@ -141,6 +141,10 @@ protected:
    Float_t                   fLastPointSizeScale;
    Float_t                   fLastLineWidthScale;
 
+   // Batched drawing of physicals sharing a logical
+   Bool_t                    fBatchDraw;         //!
+   ShapeVec_t                fBatchShapes;       //! scratch list of the current batch
+
    // ----------------------------------------------------------------
    // ----------------------------------------------------------------
 
@@ -177,6 +181,9 @@ public:
                                 Bool_t               check_timeout,
                                 const TGLPlaneSet_t* clipPlanes = 0);
 
+   Bool_t GetBatchDraw() const   { return fBatchDraw; }
+   void   SetBatchDraw(Bool_t b) { fBatchDraw = b; }
+
    // Selection
    virtual Bool_t ResolveSelectRecord(TGLSelectRecord& rec, Int_t curIdx);
 
@@ -138,7 +138,7 @@ private:
    //Auxiliary methods.
    Bool_t   HasSections()const;
    void     SetSurfaceColor(Int_t ind)const;
-   void     SetMesh(Mesh_t &mesh, Double_t isoValue);
+   void     SetMeshes(const std::vector<Mesh_t *> &meshes);
    void     DrawMesh(const Mesh_t &mesh, Int_t level)const;
    void     FindMinMax();
 
@@ -58,6 +58,7 @@ protected:
    void SetDataSource(const TKDEFGT *dataSource);
 
    void FetchDensities()const;
+   Bool_t IsThreadSafe()const;
 
    Float_t GetData(UInt_t i, UInt_t j, UInt_t k)const;
 
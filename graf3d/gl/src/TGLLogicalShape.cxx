@@ -14,6 +14,8 @@
 #include "TClass.h"
 #include "TContextMenu.h"
 
+#include <string.h>
+
 
 //==============================================================================
 // TGLLogicalShape
@@ -59,6 +61,11 @@
 // LOD levels per class.
 // See also: TGLPhysicalShape::CalculateShapeLOD() where LOD is calculated.
 //
+// Physicals sharing a logical are drawn in batches by TGLScene, see
+// DrawInstances(). Then the display-list of the logical is replayed for
+// each instance with only the transformation and, if needed, the
+// material colors changed in between.
+//
 // See base/src/TVirtualViewer3D for description of common external 3D
 // viewer architecture and how external viewer clients use it.
 //
@@ -415,6 +422,56 @@ entry_point:
    }
 }
 
+//______________________________________________________________________________
+void TGLLogicalShape::DrawInstances(TGLRnrCtx& rnrCtx, const TGLPhysicalShape* const* shapes, Int_t n) const
+{
+   // Draw n placed instances of this logical shape with the LOD currently
+   // set in rnrCtx. Called by TGLScene::RenderElements() for consecutive
+   // draw-elements sharing this logical.
+   //
+   // Between the instances only the transformation, face winding and
+   // selection name are changed. Material colors are only set up when
+   // they differ from the ones of the previous instance, which avoids most
+   // of the GL state changes when drawing many copies of the same volume.
+   // The geometry is captured into the display-list at the first instance
+   // and replayed for the others.
+   //
+   // The caller must push a selection name before calling this function.
+
+   const Bool_t   outline   = rnrCtx.IsDrawPassOutlineLine();
+   const Float_t *lastColor = 0;
+
+   for (Int_t k = 0; k < n; ++k)
+   {
+      const TGLPhysicalShape *pshp = shapes[k];
+
+      glLoadName(pshp->ID());
+      glPushMatrix();
+      glMultMatrixd(pshp->fTransform.CArr());
+      if (pshp->fInvertedWind) glFrontFace(GL_CW);
+
+      if (lastColor == 0 || memcmp(lastColor, pshp->fColor, sizeof(pshp->fColor)) != 0)
+      {
+         if (outline && lastColor) TGLUtil::UnlockColor();
+         pshp->SetupGLColors(rnrCtx);
+         if (outline) TGLUtil::LockColor();
+         lastColor = pshp->fColor;
+      }
+      else if (!outline)
+      {
+         // Shapes might change the current color while drawing.
+         glColor4fv(pshp->fColor);
+      }
+
+      Draw(rnrCtx);
+
+      if (pshp->fInvertedWind) glFrontFace(GL_CCW);
+      glPopMatrix();
+   }
+
+   if (outline && lastColor) TGLUtil::UnlockColor();
+}
+
 //______________________________________________________________________________
 void TGLLogicalShape::DrawHighlight(TGLRnrCtx& rnrCtx, const TGLPhysicalShape* pshp, Int_t lvl) const
 {
@@ -12,7 +12,10 @@
 #include <algorithm>
 #include <cmath>
 
+#include "TSystem.h"
+#include "TThread.h"
 #include "TError.h"
+#include "TEnv.h"
 #include "TF3.h"
 
 #include "TGLMarchingCubes.h"
@@ -61,6 +64,27 @@ enum ECubeBitMasks {
    k6_7            = k6 | k7
 };
 
+const UInt_t kNoId = UInt_t(-1);
+//Smaller grids are not split between threads.
+const ULong64_t kMinCellsPerThread = 32768;
+
+UInt_t gMeshBuilderThreads = kNoId;//Not read from gEnv yet.
+
+//______________________________________________________________________
+UInt_t NumberOfThreads()
+{
+   //Number of threads for TMeshBuilder, 0 is replaced
+   //by the number of CPUs.
+   static UInt_t nCpus = 0;
+   if (const UInt_t n = GetMeshBuilderThreads())
+      return n;
+   if (!nCpus) {
+      SysInfo_t info;
+      nCpus = gSystem && !gSystem->GetSysInfo(&info) && info.fCpus > 0 ? UInt_t(info.fCpus) : 1;
+   }
+   return nCpus;
+}
+
 //______________________________________________________________________
 template<class E, class V>
 void ConnectTriangles(TCell<E> &cell, TIsoMesh<V> *mesh, V eps)
@@ -97,6 +121,25 @@ void ConnectTriangles(TCell<E> &cell, TIsoMesh<V> *mesh, V eps)
 
 }//unnamed namespace.
 
+//______________________________________________________________________
+UInt_t GetMeshBuilderThreads()
+{
+   //Number of threads for TMeshBuilder, 0 - one per CPU.
+   if (gMeshBuilderThreads == kNoId) {
+      const Int_t n = gEnv->GetValue("OpenGL.MarchingCubes.Threads", 0);
+      gMeshBuilderThreads = n > 0 ? UInt_t(n) : 0;
+   }
+   return gMeshBuilderThreads;
+}
+
+//______________________________________________________________________
+void SetMeshBuilderThreads(UInt_t nThreads)
+{
+   //Set number of threads for TMeshBuilder, 0 - one per CPU,
+   //1 - serial build.
+   gMeshBuilderThreads = nThreads;
+}
+
 /*
 TF3Adapter.
 */
@@ -175,6 +218,8 @@ void TMeshBuilder<D, V>::BuildMesh(const D *s, const TGridGeometry<V> &g,
    static_cast<TGridGeometry<V> &>(*this) = g;
 
    this->SetDataSource(s);
+   fHasSource   = kFALSE;
+   fRangesValid = kFALSE;
 
    if (GetW() < 2 || GetH() < 2 || GetD() < 2) {
       Error("TMeshBuilder::BuildMesh", 
@@ -182,64 +227,333 @@ void TMeshBuilder<D, V>::BuildMesh(const D *s, const TGridGeometry<V> &g,
       return;
    }
 
-   fSlices[0].ResizeSlice(GetW() - 1, GetH() - 1);
-   fSlices[1].ResizeSlice(GetW() - 1, GetH() - 1);
-
    this->SetNormalEvaluator(s);
 
    fMesh = m;
    fIso  = iso;
 
-   SliceType_t *slice1 = fSlices;
-   SliceType_t *slice2 = fSlices + 1;
-
    this->FetchDensities();
-   NextStep(0, 0, slice1);
+   fHasSource = kTRUE;
 
-   for (UInt_t i = 1, e = GetD(); i < e - 1; ++i) {
-      NextStep(i, slice1, slice2);
-      std::swap(slice1, slice2);
+   BuildLayers(kFALSE);
+}
+
+//______________________________________________________________________
+template<class D, class V>
+void TMeshBuilder<D, V>::UpdateMesh(MeshType_t *m, V iso)
+{
+   //Build iso-mesh for a new iso level, using the data source
+   //(and the grid) from the last BuildMesh call. Min/max values
+   //of grid layers are found by the first update and reused by
+   //the next ones, only layers of cells, which can be intersected
+   //by the iso-surface, are visited.
+   if (!fHasSource) {
+      Error("TMeshBuilder::UpdateMesh", "No data source, call BuildMesh first");
+      return;
+   }
+
+   fMesh = m;
+   fIso  = iso;
+
+   if (!fRangesValid)
+      FindLayerRanges();
+
+   BuildLayers(kTRUE);
+}
+
+//______________________________________________________________________
+template<class D, class V>
+void TMeshBuilder<D, V>::BuildLayers(Bool_t skipEmpty)
+{
+   //Polygonize layers of cells nz : [0, D - 1), serially or
+   //in several threads. With skipEmpty, layers without
+   //intersections (all values in two grid layers are
+   //above or below the iso level) are not visited.
+   const UInt_t d = GetD();
+   std::vector<std::pair<UInt_t, UInt_t> > runs;//Ranges of layers to polygonize.
+   UInt_t nLayers = 0;
+
+   if (!skipEmpty) {
+      runs.push_back(std::make_pair(0u, d - 1));
+      nLayers = d - 1;
+   } else {
+      for (UInt_t i = 0; i < d - 1; ++i) {
+         const ElementType_t lo = std::min(fLayerMin[i], fLayerMin[i + 1]);
+         const ElementType_t hi = std::max(fLayerMax[i], fLayerMax[i + 1]);
+         if (lo > fIso || hi <= fIso)
+            continue;
+         if (!runs.empty() && runs.back().second == i)
+            ++runs.back().second;
+         else
+            runs.push_back(std::make_pair(i, i + 1));
+         ++nLayers;
+      }
+   }
+
+   UInt_t nThreads = 1;
+   if (nLayers > 1 && IsThreadSafe()) {
+      const ULong64_t nCells = ULong64_t(GetW() - 1) * (GetH() - 1) * nLayers;
+      nThreads = std::min(NumberOfThreads(), nLayers / 2);
+      nThreads = UInt_t(std::min(ULong64_t(nThreads), nCells / kMinCellsPerThread));
+   }
+
+   if (nThreads > 1) {
+      BuildPieces(runs, nLayers, nThreads);
+   } else {
+      fSlices[0].ResizeSlice(GetW() - 1, GetH() - 1);
+      fSlices[1].ResizeSlice(GetW() - 1, GetH() - 1);
+
+      for (UInt_t r = 0; r < runs.size(); ++r) {
+         SliceType_t *slice1 = fSlices;
+         SliceType_t *slice2 = fSlices + 1;
+
+         NextStep(runs[r].first, 0, slice1, fMesh);
+
+         for (UInt_t i = runs[r].first + 1; i < runs[r].second; ++i) {
+            NextStep(i, slice1, slice2, fMesh);
+            std::swap(slice1, slice2);
+         }
+      }
    }
 
    if(fAvgNormals)
       BuildNormals();
 }
 
+//______________________________________________________________________
+template<class D, class V>
+void TMeshBuilder<D, V>::BuildPieces(const std::vector<std::pair<UInt_t, UInt_t> > &runs,
+                                     UInt_t nLayers, UInt_t nThreads)
+{
+   //Split runs of layers into pieces, nLayers / nThreads layers per
+   //thread. Pieces are polygonized in separate threads (the calling
+   //thread processes the last group) and stitched into fMesh.
+   const UInt_t perThread = (nLayers + nThreads - 1) / nThreads;
+   const UInt_t nWorkers  = (nLayers + perThread - 1) / perThread;
+
+   std::vector<UInt_t> firsts, lasts, owners;
+   UInt_t count = 0;
+   for (UInt_t r = 0; r < runs.size(); ++r) {
+      for (UInt_t i = runs[r].first; i < runs[r].second;) {
+         const UInt_t owner = count / perThread;
+         const UInt_t n = std::min(runs[r].second - i, (owner + 1) * perThread - count);
+         firsts.push_back(i);
+         lasts.push_back(i + n);
+         owners.push_back(owner);
+         i += n;
+         count += n;
+      }
+   }
+
+   const UInt_t nPieces = UInt_t(firsts.size());
+   TMeshPiece   *pieces  = new TMeshPiece[nPieces];
+   TPieceWorker *workers = new TPieceWorker[nWorkers];
+
+   for (UInt_t i = 0; i < nPieces; ++i) {
+      pieces[i].fFirst = firsts[i];
+      pieces[i].fLast  = lasts[i];
+      if (i && pieces[i - 1].fLast == pieces[i].fFirst)
+         pieces[i - 1].fStitchTop = pieces[i].fStitchBottom = kTRUE;
+
+      TPieceWorker &worker = workers[owners[i]];
+      if (!worker.fEnd)
+         worker.fBegin = i;
+      worker.fEnd = i + 1;
+   }
+
+   std::vector<TThread *> threads;
+   for (UInt_t i = 0; i < nWorkers; ++i) {
+      workers[i].fBuilder = this;
+      workers[i].fPieces  = pieces;
+      if (i + 1 < nWorkers) {
+         threads.push_back(new TThread(Form("TMeshBuilder%u", i), PieceThread, (void *)&workers[i]));
+         threads.back()->Run();
+      }
+   }
+
+   PieceThread(&workers[nWorkers - 1]);
+
+   for (UInt_t i = 0; i < threads.size(); ++i) {
+      threads[i]->Join();
+      delete threads[i];
+   }
+
+   MergePieces(pieces, nPieces);
+
+   delete [] workers;
+   delete [] pieces;
+}
+
+//______________________________________________________________________
+template<class D, class V>
+void *TMeshBuilder<D, V>::PieceThread(void *arg)
+{
+   //Thread function: polygonize worker's pieces.
+   TPieceWorker *worker = static_cast<TPieceWorker *>(arg);
+   const TMeshBuilder *builder = worker->fBuilder;
+
+   worker->fSlices[0].ResizeSlice(builder->GetW() - 1, builder->GetH() - 1);
+   worker->fSlices[1].ResizeSlice(builder->GetW() - 1, builder->GetH() - 1);
+
+   for (UInt_t i = worker->fBegin; i < worker->fEnd; ++i)
+      builder->BuildPiece(worker->fPieces[i], worker->fSlices);
+
+   return 0;
+}
+
+//______________________________________________________________________
+template<class D, class V>
+void TMeshBuilder<D, V>::BuildPiece(TMeshPiece &piece, SliceType_t *slices)const
+{
+   //Polygonize layers [fFirst, fLast) into piece's mesh. The first
+   //layer is built as the first slice of a grid, without the previous
+   //slice, so its bottom vertices are duplicated and have to be
+   //stitched with the previous piece.
+   SliceType_t *slice1 = slices;
+   SliceType_t *slice2 = slices + 1;
+
+   NextStep(piece.fFirst, 0, slice1, &piece.fMesh);
+   if (piece.fStitchBottom)
+      SaveIds(slice1, 0, piece.fBottomIds);
+
+   for (UInt_t i = piece.fFirst + 1; i < piece.fLast; ++i) {
+      NextStep(i, slice1, slice2, &piece.fMesh);
+      std::swap(slice1, slice2);
+   }
+
+   if (piece.fStitchTop)
+      SaveIds(slice1, 4, piece.fTopIds);
+}
+
+//______________________________________________________________________
+template<class D, class V>
+void TMeshBuilder<D, V>::SaveIds(const SliceType_t *s, UInt_t firstEdge,
+                                 std::vector<UInt_t> &ids)const
+{
+   //Save vertex ids of edges [firstEdge, firstEdge + 4) (bottom or
+   //top face) of all cells in a slice, kNoId if edge is not intersected.
+   const UInt_t n = UInt_t(s->fCells.size());
+   ids.resize(n * 4);
+
+   for (UInt_t i = 0; i < n; ++i) {
+      const CellType_t &cell = s->fCells[i];
+      const UInt_t edges = eInt[cell.fType];
+      for (UInt_t j = 0; j < 4; ++j)
+         ids[i * 4 + j] = edges & (1 << (firstEdge + j)) ? cell.fIds[firstEdge + j] : kNoId;
+   }
+}
+
+//______________________________________________________________________
+template<class D, class V>
+void TMeshBuilder<D, V>::MergePieces(TMeshPiece *pieces, UInt_t nPieces)const
+{
+   //Append pieces' meshes to fMesh. Bottom vertices of a piece, adjacent
+   //to the previous one, are replaced by the top vertices of the previous
+   //piece (edge i of the first layer is edge i + 4 of the previous layer).
+   std::vector<UInt_t> prevIds, ids;//Piece's vertex index -> index in fMesh.
+   UInt_t t[3];
+
+   for (UInt_t p = 0; p < nPieces; ++p) {
+      MeshType_t &mesh = pieces[p].fMesh;
+      ids.assign(mesh.fVerts.size() / 3, kNoId);
+
+      if (pieces[p].fStitchBottom) {
+         const std::vector<UInt_t> &bottom = pieces[p].fBottomIds;
+         const std::vector<UInt_t> &top = pieces[p - 1].fTopIds;
+         for (UInt_t i = 0, e = UInt_t(bottom.size()); i < e; ++i) {
+            if (bottom[i] != kNoId && top[i] != kNoId)
+               ids[bottom[i]] = prevIds[top[i]];
+         }
+      }
+
+      const Bool_t hasNormals = mesh.fNorms.size() == mesh.fVerts.size();
+      for (UInt_t i = 0, e = UInt_t(ids.size()); i < e; ++i) {
+         if (ids[i] != kNoId)
+            continue;
+         ids[i] = fMesh->AddVertex(&mesh.fVerts[i * 3]);
+         if (hasNormals)
+            fMesh->AddNormal(&mesh.fNorms[i * 3]);
+      }
+
+      for (UInt_t i = 0, e = UInt_t(mesh.fTris.size()); i < e; i += 3) {
+         t[0] = ids[mesh.fTris[i]];
+         t[1] = ids[mesh.fTris[i + 1]];
+         t[2] = ids[mesh.fTris[i + 2]];
+         fMesh->AddTriangle(t);
+      }
+
+      prevIds.swap(ids);
+      MeshType_t().Swap(mesh);//Free piece's memory.
+   }
+}
+
+//______________________________________________________________________
+template<class D, class V>
+void TMeshBuilder<D, V>::FindLayerRanges()
+{
+   //Find min and max values in each grid layer (nz == k).
+   const UInt_t w = GetW();
+   const UInt_t h = GetH();
+   const UInt_t d = GetD();
+
+   fLayerMin.resize(d);
+   fLayerMax.resize(d);
+
+   for (UInt_t k = 0; k < d; ++k) {
+      ElementType_t lo = GetData(0, 0, k);
+      ElementType_t hi = lo;
+      for (UInt_t j = 0; j < h; ++j) {
+         for (UInt_t i = 0; i < w; ++i) {
+            const ElementType_t val = GetData(i, j, k);
+            if (val < lo)
+               lo = val;
+            else if (val > hi)
+               hi = val;
+         }
+      }
+      fLayerMin[k] = lo;
+      fLayerMax[k] = hi;
+   }
+
+   fRangesValid = kTRUE;
+}
+
 //______________________________________________________________________
 template<class D, class V>
 void TMeshBuilder<D, V>::NextStep(UInt_t depth, const SliceType_t *prevSlice, 
-                                  SliceType_t *curr)const
+                                  SliceType_t *curr, MeshType_t *mesh)const
 {
    //Fill slice with vertices and triangles.
 
    if (!prevSlice) {
-      //The first slice in mc grid.
-      BuildFirstCube(curr);
-      BuildRow(curr);
-      BuildCol(curr);
-      BuildSlice(curr);
+      //The first slice in mc grid (or in a piece of the grid).
+      BuildFirstCube(depth, curr, mesh);
+      BuildRow(depth, curr, mesh);
+      BuildCol(depth, curr, mesh);
+      BuildSlice(depth, curr, mesh);
    } else {
-      BuildFirstCube(depth, prevSlice, curr);
-      BuildRow(depth, prevSlice, curr);
-      BuildCol(depth, prevSlice, curr);
-      BuildSlice(depth, prevSlice, curr);
+      BuildFirstCube(depth, prevSlice, curr, mesh);
+      BuildRow(depth, prevSlice, curr, mesh);
+      BuildCol(depth, prevSlice, curr, mesh);
+      BuildSlice(depth, prevSlice, curr, mesh);
    }
 }
 
 //______________________________________________________________________
 template<class D, class V>
-void TMeshBuilder<D, V>::BuildFirstCube(SliceType_t *s)const
+void TMeshBuilder<D, V>::BuildFirstCube(UInt_t depth, SliceType_t *s, MeshType_t *mesh)const
 {
-   //The first cube in a grid. nx == 0, ny == 0, nz ==0.
+   //The first cube in a slice without a previous slice:
+   //nx == 0, ny == 0, nz == depth (0 or the first layer of a slab).
    CellType_t & cell = s->fCells[0];
-   cell.fVals[0] = GetData(0, 0, 0);
-   cell.fVals[1] = GetData(1, 0, 0);
-   cell.fVals[2] = GetData(1, 1, 0);
-   cell.fVals[3] = GetData(0, 1, 0);
-   cell.fVals[4] = GetData(0, 0, 1);
-   cell.fVals[5] = GetData(1, 0, 1);
-   cell.fVals[6] = GetData(1, 1, 1);
-   cell.fVals[7] = GetData(0, 1, 1);
+   cell.fVals[0] = GetData(0, 0, depth);
+   cell.fVals[1] = GetData(1, 0, depth);
+   cell.fVals[2] = GetData(1, 1, depth);
+   cell.fVals[3] = GetData(0, 1, depth);
+   cell.fVals[4] = GetData(0, 0, depth + 1);
+   cell.fVals[5] = GetData(1, 0, depth + 1);
+   cell.fVals[6] = GetData(1, 1, depth + 1);
+   cell.fVals[7] = GetData(0, 1, depth + 1);
 
    cell.fType = 0;
    for (UInt_t i = 0; i < 8; ++i) {
@@ -247,23 +561,25 @@ void TMeshBuilder<D, V>::BuildFirstCube(SliceType_t *s)const
          cell.fType |= 1 << i;
    }
 
+   const V z = this->fMinZ + depth * this->fStepZ;
    for (UInt_t i = 0, edges = eInt[cell.fType]; i < 12; ++i) {
       if (edges & (1 << i))
-         SplitEdge(cell, fMesh, i, this->fMinX, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, i, this->fMinX, this->fMinY, z, fIso);
    }
 
-   ConnectTriangles(cell, fMesh, fEpsilon);
+   ConnectTriangles(cell, mesh, fEpsilon);
 }
 
 //______________________________________________________________________
 template<class D, class V>
-void TMeshBuilder<D, V>::BuildRow(SliceType_t *s)const
+void TMeshBuilder<D, V>::BuildRow(UInt_t depth, SliceType_t *s, MeshType_t *mesh)const
 {
    //The first row (along x) in the first slice:
-   //ny == 0, nz == 0, nx : [1, W - 1].
+   //ny == 0, nz == depth, nx : [1, W - 1].
    //Each cube has previous cube.
    //Values 0, 3, 4, 7 are taken from the previous cube.
    //Edges 3, 7, 8, 11 are taken from the previous cube.
+   const V z = this->fMinZ + depth * this->fStepZ;
    for (UInt_t i = 1, e = GetW() - 1; i < e; ++i) {
       const CellType_t &prev = s->fCells[i - 1];
       CellType_t &cell = s->fCells[i];
@@ -274,13 +590,13 @@ void TMeshBuilder<D, V>::BuildRow(SliceType_t *s)const
       cell.fType |= (prev.fType & k1_5) >> 1;
       cell.fType |= (prev.fType & k2_6) << 1;
 
-      if ((cell.fVals[1] = GetData(i + 1, 0, 0)) <= fIso)
+      if ((cell.fVals[1] = GetData(i + 1, 0, depth)) <= fIso)
          cell.fType |= k1;
-      if ((cell.fVals[2] = GetData(i + 1, 1, 0)) <= fIso)
+      if ((cell.fVals[2] = GetData(i + 1, 1, depth)) <= fIso)
          cell.fType |= k2;
-      if ((cell.fVals[5] = GetData(i + 1, 0, 1)) <= fIso)
+      if ((cell.fVals[5] = GetData(i + 1, 0, depth + 1)) <= fIso)
          cell.fType |= k5;
-      if ((cell.fVals[6] = GetData(i + 1, 1, 1)) <= fIso)
+      if ((cell.fVals[6] = GetData(i + 1, 1, depth + 1)) <= fIso)
          cell.fType |= k6;
 
       const UInt_t edges = eInt[cell.fType];
@@ -298,37 +614,38 @@ void TMeshBuilder<D, V>::BuildRow(SliceType_t *s)const
       //2. Intersect edges 0, 1, 2, 4, 5, 6, 9, 10.
       const V x = this->fMinX + i * this->fStepX;
       if (edges & k0)
-         SplitEdge(cell, fMesh, 0, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 0, x, this->fMinY, z, fIso);
       if (edges & k1)
-         SplitEdge(cell, fMesh, 1, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 1, x, this->fMinY, z, fIso);
       if (edges & k2)
-         SplitEdge(cell, fMesh, 2, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 2, x, this->fMinY, z, fIso);
       if (edges & k4)
-         SplitEdge(cell, fMesh, 4, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 4, x, this->fMinY, z, fIso);
       if (edges & k5)
-         SplitEdge(cell, fMesh, 5, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 5, x, this->fMinY, z, fIso);
       if (edges & k6)
-         SplitEdge(cell, fMesh, 6, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 6, x, this->fMinY, z, fIso);
       if (edges & k9)
-         SplitEdge(cell, fMesh, 9, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 9, x, this->fMinY, z, fIso);
       if (edges & k10)
-         SplitEdge(cell, fMesh, 10, x, this->fMinY, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 10, x, this->fMinY, z, fIso);
       //3. Connect new triangles.
-      ConnectTriangles(cell, fMesh, fEpsilon);
+      ConnectTriangles(cell, mesh, fEpsilon);
    }
 }
 
 //______________________________________________________________________
 template<class D, class V>
-void TMeshBuilder<D, V>::BuildCol(SliceType_t *s)const
+void TMeshBuilder<D, V>::BuildCol(UInt_t depth, SliceType_t *s, MeshType_t *mesh)const
 {
    //"Col" (column) consists of cubes along y axis
-   //on the first slice (nx == 0, nz == 0).
+   //on the first slice (nx == 0, nz == depth).
    //Each cube has a previous cube and shares values:
    //0, 1, 4, 5 (in prev.: 3, 2, 7, 6); and edges:
    //0, 4, 8, 9 (in prev.: 2, 6, 10, 11).
    const UInt_t w = GetW();
    const UInt_t h = GetH();
+   const V z = this->fMinZ + depth * this->fStepZ;
 
    for (UInt_t i = 1; i < h - 1; ++i) {
       const CellType_t &prev = s->fCells[(i - 1) * (w - 1)];
@@ -340,13 +657,13 @@ void TMeshBuilder<D, V>::BuildCol(SliceType_t *s)const
       cell.fType |= (prev.fType & k2_6) >> 1;
       cell.fType |= (prev.fType & k3_7) >> 3;
       //Calculate values 2, 3, 6, 7.
-      if((cell.fVals[2] = GetData(1, i + 1, 0)) <= fIso)
+      if((cell.fVals[2] = GetData(1, i + 1, depth)) <= fIso)
          cell.fType |= k2;
-      if((cell.fVals[3] = GetData(0, i + 1, 0)) <= fIso)
+      if((cell.fVals[3] = GetData(0, i + 1, depth)) <= fIso)
          cell.fType |= k3;
-      if((cell.fVals[6] = GetData(1, i + 1, 1)) <= fIso)
+      if((cell.fVals[6] = GetData(1, i + 1, depth + 1)) <= fIso)
          cell.fType |= k6;
-      if((cell.fVals[7] = GetData(0, i + 1, 1)) <= fIso)
+      if((cell.fVals[7] = GetData(0, i + 1, depth + 1)) <= fIso)
          cell.fType |= k7;
 
       const UInt_t edges = eInt[cell.fType];
@@ -365,37 +682,38 @@ void TMeshBuilder<D, V>::BuildCol(SliceType_t *s)const
       const V y = this->fMinY + i * this->fStepY;
 
       if (edges & k1)
-         SplitEdge(cell, fMesh, 1, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 1, this->fMinX, y, z, fIso);
       if (edges & k2)
-         SplitEdge(cell, fMesh, 2, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 2, this->fMinX, y, z, fIso);
       if (edges & k3)
-         SplitEdge(cell, fMesh, 3, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 3, this->fMinX, y, z, fIso);
       if (edges & k5)
-         SplitEdge(cell, fMesh, 5, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 5, this->fMinX, y, z, fIso);
       if (edges & k6)
-         SplitEdge(cell, fMesh, 6, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 6, this->fMinX, y, z, fIso);
       if (edges & k7)
-         SplitEdge(cell, fMesh, 7, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 7, this->fMinX, y, z, fIso);
       if (edges & k10)
-         SplitEdge(cell, fMesh, 10, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 10, this->fMinX, y, z, fIso);
       if (edges & k11)
-         SplitEdge(cell, fMesh, 11, this->fMinX, y, this->fMinZ, fIso);
+         SplitEdge(cell, mesh, 11, this->fMinX, y, z, fIso);
 
-      ConnectTriangles(cell, fMesh, fEpsilon);
+      ConnectTriangles(cell, mesh, fEpsilon);
    }
 }
 
 //______________________________________________________________________
 template<class D, class V>
-void TMeshBuilder<D, V>::BuildSlice(SliceType_t *s)const
+void TMeshBuilder<D, V>::BuildSlice(UInt_t depth, SliceType_t *s, MeshType_t *mesh)const
 {
-   //Slice with nz == 0.
+   //The first slice, nz == depth.
    //nx : [1, W - 1], ny : [1, H - 1].
    //nx increased inside inner loop, ny - enclosing loop.
    //Each cube has two neighbours: ny - 1 => "left",
    //nx - 1 => "right".
    const UInt_t w = GetW();
    const UInt_t h = GetH();
+   const V z = this->fMinZ + depth * this->fStepZ;
 
    for (UInt_t i = 1; i < h - 1; ++i) {
       const V y = this->fMinY + i * this->fStepY;
@@ -417,9 +735,9 @@ void TMeshBuilder<D, V>::BuildSlice(SliceType_t *s)const
          cell.fVals[7] = right.fVals[6];
          cell.fType |= (right.fType & k2_6) << 1;
          //Calculate values 2, 6.
-         if((cell.fVals[2] = GetData(j + 1, i + 1, 0)) <= fIso)
+         if((cell.fVals[2] = GetData(j + 1, i + 1, depth)) <= fIso)
             cell.fType |= k2;
-         if((cell.fVals[6] = GetData(j + 1, i + 1, 1)) <= fIso)
+         if((cell.fVals[6] = GetData(j + 1, i + 1, depth + 1)) <= fIso)
             cell.fType |= k6;
 
          const UInt_t edges = eInt[cell.fType];
@@ -447,17 +765,17 @@ void TMeshBuilder<D, V>::BuildSlice(SliceType_t *s)const
          //1, 2, 5, 6, 10.
          const V x = this->fMinX + j * this->fStepX;
          if (edges & k1)
-            SplitEdge(cell, fMesh, 1, x, y, this->fMinZ, fIso);
+            SplitEdge(cell, mesh, 1, x, y, z, fIso);
          if (edges & k2)
-            SplitEdge(cell, fMesh, 2, x, y, this->fMinZ, fIso);
+            SplitEdge(cell, mesh, 2, x, y, z, fIso);
          if (edges & k5)
-            SplitEdge(cell, fMesh, 5, x, y, this->fMinZ, fIso);
+            SplitEdge(cell, mesh, 5, x, y, z, fIso);
          if (edges & k6)
-            SplitEdge(cell, fMesh, 6, x, y, this->fMinZ, fIso);
+            SplitEdge(cell, mesh, 6, x, y, z, fIso);
          if (edges & k10)
-            SplitEdge(cell, fMesh, 10, x, y, this->fMinZ, fIso);
+            SplitEdge(cell, mesh, 10, x, y, z, fIso);
 
-         ConnectTriangles(cell, fMesh, fEpsilon);
+         ConnectTriangles(cell, mesh, fEpsilon);
       }
    }
 }
@@ -465,7 +783,7 @@ void TMeshBuilder<D, V>::BuildSlice(SliceType_t *s)const
 //______________________________________________________________________
 template<class D, class V>
 void TMeshBuilder<D, V>::BuildFirstCube(UInt_t depth, const SliceType_t *prevSlice,
-                                        SliceType_t *slice)const
+                                        SliceType_t *slice, MeshType_t *mesh)const
 {
    //The first cube in a slice with nz == depth.
    //Neighbour is the first cube in the previous slice.
@@ -508,29 +826,29 @@ void TMeshBuilder<D, V>::BuildFirstCube(UInt_t depth, const SliceType_t *prevSli
    const V z = this->fMinZ + depth * this->fStepZ;
 
    if(edges & k4)
-      SplitEdge(cell, fMesh, 4,  this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 4,  this->fMinX, this->fMinY, z, fIso);
    if(edges & k5)
-      SplitEdge(cell, fMesh, 5,  this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 5,  this->fMinX, this->fMinY, z, fIso);
    if(edges & k6)
-      SplitEdge(cell, fMesh, 6,  this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 6,  this->fMinX, this->fMinY, z, fIso);
    if(edges & k7)
-      SplitEdge(cell, fMesh, 7,  this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 7,  this->fMinX, this->fMinY, z, fIso);
    if(edges & k8)
-      SplitEdge(cell, fMesh, 8,  this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 8,  this->fMinX, this->fMinY, z, fIso);
    if(edges & k9)
-      SplitEdge(cell, fMesh, 9,  this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 9,  this->fMinX, this->fMinY, z, fIso);
    if(edges & k10)
-      SplitEdge(cell, fMesh, 10, this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 10, this->fMinX, this->fMinY, z, fIso);
    if(edges & k11)
-      SplitEdge(cell, fMesh, 11, this->fMinX, this->fMinY, z, fIso);
+      SplitEdge(cell, mesh, 11, this->fMinX, this->fMinY, z, fIso);
 
-   ConnectTriangles(cell, fMesh, fEpsilon);
+   ConnectTriangles(cell, mesh, fEpsilon);
 }
 
 //______________________________________________________________________
 template<class D, class V>
 void TMeshBuilder<D, V>::BuildRow(UInt_t depth, const SliceType_t *prevSlice,
-                                  SliceType_t *slice)const
+                                  SliceType_t *slice, MeshType_t *mesh)const
 {
    //Row with ny == 0 and nz == depth, nx : [1, W - 1].
    //Two neighbours: one from previous slice (called bottom cube here),
@@ -588,25 +906,25 @@ void TMeshBuilder<D, V>::BuildRow(UInt_t depth, const SliceType_t *prevSlice,
          const V x = this->fMinX + i * this->fStepX;
 
          if(edges & k4)
-            SplitEdge(cell, fMesh, 4,  x, this->fMinY, z, fIso);
+            SplitEdge(cell, mesh, 4,  x, this->fMinY, z, fIso);
          if(edges & k5)
-            SplitEdge(cell, fMesh, 5,  x, this->fMinY, z, fIso);
+            SplitEdge(cell, mesh, 5,  x, this->fMinY, z, fIso);
          if(edges & k6)
-            SplitEdge(cell, fMesh, 6,  x, this->fMinY, z, fIso);
+            SplitEdge(cell, mesh, 6,  x, this->fMinY, z, fIso);
          if(edges & k9)
-            SplitEdge(cell, fMesh, 9,  x, this->fMinY, z, fIso);
+            SplitEdge(cell, mesh, 9,  x, this->fMinY, z, fIso);
          if(edges & k10)
-            SplitEdge(cell, fMesh, 10, x, this->fMinY, z, fIso);
+            SplitEdge(cell, mesh, 10, x, this->fMinY, z, fIso);
       }
 
-      ConnectTriangles(cell, fMesh, fEpsilon);
+      ConnectTriangles(cell, mesh, fEpsilon);
    }
 }
 
 //______________________________________________________________________
 template<class D, class V>
 void TMeshBuilder<D, V>::BuildCol(UInt_t depth, const SliceType_t *prevSlice,
-                                  SliceType_t *slice)const
+                                  SliceType_t *slice, MeshType_t *mesh)const
 {
    //nz == depth, nx == 0, ny : [1, H - 1].
    //Two neighbours - from previous slice ("bottom" cube)
@@ -660,17 +978,17 @@ void TMeshBuilder<D, V>::BuildCol(UInt_t depth, const SliceType_t *prevSlice,
       const V y = this->fMinY + i * this->fStepY;
       
       if(edges & k5)
-         SplitEdge(cell, fMesh, 5,  this->fMinX, y, z, fIso);
+         SplitEdge(cell, mesh, 5,  this->fMinX, y, z, fIso);
       if(edges & k6)
-         SplitEdge(cell, fMesh, 6,  this->fMinX, y, z, fIso);
+         SplitEdge(cell, mesh, 6,  this->fMinX, y, z, fIso);
       if(edges & k7)
-         SplitEdge(cell, fMesh, 7,  this->fMinX, y, z, fIso);
+         SplitEdge(cell, mesh, 7,  this->fMinX, y, z, fIso);
       if(edges & k10)
-         SplitEdge(cell, fMesh, 10, this->fMinX, y, z, fIso);
+         SplitEdge(cell, mesh, 10, this->fMinX, y, z, fIso);
       if(edges & k11)
-         SplitEdge(cell, fMesh, 11, this->fMinX, y, z, fIso);
+         SplitEdge(cell, mesh, 11, this->fMinX, y, z, fIso);
 
-      ConnectTriangles(cell, fMesh, fEpsilon);
+      ConnectTriangles(cell, mesh, fEpsilon);
    }
 }
 
@@ -678,7 +996,7 @@ void TMeshBuilder<D, V>::BuildCol(UInt_t depth, const SliceType_t *prevSlice,
 //______________________________________________________________________
 template<class D, class V>
 void TMeshBuilder<D, V>::BuildSlice(UInt_t depth, const SliceType_t *prevSlice,
-                                    SliceType_t *slice)const
+                                    SliceType_t *slice, MeshType_t *mesh)const
 {
    //nz == depth, nx : [1, W - 1], ny : [1, H - 1].
    //Each cube has 3 neighbours, "bottom" cube from
@@ -740,13 +1058,13 @@ void TMeshBuilder<D, V>::BuildSlice(UInt_t depth, const SliceType_t *prevSlice,
 
          const V x = this->fMinX + j * this->fStepX;
          if(edges & k5)
-            SplitEdge(cell, fMesh, 5,  x, y, z, fIso);
+            SplitEdge(cell, mesh, 5,  x, y, z, fIso);
          if(edges & k6)
-            SplitEdge(cell, fMesh, 6,  x, y, z, fIso);
+            SplitEdge(cell, mesh, 6,  x, y, z, fIso);
          if(edges & k10)
-            SplitEdge(cell, fMesh, 10, x, y, z, fIso);
+            SplitEdge(cell, mesh, 10, x, y, z, fIso);
 
-         ConnectTriangles(cell, fMesh, fEpsilon);
+         ConnectTriangles(cell, mesh, fEpsilon);
       }
    }
 }
@@ -53,12 +53,21 @@
 // provides notifications of change and destruction.
 // See class TGLPShapeRef which needs to be sub-classes for real use.
 //
+// Shapes whose projected bounding-box is not larger than
+// GetPixelLODSize() pixels are drawn as a single point (kLODPixel). The
+// default is one pixel; raising it speeds up rendering of very large
+// scenes at the price of small shapes degrading to points sooner.
+// Setting it to 0 disables the projection test for shapes not
+// supporting LOD.
+//
 // See base/src/TVirtualViewer3D for description of common external 3D
 // viewer architecture and how external viewer clients use it.
 //
 
 ClassImp(TGLPhysicalShape)
 
+Float_t TGLPhysicalShape::fgPixelLODSize = 1.0f;
+
 //______________________________________________________________________________
 TGLPhysicalShape::TGLPhysicalShape(UInt_t id, const TGLLogicalShape & logicalShape,
                                    const TGLMatrix & transform, Bool_t invertedWind,
@@ -402,10 +411,18 @@ void TGLPhysicalShape::CalculateShapeLOD(TGLRnrCtx& rnrCtx, Float_t& pixSize, Sh
    if (lodAxes == TGLLogicalShape::kLODAxesNone)
    {  // Shape doesn't support LOD along any axes return special
       // unsupported LOD draw/cache flag.
-      // TODO: Still ... could check for kLODPixel when very small,
-      //    by using diagonal from bounding-box and some special camera foo.
-      pixSize  = 100; // Make up something / irrelevant.
-      shapeLOD = TGLRnrCtx::kLODHigh;
+      // Still, if the projected bounding-box is smaller than the pixel
+      // LOD size, the shape is drawn as a point.
+      if (fgPixelLODSize > 0)
+      {
+         pixSize  = rnrCtx.RefCamera().ViewportRect(BoundingBox()).Diagonal();
+         shapeLOD = (pixSize <= fgPixelLODSize) ? (Short_t) TGLRnrCtx::kLODPixel : (Short_t) TGLRnrCtx::kLODHigh;
+      }
+      else
+      {
+         pixSize  = 100; // Make up something / irrelevant.
+         shapeLOD = TGLRnrCtx::kLODHigh;
+      }
       return;
    }
 
@@ -449,7 +466,7 @@ void TGLPhysicalShape::CalculateShapeLOD(TGLRnrCtx& rnrCtx, Float_t& pixSize, Sh
    }
    pixSize = largestDiagonal;
 
-   if (largestDiagonal <= 1.0) {
+   if (largestDiagonal <= fgPixelLODSize) {
       shapeLOD = TGLRnrCtx::kLODPixel;
    } else {
       // TODO: Get real screen size - assuming 2000 pixel screen at present
@@ -279,7 +279,8 @@ TGLScene::TGLScene() :
    fGLCtxIdentity(0),
    fInSmartRefresh(kFALSE),
    fLastPointSizeScale (0),
-   fLastLineWidthScale (0)
+   fLastLineWidthScale (0),
+   fBatchDraw          (kTRUE)
 {}
 
 //______________________________________________________________________________
@@ -350,18 +351,25 @@ inline Bool_t TGLScene::ComparePhysicalVolumes(const TGLPhysicalShape* shape1,
 {
    // Compare 'shape1' and 'shape2' bounding box volumes - return kTRUE if
    // 'shape1' bigger than 'shape2'.
+   // Shapes of equal volume are ordered by logical so that copies of the
+   // same logical end up next to each other and can be drawn in a batch.
 
-   return (shape1->BoundingBox().Volume() > shape2->BoundingBox().Volume());
+   Double_t v1 = shape1->BoundingBox().Volume(), v2 = shape2->BoundingBox().Volume();
+   if (v1 != v2) return v1 > v2;
+   return shape1->GetLogical() < shape2->GetLogical();
 }
 
 //______________________________________________________________________________
 inline Bool_t TGLScene::ComparePhysicalDiagonals(const TGLPhysicalShape* shape1,
                                                  const TGLPhysicalShape* shape2)
 {
-   // Compare 'shape1' and 'shape2' bounding box volumes - return kTRUE if
-   // 'shape1' bigger than 'shape2'.
+   // Compare 'shape1' and 'shape2' bounding box diagonals - return kTRUE if
+   // 'shape1' bigger than 'shape2'. Ties are ordered by logical, see
+   // ComparePhysicalVolumes().
 
-   return (shape1->BoundingBox().Diagonal() > shape2->BoundingBox().Diagonal());
+   Double_t d1 = shape1->BoundingBox().Diagonal(), d2 = shape2->BoundingBox().Diagonal();
+   if (d1 != d2) return d1 > d2;
+   return shape1->GetLogical() < shape2->GetLogical();
 }
 
 //______________________________________________________________________________
@@ -833,43 +841,102 @@ void TGLScene::RenderElements(TGLRnrCtx&           rnrCtx,
    // Render DrawElements in elementVec with given timeout.
    // If clipPlanes is non-zero, test each element against its
    // clipping planes.
+   //
+   // If batch drawing is enabled (default, see SetBatchDraw()),
+   // consecutive elements sharing the same logical shape and LOD are
+   // drawn with a single call to TGLLogicalShape::DrawInstances() and
+   // consecutive elements drawn as pixels with a single GL_POINTS
+   // primitive (except in selection). Highlight rendering is never
+   // batched.
 
    TSceneInfo* sinfo = dynamic_cast<TSceneInfo*>(rnrCtx.GetSceneInfo());
    assert(sinfo != 0);
 
-   Int_t drawCount = 0;
+   const Int_t  kMaxBatch  = 1000;
+   const Bool_t batchDraw  = fBatchDraw && !rnrCtx.Highlight();
+
+   Int_t drawCount = 0, nextCheck = 2000;
 
-   for (DrawElementPtrVec_i i = elVec.begin(); i != elVec.end(); ++i)
+   DrawElementPtrVec_i i = elVec.begin();
+   while (i != elVec.end())
    {
       const TGLPhysicalShape * drawShape = (*i)->fPhysical;
 
-      Bool_t drawNeeded = kTRUE;
-
       // If clipping planes are passed as argument, we test against them.
       if (clipPlanes && IsOutside(drawShape->BoundingBox(), *clipPlanes))
-         drawNeeded = kFALSE;
+      {
+         ++i;
+         continue;
+      }
 
-      // Draw?
-      if (drawNeeded)
+      Short_t lod = (*i)->fFinalLOD;
+      rnrCtx.SetShapeLOD(lod);
+      rnrCtx.SetShapePixSize((*i)->fPixelSize);
+
+      Bool_t asPixel = (lod == TGLRnrCtx::kLODPixel);
+
+      if (batchDraw && !(asPixel && rnrCtx.Selection()))
+      {
+         // Collect following elements that can be drawn together with this one.
+         const TGLLogicalShape *lshp = drawShape->GetLogical();
+         fBatchShapes.clear();
+         fBatchShapes.push_back(drawShape);
+         ++i;
+         while (i != elVec.end() && (Int_t) fBatchShapes.size() < kMaxBatch &&
+                (*i)->fFinalLOD == lod &&
+                (asPixel || (*i)->fPhysical->GetLogical() == lshp))
+         {
+            if ( ! (clipPlanes && IsOutside((*i)->fPhysical->BoundingBox(), *clipPlanes)))
+               fBatchShapes.push_back((*i)->fPhysical);
+            ++i;
+         }
+
+         Int_t n = fBatchShapes.size();
+         if (asPixel)
+         {
+            if (!rnrCtx.IsDrawPassOutlineLine())
+            {
+               glBegin(GL_POINTS);
+               for (Int_t k = 0; k < n; ++k)
+               {
+                  glColor4fv(fBatchShapes[k]->Color());
+                  glVertex3dv(fBatchShapes[k]->GetTranslation().CArr());
+               }
+               glEnd();
+            }
+         }
+         else
+         {
+            glPushName(drawShape->ID());
+            lshp->DrawInstances(rnrCtx, &fBatchShapes[0], n);
+            glPopName();
+         }
+         for (Int_t k = 0; k < n; ++k)
+            sinfo->UpdateDrawStats(*fBatchShapes[k], lod);
+         drawCount += n;
+      }
+      else
       {
-         rnrCtx.SetShapeLOD((*i)->fFinalLOD);
-         rnrCtx.SetShapePixSize((*i)->fPixelSize);
          glPushName(drawShape->ID());
          drawShape->Draw(rnrCtx);
          glPopName();
          ++drawCount;
          sinfo->UpdateDrawStats(*drawShape, rnrCtx.ShapeLOD());
+         ++i;
       }
 
       // Terminate the draw if over opaque fraction timeout.
       // Only test every 2000 objects as this is somewhat costly.
-      if (check_timeout && (drawCount % 2000) == 0 &&
-          rnrCtx.HasStopwatchTimedOut())
+      if (check_timeout && drawCount >= nextCheck)
       {
-         if (rnrCtx.ViewerLOD() == TGLRnrCtx::kLODHigh)
-             Warning("TGLScene::RenderElements",
-                     "Timeout reached, not all elements rendered.");
-         break;
+         nextCheck = drawCount + 2000;
+         if (rnrCtx.HasStopwatchTimedOut())
+         {
+            if (rnrCtx.ViewerLOD() == TGLRnrCtx::kLODHigh)
+               Warning("TGLScene::RenderElements",
+                       "Timeout reached, not all elements rendered.");
+            break;
+         }
       }
    }
 }
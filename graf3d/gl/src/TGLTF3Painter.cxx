@@ -27,6 +27,28 @@
 #include "TGLTF3Painter.h"
 #include "TGLIncludes.h"
 
+namespace {
+
+//______________________________________________________________________________
+template<class H>
+void BuildIsoMeshes(const H *hist, const Rgl::Mc::TGridGeometry<Float_t> &geom,
+                    const std::vector<Double_t> &levels,
+                    const std::vector<Rgl::Mc::TIsoMesh<Float_t> *> &meshes)
+{
+   //The first mesh is built from scratch, the next ones reuse
+   //min/max of histogram's layers and skip layers, which can
+   //not be intersected by iso-surface.
+   Rgl::Mc::TMeshBuilder<H, Float_t> builder(kTRUE);
+   for (UInt_t i = 0; i < meshes.size(); ++i) {
+      if (!i)
+         builder.BuildMesh(hist, geom, meshes[i], levels[i]);
+      else
+         builder.UpdateMesh(meshes[i], levels[i]);
+   }
+}
+
+}
+
 //______________________________________________________________________________
 //
 // Plot-painter for TF3 functions.
@@ -438,28 +460,29 @@ Bool_t TGLIsoPainter::InitGeometry()
    }
 
    MeshIter_t firstMesh = fCache.begin();
+   //Meshes for fColorLevels[i].
+   std::vector<Mesh_t *> meshes(nContours);
    //Initialize meshes, trying to reuse mesh from
    //mesh cache.
    for (UInt_t i = 0; i < nContours; ++i) {
       if (firstMesh != fCache.end()) {
          //There is a mesh in a chache.
-         SetMesh(*firstMesh, fColorLevels[i]);
+         meshes[i] = &*firstMesh;
          MeshIter_t next = firstMesh;
          ++next;
          fIsos.splice(fIsos.begin(), fCache, firstMesh);
          firstMesh = next;
       } else {
          //No meshes in a cache.
-         //Create new one and _swap_ data (look at Mesh_t::Swap in a header)
-         //between empty mesh in a list and this mesh
-         //to avoid real copying.
-         Mesh_t newMesh;
-         SetMesh(newMesh, fColorLevels[i]);
+         //Add an empty mesh into the list, list's
+         //nodes are not moved, so pointer is valid.
          fIsos.push_back(fDummyMesh);
-         fIsos.back().Swap(newMesh);
+         meshes[i] = &fIsos.back();
       }
    }
 
+   SetMeshes(meshes);
+
    if (fCoord->Modified()) {
       fUpdateSelection = kTRUE;
       fXOZSectionPos = fBackBox.Get3DBox()[0].Y();
@@ -691,30 +714,26 @@ void TGLIsoPainter::SetSurfaceColor(Int_t ind) const
 }
 
 //______________________________________________________________________________
-void TGLIsoPainter::SetMesh(Mesh_t &m, Double_t isoValue)
+void TGLIsoPainter::SetMeshes(const std::vector<Mesh_t *> &meshes)
 {
+   //Build meshes for iso levels.
    //Grid geometry.
    Rgl::Mc::TGridGeometry<Float_t> geom(fXAxis, fYAxis, fZAxis, fCoord->GetXScale(),
                                         fCoord->GetYScale(), fCoord->GetZScale());
-   //Clear mesh if it was from cache.
-   m.ClearMesh();
+   //Clear meshes if they are from cache.
+   for (UInt_t i = 0; i < meshes.size(); ++i)
+      meshes[i]->ClearMesh();
    //Select correct TMeshBuilder type.
-   if (typeid(*fHist) == typeid(TH3C)) {
-      Rgl::Mc::TMeshBuilder<TH3C, Float_t> builder(kTRUE);
-      builder.BuildMesh(static_cast<TH3C *>(fHist), geom, &m, isoValue);
-   } else if (typeid(*fHist) == typeid(TH3S)) {
-      Rgl::Mc::TMeshBuilder<TH3S, Float_t> builder(kTRUE);
-      builder.BuildMesh(static_cast<TH3S *>(fHist), geom, &m, isoValue);
-   } else if (typeid(*fHist) == typeid(TH3I)) {
-      Rgl::Mc::TMeshBuilder<TH3I, Float_t> builder(kTRUE);
-      builder.BuildMesh(static_cast<TH3I *>(fHist), geom, &m, isoValue);
-   } else if (typeid(*fHist) == typeid(TH3F)) {
-      Rgl::Mc::TMeshBuilder<TH3F, Float_t> builder(kTRUE);
-      builder.BuildMesh(static_cast<TH3F *>(fHist), geom, &m, isoValue);
-   } else if (typeid(*fHist) == typeid(TH3D)) {
-      Rgl::Mc::TMeshBuilder<TH3D, Float_t> builder(kTRUE);
-      builder.BuildMesh(static_cast<TH3D *>(fHist), geom, &m, isoValue);
-   }
+   if (typeid(*fHist) == typeid(TH3C))
+      BuildIsoMeshes(static_cast<TH3C *>(fHist), geom, fColorLevels, meshes);
+   else if (typeid(*fHist) == typeid(TH3S))
+      BuildIsoMeshes(static_cast<TH3S *>(fHist), geom, fColorLevels, meshes);
+   else if (typeid(*fHist) == typeid(TH3I))
+      BuildIsoMeshes(static_cast<TH3I *>(fHist), geom, fColorLevels, meshes);
+   else if (typeid(*fHist) == typeid(TH3F))
+      BuildIsoMeshes(static_cast<TH3F *>(fHist), geom, fColorLevels, meshes);
+   else if (typeid(*fHist) == typeid(TH3D))
+      BuildIsoMeshes(static_cast<TH3D *>(fHist), geom, fColorLevels, meshes);
 }
 
 //______________________________________________________________________________
@@ -137,6 +137,14 @@ void TKDEAdapter::FetchDensities()const
    fDE->Predict(fGrid, fDensities, fE);
 }
 
+//______________________________________________________________________________
+Bool_t TKDEAdapter::IsThreadSafe()const
+{
+   //Densities are estimated by FetchDensities, GetData only
+   //reads them.
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 Float_t TKDEAdapter::GetData(UInt_t i, UInt_t j, UInt_t k)const
 {
@@ -76,6 +76,7 @@ protected:
    Int_t  CheckByteCount(UInt_t startpos, UInt_t bcnt, const TClass *clss, const char* classname);
    void   CheckCount(UInt_t offset);
    UInt_t CheckObject(UInt_t offset, const TClass *cl, Bool_t readClass = kFALSE);
+   Bool_t UseCompiledStreamer(const TClass *cl, TStreamerInfo *sinfo) const;
 
    virtual  void  WriteObjectClass(const void *actualObjStart, const TClass *actualClass);
 
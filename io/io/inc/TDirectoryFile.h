@@ -33,6 +33,8 @@ class TFile;
 class TDirectoryFile : public TDirectory {
 
 protected:
+   class TKeysRecord;            //Keys record not yet unpacked, defined in TDirectoryFile.cxx
+
    Bool_t      fModified;        //true if directory has been modified
    Bool_t      fWritable;        //true if directory is writable
    TDatime     fDatimeC;         //Date and time when directory is created
@@ -45,9 +47,12 @@ protected:
    Long64_t    fSeekKeys;        //Location of Keys record on file
    TFile      *fFile;            //pointer to current file in memory
    TList      *fKeys;            //Pointer to keys list in memory
+   mutable TKeysRecord *fKeysRecord; //!Keys record read by ReadKeys, not yet unpacked in fKeys
 
    virtual void         CleanTargets();
+   TKey                *FindKeyCycle(const char *name, Short_t cycle, Bool_t exact) const;
    void Init(TClass *cl = 0);
+   void                 UnpackKeys() const;
 
 private:
    TDirectoryFile(const TDirectoryFile &directory);  //Directories cannot be copied
@@ -88,10 +93,10 @@ public:
    const TDatime      &GetCreationDate() const { return fDatimeC; }
    virtual TFile      *GetFile() const { return fFile; }
    virtual TKey       *GetKey(const char *name, Short_t cycle=9999) const;
-   virtual TList      *GetListOfKeys() const { return fKeys; }
+   virtual TList      *GetListOfKeys() const { if (fKeysRecord) UnpackKeys(); return fKeys; }
    const TDatime      &GetModificationDate() const { return fDatimeM; }
    virtual Int_t       GetNbytesKeys() const { return fNbytesKeys; }
-   virtual Int_t       GetNkeys() const { return fKeys->GetSize(); }
+   virtual Int_t       GetNkeys() const;
    virtual Long64_t    GetSeekDir() const { return fSeekDir; }
    virtual Long64_t    GetSeekParent() const { return fSeekParent; }
    virtual Long64_t    GetSeekKeys() const { return fSeekKeys; }
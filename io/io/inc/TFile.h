@@ -65,7 +65,7 @@ protected:
    Int_t            fNbytesFree;     //Number of bytes for free segments structure
    Int_t            fNbytesInfo;     //Number of bytes for StreamerInfo record
    Int_t            fWritten;        //Number of objects written so far
-   Int_t            fNProcessIDs;    //Number of TProcessID written to this file
+   mutable Int_t    fNProcessIDs;    //Number of TProcessID written to this file (-1 until counted)
    Int_t            fReadCalls;      //Number of read calls ( not counting the cache calls )
    TString          fRealName;       //Effective real file name (not original url)
    TString          fOption;         //File options
@@ -187,7 +187,7 @@ public:
    TObjArray          *GetListOfProcessIDs() const {return fProcessIDs;}
    TList              *GetListOfFree() const { return fFree; }
    virtual Int_t       GetNfree() const { return fFree->GetSize(); }
-   virtual Int_t       GetNProcessIDs() const { return fNProcessIDs; }
+   virtual Int_t       GetNProcessIDs() const;
    Option_t           *GetOption() const { return fOption.Data(); }
    virtual Long64_t    GetBytesRead() const { return fBytesRead; }
    virtual Long64_t    GetBytesReadExtra() const { return fBytesReadExtra; }
@@ -204,7 +204,7 @@ public:
    virtual Long64_t    GetSize() const;
    virtual TList      *GetStreamerInfoList();
    const   TList      *GetStreamerInfoCache();
-   virtual void        IncrementProcessIDs() { fNProcessIDs++; }
+   virtual void        IncrementProcessIDs();
    virtual Bool_t      IsArchive() const { return fIsArchive; }
            Bool_t      IsBinary() const { return TestBit(kBinaryFile); }
            Bool_t      IsRaw() const { return !fIsRootFile; }
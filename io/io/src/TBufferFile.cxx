@@ -3459,6 +3459,22 @@ Int_t TBufferFile::ReadClassEmulated(const TClass *cl, void *object, const TClas
    return 0;
 }
 
+//______________________________________________________________________________
+Bool_t TBufferFile::UseCompiledStreamer(const TClass *cl, TStreamerInfo *sinfo) const
+{
+   // Return true if the object can be streamed with the streamer generated
+   // by rootcint for the current layout of the class (see
+   // TClass::SetCompiledStreamerInit), i.e. if sinfo is the StreamerInfo of
+   // the current class version and has the checksum of the class. The text
+   // based buffers (XML, SQL) need the StreamerInfo elements and always use
+   // the generic path.
+
+   if (TestBit(kTextBasedStreaming)) return kFALSE;
+   if (sinfo != const_cast<TClass*>(cl)->GetCurrentStreamerInfo()) return kFALSE;
+   if (sinfo->GetCheckSum() != cl->GetCheckSum()) return kFALSE;
+   return cl->GetCompiledStreamerFunc() != 0;
+}
+
 //______________________________________________________________________________
 Int_t TBufferFile::ReadClassBuffer(const TClass *cl, void *pointer, Int_t version, UInt_t start, UInt_t count, const TClass *onFileClass)
 {
@@ -3529,8 +3545,12 @@ Int_t TBufferFile::ReadClassBuffer(const TClass *cl, void *pointer, Int_t versio
    }
 
    // Deserialize the object.
-   ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer);
-   if (sinfo->IsRecovered()) count=0;
+   if (!onFileClass && UseCompiledStreamer(cl, sinfo)) {
+      (*cl->GetCompiledStreamerFunc())(*this, pointer);
+   } else {
+      ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer);
+      if (sinfo->IsRecovered()) count=0;
+   }
 
    // Check that the buffer position corresponds to the byte count.
    CheckByteCount(start, count, cl);
@@ -3625,8 +3645,12 @@ Int_t TBufferFile::ReadClassBuffer(const TClass *cl, void *pointer, const TClass
    }
 
    //deserialize the object
-   ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer );
-   if (sinfo->TStreamerInfo::IsRecovered()) R__c=0; // 'TStreamerInfo::' avoids going via a virtual function.
+   if (!onFileClass && !v2file && UseCompiledStreamer(cl, sinfo)) {
+      (*cl->GetCompiledStreamerFunc())(*this, pointer);
+   } else {
+      ApplySequence(*(sinfo->GetReadObjectWiseActions()), (char*)pointer );
+      if (sinfo->TStreamerInfo::IsRecovered()) R__c=0; // 'TStreamerInfo::' avoids going via a virtual function.
+   }
 
    // Check that the buffer position corresponds to the byte count.
    CheckByteCount(R__s, R__c, cl);
@@ -3664,7 +3688,11 @@ Int_t TBufferFile::WriteClassBuffer(const TClass *cl, void *pointer)
 
    //NOTE: In the future Philippe wants this to happen via a custom action
    TagStreamerInfo(sinfo);
-   ApplySequence(*(sinfo->GetWriteObjectWiseActions()), (char*)pointer);
+   if (UseCompiledStreamer(cl, sinfo)) {
+      (*cl->GetCompiledStreamerFunc())(*this, pointer);
+   } else {
+      ApplySequence(*(sinfo->GetWriteObjectWiseActions()), (char*)pointer);
+   }
 
 
    //write the byte count at the start of the buffer
@@ -33,6 +33,8 @@
 #include "TClassTable.h"
 #include "TInterpreter.h"
 #include "THashList.h"
+#include "TFlatHashList.h"
+#include "TExMap.h"
 #include "TBrowser.h"
 #include "TFree.h"
 #include "TKey.h"
@@ -52,12 +54,157 @@ const Int_t  kMaxLen = 2048;
 
 ClassImp(TDirectoryFile)
 
+//______________________________________________________________________________
+class TDirectoryFile::TKeysRecord {
+   // Keys record read by ReadKeys. The headers of the keys are indexed by
+   // the hash of their name without creating the TKey objects: the TKey of
+   // a key is only created when this key is looked up (FindKeyCycle), or
+   // when the whole list of keys is needed (UnpackKeys).
+
+private:
+   TKeysRecord(const TKeysRecord&);            // not implemented
+   TKeysRecord &operator=(const TKeysRecord&); // not implemented
+
+public:
+   TKey     *fHeader;   // the keys record, its buffer holds the key headers
+   Int_t     fNkeys;    // number of valid keys in the record
+   Int_t     fNpacked;  // number of keys without a TKey yet
+   Int_t    *fOffsets;  // [fNkeys] offsets of the key headers in the buffer
+   Int_t    *fNames;    // [fNkeys] offsets of the key names in the buffer
+   Int_t    *fLengths;  // [fNkeys] lengths of the key names
+   Short_t  *fCycles;   // [fNkeys] cycles of the keys
+   Int_t    *fNext;     // [fNkeys] previous key with the same name hash, -1 at the end
+   TKey    **fKeys;     // [fNkeys] TKey created for each key, 0 if not yet
+   TExMap    fIndex;    // name hash -> 1 + last key with this hash
+
+   TKeysRecord(TKey *header, Int_t nkeys, Long64_t fsize);
+   ~TKeysRecord();
+
+   static UInt_t Hash(const char *name, Int_t len) { return TString::Hash(name, len); }
+   Int_t     First(const char *name, Int_t len) { return (Int_t)fIndex.GetValue(Hash(name, len), Hash(name, len)) - 1; }
+   Bool_t    IsName(Int_t i, const char *name, Int_t len) const {
+      return fLengths[i] == len && !memcmp(fHeader->GetBuffer() + fNames[i], name, len);
+   }
+   TKey     *Unpack(Int_t i, TDirectoryFile *dir);
+};
+
+//______________________________________________________________________________
+static Int_t ReadKeyString(char *&buffer)
+{
+   // Skip a string written by TString::FillBuffer, return its length.
+
+   UChar_t nwh;
+   Int_t   nchars;
+   frombuf(buffer, &nwh);
+   if (nwh == 255)
+      frombuf(buffer, &nchars);
+   else
+      nchars = nwh;
+   if (nchars < 0) nchars = 0;
+   buffer += nchars;
+   return nchars;
+}
+
+//______________________________________________________________________________
+TDirectoryFile::TKeysRecord::TKeysRecord(TKey *header, Int_t nkeys, Long64_t fsize)
+   : fHeader(header), fNkeys(0), fNpacked(0), fIndex(2*nkeys)
+{
+   // Index the nkeys key headers following the record header in the buffer
+   // of header, which is adopted. As in the TKey objects, the 16 highest
+   // bits of the directory position hold the pid offset (see
+   // TKey::ReadKeyBuffer). The keys from the first one pointing outside of
+   // the file are ignored.
+
+   fOffsets = new Int_t[nkeys];
+   fNames   = new Int_t[nkeys];
+   fLengths = new Int_t[nkeys];
+   fCycles  = new Short_t[nkeys];
+   fNext    = new Int_t[nkeys];
+   fKeys    = new TKey*[nkeys];
+
+   char *start = fHeader->GetBuffer();
+   char *buffer = start;
+   fHeader->ReadKeyBuffer(buffer);
+   Int_t n;
+   frombuf(buffer, &n);
+
+   Int_t nbytes, objlen;
+   UInt_t datime;
+   Version_t version;
+   Short_t keylen, cycle;
+   Long64_t seekkey, seekpdir;
+   for (Int_t i = 0; i < nkeys; i++) {
+      fOffsets[i] = buffer - start;
+      frombuf(buffer, &nbytes);
+      frombuf(buffer, &version);
+      frombuf(buffer, &objlen);
+      frombuf(buffer, &datime);
+      frombuf(buffer, &keylen);
+      frombuf(buffer, &cycle);
+      if (version > 1000) {
+         frombuf(buffer, &seekkey);
+         frombuf(buffer, &seekpdir);
+         seekpdir &= ((((Long64_t)1) << 48) - 1);
+      } else {
+         Int_t skey, sdir;
+         frombuf(buffer, &skey); seekkey  = (Long64_t)skey;
+         frombuf(buffer, &sdir); seekpdir = (Long64_t)sdir;
+      }
+      if (seekkey < 64 || seekkey > fsize || seekpdir < 64 || seekpdir > fsize) {
+         ::Error("TDirectoryFile::ReadKeys","reading illegal key, exiting after %d keys",i);
+         break;
+      }
+      ReadKeyString(buffer);               // class name
+      fNames[i]   = buffer - start;
+      fLengths[i] = ReadKeyString(buffer);
+      fNames[i]  += fLengths[i] < 255 ? 1 : 5;
+      ReadKeyString(buffer);               // title
+      fCycles[i]  = cycle;
+      fKeys[i]    = 0;
+
+      UInt_t hash = Hash(start + fNames[i], fLengths[i]);
+      Long64_t &last = fIndex(hash, hash);
+      fNext[i] = (Int_t)last - 1;
+      last = i + 1;
+      fNkeys++;
+   }
+   fNpacked = fNkeys;
+}
+
+//______________________________________________________________________________
+TDirectoryFile::TKeysRecord::~TKeysRecord()
+{
+   // Delete the record. The TKey objects created are owned by the list of
+   // keys of the directory.
+
+   delete fHeader;
+   delete [] fOffsets;
+   delete [] fNames;
+   delete [] fLengths;
+   delete [] fCycles;
+   delete [] fNext;
+   delete [] fKeys;
+}
+
+//______________________________________________________________________________
+TKey *TDirectoryFile::TKeysRecord::Unpack(Int_t i, TDirectoryFile *dir)
+{
+   // Return the TKey of the i-th key, create it if needed.
+
+   if (fKeys[i]) return fKeys[i];
+   char *buffer = fHeader->GetBuffer() + fOffsets[i];
+   fKeys[i] = new TKey(dir);
+   fKeys[i]->ReadKeyBuffer(buffer);
+   fNpacked--;
+   return fKeys[i];
+}
+
 
 //______________________________________________________________________________
 TDirectoryFile::TDirectoryFile() : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeysRecord(0)
 {
 //*-*-*-*-*-*-*-*-*-*-*-*Directory default constructor-*-*-*-*-*-*-*-*-*-*-*-*
 //*-*                    =============================
@@ -68,7 +215,7 @@ TDirectoryFile::TDirectoryFile(const char *name, const char *title, Option_t *cl
            : TDirectory()
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeysRecord(0)
 {
 //*-*-*-*-*-*-*-*-*-*-*-* Create a new DirectoryFile *-*-*-*-*-*-*-*-*-*-*-*-*-*
 //*-*                     ==========================
@@ -162,7 +309,7 @@ void TDirectoryFile::Init(TClass *cl)
 TDirectoryFile::TDirectoryFile(const TDirectoryFile & directory) : TDirectory(directory)
    , fModified(kFALSE), fWritable(kFALSE), fNbytesKeys(0), fNbytesName(0)
    , fBufferSize(0), fSeekDir(0), fSeekParent(0), fSeekKeys(0)
-   , fFile(0), fKeys(0)
+   , fFile(0), fKeys(0), fKeysRecord(0)
 {
    // Copy constructor.
    ((TDirectoryFile&)directory).Copy(*this);
@@ -173,6 +320,7 @@ TDirectoryFile::~TDirectoryFile()
 {
    // -- Destructor.
 
+   SafeDelete(fKeysRecord);
    if (fKeys) {
       fKeys->Delete("slow");
       SafeDelete(fKeys);
@@ -213,6 +361,7 @@ Int_t TDirectoryFile::AppendKey(TKey *key)
    fModified = kTRUE;
 
    key->SetMotherDir(this);
+   if (fKeysRecord) UnpackKeys();
 
    // This is a fast hash lookup in case the key does not already exist
    TKey *oldkey = (TKey*)fKeys->FindObject(key->GetName());
@@ -246,7 +395,7 @@ void TDirectoryFile::Browse(TBrowser *b)
       TObject *obj = 0;
       TIter nextin(fList);
       TKey *key = 0, *keyo = 0;
-      TIter next(fKeys);
+      TIter next(GetListOfKeys());
 
       cd();
 
@@ -301,7 +450,7 @@ void TDirectoryFile::Build(TFile* motherFile, TDirectory* motherDir)
    fSeekParent = 0;
    fSeekKeys   = 0;
    fList       = new THashList(100,50);
-   fKeys       = new THashList(100,50);
+   fKeys       = new TFlatHashList(100);
    fMother     = motherDir;
    fFile       = motherFile ? motherFile : TFile::CurrentFile();
    SetBit(kCanDelete);
@@ -543,6 +692,7 @@ void TDirectoryFile::Close(Option_t *)
    else      fList->Delete("slow");
 
    // Delete keys from key list (but don't delete the list header)
+   SafeDelete(fKeysRecord);
    if (fKeys) {
       fKeys->Delete("slow");
    }
@@ -662,7 +812,7 @@ void TDirectoryFile::Delete(const char *namecycle)
                }
 
                key->Delete();
-               fKeys->Remove(key);
+               GetListOfKeys()->Remove(key);
                fModified = kTRUE;
                delete key;
             }
@@ -716,6 +866,61 @@ TKey *TDirectoryFile::FindKey(const char *keyname) const
    return GetKey(name,cycle);
 }
 
+//______________________________________________________________________________
+TKey *TDirectoryFile::FindKeyCycle(const char *name, Short_t cycle, Bool_t exact) const
+{
+   // Return the key with the given name and cycle if exact is true, else
+   // the key with the highest cycle lower or equal to cycle (the highest
+   // cycle when cycle is 9999). The index of the list of keys is used to
+   // only look at the keys with this name. The keys of the keys record not
+   // yet unpacked are looked up in its own index, and only the TKey of the
+   // key found is created.
+
+   if (!fKeys || !name) return 0;
+
+   TKey *found = 0;
+   TKey *key;
+   TFlatHashList *index = dynamic_cast<TFlatHashList*>(fKeys);
+   if (index) {
+      Int_t slot = -1;
+      while ((key = (TKey*)index->FindNext(name, slot))) {
+         Short_t kc = key->GetCycle();
+         if (exact ? (kc == cycle) : (cycle == 9999 || kc <= cycle)) {
+            if (!found || kc > found->GetCycle()) found = key;
+         }
+      }
+   } else {
+      TIter next(fKeys);
+      while ((key = (TKey *) next())) {
+         if (strcmp(name, key->GetName())) continue;
+         Short_t kc = key->GetCycle();
+         if (exact ? (kc == cycle) : (cycle == 9999 || kc <= cycle)) {
+            if (!found || kc > found->GetCycle()) found = key;
+         }
+      }
+   }
+   if (!fKeysRecord) return found;
+
+   // The keys of the record already unpacked are in fKeys.
+   TKeysRecord *record = fKeysRecord;
+   Int_t len = strlen(name);
+   Int_t best = -1;
+   for (Int_t i = record->First(name, len); i >= 0; i = record->fNext[i]) {
+      if (record->fKeys[i] || !record->IsName(i, name, len)) continue;
+      Short_t kc = record->fCycles[i];
+      if (exact ? (kc == cycle) : (cycle == 9999 || kc <= cycle)) {
+         if (best < 0 ? (!found || kc > found->GetCycle()) : kc > record->fCycles[best]) best = i;
+      }
+   }
+   if (best < 0) return found;
+
+   TDirectoryFile *dir = const_cast<TDirectoryFile*>(this);
+   TDirectory::TContext ctxt(dir);
+   found = record->Unpack(best, dir);
+   fKeys->Add(found);
+   return found;
+}
+
 //______________________________________________________________________________
 TKey *TDirectoryFile::FindKeyAny(const char *keyname) const
 {
@@ -877,16 +1082,10 @@ TObject *TDirectoryFile::Get(const char *namecycle)
 
 //*-*---------------------Case of Key---------------------
 //                        ===========
-   TKey *key;
-   TIter nextkey(GetListOfKeys());
-   while ((key = (TKey *) nextkey())) {
-      if (strcmp(namobj,key->GetName()) == 0) {
-         if ((cycle == 9999) || (cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            idcur = key->ReadObj();
-            break;
-         }
-      }
+   TKey *key = FindKeyCycle(namobj, cycle, cycle != 9999);
+   if (key) {
+      TDirectory::TContext ctxt(this);
+      idcur = key->ReadObj();
    }
 
    return idcur;
@@ -986,16 +1185,10 @@ void *TDirectoryFile::GetObjectChecked(const char *namecycle, const TClass* expe
 //*-*---------------------Case of Key---------------------
 //                        ===========
    void *idcur = 0;
-   TKey *key;
-   TIter nextkey(GetListOfKeys());
-   while ((key = (TKey *) nextkey())) {
-      if (strcmp(namobj,key->GetName()) == 0) {
-         if ((cycle == 9999) || (cycle == key->GetCycle())) {
-            TDirectory::TContext ctxt(this);
-            idcur = key->ReadObjectAny(expectedClass);
-            break;
-         }
-      }
+   TKey *key = FindKeyCycle(namobj, cycle, cycle != 9999);
+   if (key) {
+      TDirectory::TContext ctxt(this);
+      idcur = key->ReadObjectAny(expectedClass);
    }
 
    return idcur;
@@ -1019,15 +1212,9 @@ TKey *TDirectoryFile::GetKey(const char *name, Short_t cycle) const
 //*-*-*-*-*-*-*-*-*-*-*Return pointer to key with name,cycle*-*-*-*-*-*-*-*
 //*-*                  =====================================
 //  if cycle = 9999 returns highest cycle
+//  otherwise returns the highest cycle lower or equal to cycle.
 //
-   TKey *key;
-   TIter next(GetListOfKeys());
-   while ((key = (TKey *) next()))
-      if (!strcmp(name, key->GetName())) {
-         if (cycle == 9999)             return key;
-         if (cycle >= key->GetCycle())  return key;
-      }
-   return 0;
+   return FindKeyCycle(name, cycle, kFALSE);
 }
 
 //______________________________________________________________________________
@@ -1226,9 +1413,24 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
 //  This is an efficient way (without opening/closing files) to view
 //  the latest updates of a file being modified by another process
 //  as it is typically the case in a data acquisition system.
+//
+//  Only the keys record is read here, and its keys indexed by name: the
+//  TKey of a key is created when it is looked up by Get or GetKey, and all
+//  of them the first time the list of keys is needed (see UnpackKeys), so
+//  that opening a file or a directory with many keys is cheap when only a
+//  few of them are used. The returned value is the number of keys in the
+//  record.
 
    if (fFile==0) return 0;
 
+   // A keys record still pending is dropped with the keys when they are
+   // read again, else its keys are kept in front of the ones read now.
+   if (forceRead) {
+      SafeDelete(fKeysRecord);
+   } else if (fKeysRecord) {
+      UnpackKeys();
+   }
+
    if (!fFile->IsBinary())
       return fFile->DirReadKeys(this);
 
@@ -1265,33 +1467,17 @@ Int_t TDirectoryFile::ReadKeys(Bool_t forceRead)
    }
    
    Int_t nkeys = 0;
-   Long64_t fsize = fFile->GetSize();
    if ( fSeekKeys >  0) {
       TKey *headerkey    = new TKey(fSeekKeys, fNbytesKeys, this);
       headerkey->ReadFile();
       buffer = headerkey->GetBuffer();
       headerkey->ReadKeyBuffer(buffer);
-
-      TKey *key;
       frombuf(buffer, &nkeys);
-      for (Int_t i = 0; i < nkeys; i++) {
-         key = new TKey(this);
-         key->ReadKeyBuffer(buffer);
-         if (key->GetSeekKey() < 64 || key->GetSeekKey() > fsize) {
-            Error("ReadKeys","reading illegal key, exiting after %d keys",i);
-            fKeys->Remove(key);
-            nkeys = i;
-            break;
-         }
-         if (key->GetSeekPdir() < 64 || key->GetSeekPdir() > fsize) {
-            Error("ReadKeys","reading illegal key, exiting after %d keys",i);
-            fKeys->Remove(key);
-            nkeys = i;
-            break;
-         }
-         fKeys->Add(key);
+      if (nkeys > 0) {
+         fKeysRecord = new TKeysRecord(headerkey, nkeys, fFile->GetSize());
+      } else {
+         delete headerkey;
       }
-      delete headerkey;
    }
 
    return nkeys;
@@ -1341,7 +1527,7 @@ void TDirectoryFile::ResetAfterMerge(TFileMergeInfo *info)
    fSeekParent = 0; // updated by Init
    fSeekKeys = 0;   // updated by Init
    // Does not change: fFile
-   TKey *key = (TKey*)fKeys->FindObject(fName);
+   TKey *key = (TKey*)GetListOfKeys()->FindObject(fName);
    TClass *cl = IsA();
    if (key) {
       cl = TClass::GetClass(key->GetClassName());
@@ -1655,6 +1841,44 @@ void TDirectoryFile::Streamer(TBuffer &b)
    }
 }
 
+//______________________________________________________________________________
+void TDirectoryFile::UnpackKeys() const
+{
+   // Create the TKey objects of the keys record read by ReadKeys which were
+   // not created yet by FindKeyCycle, and add them to the list of keys, in
+   // the order of the record. The list index is sized for all the keys at
+   // once.
+
+   if (!fKeysRecord) return;
+
+   TKeysRecord *record = fKeysRecord;
+   fKeysRecord = 0;
+
+   TDirectoryFile *dir = const_cast<TDirectoryFile*>(this);
+   TDirectory::TContext ctxt(dir);
+
+   TFlatHashList *index = dynamic_cast<TFlatHashList*>(fKeys);
+   if (index) index->Rehash(fKeys->GetSize() + record->fNpacked);
+
+   TKey *key;
+   for (Int_t i = 0; i < record->fNkeys; i++) {
+      key = record->fKeys[i];
+      if (key) fKeys->Remove(key);
+      else     key = record->Unpack(i, dir);
+      fKeys->Add(key);
+   }
+   delete record;
+}
+
+//______________________________________________________________________________
+Int_t TDirectoryFile::GetNkeys() const
+{
+   // Return the number of keys, including the ones of the keys record
+   // which are not unpacked yet.
+
+   return fKeys->GetSize() + (fKeysRecord ? fKeysRecord->fNpacked : 0);
+}
+
 //______________________________________________________________________________
 Int_t TDirectoryFile::Write(const char *, Int_t opt, Int_t bufsize)
 {
@@ -1800,7 +2024,7 @@ Int_t TDirectoryFile::WriteTObject(const TObject *obj, const char *name, Option_
    if (newName) delete [] newName;
 
    if (!key->GetSeekKey()) {
-      fKeys->Remove(key);
+      GetListOfKeys()->Remove(key);
       delete key;
       if (bufsize) fFile->SetBufferSize(bufsize);
       return 0;
@@ -1924,7 +2148,7 @@ Int_t TDirectoryFile::WriteObjectAny(const void *obj, const TClass *cl, const ch
    if (newName) delete [] newName;
 
    if (!key->GetSeekKey()) {
-      fKeys->Remove(key);
+      GetListOfKeys()->Remove(key);
       delete key;
       return 0;
    }
@@ -1988,7 +2212,7 @@ void TDirectoryFile::WriteKeys()
       f->MakeFree(fSeekKeys, fSeekKeys + fNbytesKeys -1);
    }
 //*-* Write new keys record
-   TIter next(fKeys);
+   TIter next(GetListOfKeys());
    TKey *key;
    Int_t nkeys  = fKeys->GetSize();
    Int_t nbytes = sizeof nkeys;          //*-* Compute size of all keys
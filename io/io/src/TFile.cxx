@@ -779,15 +779,10 @@ void TFile::Init(Bool_t create)
       }
    }
 
-   // Count number of TProcessIDs in this file
-   {
-      TIter next(fKeys);
-      TKey *key;
-      while ((key = (TKey*)next())) {
-         if (!strcmp(key->GetClassName(),"TProcessID")) fNProcessIDs++;
-      }
-      fProcessIDs = new TObjArray(fNProcessIDs+1);
-   }
+   // The number of TProcessIDs in this file is counted when first needed
+   // (see GetNProcessIDs) so that the keys are not unpacked here.
+   fNProcessIDs = -1;
+   fProcessIDs  = new TObjArray(10);
    return;
 
 zombie:
@@ -1090,6 +1085,24 @@ TFileCacheWrite *TFile::GetCacheWrite() const
    return fCacheWrite;
 }
 
+//______________________________________________________________________________
+Int_t TFile::GetNProcessIDs() const
+{
+   // Return the number of TProcessIDs written to this file.
+   // For a file being read, the keys are scanned the first time.
+
+   if (fNProcessIDs < 0) {
+      Int_t npids = 0;
+      TIter next(GetListOfKeys());
+      TKey *key;
+      while ((key = (TKey*)next())) {
+         if (!strcmp(key->GetClassName(),"TProcessID")) npids++;
+      }
+      fNProcessIDs = npids;
+   }
+   return fNProcessIDs;
+}
+
 //______________________________________________________________________________
 Int_t TFile::GetRecordHeader(char *buf, Long64_t first, Int_t maxbytes, Int_t &nbytes, Int_t &objlen, Int_t &keylen)
 {
@@ -1224,6 +1237,15 @@ void TFile::ls(Option_t *option) const
    TROOT::DecreaseDirLevel();
 }
 
+//______________________________________________________________________________
+void TFile::IncrementProcessIDs()
+{
+   // Increment the number of TProcessIDs written to this file.
+
+   if (fNProcessIDs < 0) GetNProcessIDs();
+   fNProcessIDs++;
+}
+
 //______________________________________________________________________________
 Bool_t TFile::IsOpen() const
 {
@@ -1612,10 +1634,7 @@ TProcessID  *TFile::ReadProcessID(UShort_t pidf)
    TProcessID *pid = 0;
    TObjArray *pids = GetListOfProcessIDs();
    if (pidf < pids->GetSize()) pid = (TProcessID *)pids->UncheckedAt(pidf);
-   if (pid) {
-      pid->CheckInit();
-      return pid;
-   }
+   if (pid) return pid;
 
    //check if fProcessIDs[uid] is set in file
    //if not set, read the process uid from file
@@ -3404,7 +3423,7 @@ void TFile::WriteStreamerInfo()
    if (fSeekInfo) MakeFree(fSeekInfo,fSeekInfo+fNbytesInfo-1);
    //Create new key
    TKey key(&list,"StreamerInfo",GetBestBuffer(), this);
-   fKeys->Remove(&key);
+   GetListOfKeys()->Remove(&key);
    fSeekInfo   = key.GetSeekKey();
    fNbytesInfo = key.GetNbytes();
    SumBuffer(key.GetObjlen());
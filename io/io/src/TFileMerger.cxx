@@ -31,6 +31,7 @@
 #include "TSystem.h"
 #include "TKey.h"
 #include "THashList.h"
+#include "TFlatHashList.h"
 #include "TObjString.h"
 #include "TClass.h"
 #include "TMethodCall.h"
@@ -358,7 +359,8 @@ Bool_t TFileMerger::MergeRecursive(TDirectory *target, TList *sourcelist, Int_t
    THashList allNames(nguess);
    allNames.SetOwner(kTRUE);
    ((THashList*)target->GetList())->Rehash(nguess);
-   ((THashList*)target->GetListOfKeys())->Rehash(nguess);
+   TFlatHashList *keyIndex = dynamic_cast<TFlatHashList*>(target->GetListOfKeys());
+   if (keyIndex) keyIndex->Rehash(nguess);
    
    TFileMergeInfo info(target);
 
@@ -2721,7 +2721,7 @@ void TStreamerInfo::GenerateDeclaration(FILE *fp, FILE *sfp, const TList *subCla
          
          name = ename;
          for (Int_t i=0;i < element->GetArrayDim();i++) {
-            name += TString::Format("[%d]",element->GetMaxIndex(i));
+            name.AppendFormat("[%d]",element->GetMaxIndex(i));
          }
          name += ";";
          ld = name.Length();
@@ -2851,7 +2851,7 @@ UInt_t TStreamerInfo::GenerateIncludes(FILE *fp, char *inclist, const TList *ext
       if (colon2) ename = colon2+2;
       name = ename;
       for (Int_t i=0;i < element->GetArrayDim();i++) {
-         name += TString::Format("[%d]",element->GetMaxIndex(i));
+         name.AppendFormat("[%d]",element->GetMaxIndex(i));
       }
       ld = name.Length();
       lt = strlen(element->GetTypeName());
@@ -809,6 +809,10 @@ namespace TStreamerInfoActions
       return ((TStreamerInfo*)config->fInfo)->WriteBufferAux(buf, arr, config->fElemId, n, config->fOffset, 1|2 );
    }
 
+   // Number of element addresses kept on the stack when wrapping the legacy
+   // code, to avoid a heap allocation for each collection read or written.
+   const UInt_t kVectorLocalSize = 64;
+
    Int_t ReadVectorBase(TBuffer &buf, void *start, const void *end, const TLoopConfiguration * loopconfig, const TConfiguration *config) 
    {
       // Well the implementation is non trivial since we do not have a proxy for the container of _only_ the base class.  For now
@@ -816,13 +820,14 @@ namespace TStreamerInfoActions
 
       UInt_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
       UInt_t n = (((char*)end)-((char*)start))/incr;
-      char **arrptr = new char*[n];
+      char *local[kVectorLocalSize];
+      char **arrptr = (n <= kVectorLocalSize) ? local : new char*[n];
       UInt_t i = 0;
       for(void *iter = start; iter != end; iter = (char*)iter + incr, ++i ) {
          arrptr[i] = (char*)iter;
       }
       ((TStreamerInfo*)config->fInfo)->ReadBuffer(buf, arrptr, config->fElemId, n, config->fOffset, 1|2 );
-      delete [] arrptr;
+      if (arrptr != local) delete [] arrptr;
 
 //      // Idea: need to cache this result!
 //      TStreamerInfo *info = (TStreamerInfo*)config->fInfo;
@@ -850,13 +855,14 @@ namespace TStreamerInfoActions
 
       UInt_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
       UInt_t n = (((char*)end)-((char*)start))/incr;
-      char **arrptr = new char*[n];
+      char *local[kVectorLocalSize];
+      char **arrptr = (n <= kVectorLocalSize) ? local : new char*[n];
       UInt_t i = 0;
       for(void *iter = start; iter != end; iter = (char*)iter + incr, ++i ) {
          arrptr[i] = (char*)iter;
       }
       ((TStreamerInfo*)config->fInfo)->ReadBuffer(buf, arrptr, config->fElemId, n, config->fOffset, 1|2 );
-      delete [] arrptr;
+      if (arrptr != local) delete [] arrptr;
       return 0;
    }
 
@@ -866,13 +872,14 @@ namespace TStreamerInfoActions
 
       UInt_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
       UInt_t n = (((char*)end)-((char*)start))/incr;
-      char **arrptr = new char*[n];
+      char *local[kVectorLocalSize];
+      char **arrptr = (n <= kVectorLocalSize) ? local : new char*[n];
       UInt_t i = 0;
       for(void *iter = start; iter != end; iter = (char*)iter + incr, ++i ) {
          arrptr[i] = (char*)iter;
       }
       ((TStreamerInfo*)config->fInfo)->WriteBufferAux(buf, arrptr, config->fElemId, n, config->fOffset, 1|2 );
-      delete [] arrptr;
+      if (arrptr != local) delete [] arrptr;
       return 0;
    }
 
@@ -933,6 +940,50 @@ namespace TStreamerInfoActions
       return 0;
    }
 
+   template <typename T> 
+   Int_t ReadBasicTypeVectorStrided(TBuffer &buf, void *start, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
+   {
+      // Read the data member of all the elements of the vector in one pass.
+      // In the member-wise format the values are contiguous in the buffer, so
+      // for a TBufferFile they are decoded directly into the strided vector
+      // storage instead of calling the virtual TBuffer::ReadXXX per element.
+
+      const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
+      const Int_t n = (((char*)end)-((char*)start))/incr;
+      if (buf.IsA() != TBufferFile::Class() || buf.Length() + n*(Int_t)sizeof(T) > buf.BufferSize()) {
+         return ReadBasicTypeVectorLoop<T>(buf, start, end, loopconfig, config);
+      }
+      char *cursor = buf.Buffer() + buf.Length();
+      char *addr = ((char*)start) + config->fOffset;
+      for(Int_t i = 0; i < n; ++i, addr += incr) {
+         frombuf(cursor, (T*)addr);
+      }
+      buf.SetBufferOffset(cursor - buf.Buffer());
+      return 0;
+   }
+
+   template <typename T> 
+   Int_t WriteBasicTypeVectorStrided(TBuffer &buf, void *start, const void *end, const TLoopConfiguration *loopconfig, const TConfiguration *config)
+   {
+      // Write the data member of all the elements of the vector in one pass,
+      // see ReadBasicTypeVectorStrided.
+
+      if (buf.IsA() != TBufferFile::Class()) {
+         return WriteBasicTypeVectorLoop<T>(buf, start, end, loopconfig, config);
+      }
+      const Int_t incr = ((TVectorLoopConfig*)loopconfig)->fIncrement;
+      const Int_t n = (((char*)end)-((char*)start))/incr;
+      const Int_t needed = buf.Length() + n*(Int_t)sizeof(T);
+      if (needed > buf.BufferSize()) buf.AutoExpand(needed);
+      char *cursor = buf.Buffer() + buf.Length();
+      char *addr = ((char*)start) + config->fOffset;
+      for(Int_t i = 0; i < n; ++i, addr += incr) {
+         tobuf(cursor, *(T*)addr);
+      }
+      buf.SetBufferOffset(cursor - buf.Buffer());
+      return 0;
+   }
+
    template <typename T> 
    Int_t ReadBasicTypeGenericLoop(TBuffer &buf, void *start, const void *end, const TLoopConfiguration *loopconf, const TConfiguration *config)
    {
@@ -1048,19 +1099,19 @@ static TConfiguredAction GetVectorReadAction(TVirtualStreamerInfo *info, TStream
 {
    switch (type) {
          // read basic types
-      case TStreamerInfo::kBool:    return TConfiguredAction( ReadBasicTypeVectorLoop<Bool_t>, new TConfiguration(info,i,offset) );    break;
-      case TStreamerInfo::kChar:    return TConfiguredAction( ReadBasicTypeVectorLoop<Char_t>, new TConfiguration(info,i,offset) );    break;
-      case TStreamerInfo::kShort:   return TConfiguredAction( ReadBasicTypeVectorLoop<Short_t>, new TConfiguration(info,i,offset) );   break;
-      case TStreamerInfo::kInt:     return TConfiguredAction( ReadBasicTypeVectorLoop<Int_t>, new TConfiguration(info,i,offset) );     break;
+      case TStreamerInfo::kBool:    return TConfiguredAction( ReadBasicTypeVectorStrided<Bool_t>, new TConfiguration(info,i,offset) );    break;
+      case TStreamerInfo::kChar:    return TConfiguredAction( ReadBasicTypeVectorStrided<Char_t>, new TConfiguration(info,i,offset) );    break;
+      case TStreamerInfo::kShort:   return TConfiguredAction( ReadBasicTypeVectorStrided<Short_t>, new TConfiguration(info,i,offset) );   break;
+      case TStreamerInfo::kInt:     return TConfiguredAction( ReadBasicTypeVectorStrided<Int_t>, new TConfiguration(info,i,offset) );     break;
       case TStreamerInfo::kLong:    return TConfiguredAction( ReadBasicTypeVectorLoop<Long_t>, new TConfiguration(info,i,offset) );    break;
-      case TStreamerInfo::kLong64:  return TConfiguredAction( ReadBasicTypeVectorLoop<Long64_t>, new TConfiguration(info,i,offset) );  break;
-      case TStreamerInfo::kFloat:   return TConfiguredAction( ReadBasicTypeVectorLoop<Float_t>, new TConfiguration(info,i,offset) );   break;
-      case TStreamerInfo::kDouble:  return TConfiguredAction( ReadBasicTypeVectorLoop<Double_t>, new TConfiguration(info,i,offset) );  break;
-      case TStreamerInfo::kUChar:   return TConfiguredAction( ReadBasicTypeVectorLoop<UChar_t>, new TConfiguration(info,i,offset) );   break;
-      case TStreamerInfo::kUShort:  return TConfiguredAction( ReadBasicTypeVectorLoop<UShort_t>, new TConfiguration(info,i,offset) );  break;
-      case TStreamerInfo::kUInt:    return TConfiguredAction( ReadBasicTypeVectorLoop<UInt_t>, new TConfiguration(info,i,offset) );    break;
+      case TStreamerInfo::kLong64:  return TConfiguredAction( ReadBasicTypeVectorStrided<Long64_t>, new TConfiguration(info,i,offset) );  break;
+      case TStreamerInfo::kFloat:   return TConfiguredAction( ReadBasicTypeVectorStrided<Float_t>, new TConfiguration(info,i,offset) );   break;
+      case TStreamerInfo::kDouble:  return TConfiguredAction( ReadBasicTypeVectorStrided<Double_t>, new TConfiguration(info,i,offset) );  break;
+      case TStreamerInfo::kUChar:   return TConfiguredAction( ReadBasicTypeVectorStrided<UChar_t>, new TConfiguration(info,i,offset) );   break;
+      case TStreamerInfo::kUShort:  return TConfiguredAction( ReadBasicTypeVectorStrided<UShort_t>, new TConfiguration(info,i,offset) );  break;
+      case TStreamerInfo::kUInt:    return TConfiguredAction( ReadBasicTypeVectorStrided<UInt_t>, new TConfiguration(info,i,offset) );    break;
       case TStreamerInfo::kULong:   return TConfiguredAction( ReadBasicTypeVectorLoop<ULong_t>, new TConfiguration(info,i,offset) );   break;
-      case TStreamerInfo::kULong64: return TConfiguredAction( ReadBasicTypeVectorLoop<ULong64_t>, new TConfiguration(info,i,offset) ); break;
+      case TStreamerInfo::kULong64: return TConfiguredAction( ReadBasicTypeVectorStrided<ULong64_t>, new TConfiguration(info,i,offset) ); break;
       case TStreamerInfo::kFloat16: {
          if (element->GetFactor() != 0) {
             return TConfiguredAction( VectorLooper<ReadBasicType_WithFactor<float> >, new TConfWithFactor(info,i,offset,element->GetFactor(),element->GetXmin()) );
@@ -1106,19 +1157,19 @@ static TConfiguredAction GetVectorReadAction(TVirtualStreamerInfo *info, TStream
 static TConfiguredAction GetVectorWriteAction(TVirtualStreamerInfo *info, TStreamerElement * /*element*/, Int_t type, UInt_t i, Int_t offset) {
   switch (type) {
         // read basic types
-     case TStreamerInfo::kBool:    return TConfiguredAction( WriteBasicTypeVectorLoop<Bool_t>, new TConfiguration(info,i,offset) );    break;
-     case TStreamerInfo::kChar:    return TConfiguredAction( WriteBasicTypeVectorLoop<Char_t>, new TConfiguration(info,i,offset) );    break;
-     case TStreamerInfo::kShort:   return TConfiguredAction( WriteBasicTypeVectorLoop<Short_t>, new TConfiguration(info,i,offset) );   break;
-     case TStreamerInfo::kInt:     return TConfiguredAction( WriteBasicTypeVectorLoop<Int_t>, new TConfiguration(info,i,offset) );     break;
+     case TStreamerInfo::kBool:    return TConfiguredAction( WriteBasicTypeVectorStrided<Bool_t>, new TConfiguration(info,i,offset) );    break;
+     case TStreamerInfo::kChar:    return TConfiguredAction( WriteBasicTypeVectorStrided<Char_t>, new TConfiguration(info,i,offset) );    break;
+     case TStreamerInfo::kShort:   return TConfiguredAction( WriteBasicTypeVectorStrided<Short_t>, new TConfiguration(info,i,offset) );   break;
+     case TStreamerInfo::kInt:     return TConfiguredAction( WriteBasicTypeVectorStrided<Int_t>, new TConfiguration(info,i,offset) );     break;
      case TStreamerInfo::kLong:    return TConfiguredAction( WriteBasicTypeVectorLoop<Long_t>, new TConfiguration(info,i,offset) );    break;
-     case TStreamerInfo::kLong64:  return TConfiguredAction( WriteBasicTypeVectorLoop<Long64_t>, new TConfiguration(info,i,offset) );  break;
-     case TStreamerInfo::kFloat:   return TConfiguredAction( WriteBasicTypeVectorLoop<Float_t>, new TConfiguration(info,i,offset) );   break;
-     case TStreamerInfo::kDouble:  return TConfiguredAction( WriteBasicTypeVectorLoop<Double_t>, new TConfiguration(info,i,offset) );  break;
-     case TStreamerInfo::kUChar:   return TConfiguredAction( WriteBasicTypeVectorLoop<UChar_t>, new TConfiguration(info,i,offset) );   break;
-     case TStreamerInfo::kUShort:  return TConfiguredAction( WriteBasicTypeVectorLoop<UShort_t>, new TConfiguration(info,i,offset) );  break;
-     case TStreamerInfo::kUInt:    return TConfiguredAction( WriteBasicTypeVectorLoop<UInt_t>, new TConfiguration(info,i,offset) );    break;
+     case TStreamerInfo::kLong64:  return TConfiguredAction( WriteBasicTypeVectorStrided<Long64_t>, new TConfiguration(info,i,offset) );  break;
+     case TStreamerInfo::kFloat:   return TConfiguredAction( WriteBasicTypeVectorStrided<Float_t>, new TConfiguration(info,i,offset) );   break;
+     case TStreamerInfo::kDouble:  return TConfiguredAction( WriteBasicTypeVectorStrided<Double_t>, new TConfiguration(info,i,offset) );  break;
+     case TStreamerInfo::kUChar:   return TConfiguredAction( WriteBasicTypeVectorStrided<UChar_t>, new TConfiguration(info,i,offset) );   break;
+     case TStreamerInfo::kUShort:  return TConfiguredAction( WriteBasicTypeVectorStrided<UShort_t>, new TConfiguration(info,i,offset) );  break;
+     case TStreamerInfo::kUInt:    return TConfiguredAction( WriteBasicTypeVectorStrided<UInt_t>, new TConfiguration(info,i,offset) );    break;
      case TStreamerInfo::kULong:   return TConfiguredAction( WriteBasicTypeVectorLoop<ULong_t>, new TConfiguration(info,i,offset) );   break;
-     case TStreamerInfo::kULong64: return TConfiguredAction( WriteBasicTypeVectorLoop<ULong64_t>, new TConfiguration(info,i,offset) ); break;
+     case TStreamerInfo::kULong64: return TConfiguredAction( WriteBasicTypeVectorStrided<ULong64_t>, new TConfiguration(info,i,offset) ); break;
      default:
          return TConfiguredAction( WriteVectorWrapping, new TConfiguration(info,i,0 /* 0 because we call the legacy code */) );  
   }
@@ -64,6 +64,7 @@ protected:
    Long64_t         fFirstObjId;           //!   id of first object to be read from the database
    Long64_t         fLastObjId;            //!   id of last object correspond to this key
    TMap*            fPoolsMap;             //!   map of pools with data from different tables
+   TMap*            fBlobPoolsMap;         //!   map of pools with data from different raw tables
 
    // TBufferSQL2 objects cannot be copied or assigned
    TBufferSQL2(const TBufferSQL2 &);       // not implemented
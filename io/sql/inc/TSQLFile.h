@@ -85,6 +85,7 @@ protected:
    // generic sql functions
    TSQLResult*       SQLQuery(const char* cmd, Int_t flag = 0, Bool_t* res = 0);
    Bool_t            SQLCanStatement();
+   Bool_t            SQLUseStatements();
    TSQLStatement*    SQLStatement(const char* cmd, Int_t bufsize = 1000);
    void              SQLDeleteStatement(TSQLStatement* stmt);
    Bool_t            SQLApplyCommands(TObjArray* cmds);
@@ -133,6 +134,7 @@ protected:
    TSQLResult*       GetNormalClassDataAll(Long64_t minobjid, Long64_t maxobjid, TSQLClassInfo* sqlinfo);
    TSQLResult*       GetBlobClassData(Long64_t objid, TSQLClassInfo* sqlinfo);
    TSQLStatement*    GetBlobClassDataStmt(Long64_t objid, TSQLClassInfo* sqlinfo);
+   TSQLResult*       GetBlobClassDataAll(Long64_t minobjid, Long64_t maxobjid, TSQLClassInfo* sqlinfo);
    Long64_t          StoreObjectInTables(Long64_t keyid, const void* obj, const TClass* cl);
    Bool_t            WriteSpecialObject(Long64_t keyid, TObject* obj, const char* name, const char* title);
    TObject*          ReadSpecialObject(Long64_t keyid, TObject* obj = 0);
@@ -165,6 +167,8 @@ protected:
    TString           fTablesType;      //! type, used in CREATE TABLE statements
    Int_t             fUseTransactions; //! use transaction statements for writing data into the tables
    Int_t             fUseIndexes;      //! use indexes for tables: 0 - off, 1 - only for basic tables, 2  + normal class tables, 3 - all tables
+   Bool_t            fUseStatements;   //! use TSQLStatement with bound parameters to insert data (always for Oracle and ODBC)
+   Int_t             fBatchSize;       //! number of rows inserted with a single statement execution or INSERT query
    Int_t             fModifyCounter;   //! indicates how many changes was done with database tables
    Int_t             fQuerisCounter;   //! how many query was applied
   
@@ -213,6 +217,10 @@ public:
    Int_t             GetUseTransactions() const { return fUseTransactions; }
    void              SetUseIndexes(Int_t use_type = kIndexesBasic);
    Int_t             GetUseIndexes() const { return fUseIndexes; }
+   void              SetUseStatements(Bool_t on = kTRUE) { fUseStatements = on; }
+   Bool_t            GetUseStatements() const { return fUseStatements; }
+   void              SetBatchSize(Int_t nrows = 1000) { fBatchSize = (nrows>0) ? nrows : 1; }
+   Int_t             GetBatchSize() const { return fBatchSize; }
    Int_t             GetQuerisCounter() const { return fQuerisCounter; }
 
    TString           MakeSelectQuery(TClass* cl);
@@ -69,7 +69,8 @@ public:
                   TSQLResult*    classdata,
                   TSQLRow*       classrow,
                   TSQLResult*    blobdata,
-                  TSQLStatement* blobstmt);
+                  TSQLStatement* blobstmt,
+                  TObjArray*     blobrows = 0);
    
    virtual ~TSQLObjectData();
    
@@ -104,6 +105,8 @@ protected:
    TSQLResult*       fClassData;      //!
    TSQLResult*       fBlobData;       //!
    TSQLStatement*    fBlobStmt;      //!
+   TObjArray*        fBlobRows;       //! raw data rows, taken from TSQLObjectDataPool
+   Int_t             fBlobRowIndx;    //! index of next row in fBlobRows
    Int_t             fLocatedColumn;  //!
    TSQLRow*          fClassRow;       //!
    TSQLRow*          fBlobRow;        //!
@@ -130,6 +133,7 @@ public:
    TSQLClassInfo*    GetSqlInfo() const { return fInfo; }
    TSQLResult*       GetClassData() const { return fClassData; }
    TSQLRow*          GetObjectRow(Long64_t objid);   
+   TObjArray*        GetObjectRows(Long64_t objid);
    
 protected:
 
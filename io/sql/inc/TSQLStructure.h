@@ -182,6 +182,7 @@ public:
    virtual void     Print(Option_t* option = "") const;
    void             PrintLevel(Int_t level) const;
   
+   Bool_t           CreateTables(TSQLFile* f, Long64_t keyid);
    Bool_t           ConvertToTables(TSQLFile* f, Long64_t keyid, TObjArray* cmds);
   
    Int_t            LocateElementColumn(TSQLFile* f, TBufferSQL2* buf, TSQLObjectData* data);
@@ -76,7 +76,8 @@ TBufferSQL2::TBufferSQL2() :
    fObjectsInfos(0),
    fFirstObjId(0),
    fLastObjId(0),
-   fPoolsMap(0)
+   fPoolsMap(0),
+   fBlobPoolsMap(0)
 {
    // Default constructor, should not be used
 }
@@ -99,7 +100,8 @@ TBufferSQL2::TBufferSQL2(TBuffer::EMode mode) :
    fObjectsInfos(0),
    fFirstObjId(0),
    fLastObjId(0),
-   fPoolsMap(0)
+   fPoolsMap(0),
+   fBlobPoolsMap(0)
 {
    // Creates buffer object to serailize/deserialize data to/from sql.
    // Mode should be either TBuffer::kRead or TBuffer::kWrite.
@@ -127,7 +129,8 @@ TBufferSQL2::TBufferSQL2(TBuffer::EMode mode, TSQLFile* file) :
    fObjectsInfos(0),
    fFirstObjId(0),
    fLastObjId(0),
-   fPoolsMap(0)
+   fPoolsMap(0),
+   fBlobPoolsMap(0)
 {
    // Creates buffer object to serailize/deserialize data to/from sql.
    // This constructor should be used, if data from buffer supposed to be stored in file.
@@ -165,6 +168,11 @@ TBufferSQL2::~TBufferSQL2()
       fPoolsMap->DeleteValues();
       delete fPoolsMap;
    }
+
+   if (fBlobPoolsMap!=0) {
+      fBlobPoolsMap->DeleteValues();
+      delete fBlobPoolsMap;
+   }
 }
 
 //______________________________________________________________________________
@@ -310,7 +318,33 @@ TSQLObjectData* TBufferSQL2::SqlObjectData(Long64_t objid, TSQLClassInfo* sqlinf
    }
 
    TSQLResult *blobdata = 0;
-   TSQLStatement* blobstmt = fSQL->GetBlobClassDataStmt(objid, sqlinfo);
+   TSQLStatement* blobstmt = 0;
+   TObjArray* blobrows = 0;
+
+   if (sqlinfo->IsRawTableExist() && (fLastObjId>fFirstObjId)) {
+      // raw data of all objects of the key requested with single query,
+      // as for normal tables
+      TSQLObjectDataPool* pool = 0;
+
+      if (fBlobPoolsMap!=0)
+        pool = (TSQLObjectDataPool*) fBlobPoolsMap->GetValue(sqlinfo);
+
+      if (pool==0) {
+         TSQLResult *alldata = fSQL->GetBlobClassDataAll(fFirstObjId, fLastObjId, sqlinfo);
+         if (alldata!=0) {
+            if (fBlobPoolsMap==0) fBlobPoolsMap = new TMap();
+            pool = new TSQLObjectDataPool(sqlinfo, alldata);
+            fBlobPoolsMap->Add(sqlinfo, pool);
+         }
+      }
+
+      if (pool!=0) {
+         blobrows = pool->GetObjectRows(objid);
+         return new TSQLObjectData(sqlinfo, objid, classdata, classrow, 0, 0, blobrows);
+      }
+   }
+
+   blobstmt = fSQL->GetBlobClassDataStmt(objid, sqlinfo);
 
    if (blobstmt==0) blobdata = fSQL->GetBlobClassData(objid, sqlinfo);
 
@@ -98,6 +98,13 @@
 // they can be disabled by SetUseTransactions(kTransactionsOff). Or user
 // can take responsibility to use transactions function to hime
 //
+// Object data can be inserted with TSQLStatement and bound parameters
+// instead of text queries. This is always done for Oracle and ODBC and
+// can be enabled for other servers with SetUseStatements(). SetBatchSize()
+// defines how many rows are bound before the statement is executed, or how
+// many rows are combined in one INSERT query for MySQL (default 1000).
+// All rows of one object are inserted in a single transaction.
+//
 // By default only indexes for basic tables are created.
 // In most cases usage of indexes increase perfomance to data reading,
 // but it also can increase time of writing data to database.
@@ -289,6 +296,8 @@ TSQLFile::TSQLFile() :
    fTablesType(),
    fUseTransactions(0),
    fUseIndexes(0),
+   fUseStatements(kFALSE),
+   fBatchSize(1000),
    fModifyCounter(0),
    fQuerisCounter(0),
    fBasicTypes(0),
@@ -314,6 +323,8 @@ TSQLFile::TSQLFile(const char* dbname, Option_t* option, const char* user, const
    fTablesType(),
    fUseTransactions(0),
    fUseIndexes(0),
+   fUseStatements(kFALSE),
+   fBatchSize(1000),
    fModifyCounter(0),
    fQuerisCounter(0),
    fBasicTypes(mysql_BasicTypes),
@@ -1455,6 +1466,18 @@ Bool_t TSQLFile::SQLCanStatement()
    return kTRUE; // !IsOracle() || (fStmtCounter<15);
 }
 
+//______________________________________________________________________________
+Bool_t TSQLFile::SQLUseStatements()
+{
+   // Test if object data should be inserted with statements and bound
+   // parameters rather than with text queries. Always the case for Oracle
+   // and ODBC, optional for other servers (see SetUseStatements())
+
+   if (!IsOracle() && !IsODBC() && !fUseStatements) return kFALSE;
+
+   return SQLCanStatement();
+}
+
 //______________________________________________________________________________
 TSQLStatement* TSQLFile::SQLStatement(const char* cmd, Int_t bufsize)
 {
@@ -2485,6 +2508,25 @@ TSQLResult* TSQLFile::GetBlobClassData(Long64_t objid, TSQLClassInfo* sqlinfo)
    return SQLQuery(sqlcmd.Data(), 2);
 }
 
+//______________________________________________________________________________
+TSQLResult* TSQLFile::GetBlobClassDataAll(Long64_t minobjid, Long64_t maxobjid, TSQLClassInfo* sqlinfo)
+{
+//  Method return raw data for several objects from the range from _streamer_ classtable.
+//  First column is object id, rows are ordered by object id and raw id
+
+   if (!sqlinfo->IsRawTableExist()) return 0;
+   TString sqlcmd;
+   const char* quote = SQLIdentifierQuote();
+   sqlcmd.Form("SELECT %s%s%s, %s, %s FROM %s%s%s WHERE %s%s%s BETWEEN %lld AND %lld ORDER BY %s%s%s, %s%s%s",
+               quote, SQLObjectIdColumn(), quote,
+               sqlio::BT_Field, sqlio::BT_Value,
+               quote, sqlinfo->GetRawTableName(), quote,
+               quote, SQLObjectIdColumn(), quote, minobjid, maxobjid,
+               quote, SQLObjectIdColumn(), quote,
+               quote, SQLRawIdColumn(), quote);
+   return SQLQuery(sqlcmd.Data(), 2);
+}
+
 //______________________________________________________________________________
 TSQLStatement* TSQLFile::GetBlobClassDataStmt(Long64_t objid, TSQLClassInfo* sqlinfo)
 {
@@ -2535,10 +2577,12 @@ Long64_t TSQLFile::StoreObjectInTables(Long64_t keyid, const void* obj, const TC
       objid = -1;
    } else {
       TObjArray cmds;
-      // here tables may be already created, therefore
-      // it should be protected by transactions operations
-      if (s && !s->ConvertToTables(this, keyid, &cmds)) {
-         Error("StoreObjectInTables","Cannot convert to SQL statements");
+      // Tables are created before the transaction is started: table
+      // definitions commit implicitly on several SQL servers.
+      // Statements are executed during the conversion, so that the
+      // transaction must be started before to group all inserted rows
+      if (s && !s->CreateTables(this, keyid)) {
+         Error("StoreObjectInTables","Cannot create tables for object data");
          objid = -1;
       } else {
          Bool_t needcommit = kFALSE;
@@ -2548,12 +2592,18 @@ Long64_t TSQLFile::StoreObjectInTables(Long64_t keyid, const void* obj, const TC
             needcommit = kTRUE;
          }
 
-         if (!SQLApplyCommands(&cmds)) {
-            Error("StoreObject","Cannot correctly store object data in database");
+         if (s && !s->ConvertToTables(this, keyid, &cmds)) {
+            Error("StoreObjectInTables","Cannot convert to SQL statements");
             objid = -1;
             if (needcommit) SQLRollback();
          } else {
-            if (needcommit) SQLCommit();
+            if (!SQLApplyCommands(&cmds)) {
+               Error("StoreObject","Cannot correctly store object data in database");
+               objid = -1;
+               if (needcommit) SQLRollback();
+            } else {
+               if (needcommit) SQLCommit();
+            }
          }
       }
       cmds.Delete();
@@ -69,6 +69,8 @@ TSQLObjectData::TSQLObjectData() :
       fClassData(0),
       fBlobData(0),
       fBlobStmt(0),
+      fBlobRows(0),
+      fBlobRowIndx(0),
       fLocatedColumn(-1),
       fClassRow(0),
       fBlobRow(0),
@@ -88,7 +90,8 @@ TSQLObjectData::TSQLObjectData(TSQLClassInfo* sqlinfo,
                                TSQLResult*    classdata,
                                TSQLRow*       classrow,
                                TSQLResult*    blobdata,
-                               TSQLStatement* blobstmt) :
+                               TSQLStatement* blobstmt,
+                               TObjArray*     blobrows) :
    TObject(),
    fInfo(sqlinfo),
    fObjId(objid),
@@ -96,6 +99,8 @@ TSQLObjectData::TSQLObjectData(TSQLClassInfo* sqlinfo,
    fClassData(classdata),
    fBlobData(blobdata),
    fBlobStmt(blobstmt),
+   fBlobRows(blobrows),
+   fBlobRowIndx(0),
    fLocatedColumn(-1),
    fClassRow(classrow),
    fBlobRow(0),
@@ -107,6 +112,10 @@ TSQLObjectData::TSQLObjectData(TSQLClassInfo* sqlinfo,
    fUnpack(0)
 {
    // normal contrsuctor,
+   // raw data can be provided as result of request for this object (blobdata),
+   // as statement (blobstmt) or as array of rows, extracted from
+   // TSQLObjectDataPool with raw data of several objects (blobrows).
+   // In last case first column of the rows is object id.
 
    // take ownership if no special row from data pool is provided
    if ((fClassData!=0) && (fClassRow==0)) {
@@ -128,6 +137,7 @@ TSQLObjectData::~TSQLObjectData()
    if (fBlobData!=0) delete fBlobData;
    if (fUnpack!=0) { fUnpack->Delete(); delete fUnpack; }
    if (fBlobStmt!=0) delete fBlobStmt;
+   if (fBlobRows!=0) { fBlobRows->Delete(); delete fBlobRows; }
 }
 
 //______________________________________________________________________________
@@ -211,7 +221,14 @@ Bool_t TSQLObjectData::ShiftBlobRow()
    }
    
    delete fBlobRow;
-   fBlobRow = fBlobData ? fBlobData->Next() : 0;
+   fBlobRow = 0;
+   if (fBlobRows!=0) {
+      // take ownership over the row from array
+      if (fBlobRowIndx<=fBlobRows->GetLast())
+         fBlobRow = (TSQLRow*) fBlobRows->RemoveAt(fBlobRowIndx++);
+   } else
+   if (fBlobData!=0)
+      fBlobRow = fBlobData->Next();
    return fBlobRow!=0;
 }
 
@@ -232,8 +249,10 @@ Bool_t TSQLObjectData::ExtractBlobValues()
 
    if (!hasdata) {
       if (fBlobRow!=0) {
-         fLocatedValue = fBlobRow->GetField(1);
-         name = fBlobRow->GetField(0);
+         // rows from data pool have object id in first column
+         Int_t shift = (fBlobRows!=0) ? 1 : 0;
+         fLocatedValue = fBlobRow->GetField(1+shift);
+         name = fBlobRow->GetField(0+shift);
       }
    }
    
@@ -461,3 +480,51 @@ TSQLRow* TSQLObjectDataPool::GetObjectRow(Long64_t objid)
    return 0;
 }
   
+
+//______________________________________________________________________________
+TObjArray* TSQLObjectDataPool::GetObjectRows(Long64_t objid)
+{
+   // Returns all sql rows with raw data of specified object.
+   // Used when data of several objects is requested from raw table,
+   // where rows are sorted by object id. Caller takes ownership of array and rows
+
+   if (fClassData==0) return 0;
+
+   TObjArray* rows = 0;
+   Long64_t rowid;
+
+   if (fRowsPool!=0) {
+      TObjLink* link = fRowsPool->FirstLink();
+      while (link!=0) {
+         TSQLRow* row = (TSQLRow*) link->GetObject();
+         TObjLink* next = link->Next();
+         rowid = sqlio::atol64(row->GetField(0));
+         if (rowid==objid) {
+            fRowsPool->Remove(link);
+            if (rows==0) rows = new TObjArray();
+            rows->Add(row);
+         }
+         link = next;
+      }
+   }
+
+   while (fIsMoreRows) {
+      TSQLRow* row = fClassData->Next();
+      if (row==0) {
+         fIsMoreRows = kFALSE;
+         break;
+      }
+      rowid = sqlio::atol64(row->GetField(0));
+      if (rowid==objid) {
+         if (rows==0) rows = new TObjArray();
+         rows->Add(row);
+         continue;
+      }
+      if (fRowsPool==0) fRowsPool = new TList();
+      fRowsPool->Add(row);
+      // rows are sorted, no more rows for this object
+      if (rowid>objid) break;
+   }
+
+   return rows;
+}
@@ -825,6 +825,22 @@ const char* TSQLStructure::GetSimpleTypeName(Int_t typ)
    return 0;
 }
 
+//___________________________________________________________
+static void SqlStatementParameters(TSQLFile* f, Int_t npars, TString& pars)
+{
+   // produce list of parameters markers for INSERT statement
+
+   pars = "";
+   for (Int_t n=0;n<npars;n++) {
+      if (n>0) pars += ", ";
+      if (f->IsOracle()) {
+         pars += ":";
+         pars += (n+1);
+      } else
+         pars += "?";
+   }
+}
+
 //___________________________________________________________
 
 // TSqlCmdsBuffer used as buffer for data, which are correspond to
@@ -886,7 +902,8 @@ public:
       fPool(),
       fLongStrValues(),
       fRegValues(),
-      fRegStmt(0)
+      fRegStmt(0),
+      fTablesOnly(kFALSE)
    {
    }
 
@@ -907,6 +924,7 @@ public:
    
    TSQLStatement* fRegStmt;
 
+   Bool_t     fTablesOnly;  // only create the tables, do not produce any data
 
    virtual ~TSqlRegistry()
    {
@@ -947,6 +965,8 @@ public:
       Bool_t canbelong = f->IsMySQL();
 
       Int_t maxsize = 50000;
+      Int_t maxrows = f->GetBatchSize();
+      Int_t nrows = 0;
       TString sqlcmd(maxsize), value, onecmd, cmdmask;
 
       const char* quote = f->SQLIdentifierQuote();
@@ -964,17 +984,36 @@ public:
             sqlcmd+=")";
          }
 
-         if (!canbelong || (sqlcmd.Length()>maxsize*0.9)) {
+         nrows++;
+
+         if (!canbelong || (sqlcmd.Length()>maxsize*0.9) || (nrows>=maxrows)) {
             AddSqlCmd(sqlcmd.Data());
             sqlcmd = "";
+            nrows = 0;
          }
       }
 
       if (sqlcmd.Length()>0) AddSqlCmd(sqlcmd.Data());
    }
 
-   void ConvertPoolValues()
+   Bool_t ProcessStatement(TSQLStatement* stmt)
    {
+      // apply last rows, bound to the statement
+
+      if (stmt==0) return kTRUE;
+      if (!stmt->Process() || stmt->IsError()) {
+         Error("ProcessStatement","Error %d: %s", stmt->GetErrorCode(), stmt->GetErrorMsg());
+         return kFALSE;
+      }
+      return kTRUE;
+   }
+
+   Bool_t ConvertPoolValues()
+   {
+      // convert values from the pool to SQL commands and
+      // apply rows, bound to the statements. Return kFALSE if any statement failed
+
+      Bool_t res = kTRUE;
       TSQLClassInfo* sqlinfo = 0;
       TIter iter(&fPool);
       while ((sqlinfo = (TSQLClassInfo*) iter())!=0) {
@@ -984,15 +1023,14 @@ public:
          // ensure that raw table will be created
          if (buf->fBlobCmds.GetLast()>=0) f->CreateRawTable(sqlinfo);
          ConvertSqlValues(buf->fBlobCmds, sqlinfo->GetRawTableName());
-         if (buf->fBlobStmt)
-            buf->fBlobStmt->Process();
-         if (buf->fNormStmt)
-            buf->fNormStmt->Process();
+         if (!ProcessStatement(buf->fBlobStmt)) res = kFALSE;
+         if (!ProcessStatement(buf->fNormStmt)) res = kFALSE;
       }
 
       ConvertSqlValues(fLongStrValues, sqlio::StringsTable);
       ConvertSqlValues(fRegValues, sqlio::ObjectsTable);
-      if (fRegStmt) fRegStmt->Process();
+      if (!ProcessStatement(fRegStmt)) res = kFALSE;
+      return res;
    }
 
 
@@ -1003,16 +1041,18 @@ public:
          Error("AddRegCmd","Something wrong with objid = %lld", objid);
          return;
       }
+
+      if (fTablesOnly) return;
       
-      if (f->IsOracle() || f->IsODBC()) {
-         if ((fRegStmt==0) && f->SQLCanStatement()) {
+      if (f->SQLUseStatements()) {
+         if (fRegStmt==0) {
             const char* quote = f->SQLIdentifierQuote();
             
-            TString sqlcmd;
-            const char* pars = f->IsOracle() ? ":1, :2, :3, :4" : "?, ?, ?, ?";
+            TString sqlcmd, pars;
+            SqlStatementParameters(f, 4, pars);
             sqlcmd.Form("INSERT INTO %s%s%s VALUES (%s)", 
-                     quote, sqlio::ObjectsTable, quote, pars);
-            fRegStmt = f->SQLStatement(sqlcmd.Data(), 1000);
+                     quote, sqlio::ObjectsTable, quote, pars.Data());
+            fRegStmt = f->SQLStatement(sqlcmd.Data(), f->GetBatchSize());
          }
          
          if (fRegStmt!=0) {
@@ -1041,6 +1081,7 @@ public:
 
       if (fLastLongStrId==0) f->VerifyLongStringTable();
       Int_t strid = ++fLastLongStrId;
+      if (fTablesOnly) return strid;
       TString value = strvalue;
       const char* valuequote = f->SQLValueQuote();
       TSQLStructure::AddStrBrackets(value, valuequote);
@@ -1053,31 +1094,20 @@ public:
       return strid;
    }
 
-   Bool_t InsertToNormalTableOracle(TSQLTableData* columns, TSQLClassInfo* sqlinfo)
+   Bool_t InsertToNormalTableStmt(TSQLTableData* columns, TSQLClassInfo* sqlinfo)
    {
       TSqlCmdsBuffer* buf = GetCmdsBuffer(sqlinfo);
       if (buf==0) return kFALSE;
       
       TSQLStatement* stmt = buf->fNormStmt;
       if (stmt==0) {
-         // if one cannot create statement, do it normal way
-         if (!f->SQLCanStatement()) return kFALSE;
-         
          const char* quote = f->SQLIdentifierQuote();
-         TString sqlcmd;
-         sqlcmd.Form("INSERT INTO %s%s%s VALUES (", 
-                     quote, sqlinfo->GetClassTableName(), quote);
-         for (int n=0;n<columns->GetNumColumns();n++) {
-            if (n>0) sqlcmd +=", ";
-            if (f->IsOracle()) {
-               sqlcmd += ":"; 
-               sqlcmd += (n+1);
-            } else
-               sqlcmd += "?";
-         }
-         sqlcmd += ")";
+         TString sqlcmd, pars;
+         SqlStatementParameters(f, columns->GetNumColumns(), pars);
+         sqlcmd.Form("INSERT INTO %s%s%s VALUES (%s)", 
+                     quote, sqlinfo->GetClassTableName(), quote, pars.Data());
                      
-         stmt = f->SQLStatement(sqlcmd.Data(), 1000);
+         stmt = f->SQLStatement(sqlcmd.Data(), f->GetBatchSize());
          if (stmt==0) return kFALSE;
          buf->fNormStmt = stmt;
       }
@@ -1099,8 +1129,10 @@ public:
    {
       // produce SQL query to insert object data into normal table
 
-      if (f->IsOracle() || f->IsODBC())
-         if (InsertToNormalTableOracle(columns, sqlinfo))
+      if (fTablesOnly) return;
+
+      if (f->SQLUseStatements())
+         if (InsertToNormalTableStmt(columns, sqlinfo))
            return;
 
       const char* valuequote = f->SQLValueQuote();
@@ -1144,9 +1176,11 @@ public:
       fRawId(0),
       fValueMask(),
       fValueQuote(0),
-      fMaxStrSize(255)
+      fMaxStrSize(255),
+      fTablesOnly(kFALSE)
    {
       fFile = reg->f;
+      fTablesOnly = reg->fTablesOnly;
       fInfo = sqlinfo;
       fCmdBuf = reg->GetCmdsBuffer(sqlinfo);
       fObjId = reg->fCurrentObjId;
@@ -1172,22 +1206,26 @@ public:
    {
       if (fCmdBuf==0) return;
       
+      if (fTablesOnly) {
+         // only ensure that raw table exists
+         if (fRawId++==0) fFile->CreateRawTable(fInfo);
+         return;
+      }
+
       // when first line is created, check all problems
       if (fRawId==0) {
-         Bool_t maketmt = kFALSE;
-         if (fFile->IsOracle() || fFile->IsODBC())
-            maketmt = (fCmdBuf->fBlobStmt==0) && fFile->SQLCanStatement();
+         Bool_t maketmt = (fCmdBuf->fBlobStmt==0) && fFile->SQLUseStatements();
             
          if (maketmt) {
             // ensure that raw table is exists
             fFile->CreateRawTable(fInfo);
             
             const char* quote = fFile->SQLIdentifierQuote();
-            TString sqlcmd;
-            const char* params = fFile->IsOracle() ? ":1, :2, :3, :4" : "?, ?, ?, ?";
+            TString sqlcmd, params;
+            SqlStatementParameters(fFile, 4, params);
             sqlcmd.Form("INSERT INTO %s%s%s VALUES (%s)", 
-                        quote, fInfo->GetRawTableName(), quote, params);
-            TSQLStatement* stmt = fFile->SQLStatement(sqlcmd.Data(), 2000);
+                        quote, fInfo->GetRawTableName(), quote, params.Data());
+            TSQLStatement* stmt = fFile->SQLStatement(sqlcmd.Data(), fFile->GetBatchSize());
             fCmdBuf->fBlobStmt = stmt;
          }
       }
@@ -1227,6 +1265,7 @@ public:
    TString fValueMask;
    const char* fValueQuote;
    Int_t fMaxStrSize;
+   Bool_t fTablesOnly;
 };
 
 //________________________________________________________________________
@@ -1244,6 +1283,29 @@ Long64_t TSQLStructure::FindMaxObjectId()
    return max;
 }
 
+//________________________________________________________________________
+Bool_t TSQLStructure::CreateTables(TSQLFile* file, Long64_t keyid)
+{
+   // Create all class and raw tables, which are required to store
+   // object data of this structure, without producing any data.
+   // Allows to perform all table definitions before the transaction
+   // with the object data is started, while several SQL servers
+   // (for instance MySQL and Oracle) commit implicitly after them.
+   // Should be only called for toplevel structure
+
+   if (file==0) return kFALSE;
+
+   TSqlRegistry reg;
+
+   reg.f = file;
+   reg.fKeyId = keyid;
+   reg.fFirstObjId = DefineObjectId(kFALSE);
+   reg.fLastObjId = FindMaxObjectId();
+   reg.fTablesOnly = kTRUE;
+
+   return StoreObject(&reg, reg.fFirstObjId, GetObjectClass());
+}
+
 //________________________________________________________________________
 Bool_t TSQLStructure::ConvertToTables(TSQLFile* file, Long64_t keyid, TObjArray* cmds)
 {
@@ -1267,7 +1329,7 @@ Bool_t TSQLStructure::ConvertToTables(TSQLFile* file, Long64_t keyid, TObjArray*
    Bool_t res = StoreObject(&reg, reg.fFirstObjId, GetObjectClass());
 
    // convert values from pool to SQL commands
-   reg.ConvertPoolValues();
+   if (!reg.ConvertPoolValues()) res = kFALSE;
 
    return res;
 }
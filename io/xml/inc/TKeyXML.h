@@ -33,7 +33,7 @@ protected:
 public:
    TKeyXML(TDirectory* mother, Long64_t keyid, const TObject* obj, const char* name = 0, const char* title = 0);
    TKeyXML(TDirectory* mother, Long64_t keyid, const void* obj, const TClass* cl, const char* name, const char* title = 0);
-   TKeyXML(TDirectory* mother, Long64_t keyid, XMLNodePointer_t keynode);
+   TKeyXML(TDirectory* mother, Long64_t keyid, XMLNodePointer_t keynode, Long64_t keypos = 0);
    virtual ~TKeyXML();
    
    // redefined TKey Methods
@@ -62,6 +62,8 @@ public:
    
    XMLNodePointer_t  KeyNode() const { return fKeyNode; }
    Long64_t          GetKeyId() const { return fKeyId; }
+   Long64_t          GetKeyPos() const { return fKeyPos; }
+   Bool_t            LoadKeyNode(Bool_t dropsubkeys = kTRUE);
    Bool_t            IsSubdir() const { return fSubdir; }
    void              SetSubir() { fSubdir = kTRUE; }
    void              UpdateObject(TObject* obj);
@@ -77,6 +79,7 @@ protected:
    
    XMLNodePointer_t  fKeyNode;  //! node with stored object
    Long64_t          fKeyId;    //! unique identifier of key for search methods
+   Long64_t          fKeyPos;   //! position of key node in the file, when key was read in streaming mode
    Bool_t            fSubdir;   //! indicates that key contains subdirectory
    
    ClassDef(TKeyXML,1) // a special TKey for XML files      
@@ -37,7 +37,7 @@ protected:
    void              UnpackSpecialCharacters(char* target, const char* source, int srclen);
    void              OutputValue(char* value, TXMLOutputStream* out);
    void              SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream* out, Int_t layout, Int_t level);
-   XMLNodePointer_t  ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue);
+   XMLNodePointer_t  ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue, Bool_t readchilds = kTRUE);
    void              DisplayError(Int_t error, Int_t linenumber);
    XMLDocPointer_t   ParseStream(TXMLInputStream* input);
 
@@ -108,6 +108,12 @@ public:
    XMLNodePointer_t  DocGetRootElement(XMLDocPointer_t xmldoc);
    XMLDocPointer_t   ParseFile(const char* filename, Int_t maxbuf = 100000);
    XMLDocPointer_t   ParseString(const char* xmlstring);
+   XMLDocPointer_t   OpenStream(const char* filename, Long64_t pos = 0, Int_t maxbuf = 100000);
+   XMLNodePointer_t  ReadNextNode(XMLDocPointer_t xmldoc, XMLNodePointer_t xmlparent, Bool_t fulltree = kTRUE);
+   Bool_t            SkipNodeContent(XMLDocPointer_t xmldoc, XMLNodePointer_t xmlnode);
+   Long64_t          GetStreamNodePos(XMLDocPointer_t xmldoc);
+   Bool_t            IsStreamError(XMLDocPointer_t xmldoc);
+   void              CloseStream(XMLDocPointer_t xmldoc);
    Bool_t            ValidateVersion(XMLDocPointer_t doc, const char* version = 0);
    Bool_t            ValidateDocument(XMLDocPointer_t, Bool_t = kFALSE) { return kFALSE; } // obsolete
    void              SaveSingleNode(XMLNodePointer_t xmlnode, TString* res, Int_t layout = 1);
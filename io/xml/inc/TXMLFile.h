@@ -121,6 +121,7 @@ public:
    Bool_t            AddXmlLine(const char* line);                                   
 
    TXMLEngine*       XML() { return fXML; } 
+   XMLNodePointer_t  ReadKeyNode(Long64_t keypos);
 
 protected:
    // functions to store streamer infos
@@ -130,6 +131,8 @@ protected:
 
    Bool_t            ReadFromFile();
    Int_t             ReadKeysList(TDirectory* dir, XMLNodePointer_t topnode);
+   Int_t             ReadKeysStream(TDirectory* dir, XMLDocPointer_t doc, XMLNodePointer_t topnode);
+   void              LoadKeysNodes(TDirectory* dir);
    TKeyXML*          FindDirKey(TDirectory* dir);
    TDirectory*       FindKeyDir(TDirectory* mother, Long64_t keyid);
    void              CombineNodesTree(TDirectory* dir, XMLNodePointer_t topnode, Bool_t dolink);
@@ -32,6 +32,7 @@ TKeyXML::TKeyXML() :
    TKey(),
    fKeyNode(0),
    fKeyId(0),
+   fKeyPos(0),
    fSubdir(kFALSE)
 {
    // default constructor
@@ -42,6 +43,7 @@ TKeyXML::TKeyXML(TDirectory* mother, Long64_t keyid, const TObject* obj, const c
     TKey(mother),
     fKeyNode(0),
     fKeyId(keyid),
+    fKeyPos(0),
     fSubdir(kFALSE)
 {
    // Creates TKeyXML and convert obj data to xml structures
@@ -73,6 +75,7 @@ TKeyXML::TKeyXML(TDirectory* mother, Long64_t keyid, const void* obj, const TCla
    TKey(mother),
    fKeyNode(0),
    fKeyId(keyid),
+   fKeyPos(0),
    fSubdir(kFALSE)
 {
    // Creates TKeyXML and convert obj data to xml structures
@@ -94,13 +97,16 @@ TKeyXML::TKeyXML(TDirectory* mother, Long64_t keyid, const void* obj, const TCla
 }
 
 //______________________________________________________________________________
-TKeyXML::TKeyXML(TDirectory* mother, Long64_t keyid, XMLNodePointer_t keynode) :
+TKeyXML::TKeyXML(TDirectory* mother, Long64_t keyid, XMLNodePointer_t keynode, Long64_t keypos) :
    TKey(mother),
    fKeyNode(keynode),
    fKeyId(keyid),
+   fKeyPos(keypos),
    fSubdir(kFALSE)
 {
    // Creates TKeyXML and takes ownership over xml node, from which object can be restored
+   // If keypos>0, key node contains only attributes of the key and of the object node,
+   // object data will be read from specified position of the file when requested
 
    TXMLEngine* xml = XMLEngine();
 
@@ -313,11 +319,18 @@ void* TKeyXML::XmlReadAny(void* obj, const TClass* expectedClass)
    TXMLEngine* xml = XMLEngine();
    if ((f==0) || (xml==0)) return obj;
    
+   // in streaming mode object data is read from the file and released after reading
+   XMLNodePointer_t keynode = fKeyNode;
+   if (fKeyPos>0) {
+      keynode = f->ReadKeyNode(fKeyPos);
+      if (keynode==0) return obj;
+   }
+   
    TBufferXML buffer(TBuffer::kRead, f);
    if (f->GetIOVersion()==1)
       buffer.SetBit(TBuffer::kCannotHandleMemberWiseStreaming, kFALSE);
 
-   XMLNodePointer_t blocknode = xml->GetChild(fKeyNode);
+   XMLNodePointer_t blocknode = xml->GetChild(keynode);
    xml->SkipEmpty(blocknode);
    while (blocknode!=0) {
       if (strcmp(xml->GetNodeName(blocknode), xmlio::XmlBlock)==0) break;
@@ -325,12 +338,14 @@ void* TKeyXML::XmlReadAny(void* obj, const TClass* expectedClass)
    }
    buffer.XmlReadBlock(blocknode);
 
-   XMLNodePointer_t objnode = xml->GetChild(fKeyNode);
+   XMLNodePointer_t objnode = xml->GetChild(keynode);
    xml->SkipEmpty(objnode);
 
    TClass* cl = 0;
    void* res = buffer.XmlReadAny(objnode, obj, &cl);
    
+   if (keynode!=fKeyNode) xml->FreeNode(keynode);
+   
    if ((cl==0) || (res==0)) return obj;
    
    Int_t delta = 0;
@@ -352,6 +367,40 @@ void* TKeyXML::XmlReadAny(void* obj, const TClass* expectedClass)
    return ((char*)res) + delta;
 }
 
+//______________________________________________________________________________
+Bool_t TKeyXML::LoadKeyNode(Bool_t dropsubkeys)
+{
+   // Reads complete key node from the file, if key was read in streaming mode.
+   // If dropsubkeys is true, nodes of subkeys, which are already read by
+   // subdirectory, are removed. Otherwise they are kept in the key node and
+   // will be read from there when subdirectory is requested.
+
+   if (fKeyPos<=0) return kTRUE;
+
+   TXMLFile* f = (TXMLFile*) GetFile();
+   TXMLEngine* xml = XMLEngine();
+   if ((f==0) || (xml==0)) return kFALSE;
+
+   XMLNodePointer_t keynode = f->ReadKeyNode(fKeyPos);
+   if (keynode==0) return kFALSE;
+
+   if (fSubdir && dropsubkeys) {
+      XMLNodePointer_t node = xml->GetChild(keynode);
+      while (node!=0) {
+         XMLNodePointer_t next = xml->GetNext(node);
+         if (strcmp(xml->GetNodeName(node), xmlio::Xmlkey)==0)
+            xml->UnlinkFreeNode(node);
+         node = next;
+      }
+   }
+
+   xml->FreeNode(fKeyNode);
+   fKeyNode = keynode;
+   fKeyPos = 0;
+
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 TXMLEngine* TKeyXML::XMLEngine()
 {
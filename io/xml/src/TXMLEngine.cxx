@@ -59,6 +59,10 @@ struct SXmlDoc_t {
    SXmlNode_t  *fRootNode;
    char        *fDtdName;
    char        *fDtdRoot;
+   TXMLInputStream *fStream;     // input stream, when document is read in streaming mode
+   SXmlNode_t  *fStreamNode;     // innermost node, which childs are not yet read from stream
+   Long64_t     fStreamNodePos;  // position in stream of last node, returned by ReadNextNode()
+   Int_t        fStreamStatus;   // 0 - reading, 1 - end of stream, <0 - error
 };
 
 class TXMLOutputStream {
@@ -160,17 +164,21 @@ protected:
    char          *fMaxAddr;
    char          *fLimitAddr;
 
-   Int_t          fTotalPos;
+   Long64_t       fTotalPos;
    Int_t          fCurrentLine;
 
 public:
 
    char           *fCurrent;
 
-   TXMLInputStream(bool isfilename, const char* filename, Int_t ibufsize)
+   TXMLInputStream(bool isfilename, const char* filename, Int_t ibufsize, Long64_t pos = 0)
    {
       if (isfilename) {
-         fInp = new std::ifstream(filename);
+         // binary mode: positions in the stream are counted per byte and
+         // used to seek back to nodes, see TXMLEngine::GetStreamNodePos()
+         fInp = new std::ifstream(filename, std::ios::in | std::ios::binary);
+         if (pos>0) fInp->seekg((std::streamoff) pos);
+         if (fInp->fail()) { delete fInp; fInp = 0; }
          fInpStr = 0;
          fInpStrLen = 0;
       } else {
@@ -190,7 +198,7 @@ public:
       fMaxAddr = fBuf+len;
       fLimitAddr = fBuf + int(len*0.75);
 
-      fTotalPos = 0;
+      fTotalPos = (pos>0) ? pos : 0;
       fCurrentLine = 1;
    }
 
@@ -253,7 +261,7 @@ public:
       return kTRUE;
    }
 
-   Int_t  TotalPos() { return fTotalPos; }
+   Long64_t TotalPos() { return fTotalPos; }
 
    Int_t CurrentLine() { return fCurrentLine; }
 
@@ -991,6 +999,10 @@ XMLDocPointer_t TXMLEngine::NewDoc(const char* version)
 
    doc->fDtdName = 0;
    doc->fDtdRoot = 0;
+   doc->fStream = 0;
+   doc->fStreamNode = 0;
+   doc->fStreamNodePos = 0;
+   doc->fStreamStatus = 1;
    return (XMLDocPointer_t) doc;
 }
 
@@ -1014,6 +1026,7 @@ void TXMLEngine::FreeDoc(XMLDocPointer_t xmldoc)
 
    if (xmldoc==0) return;
    SXmlDoc_t* doc = (SXmlDoc_t*) xmldoc;
+   delete doc->fStream;
    FreeNode((XMLNodePointer_t) doc->fRootNode);
    delete[] doc->fDtdName;
    delete[] doc->fDtdRoot;
@@ -1131,6 +1144,161 @@ XMLDocPointer_t TXMLEngine::ParseStream(TXMLInputStream* inp)
    return xmldoc;
 }
 
+//______________________________________________________________________________
+XMLDocPointer_t TXMLEngine::OpenStream(const char* filename, Long64_t pos, Int_t maxbuf)
+{
+   // Opens file for reading in streaming mode.
+   // In contrast to ParseFile(), nothing is read from the file at this
+   // moment. Nodes should be read one by one with ReadNextNode() method,
+   // therefore only nodes, required by the caller, are kept in memory.
+   // If pos>0, reading starts from specified position in the file. Such
+   // position can be obtained with GetStreamNodePos() method when file was
+   // read before. Document should be released with FreeDoc().
+
+   if ((filename==0) || (strlen(filename)==0)) return 0;
+   if (maxbuf < 100000) maxbuf = 100000;
+
+   SXmlDoc_t* doc = (SXmlDoc_t*) NewDoc(0);
+   doc->fStream = new TXMLInputStream(true, filename, maxbuf, pos);
+   doc->fStreamNode = doc->fRootNode;
+   doc->fStreamNodePos = pos;
+   doc->fStreamStatus = 0;
+
+   if (doc->fStream->EndOfStream()) {
+      Error("OpenStream", "Cannot read file %s", filename);
+      FreeDoc((XMLDocPointer_t) doc);
+      return 0;
+   }
+
+   return (XMLDocPointer_t) doc;
+}
+
+//______________________________________________________________________________
+XMLNodePointer_t TXMLEngine::ReadNextNode(XMLDocPointer_t xmldoc, XMLNodePointer_t xmlparent, Bool_t fulltree)
+{
+   // Reads next child of xmlparent node from the document, opened with OpenStream().
+   // If xmlparent==0, next top-level node of the document (like xml version or
+   // main node) will be read.
+   // If fulltree is true, complete node with all subnodes is read. Otherwise
+   // only node name and attributes are read and node remains open - its childs
+   // can be read later calling ReadNextNode() with this node as parent.
+   // Child is added to xmlparent; when processed, it can be released with
+   // UnlinkFreeNode(). Open nodes should not be released before their end is reached.
+   // Content, which was not read for nodes inside xmlparent, is skipped.
+   // Returns 0 when all childs of xmlparent are read or in case of error,
+   // which can be checked with IsStreamError() method.
+
+   SXmlDoc_t* doc = (SXmlDoc_t*) xmldoc;
+   if ((doc==0) || (doc->fStream==0) || (doc->fStreamStatus!=0)) return 0;
+
+   SXmlNode_t* top = (xmlparent==0) ? doc->fRootNode : (SXmlNode_t*) xmlparent;
+
+   // parent should be one of the nodes, which are not yet completely read
+   SXmlNode_t* open = doc->fStreamNode;
+   while ((open!=0) && (open!=top)) open = open->fParent;
+   if (open==0) return 0;
+
+   TXMLInputStream* inp = doc->fStream;
+
+   do {
+      SXmlNode_t* current = doc->fStreamNode;
+
+      // coverity[unchecked_value] end of stream is checked afterwards or by ReadNode()
+      if (!inp->EndOfStream()) inp->SkipSpaces();
+
+      if ((current==doc->fRootNode) && inp->EndOfStream()) {
+         // on the top level end of the stream is not an error
+         doc->fStreamStatus = 1;
+         return 0;
+      }
+
+      Long64_t pos = inp->TotalPos();
+
+      // content of nodes, opened inside parent node, is read completely and skipped
+      Int_t resvalue = 0;
+      XMLNodePointer_t node = ReadNode((XMLNodePointer_t) current, inp, resvalue, (current==top) ? fulltree : kTRUE);
+
+      if (resvalue==1) {
+         // end of the current node is reached
+         doc->fStreamNode = current->fParent;
+         if (current==top) return 0;
+         continue;
+      }
+
+      if ((resvalue!=2) && (resvalue!=3)) {
+         if ((resvalue==-1) && (current==doc->fRootNode) && inp->EndOfStream()) {
+            // comment at the end of the document
+            doc->fStreamStatus = 1;
+         } else {
+            DisplayError(resvalue, inp->CurrentLine());
+            doc->fStreamStatus = resvalue<0 ? resvalue : -100;
+         }
+         UnlinkFreeNode(node);
+         return 0;
+      }
+
+      // skipped comment
+      if (node==0) continue;
+
+      if (current!=top) {
+         UnlinkFreeNode(node);
+         continue;
+      }
+
+      if (resvalue==3) doc->fStreamNode = (SXmlNode_t*) node;
+      doc->fStreamNodePos = pos;
+      return node;
+
+   } while (true);
+
+   return 0;
+}
+
+//______________________________________________________________________________
+Bool_t TXMLEngine::SkipNodeContent(XMLDocPointer_t xmldoc, XMLNodePointer_t xmlnode)
+{
+   // Skips all not yet read childs of xmlnode in the document, opened with OpenStream().
+   // Childs, which were already read, are preserved.
+   // After that node is complete and can be unlinked from its parent.
+
+   XMLNodePointer_t child = 0;
+   while ((child = ReadNextNode(xmldoc, xmlnode, kTRUE)) != 0)
+      UnlinkFreeNode(child);
+
+   return !IsStreamError(xmldoc);
+}
+
+//______________________________________________________________________________
+Long64_t TXMLEngine::GetStreamNodePos(XMLDocPointer_t xmldoc)
+{
+   // Returns position in the file of last node, read with ReadNextNode().
+   // It can be used to read this node again with OpenStream().
+
+   return (xmldoc==0) ? 0 : ((SXmlDoc_t*) xmldoc)->fStreamNodePos;
+}
+
+//______________________________________________________________________________
+Bool_t TXMLEngine::IsStreamError(XMLDocPointer_t xmldoc)
+{
+   // Returns kTRUE if error was detected when reading document in streaming mode
+
+   return (xmldoc==0) ? kTRUE : (((SXmlDoc_t*) xmldoc)->fStreamStatus < 0);
+}
+
+//______________________________________________________________________________
+void TXMLEngine::CloseStream(XMLDocPointer_t xmldoc)
+{
+   // Closes input stream of the document, opened with OpenStream().
+   // Nodes, which are already read, remain in the document.
+
+   if (xmldoc==0) return;
+   SXmlDoc_t* doc = (SXmlDoc_t*) xmldoc;
+   delete doc->fStream;
+   doc->fStream = 0;
+   doc->fStreamNode = 0;
+   if (doc->fStreamStatus==0) doc->fStreamStatus = 1;
+}
+
 //______________________________________________________________________________
 Bool_t TXMLEngine::ValidateVersion(XMLDocPointer_t xmldoc, const char* version)
 {
@@ -1444,13 +1612,16 @@ void TXMLEngine::SaveNode(XMLNodePointer_t xmlnode, TXMLOutputStream* out, Int_t
 }
 
 //______________________________________________________________________________
-XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue)
+XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStream* inp, Int_t& resvalue, Bool_t readchilds)
 {
    // Tries to construct xml node from input stream. Node should be
    // child of xmlparent node or it can be closing tag of xmlparent.
+   // If readchilds is false, only start tag with attributes is read
+   // and childs of the node remain in the stream.
    // resvalue <= 0 if error
    // resvalue == 1 if this is endnode of parent
    // resvalue == 2 if this is child
+   // resvalue == 3 if this is child, which childs are not yet read
 
    resvalue = 0;
 
@@ -1583,6 +1754,11 @@ XMLNodePointer_t TXMLEngine::ReadNode(XMLNodePointer_t xmlparent, TXMLInputStrea
 
          if (!inp->ShiftCurrent()) return 0;
 
+         if (!readchilds) {
+            resvalue = 3;
+            return node;
+         }
+
          do {
             ReadNode(node, inp, resvalue);
          } while (resvalue==2);
@@ -419,6 +419,9 @@ Int_t TXMLFile::ReOpen(Option_t* mode)
    } else {
       fOption = opt;
 
+      // keys, read in streaming mode, should get complete data
+      LoadKeysNodes(this);
+
       SetWritable(kTRUE);
    }
 
@@ -564,14 +567,28 @@ void TXMLFile::CombineNodesTree(TDirectory* dir, XMLNodePointer_t topnode, Bool_
 Bool_t TXMLFile::ReadFromFile()
 {
    // read document from file
-   // Now full content of docuument reads into the memory
+   // If file opened for writing, full content of docuument reads into the memory.
    // Then document decomposed to separate keys and streamer info structures
    // All inrelevant data will be cleaned
+   // If file opened only for reading, document is read in streaming mode.
+   // Only attributes of keys are kept in memory, objects data will be
+   // read from the file when object is requested from the key.
 
-   fDoc = fXML->ParseFile(fRealName);
-   if (fDoc==0) return kFALSE;
+   Bool_t streaming = !IsWritable();
 
-   XMLNodePointer_t fRootNode = fXML->DocGetRootElement(fDoc);
+   XMLNodePointer_t fRootNode = 0;
+
+   if (streaming) {
+      fDoc = fXML->OpenStream(fRealName);
+      if (fDoc==0) return kFALSE;
+      // read xml prolog and start of main node
+      while ((fRootNode = fXML->ReadNextNode(fDoc, 0, kFALSE)) != 0)
+         if (!fXML->IsEmptyNode(fRootNode)) break;
+   } else {
+      fDoc = fXML->ParseFile(fRealName);
+      if (fDoc==0) return kFALSE;
+      fRootNode = fXML->DocGetRootElement(fDoc);
+   }
 
    if ((fRootNode==0) || !fXML->ValidateVersion(fDoc)) {
       fXML->FreeDoc(fDoc);
@@ -604,6 +621,26 @@ Bool_t TXMLFile::ReadFromFile()
    else
       fIOVersion = 1;
 
+   if (streaming) {
+      // streamer infos are stored after the keys, therefore keys are read first
+      ReadKeysStream(this, fDoc, fRootNode);
+
+      Bool_t iserr = fXML->IsStreamError(fDoc);
+      fXML->CloseStream(fDoc);
+      fXML->CleanNode(fRootNode);
+
+      if (iserr) {
+         fXML->FreeDoc(fDoc);
+         fDoc = 0;
+         return kFALSE;
+      }
+
+      if (fStreamerInfoNode!=0)
+         ReadStreamerInfo();
+
+      return kTRUE;
+   }
+
    fStreamerInfoNode = fXML->GetChild(fRootNode);
    fXML->SkipEmpty(fStreamerInfoNode);
    while (fStreamerInfoNode!=0) {
@@ -662,6 +699,102 @@ Int_t TXMLFile::ReadKeysList(TDirectory* dir, XMLNodePointer_t topnode)
    return nkeys;
 }
 
+//______________________________________________________________________________
+Int_t TXMLFile::ReadKeysStream(TDirectory* dir, XMLDocPointer_t doc, XMLNodePointer_t topnode)
+{
+   // Read list of keys for directory from document, opened in streaming mode.
+   // For each key only key attributes and attributes of object node are
+   // kept in memory, remaining data is skipped. Key remembers its position
+   // in the file to read object data when it will be requested.
+   // Streamer infos node, found on the top level, is read completely.
+
+   if ((dir==0) || (doc==0) || (topnode==0)) return 0;
+
+   Int_t nkeys = 0;
+
+   XMLNodePointer_t node = 0;
+   while ((node = fXML->ReadNextNode(doc, topnode, kFALSE)) != 0) {
+
+      if (strcmp(xmlio::Xmlkey, fXML->GetNodeName(node))==0) {
+         Long64_t keypos = fXML->GetStreamNodePos(doc);
+
+         // first node contains class name of stored object
+         XMLNodePointer_t objnode = 0;
+         while ((objnode = fXML->ReadNextNode(doc, node, kFALSE)) != 0)
+            if (!fXML->IsEmptyNode(objnode)) break;
+
+         if (!fXML->SkipNodeContent(doc, node)) {
+            fXML->UnlinkFreeNode(node);
+            break;
+         }
+
+         fXML->UnlinkNode(node);
+
+         TKeyXML* key = new TKeyXML(dir, ++fKeyCounter, node, keypos);
+         dir->AppendKey(key);
+
+         if (gDebug>2)
+            Info("ReadKeysStream","Add key %s from position %lld", key->GetName(), keypos);
+
+         nkeys++;
+      } else
+      if ((dir==this) && (fStreamerInfoNode==0) &&
+          (strcmp(xmlio::SInfos, fXML->GetNodeName(node))==0)) {
+         while (fXML->ReadNextNode(doc, node, kTRUE) != 0);
+         fXML->UnlinkNode(node);
+         fStreamerInfoNode = node;
+      } else {
+         fXML->SkipNodeContent(doc, node);
+         fXML->UnlinkFreeNode(node);
+      }
+   }
+
+   return nkeys;
+}
+
+//______________________________________________________________________________
+XMLNodePointer_t TXMLFile::ReadKeyNode(Long64_t keypos)
+{
+   // Reads complete key node, which starts at specified position in the file.
+   // Used when file was opened in streaming mode and object data are
+   // requested from the key. Returned node should be released by the caller.
+
+   XMLDocPointer_t doc = fXML->OpenStream(fRealName, keypos);
+   if (doc==0) return 0;
+
+   XMLNodePointer_t keynode = fXML->ReadNextNode(doc, 0, kTRUE);
+   if ((keynode!=0) && (strcmp(xmlio::Xmlkey, fXML->GetNodeName(keynode))!=0)) {
+      Error("ReadKeyNode", "No key node at position %lld in file %s", keypos, fRealName.Data());
+      keynode = 0;
+   }
+
+   fXML->UnlinkNode(keynode);
+   fXML->FreeDoc(doc);
+
+   return keynode;
+}
+
+//______________________________________________________________________________
+void TXMLFile::LoadKeysNodes(TDirectory* dir)
+{
+   // Reads complete nodes for all keys of directory (and subdirectories),
+   // read in streaming mode. Required when file switched to UPDATE mode,
+   // while full xml structures will be written back to the file.
+
+   if (dir==0) return;
+
+   TIter next(dir->GetListOfKeys());
+   TObject* obj = 0;
+   while ((obj = next())!=0) {
+      TKeyXML* key = dynamic_cast<TKeyXML*> (obj);
+      if (key==0) continue;
+      // subdirectory, which is not yet read, keeps nodes of its keys
+      TDirectory* subdir = key->IsSubdir() ? FindKeyDir(dir, key->GetKeyId()) : 0;
+      key->LoadKeyNode(subdir!=0);
+      if (subdir!=0) LoadKeysNodes(subdir);
+   }
+}
+
 //______________________________________________________________________________
 void TXMLFile::WriteStreamerInfo()
 {
@@ -1069,6 +1202,15 @@ Int_t TXMLFile::DirReadKeys(TDirectory* dir)
    TKeyXML* key = FindDirKey(dir);
    if (key==0) return 0;
 
+   if (key->GetKeyPos()>0) {
+      // key was read in streaming mode, subkeys are read from the file
+      XMLDocPointer_t doc = fXML->OpenStream(fRealName, key->GetKeyPos());
+      if (doc==0) return 0;
+      Int_t nkeys = ReadKeysStream(dir, doc, fXML->ReadNextNode(doc, 0, kFALSE));
+      fXML->FreeDoc(doc);
+      return nkeys;
+   }
+
    return ReadKeysList(dir, key->KeyNode());
 }
 
@@ -13,7 +13,8 @@
 
 class TMemStat: public TObject {
 private:
-   Bool_t fIsActive;    // is object attached to MemStat
+   Bool_t fIsActive;       // is object attached to MemStat
+   Bool_t fSlabAllocator;  // TStorage slab allocator was enabled
 
 public:
    TMemStat(Option_t* option = "read", Int_t buffersize=10000, Int_t maxcalls=5000000);
@@ -22,6 +23,7 @@ public:
    virtual void Disable();
    virtual void Enable();
    static  void Show(Double_t update=0.1, Int_t nbigleaks=20, const char* fname="*");
+   static  void PrintSlabStatistics();
 
    ClassDef(TMemStat, 0) // a user interface class of MemStat
 };
@@ -78,10 +78,17 @@
 // You can restrict the address range to be analyzed via TMemStatShow::SetAddressRange
 // You can restrict the entry range to be analyzed via TMemStatShow::SetEntryRange
 //
+// The objects allocated by the TStorage slab allocator (resource
+// Root.ObjectSlabs) do not go through malloc; while TMemStat is active
+// the slab allocator is disabled so that all objects are recorded.
+// The statistics of the slab allocator itself are printed by
+//   root > TMemStat::PrintSlabStatistics()
+//
 //___________________________________________________________________________
 
 #include "TROOT.h"
 #include "TDirectory.h"
+#include "TStorage.h"
 #include "TMemStat.h"
 #include "TMemStatBacktrace.h"
 #include "TMemStatMng.h"
@@ -95,7 +102,8 @@ using namespace memstat;
 _INIT_TOP_STACK;
 
 //______________________________________________________________________________
-TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActive(kFALSE)
+TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActive(kFALSE),
+   fSlabAllocator(kFALSE)
 {
    // Supported options:
    //    "gnubuiltin" - if declared, then MemStat will use gcc build-in function,
@@ -123,6 +131,9 @@ TMemStat::TMemStat(Option_t* option, Int_t buffersize, Int_t maxcalls): fIsActiv
    TMemStatMng::GetInstance()->SetBufferSize(buffersize);
    TMemStatMng::GetInstance()->SetMaxCalls(maxcalls);
    TMemStatMng::GetInstance()->Enable();
+   // the slab allocations of TStorage are not seen by the malloc hooks
+   fSlabAllocator = TStorage::HasSlabAllocator();
+   TStorage::EnableSlabAllocator(kFALSE);
    // set this variable only if "NEW" mode is active
    fIsActive = kTRUE;
 
@@ -135,6 +146,7 @@ TMemStat::~TMemStat()
    if (fIsActive) {
       TMemStatMng::GetInstance()->Disable();
       TMemStatMng::GetInstance()->Close();
+      TStorage::EnableSlabAllocator(fSlabAllocator);
    }
 }
 
@@ -166,3 +178,29 @@ void TMemStat::Show(Double_t update, Int_t nbigleaks, const char* fname)
    TString action = TString::Format("TMemStatShow::Show(%g,%d,\"%s\");",update,nbigleaks,fname);
    gROOT->ProcessLine(action);
 }
+
+//______________________________________________________________________________
+void TMemStat::PrintSlabStatistics()
+{
+   // Print the statistics of the TStorage slab allocator: for each block
+   // size the number of allocations and deallocations, the number of
+   // blocks in use and the memory reserved in slabs.
+
+   Printf("Slab allocator statistics (%s)",
+          TStorage::HasSlabAllocator() ? "enabled" : "disabled");
+   Printf("%8s%14s%14s%14s%10s%12s", "size", "alloc", "free", "in use", "slabs", "kbytes");
+   Printf("========================================================================");
+   Long64_t nalloc, nfree, nchunks;
+   Long64_t talloc = 0, tfree = 0, tchunks = 0;
+   const Long64_t kbytes = (Long64_t)TStorage::GetSlabChunkSize()/1024;
+   for (Int_t i = 0; i < TStorage::GetSlabClasses(); i++) {
+      TStorage::GetSlabStatistics(i, nalloc, nfree, nchunks);
+      if (!nchunks) continue;
+      Printf("%8d%14lld%14lld%14lld%10lld%12lld", (Int_t)TStorage::GetSlabClassSize(i),
+             nalloc, nfree, nalloc-nfree, nchunks, nchunks*kbytes);
+      talloc += nalloc; tfree += nfree; tchunks += nchunks;
+   }
+   Printf("------------------------------------------------------------------------");
+   Printf("%8s%14lld%14lld%14lld%10lld%12lld", "total", talloc, tfree, talloc-tfree,
+          tchunks, tchunks*kbytes);
+}
@@ -25,19 +25,45 @@
 
 class TSQLStatement : public TObject {
 
+public:
+   enum EBulkType { kBulkInt = 1, kBulkUInt, kBulkLong64, kBulkULong64, kBulkFloat, kBulkDouble, kBulkString };
+
 protected:
+   #ifdef __CINT__
+   struct BulkColumn_t;
+   #else
+   struct BulkColumn_t {
+      Int_t       fCol;       // column number in result set
+      Int_t       fType;      // type of values in array, see EBulkType
+      char       *fArr;       // user array for column values
+      Int_t       fSize;      // size of one array element
+      Bool_t     *fNulls;     // optional user array, marking NULL values
+   };
+   #endif
+
    TSQLStatement(Bool_t errout = kTRUE) : TObject(), fErrorCode(0),
-     fErrorMsg(), fErrorOut(errout) { ClearError(); }
+     fErrorMsg(), fErrorOut(errout), fBulk(0), fNumBulk(0) { ClearError(); }
 
-   Int_t     fErrorCode;  // error code of last operation
-   TString   fErrorMsg;   // error message of last operation
-   Bool_t    fErrorOut;   // enable error output 
+   Int_t         fErrorCode;  // error code of last operation
+   TString       fErrorMsg;   // error message of last operation
+   Bool_t        fErrorOut;   // enable error output 
+   BulkColumn_t *fBulk;       //! columns, bound for bulk fetch
+   Int_t         fNumBulk;    //! number of bound columns
 
    void                ClearError();
    void                SetError(Int_t code, const char* msg, const char* method = 0);
 
+   virtual Bool_t      FetchBulkRow(Int_t row);
+   void                SetBulkNull(BulkColumn_t& col, Int_t row);
+   void                SetBulkNumeric(BulkColumn_t& col, Int_t row, long double value);
+   void                SetBulkString(BulkColumn_t& col, Int_t row, const char* value, Int_t len = -1);
+
+private:
+   TSQLStatement(const TSQLStatement&);            // not implemented
+   TSQLStatement& operator=(const TSQLStatement&); // not implemented
+
 public:
-   virtual ~TSQLStatement() {}
+   virtual ~TSQLStatement() { ResetBulk(); }
 
    virtual Int_t       GetBufferLength() const = 0;
    virtual Int_t       GetNumParameters() = 0;
@@ -111,6 +137,18 @@ public:
    virtual Bool_t      GetVDouble(Int_t, std::vector<Double_t>&) { return kFALSE; }
 #endif
 
+           Bool_t      BindBulkColumn(Int_t ncol, Int_t type, void* arr, Int_t size = 0, Bool_t* nulls = 0);
+           Bool_t      BindBulkInt(Int_t ncol, Int_t* arr, Bool_t* nulls = 0) { return BindBulkColumn(ncol, kBulkInt, arr, 0, nulls); }
+           Bool_t      BindBulkUInt(Int_t ncol, UInt_t* arr, Bool_t* nulls = 0) { return BindBulkColumn(ncol, kBulkUInt, arr, 0, nulls); }
+           Bool_t      BindBulkLong64(Int_t ncol, Long64_t* arr, Bool_t* nulls = 0) { return BindBulkColumn(ncol, kBulkLong64, arr, 0, nulls); }
+           Bool_t      BindBulkULong64(Int_t ncol, ULong64_t* arr, Bool_t* nulls = 0) { return BindBulkColumn(ncol, kBulkULong64, arr, 0, nulls); }
+           Bool_t      BindBulkFloat(Int_t ncol, Float_t* arr, Bool_t* nulls = 0) { return BindBulkColumn(ncol, kBulkFloat, arr, 0, nulls); }
+           Bool_t      BindBulkDouble(Int_t ncol, Double_t* arr, Bool_t* nulls = 0) { return BindBulkColumn(ncol, kBulkDouble, arr, 0, nulls); }
+           Bool_t      BindBulkString(Int_t ncol, char* arr, Int_t maxsize, Bool_t* nulls = 0) { return BindBulkColumn(ncol, kBulkString, arr, maxsize, nulls); }
+           Int_t       GetNumBulkColumns() const { return fNumBulk; }
+           void        ResetBulk();
+   virtual Int_t       FetchBulk(Int_t maxrows);
+
    virtual Bool_t      IsError() const { return GetErrorCode()!=0; }
    virtual Int_t       GetErrorCode() const;
    virtual const char* GetErrorMsg() const;
@@ -197,10 +197,39 @@
 // column must be retrieved at once. Therefore very big data of 
 // gigabytes size may cause a problem.
 //
+// 6. Bulk fetch of result rows
+// ============================
+// Instead of accessing each value of the result set with GetInt(), GetDouble()
+// and other methods, values of many rows can be copied at once into arrays,
+// provided by the user. For each column an array of the correspondent type
+// should be bound with BindBulkInt(), BindBulkDouble(), BindBulkString() and
+// so on, optionally together with Bool_t array marking NULL values.
+// FetchBulk() shifts to next result rows and fills arrays. It returns number
+// of rows filled, which is less than requested only at the end of result set:
+//
+//    const Int_t nbulk = 1000;
+//    Int_t id1[nbulk]; Double_t value[nbulk]; char name[nbulk][64];
+//    stmt->BindBulkInt(0, id1);
+//    stmt->BindBulkDouble(1, value);
+//    stmt->BindBulkString(2, name[0], 64);
+//    Int_t nrows = 0;
+//    while ((nrows = stmt->FetchBulk(nbulk)) > 0)
+//       for (Int_t n=0;n<nrows;n++)
+//          cout << id1[n] << "  " << value[n] << "  " << name[n] << endl;
+//
+// Depending on the driver, values are copied directly from driver buffers
+// (MySQL, ODBC) or converted from text representation (PgSQL). Generic
+// implementation uses GetInt(), GetDouble() and other methods.
+// TTreeSQL::ImportStatement() uses this to fill TTree from result set.
+//
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "TSQLStatement.h"
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 ClassImp(TSQLStatement)
 
 //______________________________________________________________________________
@@ -382,3 +411,187 @@ TDatime TSQLStatement::GetTimestamp(Int_t npar)
    return TDatime(year, month, day, hour, min, sec);
 }
 
+//______________________________________________________________________________
+Bool_t TSQLStatement::BindBulkColumn(Int_t ncol, Int_t type, void* arr, Int_t size, Bool_t* nulls)
+{
+   // Bind user array for values of column ncol, used by FetchBulk() method.
+   // Type should be one of EBulkType values. For kBulkString size specifies
+   // maximum string length (including terminating zero) of each array element,
+   // for other types size is not used. Optional nulls array marks NULL values.
+
+   ClearError();
+
+   if ((ncol<0) || (arr==0)) {
+      SetError(-1, "Invalid column number or array pointer", "BindBulkColumn");
+      return kFALSE;
+   }
+
+   Int_t elemsize = 0;
+   switch (type) {
+      case kBulkInt:     elemsize = sizeof(Int_t); break;
+      case kBulkUInt:    elemsize = sizeof(UInt_t); break;
+      case kBulkLong64:  elemsize = sizeof(Long64_t); break;
+      case kBulkULong64: elemsize = sizeof(ULong64_t); break;
+      case kBulkFloat:   elemsize = sizeof(Float_t); break;
+      case kBulkDouble:  elemsize = sizeof(Double_t); break;
+      case kBulkString:  elemsize = size; break;
+   }
+
+   if (elemsize<=0) {
+      SetError(-1, "Invalid type or size of array element", "BindBulkColumn");
+      return kFALSE;
+   }
+
+   Int_t indx = 0;
+   while ((indx<fNumBulk) && (fBulk[indx].fCol!=ncol)) indx++;
+
+   if (indx==fNumBulk) {
+      BulkColumn_t* bulk = new BulkColumn_t[fNumBulk+1];
+      for (Int_t n=0;n<fNumBulk;n++) bulk[n] = fBulk[n];
+      delete[] fBulk;
+      fBulk = bulk;
+      fNumBulk++;
+   }
+
+   fBulk[indx].fCol = ncol;
+   fBulk[indx].fType = type;
+   fBulk[indx].fArr = (char*) arr;
+   fBulk[indx].fSize = elemsize;
+   fBulk[indx].fNulls = nulls;
+
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+void TSQLStatement::ResetBulk()
+{
+   // Remove all arrays, bound for bulk fetch
+
+   delete[] fBulk;
+   fBulk = 0;
+   fNumBulk = 0;
+}
+
+//______________________________________________________________________________
+Int_t TSQLStatement::FetchBulk(Int_t maxrows)
+{
+   // Fetch up to maxrows next rows of the result set into arrays, bound
+   // with BindBulkInt(), BindBulkDouble() and other methods.
+   // Arrays should have at least maxrows elements.
+   // Returns number of filled rows, 0 when result set is finished.
+   // Returns -1 if a row cannot be fetched or copied into the arrays: the
+   // error is then kept (see IsError() and GetErrorMsg()) and the content
+   // of the arrays is undefined.
+   // StoreResult() should be called before.
+
+   ClearError();
+
+   if ((fNumBulk==0) || (maxrows<=0)) return 0;
+
+   Int_t nrows = 0;
+   while ((nrows<maxrows) && NextResultRow()) {
+      if (!FetchBulkRow(nrows)) {
+         if (!IsError()) SetError(-1, Form("Cannot fetch row %d into bound arrays", nrows), "FetchBulk");
+         return -1;
+      }
+      nrows++;
+   }
+
+   if (IsError()) return -1;
+
+   return nrows;
+}
+
+//______________________________________________________________________________
+Bool_t TSQLStatement::FetchBulkRow(Int_t row)
+{
+   // Copy values of current result row into row element of bound arrays.
+   // Generic implementation, which uses GetInt(), GetDouble() and other methods.
+   // Drivers can reimplement it with direct access to their buffers.
+
+   for (Int_t n=0;n<fNumBulk;n++) {
+      BulkColumn_t& col = fBulk[n];
+      if (IsNull(col.fCol)) {
+         SetBulkNull(col, row);
+         continue;
+      }
+      if (col.fNulls) col.fNulls[row] = kFALSE;
+      char* addr = col.fArr + row*col.fSize;
+      switch (col.fType) {
+         case kBulkInt:     *((Int_t*) addr) = GetInt(col.fCol); break;
+         case kBulkUInt:    *((UInt_t*) addr) = GetUInt(col.fCol); break;
+         case kBulkLong64:  *((Long64_t*) addr) = GetLong64(col.fCol); break;
+         case kBulkULong64: *((ULong64_t*) addr) = GetULong64(col.fCol); break;
+         case kBulkFloat:   *((Float_t*) addr) = (Float_t) GetDouble(col.fCol); break;
+         case kBulkDouble:  *((Double_t*) addr) = GetDouble(col.fCol); break;
+         case kBulkString:  SetBulkString(col, row, GetString(col.fCol)); break;
+      }
+   }
+
+   return !IsError();
+}
+
+//______________________________________________________________________________
+void TSQLStatement::SetBulkNull(BulkColumn_t& col, Int_t row)
+{
+   // Set element of bound array to zero and mark it as NULL
+
+   memset(col.fArr + row*col.fSize, 0, col.fSize);
+   if (col.fNulls) col.fNulls[row] = kTRUE;
+}
+
+//______________________________________________________________________________
+void TSQLStatement::SetBulkNumeric(BulkColumn_t& col, Int_t row, long double value)
+{
+   // Store numeric value in element of bound array
+
+   if (col.fNulls) col.fNulls[row] = kFALSE;
+   char* addr = col.fArr + row*col.fSize;
+   switch (col.fType) {
+      case kBulkInt:     *((Int_t*) addr) = (Int_t) value; break;
+      case kBulkUInt:    *((UInt_t*) addr) = (UInt_t) value; break;
+      case kBulkLong64:  *((Long64_t*) addr) = (Long64_t) value; break;
+      case kBulkULong64: *((ULong64_t*) addr) = (ULong64_t) value; break;
+      case kBulkFloat:   *((Float_t*) addr) = (Float_t) value; break;
+      case kBulkDouble:  *((Double_t*) addr) = (Double_t) value; break;
+      case kBulkString:  SetBulkString(col, row, TString::Format("%.15Lg", value).Data()); break;
+   }
+}
+
+//______________________________________________________________________________
+void TSQLStatement::SetBulkString(BulkColumn_t& col, Int_t row, const char* value, Int_t len)
+{
+   // Store string value in element of bound array. For numeric columns
+   // string is converted to number. If len<0, value is zero-terminated string.
+
+   if (col.fNulls) col.fNulls[row] = kFALSE;
+   char* addr = col.fArr + row*col.fSize;
+
+   if (value==0) { value = ""; len = 0; }
+
+   if (col.fType!=kBulkString) {
+      // value may be not zero-terminated
+      char buf[64];
+      if (len>=0) {
+         if (len>63) len = 63;
+         memcpy(buf, value, len);
+         buf[len] = 0;
+         value = buf;
+      }
+      char* end = 0;
+      switch (col.fType) {
+         case kBulkInt:     *((Int_t*) addr) = (Int_t) strtol(value, &end, 10); break;
+         case kBulkUInt:    *((UInt_t*) addr) = (UInt_t) strtoul(value, &end, 10); break;
+         case kBulkLong64:  if (sscanf(value, "%lld", (Long64_t*) addr)!=1) *((Long64_t*) addr) = 0; break;
+         case kBulkULong64: if (sscanf(value, "%llu", (ULong64_t*) addr)!=1) *((ULong64_t*) addr) = 0; break;
+         case kBulkFloat:   *((Float_t*) addr) = (Float_t) strtod(value, &end); break;
+         case kBulkDouble:  *((Double_t*) addr) = strtod(value, &end); break;
+      }
+      return;
+   }
+
+   if (len<0) len = strlen(value);
+   if (len>col.fSize-1) len = col.fSize-1;
+   memcpy(addr, value, len);
+   addr[len] = 0;
+}
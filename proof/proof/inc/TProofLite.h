@@ -51,6 +51,7 @@ private:
    TString  fSockPath;    // UNIX socket path for communication with workers
    TServerSocket *fServSock; // Server socket to accept call backs
    Bool_t   fForkStartup; // Startup N-1 workers forking the first worker
+   TString  fSharedOutDir; // Directory where workers save their output lists (shared output mode)
 
    TString  fVarExp;      // Internal variable to pass drawing options
    TString  fSelection;   // Internal variable to pass drawing options
@@ -198,6 +198,7 @@ private:
 
    // Results handling
    Int_t         SendResults(TSocket *sock, TList *outlist = 0, TQueryResult *pq = 0);
+   Int_t         SendResultsViaFile(TSocket *sock, TList *outlist, const char *dir);
    Bool_t        AcceptResults(Int_t connections, TVirtualProofPlayer *mergerPlayer);
    
    Int_t         RegisterDataSets(TList *in, TList *out);
@@ -370,6 +370,10 @@ TProofLite::~TProofLite()
    // Cleanup the socket
    SafeDelete(fServSock);
    gSystem->Unlink(fSockPath);
+
+   // Remove the directory for the shared output, if any
+   if (!fSharedOutDir.IsNull())
+      gSystem->Exec(Form("%s %s", kRM, fSharedOutDir.Data()));
 }
 
 //______________________________________________________________________________
@@ -1016,6 +1020,39 @@ Long64_t TProofLite::Process(TDSet *dset, const char *selector, Option_t *option
    if (!fPlayer->GetInputList()->FindObject("PROOF_MaxSlavesPerNode"))
       SetParameter("PROOF_MaxSlavesPerNode", (Long_t)fNWorkers);
 
+   // Shared output mode: the workers save their output lists in files under a
+   // local directory instead of sending them object by object; the player
+   // merges each list as it arrives. The directory is 'ProofLite.SharedOutputDir',
+   // if set and writable, otherwise /dev/shm, if it exists and is writable,
+   // otherwise the sandbox; the temporary directory is the last resort
+   TObject *shdir = fPlayer->GetInputList()->FindObject("PROOF_SharedOutputDir");
+   if (shdir) {
+      fPlayer->GetInputList()->Remove(shdir);
+      delete shdir;
+   }
+   Int_t sharedOutput = -1;
+   if (TProof::GetParameter(fPlayer->GetInputList(), "PROOF_SharedOutput", sharedOutput) != 0)
+      sharedOutput = gEnv->GetValue("ProofLite.SharedOutput", 0);
+   if (sharedOutput > 0) {
+      if (fSharedOutDir.IsNull()) {
+         TString shbase = gEnv->GetValue("ProofLite.SharedOutputDir", "");
+         if (shbase.IsNull() || gSystem->AccessPathName(shbase, kWritePermission))
+            shbase = "/dev/shm";
+         if (gSystem->AccessPathName(shbase, kWritePermission))
+            shbase = fQueryDir;
+         if (gSystem->AccessPathName(shbase, kWritePermission))
+            shbase = gSystem->TempDirectory();
+         fSharedOutDir.Form("%s/proof-output-%d", shbase.Data(), gSystem->GetPid());
+         if (gSystem->AccessPathName(fSharedOutDir) &&
+             gSystem->mkdir(fSharedOutDir, kTRUE) != 0) {
+            Warning("Process", "could not create %s: shared output disabled", fSharedOutDir.Data());
+            fSharedOutDir = "";
+         }
+      }
+      if (!fSharedOutDir.IsNull())
+         fPlayer->AddInput(new TNamed("PROOF_SharedOutputDir", fSharedOutDir.Data()));
+   }
+
    Bool_t hasNoData = (!dset || (dset && dset->TestBit(TDSet::kEmpty))) ? kTRUE : kFALSE;
 
    // If just a name was given to identify the dataset, retrieve it from the
@@ -3892,9 +3892,16 @@ void TProofServ::HandleProcess(TMessage *mess, TString *slb)
          // Sub-master OR worker not in merging mode
          // ---------------------------------------------
          if (fPlayer->GetExitStatus() != TVirtualProofPlayer::kAborted && fPlayer->GetOutputList()) {
-            PDB(kGlobal, 2)  Info("HandleProcess", "sending result directly to master");
-            if (SendResults(fSocket, fPlayer->GetOutputList()) != 0)
-               Warning("HandleProcess","problems sending output list");
+            // PROOF-Lite shared output mode: save the list in the shared directory
+            TNamed *shd = (!IsMaster() && fPlayer->GetInputList()) ?
+               dynamic_cast<TNamed *>(fPlayer->GetInputList()->FindObject("PROOF_SharedOutputDir")) : 0;
+            if (shd && SendResultsViaFile(fSocket, fPlayer->GetOutputList(), shd->GetTitle()) == 0) {
+               PDB(kGlobal, 2)  Info("HandleProcess", "result saved in %s", shd->GetTitle());
+            } else {
+               PDB(kGlobal, 2)  Info("HandleProcess", "sending result directly to master");
+               if (SendResults(fSocket, fPlayer->GetOutputList()) != 0)
+                  Warning("HandleProcess","problems sending output list");
+            }
          } else {
             if (fPlayer->GetExitStatus() != TVirtualProofPlayer::kAborted)
                Warning("HandleProcess","the output list is empty!");
@@ -3949,6 +3956,47 @@ void TProofServ::HandleProcess(TMessage *mess, TString *slb)
    return;
 }
 
+//______________________________________________________________________________
+Int_t TProofServ::SendResultsViaFile(TSocket *sock, TList *outlist, const char *dir)
+{
+   // Save the output list in a file under 'dir' (chosen by the PROOF-Lite
+   // master, on a memory file system if available) and send to the master only
+   // the path of the file, via a TNamed named 'PROOF_SharedOutputFile'. Used by
+   // the PROOF-Lite workers in shared output mode: the master reads and merges
+   // each list as it arrives, avoiding to stream each object through the socket.
+   // Return 0 on success, -1 if the file could not be written (nothing is sent
+   // in such a case).
+
+   if (!outlist || !dir || strlen(dir) <= 0) return -1;
+
+   TString path = TString::Format("%s/output-%s-%d.root", dir, fOrdinal.Data(),
+                                                          gSystem->GetPid());
+   {  TDirectory::TContext ctxt(0);
+      TFile *f = TFile::Open(path, "RECREATE");
+      if (!f || f->IsZombie()) {
+         Warning("SendResultsViaFile", "could not create file %s", path.Data());
+         SafeDelete(f);
+         gSystem->Unlink(path);
+         return -1;
+      }
+      // The file lives only until the master has read it: do not compress
+      f->SetCompressionLevel(0);
+      Int_t nb = outlist->Write("PROOF_OutputList", TObject::kSingleKey);
+      f->Close();
+      delete f;
+      if (nb <= 0) {
+         Warning("SendResultsViaFile", "could not write the output list to %s", path.Data());
+         gSystem->Unlink(path);
+         return -1;
+      }
+   }
+
+   TList shlist;
+   shlist.SetOwner(kTRUE);
+   shlist.Add(new TNamed("PROOF_SharedOutputFile", path.Data()));
+   return SendResults(sock, &shlist);
+}
+
 //______________________________________________________________________________
 Int_t TProofServ::SendResults(TSocket *sock, TList *outlist, TQueryResult *pq)
 {
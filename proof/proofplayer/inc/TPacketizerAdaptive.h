@@ -83,6 +83,11 @@ private:
                                        // It can be set with PROOF_PacketAsAFraction in input list.
    Int_t          fStrategy;           // 0 means the classic and 1 (default) - the adaptive strategy
    Int_t          fTryReassign;        // Controls attempts to reassign packets (0 == no reassignment)
+   Long64_t       fClusterSize;        // Entries per tree cluster: packet boundaries are aligned
+                                       // to multiples of it (0 == no alignment)
+   Bool_t         fWorkStealing;       // If kTRUE, split the remaining ranges at the end of the query
+                                       // and let idle workers take from the largest active files
+   Bool_t         fTailReported;       // kTRUE once the tail metrics have been sent to TPerfStats
 
    TPacketizerAdaptive();
    TPacketizerAdaptive(const TPacketizerAdaptive&);    // no implementation, will generate
@@ -97,8 +102,12 @@ private:
 
    TFileStat     *GetNextUnAlloc(TFileNode *node = 0, const char *nodeHostName = 0);
    TFileStat     *GetNextActive();
+   TFileStat     *GetLargestActive();
    void           RemoveActive(TFileStat *file);
 
+   Long64_t       GetEntriesLeft();
+   void           ReportTail();
+
    void           Reset();
    void           ValidateFiles(TDSet *dset, TList *slaves, Long64_t maxent = -1, Bool_t byfile = kFALSE);
    Int_t          ReassignPacket(TDSetElement *e, TList **listOfMissingFiles);
@@ -90,12 +90,15 @@ private:
    TH2D          *fLatencyHist;  //!histogram of latency due to packet requests
    TH2D          *fProcTimeHist; //!histogram of real time spent processing packets
    TH2D          *fCpuTimeHist;  //!histogram of cpu time spent processing packets
+   TH1D          *fIdleTimeHist; //!histogram of idle time per slave in the tail of the query
    Long64_t       fBytesRead;    //!track bytes read of main file
    Double_t       fTotCpuTime;   //!total cpu time of all slaves
    Long64_t       fTotBytesRead; //!total bytes read on all slaves
    Long64_t       fTotEvents;    //!total number of events processed
    Long64_t       fNumEvents;    //!total number of events to be processed
    Int_t          fSlaves;       //!number of active slaves
+   Double_t       fTailTime;     //!longest idle time of a slave in the tail of the query
+   Double_t       fTotIdleTime;  //!total idle time of the slaves in the tail of the query
 
    Bool_t         fDoHist;       //!Fill histos
    Bool_t         fDoTrace;      //!Trace details in master
@@ -128,6 +131,7 @@ public:
                     Double_t proctime, Double_t cputime, Long64_t bytesRead);
    void FileEvent(const char *slave, const char *slavename, const char *nodename, const char *filename,
                   Bool_t isStart);
+   void TailEvent(const char *slave, const char *slavename, Double_t idletime);
 
    void FileOpenEvent(TFile *file, const char *filename, Double_t start);
    void FileReadEvent(TFile *file, Int_t len, Double_t start);
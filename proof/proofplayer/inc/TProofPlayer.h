@@ -266,6 +266,7 @@ protected:
    TDSet              *fDSet;          //!tdset for current processing
    ErrorHandlerFunc_t  fErrorHandler;  // Store previous handler when redirecting output
    Bool_t              fUseTH1Merge;   // If kTRUE forces use of TH1::Merge [kFALSE]
+   THashList          *fSharedOutput;  // Merged output lists saved by the PROOF-Lite workers
 
    virtual Bool_t  HandleTimer(TTimer *timer);
    Int_t           InitPacketizer(TDSet *dset, Long64_t nentries,
@@ -273,6 +274,7 @@ protected:
                                   const char *defpackdata);
    TList          *MergeFeedback();
    Bool_t          MergeOutputFiles();
+   void            MergeSharedOutput(const char *path);
    void            NotifyMemory(TObject *obj);
    void            SetLastMergingMsg(TObject *obj);
    virtual Bool_t  SendSelector(const char *selector_file); //send selector to slaves
@@ -285,7 +287,7 @@ public:
    TProofPlayerRemote(TProof *proof = 0) : fProof(proof), fOutputLists(0), fFeedback(0),
                                            fFeedbackLists(0), fPacketizer(0),
                                            fMergeFiles(kFALSE), fDSet(0), fErrorHandler(0),
-                                           fUseTH1Merge(kFALSE)
+                                           fUseTH1Merge(kFALSE), fSharedOutput(0)
                                            { fProgressStatus = new TProofProgressStatus(); }
    virtual ~TProofPlayerRemote();   // Owns the fOutput list
    virtual Long64_t Process(TDSet *set, const char *selector,
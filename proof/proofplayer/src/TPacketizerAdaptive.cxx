@@ -92,6 +92,8 @@ public:
    TDSetElement  *GetElement() const {return fElement;}
    Long64_t       GetNextEntry() const {return fNextEntry;}
    void           MoveNextEntry(Long64_t step) {fNextEntry += step;}
+   Long64_t       GetEntriesLeft() const
+                     { return fElement->GetFirst() + fElement->GetNum() - fNextEntry; }
 
    // This method is used to keep a sorted list of remaining files to be processed
    Int_t          Compare(const TObject* obj) const
@@ -252,6 +254,24 @@ public:
       return (TFileStat *) next;
    }
 
+   TFileStat *GetLargestActive(Long64_t &left) const
+   {
+      // Return the active file with the largest number of entries not yet
+      // assigned to a packet; 'left' is set to that number
+
+      TFileStat *largest = 0;
+      left = 0;
+      TIter nxf(fActFiles);
+      TFileStat *fs = 0;
+      while ((fs = (TFileStat *) nxf())) {
+         if (fs->GetEntriesLeft() > left) {
+            left = fs->GetEntriesLeft();
+            largest = fs;
+         }
+      }
+      return largest;
+   }
+
    void RemoveActive(TFileStat *file)
    {
       if (fActFileNext == file) fActFileNext = fActFiles->After(file);
@@ -343,6 +363,7 @@ private:
    Long64_t       fCurProcessed; // events processed in the current file
    Float_t        fCurProcTime;  // proc time spent on the current file
    TList         *fDSubSet;      // packets processed by this worker
+   Double_t       fIdleSince;    // time at which the worker ran out of work (-1 if busy)
 
 public:
    TSlaveStat(TSlave *slave);
@@ -366,7 +387,7 @@ public:
 //______________________________________________________________________________
 TPacketizerAdaptive::TSlaveStat::TSlaveStat(TSlave *slave)
    : fFileNode(0), fCurFile(0), fCurElem(0),
-     fCurProcessed(0), fCurProcTime(0)
+     fCurProcessed(0), fCurProcTime(0), fIdleSince(-1.)
 {
    // Constructor
 
@@ -466,6 +487,9 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
    fStrategy = 1;
    fFilesToProcess = new TSortedList;
    fFilesToProcess->SetOwner(kFALSE);
+   fClusterSize = 0;
+   fWorkStealing = kFALSE;
+   fTailReported = kFALSE;
 
    if (!fProgressStatus) {
       Error("TPacketizerAdaptive", "No progress status");
@@ -570,6 +594,29 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
    if (fTryReassign != 0)
       Info("TPacketizerAdaptive", "failed packets will be re-assigned");
 
+   // Alignment of the packet boundaries to the tree clusters (entries per cluster,
+   // e.g. the auto-flush setting of the trees): packets ending in the middle of a
+   // cluster force the baskets of that cluster to be read by two workers
+   Long64_t clusterSize = -1;
+   if (TProof::GetParameter(input, "PROOF_PacketizerClusterSize", clusterSize) != 0) {
+      Int_t clsz = -1;
+      if (TProof::GetParameter(input, "PROOF_PacketizerClusterSize", clsz) != 0)
+         clsz = gEnv->GetValue("Packetizer.ClusterSize", 0);
+      clusterSize = clsz;
+   }
+   if (clusterSize > 0) {
+      fClusterSize = clusterSize;
+      Info("TPacketizerAdaptive", "aligning packets to clusters of %lld entries", fClusterSize);
+   }
+
+   // Work stealing at the end of the query (off by default): the entries left
+   // are split among the workers and idle workers take from the active files
+   // with most entries left instead of cycling over the active nodes
+   Int_t workStealing = -1;
+   if (TProof::GetParameter(input, "PROOF_PacketizerWorkStealing", workStealing) != 0)
+      workStealing = gEnv->GetValue("Packetizer.WorkStealing", 0);
+   fWorkStealing = (workStealing != 0) ? kTRUE : kFALSE;
+
    // Save the config parameters in the dedicated list so that they will be saved
    // in the outputlist and therefore in the relevant TQueryResult
    fConfigParams->Add(new TParameter<Int_t>("PROOF_PacketizerCachePacketSync", (Int_t)fCachePacketSync));
@@ -578,6 +625,8 @@ TPacketizerAdaptive::TPacketizerAdaptive(TDSet *dset, TList *slaves,
    fConfigParams->Add(new TParameter<Int_t>("PROOF_MaxWorkersPerNode", (Int_t)fMaxSlaveCnt));
    fConfigParams->Add(new TParameter<Int_t>("PROOF_ForceLocal", (Int_t)fForceLocal));
    fConfigParams->Add(new TParameter<Int_t>("PROOF_PacketAsAFraction", fPacketAsAFraction));
+   fConfigParams->Add(new TParameter<Long64_t>("PROOF_PacketizerClusterSize", fClusterSize));
+   fConfigParams->Add(new TParameter<Int_t>("PROOF_PacketizerWorkStealing", (Int_t)fWorkStealing));
 
    Double_t baseLocalPreference = 1.2;
    fBaseLocalPreference = (Float_t)baseLocalPreference;
@@ -1043,6 +1092,42 @@ TPacketizerAdaptive::TFileStat *TPacketizerAdaptive::GetNextActive()
 }
 
 
+//______________________________________________________________________________
+TPacketizerAdaptive::TFileStat *TPacketizerAdaptive::GetLargestActive()
+{
+   // Get the active file with the largest number of entries not yet assigned,
+   // over all the active nodes not exceeding the workers-per-node limit.
+   // Used at the end of the query to let idle workers help on the largest
+   // remaining ranges.
+
+   TFileStat *file = 0;
+   Long64_t maxleft = 0;
+   TList empty;
+   TIter nxn(fActive);
+   TFileNode *node = 0;
+   while ((node = (TFileNode *) nxn())) {
+      if (node->GetNumberOfActiveFiles() == 0) {
+         empty.Add(node);
+         continue;
+      }
+      if (fMaxSlaveCnt > 0 && node->GetExtSlaveCnt() >= fMaxSlaveCnt) continue;
+      Long64_t left = 0;
+      TFileStat *fs = node->GetLargestActive(left);
+      if (fs && left > maxleft) {
+         maxleft = left;
+         file = fs;
+      }
+   }
+   TIter nxe(&empty);
+   while ((node = (TFileNode *) nxe()))
+      RemoveActiveNode(node);
+
+   PDB(kPacketizer,2)
+      if (file) Info("GetLargestActive", "%s: %lld entries left",
+                                         file->GetElement()->GetName(), maxleft);
+   return file;
+}
+
 //______________________________________________________________________________
 TPacketizerAdaptive::TFileNode *TPacketizerAdaptive::NextActiveNode()
 {
@@ -1714,6 +1799,8 @@ TDSetElement *TPacketizerAdaptive::GetNextPacket(TSlave *sl, TMessage *r)
             // Send last timer message and stop the timer
             HandleTimer(0);
             SafeDelete(fProgress);
+            // Idle time of the workers waiting for the end of the query
+            ReportTail();
          }
       } else {
          if (file) {
@@ -1864,9 +1951,14 @@ TDSetElement *TPacketizerAdaptive::GetNextPacket(TSlave *sl, TMessage *r)
 
       // Then look at the active filenodes
       if(file == 0 && !fForceLocal)
-         file = GetNextActive();
+         file = fWorkStealing ? GetLargestActive() : GetNextActive();
 
-      if (file == 0) return 0;
+      if (file == 0) {
+         // Nothing left for this worker: record when it became idle
+         if (slstat->fIdleSince < 0)
+            slstat->fIdleSince = Long64_t(gSystem->Now()) / (Double_t)1000.;
+         return 0;
+      }
 
       PDB(kPacketizer,3) if (fFilesToProcess) fFilesToProcess->Print();
 
@@ -1898,6 +1990,29 @@ TDSetElement *TPacketizerAdaptive::GetNextPacket(TSlave *sl, TMessage *r)
    Long64_t first = file->GetNextEntry();
    Long64_t last = base->GetFirst() + base->GetNum();
 
+   // At the end of the query share the entries left among the workers, so that
+   // no worker gets a last packet much longer than the others
+   if (fWorkStealing) {
+      Int_t nwrk = fSlaveStats->GetSize();
+      Long64_t left = GetEntriesLeft();
+      if (nwrk > 1 && left < num * nwrk) {
+         Long64_t share = (left / nwrk > 0) ? left / nwrk : 1;
+         if (share < num) {
+            PDB(kPacketizer,2)
+               Info("GetNextPacket", "%s: tail: %lld entries left, packet size %lld -> %lld",
+                                     sl->GetOrdinal(), left, num, share);
+            num = share;
+         }
+      }
+   }
+
+   // Align the end of the packet to a cluster boundary
+   if (fClusterSize > 0) {
+      Long64_t end = ((first + num + fClusterSize / 2) / fClusterSize) * fClusterSize;
+      if (end <= first) end = (first / fClusterSize + 1) * fClusterSize;
+      num = end - first;
+   }
+
    // If the remaining part is smaller than the (packetsize * 1.5)
    // then increase the packetsize
 
@@ -1911,6 +2026,7 @@ TDSetElement *TPacketizerAdaptive::GetNextPacket(TSlave *sl, TMessage *r)
    // Update NextEntry in the file object
    file->MoveNextEntry(num);
 
+   slstat->fIdleSince = -1.;
    slstat->fCurElem = CreateNewPacket(base, first, num);
    if (base->GetEntryList())
       slstat->fCurElem->SetEntryList(base->GetEntryList(), first, num);
@@ -1927,6 +2043,52 @@ TDSetElement *TPacketizerAdaptive::GetNextPacket(TSlave *sl, TMessage *r)
    return slstat->fCurElem;
 }
 
+//______________________________________________________________________________
+Long64_t TPacketizerAdaptive::GetEntriesLeft()
+{
+   // Return the number of entries neither processed nor assigned to the
+   // packets currently being processed
+
+   Long64_t left = fTotalEntries - fProgressStatus->GetEntries();
+   TIter nxw(fSlaveStats);
+   TObject *key;
+   while ((key = nxw())) {
+      TSlaveStat *wrkstat = (TSlaveStat *) fSlaveStats->GetValue(key);
+      if (wrkstat && wrkstat->fCurElem) left -= wrkstat->fCurElem->GetNum();
+   }
+   return (left > 0) ? left : 0;
+}
+
+//______________________________________________________________________________
+void TPacketizerAdaptive::ReportTail()
+{
+   // Report to TPerfStats the time spent idle by the workers which ran out of
+   // work before the end of the query. Called once, when the last entries
+   // have been processed.
+
+   if (fTailReported) return;
+   fTailReported = kTRUE;
+
+   Double_t now = Long64_t(gSystem->Now()) / (Double_t)1000.;
+   TPerfStats *perfstats = dynamic_cast<TPerfStats *>(gPerfStats);
+   Double_t tail = 0.;
+   Int_t nidle = 0;
+   TIter nxw(fSlaveStats);
+   TObject *key;
+   while ((key = nxw())) {
+      TSlaveStat *wrkstat = (TSlaveStat *) fSlaveStats->GetValue(key);
+      if (wrkstat && wrkstat->fIdleSince >= 0) {
+         Double_t idle = now - wrkstat->fIdleSince;
+         if (idle > tail) tail = idle;
+         nidle++;
+         if (perfstats)
+            perfstats->TailEvent(wrkstat->GetOrdinal(), wrkstat->GetName(), idle);
+      }
+   }
+   PDB(kPacketizer,1)
+      Info("ReportTail", "%d worker(s) idle at the end of the query; tail: %.3f s", nidle, tail);
+}
+
 //______________________________________________________________________________
 Int_t TPacketizerAdaptive::GetActiveWorkers()
 {
@@ -117,9 +117,9 @@ Long_t TPerfStats::fgResMemMax = -1;
 //______________________________________________________________________________
 TPerfStats::TPerfStats(TList *input, TList *output)
    : fTrace(0), fPerfEvent(0), fPacketsHist(0), fEventsHist(0), fLatencyHist(0),
-      fProcTimeHist(0), fCpuTimeHist(0), fBytesRead(0),
+      fProcTimeHist(0), fCpuTimeHist(0), fIdleTimeHist(0), fBytesRead(0),
       fTotCpuTime(0.), fTotBytesRead(0), fTotEvents(0), fNumEvents(0),
-      fSlaves(0), fDoHist(kFALSE),
+      fSlaves(0), fTailTime(0.), fTotIdleTime(0.), fDoHist(kFALSE),
       fDoTrace(kFALSE), fDoTraceRate(kFALSE), fDoSlaveTrace(kFALSE), fDoQuota(kFALSE),
       fMonitorPerPacket(kFALSE), fMonSenders(3),
       fDataSet("+++none+++"), fDataSetSize(-1), fOutput(output)
@@ -251,6 +251,14 @@ TPerfStats::TPerfStats(TList *input, TList *output)
       fCpuTimeHist->SetBit(TH1::kCanRebin);
       output->Add(fCpuTimeHist);
 
+      gDirectory->RecursiveRemove(gDirectory->FindObject("PROOF_IdleTimeHist"));
+      fIdleTimeHist = new TH1D("PROOF_IdleTimeHist", "Idle Time per Worker in the Query Tail",
+                               fSlaves, 0, fSlaves);
+      fIdleTimeHist->SetFillColor(kRed);
+      fIdleTimeHist->SetDirectory(0);
+      fIdleTimeHist->SetMinimum(0);
+      output->Add(fIdleTimeHist);
+
       nextslaveinfo.Reset();
       Int_t slavebin=1;
       while (TSlaveInfo *si = dynamic_cast<TSlaveInfo*>(nextslaveinfo())) {
@@ -261,6 +269,7 @@ TPerfStats::TPerfStats(TList *input, TList *output)
             fLatencyHist->GetXaxis()->SetBinLabel(slavebin, si->GetOrdinal());
             fProcTimeHist->GetXaxis()->SetBinLabel(slavebin, si->GetOrdinal());
             fCpuTimeHist->GetXaxis()->SetBinLabel(slavebin, si->GetOrdinal());
+            fIdleTimeHist->GetXaxis()->SetBinLabel(slavebin, si->GetOrdinal());
             slavebin++;
          }
       }
@@ -340,6 +349,15 @@ void TPerfStats::SimpleEvent(EEventType type)
       fNodeHist->LabelsOption("auv","X");
    }
 
+   if (type == kStop && fTailTime > 0. && fOutput) {
+      // Summary of the tail of the query, i.e. the time during which some
+      // workers were idle waiting for the last packets to be processed
+      PDB(kMonitoring,1)
+         Info("SimpleEvent", "tail: %.3f s (total idle time: %.3f s)", fTailTime, fTotIdleTime);
+      fOutput->Add(new TParameter<Double_t>("PROOF_TailTime", fTailTime));
+      fOutput->Add(new TParameter<Double_t>("PROOF_TotIdleTime", fTotIdleTime));
+   }
+
    if (type == kStop && fDoQuota)
       WriteQueryLog();
 
@@ -494,6 +512,22 @@ void TPerfStats::FileEvent(const char *slave, const char *slavename, const char
    }
 }
 
+//______________________________________________________________________________
+void TPerfStats::TailEvent(const char *slave, const char *slavename, Double_t idletime)
+{
+   // Tail event: 'slave' ran out of work 'idletime' seconds before the end of
+   // the query, while other workers were still processing their last packets.
+
+   PDB(kMonitoring,1)
+      Info("TailEvent", "%s (%s): idle for %.3f s", slave, slavename, idletime);
+
+   if (idletime > fTailTime) fTailTime = idletime;
+   fTotIdleTime += idletime;
+
+   if (fDoHist && fIdleTimeHist != 0)
+      fIdleTimeHist->Fill(slave, idletime);
+}
+
 //______________________________________________________________________________
 void TPerfStats::FileOpenEvent(TFile *file, const char *filename, Double_t start)
 {
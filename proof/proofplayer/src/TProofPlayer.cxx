@@ -1387,6 +1387,7 @@ TProofPlayerRemote::~TProofPlayerRemote()
 
    SafeDelete(fOutput);      // owns the output list
    SafeDelete(fOutputLists);
+   SafeDelete(fSharedOutput);
 
    // Objects stored in maps are already deleted when merging the feedback
    SafeDelete(fFeedbackLists);
@@ -2324,6 +2325,16 @@ void TProofPlayerRemote::MergeOutput()
 
    PDB(kOutput,1) Info("MergeOutput","Enter");
 
+   // Output lists saved by the workers in shared output mode, already merged
+   if (fSharedOutput) {
+      TObject *o = 0;
+      while ((o = fSharedOutput->First())) {
+         fSharedOutput->Remove(o);
+         if (AddOutputObject(o) == 1) delete o;
+      }
+      SafeDelete(fSharedOutput);
+   }
+
    TObject *obj = 0;
    if (fOutputLists) {
 
@@ -2431,6 +2442,100 @@ void TProofPlayerRemote::MergeOutput()
    PDB(kOutput,1) Info("MergeOutput","leave (%d object(s))", fOutput->GetSize());
 }
 
+//______________________________________________________________________________
+static void MergeSharedLists(THashList *into, THashList *from)
+{
+   // Merge the objects in 'from' into the objects with the same name in 'into'.
+   // Objects without a counterpart or which cannot be merged are moved to 'into';
+   // the merged ones are left in 'from'.
+
+   TList moved, one;
+   TIter nxo(from);
+   TObject *o = 0;
+   while ((o = nxo())) {
+      Bool_t merged = kFALSE;
+      TObject *dst = into->FindObject(o->GetName());
+      if (dst) {
+         one.Add(o);
+         if (dst->InheritsFrom(TH1::Class())) {
+            merged = (((TH1 *)dst)->Merge(&one) >= 0) ? kTRUE : kFALSE;
+         } else {
+            TMethodCall callEnv;
+            if (dst->IsA())
+               callEnv.InitWithPrototype(dst->IsA(), "Merge", "TCollection*");
+            if (callEnv.IsValid()) {
+               callEnv.SetParam((Long_t) &one);
+               callEnv.Execute(dst);
+               merged = kTRUE;
+            }
+         }
+         one.Clear();
+      }
+      if (!merged) moved.Add(o);
+   }
+   TIter nxm(&moved);
+   while ((o = nxm())) {
+      from->Remove(o);
+      into->Add(o);
+   }
+}
+
+//______________________________________________________________________________
+void TProofPlayerRemote::MergeSharedOutput(const char *path)
+{
+   // Read the output list saved by a PROOF-Lite worker in the file 'path' and
+   // merge it into the lists received so far, using hashed look-ups; the list
+   // and the file are freed right away, so that at most one worker list is in
+   // memory in addition to the merged one. The merge is done serially: the
+   // Merge methods are called through the interpreter and not all of them are
+   // thread safe. The merged objects are incorporated in the output list by
+   // MergeOutput, as if they were sent by a worker.
+
+   PDB(kOutput,1) Info("MergeSharedOutput", "enter: %s", path);
+
+   TList *l = 0;
+   {  TDirectory::TContext ctxt(0);
+      TFile *f = TFile::Open(path);
+      if (f && !f->IsZombie())
+         l = dynamic_cast<TList *>(f->Get("PROOF_OutputList"));
+      SafeDelete(f);
+   }
+   gSystem->Unlink(path);
+   if (!l) {
+      Error("MergeSharedOutput", "could not read the output list from %s", path);
+      return;
+   }
+
+   // Special objects are incorporated in the output list as they are
+   THashList *hl = new THashList;
+   TIter nxo(l);
+   TObject *o = 0;
+   while ((o = nxo())) {
+      if (o->InheritsFrom(TH1::Class())) ((TH1 *)o)->SetDirectory(0);
+      if (o->InheritsFrom(TProofOutputFile::Class()) ||
+          !strcmp(o->GetName(), "PROOF_EventListsList")) {
+         if (AddOutputObject(o) == 1) delete o;
+      } else {
+         hl->Add(o);
+      }
+   }
+   l->SetOwner(kFALSE);
+   delete l;
+
+   if (!fSharedOutput) {
+      // The first list is taken as it is
+      fSharedOutput = hl;
+      fSharedOutput->SetOwner(kTRUE);
+   } else {
+      MergeSharedLists(fSharedOutput, hl);
+      // The merged list is not needed anymore
+      hl->Delete();
+      delete hl;
+   }
+
+   PDB(kOutput,1) Info("MergeSharedOutput", "done (%d object(s))", fSharedOutput->GetSize());
+}
+
 //______________________________________________________________________________
 void TProofPlayerRemote::Progress(Long64_t total, Long64_t processed)
 {
@@ -2541,6 +2646,14 @@ Int_t TProofPlayerRemote::AddOutputObject(TObject *obj)
    if (!fOutput)
       fOutput = new TList;
 
+   // Output list saved in a file by a PROOF-Lite worker in shared output mode:
+   // it is read and merged with the lists of the other workers as it arrives
+   if (obj->IsA() == TNamed::Class() && !strcmp(obj->GetName(), "PROOF_SharedOutputFile")) {
+      PDB(kOutput,1) Info("AddOutputObject","output list saved in %s", obj->GetTitle());
+      MergeSharedOutput(obj->GetTitle());
+      return 1;
+   }
+
    // Flag about merging
    Bool_t merged = kTRUE;
 
@@ -70,6 +70,8 @@ protected:
    void        SetBuffersNumber(Int_t n);
 
    void       *BeforeSet(const char* method, Int_t npar, Int_t sqltype, Bool_t sig = kTRUE, unsigned long size = 0);
+
+   virtual Bool_t FetchBulkRow(Int_t row);
    
    static ULong64_t fgAllocSizeLimit;
 
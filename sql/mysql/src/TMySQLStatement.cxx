@@ -245,6 +245,59 @@ Bool_t TMySQLStatement::NextResultRow()
    return res;
 }
 
+//______________________________________________________________________________
+Bool_t TMySQLStatement::FetchBulkRow(Int_t row)
+{
+   // Copy values of current result row into arrays, bound for bulk fetch.
+   // If type of array matches type of fetch buffer, value is copied directly,
+   // otherwise it is converted.
+
+   for (Int_t n=0;n<fNumBulk;n++) {
+      BulkColumn_t& col = fBulk[n];
+      Int_t npar = col.fCol;
+
+      if ((npar<0) || (npar>=fNumBuffers)) {
+         SetError(-1, Form("Invalid column number %d", npar), "FetchBulkRow");
+         return kFALSE;
+      }
+
+      void* addr = fBuffer[npar].fMem;
+
+      if (fBuffer[npar].fResNull || (addr==0)) {
+         SetBulkNull(col, row);
+         continue;
+      }
+
+      Int_t bulktype = 0; // type of array, which matches fetch buffer
+      switch (fBind[npar].buffer_type) {
+         case MYSQL_TYPE_LONG:       bulktype = fBuffer[npar].fSign ? kBulkInt : kBulkUInt; break;
+         case MYSQL_TYPE_LONGLONG:   bulktype = fBuffer[npar].fSign ? kBulkLong64 : kBulkULong64; break;
+         case MYSQL_TYPE_FLOAT:      bulktype = kBulkFloat; break;
+         case MYSQL_TYPE_DOUBLE:     bulktype = kBulkDouble; break;
+         case MYSQL_TYPE_STRING:
+         case MYSQL_TYPE_VAR_STRING: bulktype = kBulkString; break;
+         default: break;
+      }
+
+      if (bulktype==col.fType) {
+         if (bulktype==kBulkString) {
+            Int_t len = fBuffer[npar].fResLength;
+            if (len>fBuffer[npar].fSize) len = fBuffer[npar].fSize;
+            SetBulkString(col, row, (const char*) addr, len);
+         } else {
+            memcpy(col.fArr + row*col.fSize, addr, col.fSize);
+            if (col.fNulls) col.fNulls[row] = kFALSE;
+         }
+      } else
+      if (col.fType==kBulkString)
+         SetBulkString(col, row, ConvertToString(npar));
+      else
+         SetBulkNumeric(col, row, ConvertToNumeric(npar));
+   }
+
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 Bool_t TMySQLStatement::NextIteration()
 {
@@ -1126,6 +1179,14 @@ Bool_t TMySQLStatement::NextResultRow()
 }
 
 
+//______________________________________________________________________________
+Bool_t TMySQLStatement::FetchBulkRow(Int_t)
+{
+   // Copy values of current result row into arrays, bound for bulk fetch.
+
+   return kFALSE;
+}
+
 //______________________________________________________________________________
 Bool_t TMySQLStatement::NextIteration()
 {
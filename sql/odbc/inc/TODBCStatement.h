@@ -76,6 +76,8 @@ protected:
    Bool_t      IsParSettMode() const { return fWorkingMode==1; }
    Bool_t      IsResultSet() const { return fWorkingMode==2; }
 
+   virtual Bool_t FetchBulkRow(Int_t row);
+
 public:
    TODBCStatement(SQLHSTMT stmt, Int_t rowarrsize, Bool_t errout = kTRUE);
    virtual ~TODBCStatement();
@@ -26,6 +26,7 @@
 
 #include <sqlext.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define kSqlTime      123781
 #define kSqlDate      123782
@@ -673,6 +674,57 @@ const char* TODBCStatement::ConvertToString(Int_t npar)
    return buf;
 }
 
+//______________________________________________________________________________
+Bool_t TODBCStatement::FetchBulkRow(Int_t row)
+{
+   // Copy values of current result row into arrays, bound for bulk fetch.
+   // Rows are fetched by ODBC into column-wise buffers, therefore values are
+   // copied directly if type of array matches C type of the buffer.
+
+   for (Int_t n=0;n<fNumBulk;n++) {
+      BulkColumn_t& col = fBulk[n];
+      Int_t npar = col.fCol;
+
+      void* addr = GetParAddr(npar);
+      if (addr==0) {
+         if (IsError()) return kFALSE;
+         SetBulkNull(col, row);
+         continue;
+      }
+
+      Int_t len = fBuffer[npar].fBlenarray[fBufferCounter];
+      if (len == SQL_NULL_DATA) {
+         SetBulkNull(col, row);
+         continue;
+      }
+
+      Int_t bulktype = 0; // type of array, which matches buffer
+      switch (fBuffer[npar].fBsqlctype) {
+         case SQL_C_SLONG:   if (sizeof(SQLINTEGER)==sizeof(Int_t)) bulktype = kBulkInt; break;
+         case SQL_C_ULONG:   if (sizeof(SQLUINTEGER)==sizeof(UInt_t)) bulktype = kBulkUInt; break;
+         case SQL_C_SBIGINT: bulktype = kBulkLong64; break;
+         case SQL_C_UBIGINT: bulktype = kBulkULong64; break;
+         case SQL_C_FLOAT:   bulktype = kBulkFloat; break;
+         case SQL_C_DOUBLE:  bulktype = kBulkDouble; break;
+         case SQL_C_CHAR:    bulktype = kBulkString; break;
+      }
+
+      if ((bulktype==kBulkString) || (col.fType==kBulkString)) {
+         if (bulktype!=kBulkString)
+            SetBulkString(col, row, ConvertToString(npar));
+         else
+            SetBulkString(col, row, (const char*) addr, len < fBuffer[npar].fBelementsize ? len : fBuffer[npar].fBelementsize);
+      } else
+      if (bulktype==col.fType) {
+         memcpy(col.fArr + row*col.fSize, addr, col.fSize);
+         if (col.fNulls) col.fNulls[row] = kFALSE;
+      } else
+         SetBulkNumeric(col, row, ConvertToNumeric(npar));
+   }
+
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 Bool_t TODBCStatement::IsNull(Int_t npar)
 {
@@ -68,6 +68,8 @@ private:
    void        FreeBuffers();
    void        SetBuffersNumber(Int_t n);
 
+   virtual Bool_t FetchBulkRow(Int_t row);
+
 public:
    TPgSQLStatement(PgSQL_Stmt_t* stmt, Bool_t errout = kTRUE);
    virtual ~TPgSQLStatement();
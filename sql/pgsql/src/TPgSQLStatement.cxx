@@ -224,6 +224,31 @@ Bool_t TPgSQLStatement::NextResultRow()
    return res;
 }
 
+//______________________________________________________________________________
+Bool_t TPgSQLStatement::FetchBulkRow(Int_t row)
+{
+   // Copy values of current result row into arrays, bound for bulk fetch.
+   // Values are converted directly from text representation of the result.
+
+   for (Int_t n=0;n<fNumBulk;n++) {
+      BulkColumn_t& col = fBulk[n];
+      Int_t npar = col.fCol;
+
+      if ((npar<0) || (npar>=fNumResultCols)) {
+         SetError(-1, Form("Invalid column number %d", npar), "FetchBulkRow");
+         return kFALSE;
+      }
+
+      if (PQgetisnull(fStmt->fRes, fIterationCount, npar))
+         SetBulkNull(col, row);
+      else
+         SetBulkString(col, row, PQgetvalue(fStmt->fRes, fIterationCount, npar),
+                       PQgetlength(fStmt->fRes, fIterationCount, npar));
+   }
+
+   return kTRUE;
+}
+
 //______________________________________________________________________________
 Bool_t TPgSQLStatement::NextIteration()
 {
@@ -723,6 +748,14 @@ Bool_t TPgSQLStatement::NextResultRow()
 }
 
 
+//______________________________________________________________________________
+Bool_t TPgSQLStatement::FetchBulkRow(Int_t)
+{
+   // Copy values of current result row into arrays, bound for bulk fetch.
+
+   return kFALSE;
+}
+
 //______________________________________________________________________________
 Bool_t TPgSQLStatement::NextIteration()
 {
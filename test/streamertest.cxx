@@ -0,0 +1,180 @@
+// @(#)root/test:$Id$
+// Author: agent   18/10/26
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Round trip test of the streamers compiled by rootcint                //
+// --compiled-streamers against the StreamerInfo actions.               //
+//                                                                      //
+// For each class the object is written with the compiled streamer and  //
+// with the StreamerInfo actions; the two buffers must be identical.    //
+// The buffer is then read back with both paths, and the objects must   //
+// be equal to the original. Finally the object is written and read     //
+// with TBufferFile::WriteObjectAny/ReadObjectAny, which go through     //
+// TBufferFile::WriteClassBuffer/ReadClassBuffer.                       //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TStreamerInfo.h"
+#include "TStreamerInfoActions.h"
+
+#include "streamertest.h"
+
+ClassImp(TFlatHit)
+ClassImp(TFlatHeader)
+
+//______________________________________________________________________________
+TFlatHit::TFlatHit() : fId(0), fValid(kFALSE), fLayer(0), fChannel(0), fTime(0),
+                       fEnergy(0), fKind(kNone), fCache(0)
+{
+   // Default constructor.
+
+   fPos[0] = fPos[1] = fPos[2] = 0;
+}
+
+//______________________________________________________________________________
+void TFlatHit::Set(Int_t id)
+{
+   // Fill the hit with values depending on id.
+
+   SetUniqueID(id + 7);
+   fId      = id;
+   fValid   = (id % 2) != 0;
+   fLayer   = -id;
+   fChannel = 4000000000U - id;
+   fTime    = 1000000000000LL * id + 3;
+   fPos[0]  = 1.5f * id;
+   fPos[1]  = -2.25f * id;
+   fPos[2]  = 0.125f;
+   fEnergy  = 3.14159 * id;
+   fKind    = (id % 3) ? kShower : kTrack;
+   fSamples.clear();
+   for (Int_t i = 0; i < id; ++i) fSamples.push_back(0.5f * i);
+   fCache   = id;
+}
+
+//______________________________________________________________________________
+Bool_t TFlatHit::IsSame(const TFlatHit &hit) const
+{
+   // Compare the persistent data members of the two hits.
+
+   return GetUniqueID() == hit.GetUniqueID() && fId == hit.fId &&
+          fValid == hit.fValid && fLayer == hit.fLayer &&
+          fChannel == hit.fChannel && fTime == hit.fTime &&
+          !memcmp(fPos, hit.fPos, sizeof(fPos)) && fEnergy == hit.fEnergy &&
+          fKind == hit.fKind && fSamples == hit.fSamples;
+}
+
+//______________________________________________________________________________
+TFlatHeader::TFlatHeader() : fRun(0), fEvent(0)
+{
+   // Default constructor.
+
+   memset(fTag, 0, sizeof(fTag));
+   for (Int_t i = 0; i < 4; ++i) fWeights[i] = 0;
+}
+
+//______________________________________________________________________________
+void TFlatHeader::Set(Int_t run, UInt_t event)
+{
+   // Fill the header.
+
+   fRun   = run;
+   fEvent = event;
+   snprintf(fTag, sizeof(fTag), "r%de%u", run, event);
+   for (Int_t i = 0; i < 4; ++i) fWeights[i] = run * 0.25 + i;
+}
+
+//______________________________________________________________________________
+Bool_t TFlatHeader::IsSame(const TFlatHeader &header) const
+{
+   // Compare the persistent data members of the two headers.
+
+   return fRun == header.fRun && fEvent == header.fEvent &&
+          !memcmp(fTag, header.fTag, sizeof(fTag)) &&
+          !memcmp(fWeights, header.fWeights, sizeof(fWeights));
+}
+
+//______________________________________________________________________________
+template <class T> Bool_t RoundTrip(const T &obj)
+{
+   // Check that the compiled streamer of T and its StreamerInfo write the
+   // same bytes and read them back to objects equal to obj.
+
+   TClass *cl = T::Class();
+   TStreamerInfo *info = (TStreamerInfo*)cl->GetStreamerInfo();
+   ClassStreamerFunc_t compiled = cl->GetCompiledStreamerFunc();
+   if (!info || !compiled) {
+      printf("%s has no compiled streamer\n", cl->GetName());
+      return kFALSE;
+   }
+   void *ptr = const_cast<T*>(&obj);
+
+   // Write with both paths.
+   TBufferFile bcomp(TBuffer::kWrite);
+   TBufferFile binfo(TBuffer::kWrite);
+   (*compiled)(bcomp, ptr);
+   binfo.ApplySequence(*info->GetWriteObjectWiseActions(), ptr);
+   if (bcomp.Length() != binfo.Length() ||
+       memcmp(bcomp.Buffer(), binfo.Buffer(), bcomp.Length())) {
+      printf("%s: the compiled streamer wrote %d bytes, the StreamerInfo %d bytes\n",
+             cl->GetName(), bcomp.Length(), binfo.Length());
+      return kFALSE;
+   }
+
+   // Read back with both paths.
+   TBufferFile bread(TBuffer::kRead, binfo.Length(), binfo.Buffer(), kFALSE);
+   T rcomp;
+   (*compiled)(bread, &rcomp);
+   Int_t ncomp = bread.Length();
+   bread.SetBufferOffset(0);
+   T rinfo;
+   bread.ApplySequence(*info->GetReadObjectWiseActions(), &rinfo);
+   if (ncomp != binfo.Length() || bread.Length() != binfo.Length()) {
+      printf("%s: %d bytes written, %d read by the compiled streamer, %d by the StreamerInfo\n",
+             cl->GetName(), binfo.Length(), ncomp, bread.Length());
+      return kFALSE;
+   }
+   if (!obj.IsSame(rcomp) || !obj.IsSame(rinfo)) {
+      printf("%s: the objects read back differ\n", cl->GetName());
+      return kFALSE;
+   }
+
+   // Complete object, with the class version and byte count.
+   TBufferFile bobj(TBuffer::kWrite);
+   bobj.WriteObjectAny(ptr, cl);
+   bobj.SetReadMode();
+   bobj.SetBufferOffset(0);
+   T *robj = (T*)bobj.ReadObjectAny(cl);
+   Bool_t same = robj && obj.IsSame(*robj);
+   delete robj;
+   if (!same) {
+      printf("%s: the object read by ReadObjectAny differs\n", cl->GetName());
+   }
+   return same;
+}
+
+//______________________________________________________________________________
+int main()
+{
+   Int_t nfail = 0;
+   for (Int_t id = 0; id < 4; ++id) {
+      TFlatHit hit;
+      hit.Set(id);
+      Bool_t ok = RoundTrip(hit);
+      printf("Test TFlatHit    %d .............................. %s\n", id, ok ? "OK" : "FAILED");
+      if (!ok) ++nfail;
+
+      TFlatHeader header;
+      header.Set(100 + id, 4000000000U + id);
+      ok = RoundTrip(header);
+      printf("Test TFlatHeader %d .............................. %s\n", id, ok ? "OK" : "FAILED");
+      if (!ok) ++nfail;
+   }
+   return nfail ? 1 : 0;
+}
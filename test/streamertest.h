@@ -0,0 +1,68 @@
+// @(#)root/test:$Id$
+// Author: agent   18/10/26
+
+#ifndef ROOT_streamertest
+#define ROOT_streamertest
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Classes of the program streamertest. Their dictionary is generated   //
+// with rootcint --compiled-streamers, so that they get a streamer      //
+// compiled for their layout.                                           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_TObject
+#include "TObject.h"
+#endif
+
+#include <vector>
+
+
+class TFlatHit : public TObject {
+
+public:
+   enum EKind { kNone, kTrack, kShower };
+
+private:
+   Int_t                 fId;        //Hit identifier
+   Bool_t                fValid;     //Validity flag
+   Short_t               fLayer;     //Layer number
+   UInt_t                fChannel;   //Readout channel
+   Long64_t              fTime;      //Time stamp
+   Float_t               fPos[3];    //Position
+   Double_t              fEnergy;    //Deposited energy
+   EKind                 fKind;      //Kind of hit
+   std::vector<Float_t>  fSamples;   //Pulse samples
+   Int_t                 fCache;     //!Transient, not streamed
+
+public:
+   TFlatHit();
+   virtual ~TFlatHit() { }
+
+   void          Set(Int_t id);
+   Bool_t        IsSame(const TFlatHit &hit) const;
+
+   ClassDef(TFlatHit,1)  //Hit with a compiled streamer
+};
+
+
+class TFlatHeader {
+
+private:
+   Int_t      fRun;          //Run number
+   UInt_t     fEvent;        //Event number
+   Char_t     fTag[8];       //Event tag
+   Double_t   fWeights[4];   //Event weights
+
+public:
+   TFlatHeader();
+   virtual ~TFlatHeader() { }
+
+   void          Set(Int_t run, UInt_t event);
+   Bool_t        IsSame(const TFlatHeader &header) const;
+
+   ClassDef(TFlatHeader,1)  //Header without TObject base, with a compiled streamer
+};
+
+#endif
@@ -545,6 +545,7 @@ Int_t PT_EventRange(void *);
 Int_t PT_POFNtuple(void *);
 Int_t PT_POFDataset(void *);
 Int_t PT_Friends(void *);
+Int_t PT_H1SharedOutput(void *);
 
 // Arguments structures
 typedef struct {            // Open
@@ -741,6 +742,8 @@ int stressProof(const char *url, Int_t nwrks, Int_t verbose, const char *logfile
    Bool_t sameFile = kTRUE;
    testList->Add(new ProofTest("TTree friends, same file", 24,
                                &PT_Friends, (void *)&sameFile, "1", "ProofFriends,ProofAux"));
+   // H1 analysis with the output lists merged in PROOF-Lite shared output mode
+   testList->Add(new ProofTest("H1: shared output mode", 25, &PT_H1SharedOutput, 0, "1", "h1analysis"));
 
    // The selectors
    gSystem->ExpandPathName(gH1Sel);
@@ -802,7 +805,7 @@ int stressProof(const char *url, Int_t nwrks, Int_t verbose, const char *logfile
             printf("*  Non-positive test number: %d\n", test);
             continue;
          }
-         const int tmx = 24;
+         const int tmx = 25;
          if (test > tmx) {
             printf("*                                                               **\r");
             printf("*  Unknown test number: %d\n", test);
@@ -3236,3 +3239,108 @@ Int_t PT_Friends(void *sf)
    return PT_CheckFriends(gProof->GetQueryResult(), nevt * nwrk);
 }
 
+
+//_____________________________________________________________________________
+Int_t PT_H1SharedOutput(void *)
+{
+   // Test run for the H1 analysis as a file collection, with the output lists
+   // saved by the workers in files and merged by the master (PROOF-Lite shared
+   // output mode); the merged histograms must be identical to those obtained
+   // when the objects are sent and merged one by one
+
+   // Checking arguments
+   PutPoint();
+   if (!gProof) {
+      printf("\n >>> Test failure: no PROOF session found\n");
+      return -1;
+   }
+
+   // Set/unset the parallel unzip flag
+   AssertParallelUnzip();
+
+   // Create the file collection
+   PutPoint();
+   TFileCollection *fc = new TFileCollection("h42");
+
+   // Assert the files, if needed
+   if (!gh1ok) {
+      if (PT_H1AssertFiles(gh1src.Data()) != 0) {
+         printf("\n >>> Test failure: could not assert the H1 files\n");
+         return -1;
+      }
+   }
+   Int_t i = 0;
+   for (i = 0; i < 4; i++) {
+      fc->Add(new TFileInfo(TString::Format("%s/%s", gh1src.Data(), gh1file[i])));
+   }
+
+   // Process first with the objects sent through the sockets
+   PutPoint();
+   if (gProof->GetQueryResults()) gProof->GetQueryResults()->Clear();
+   gProof->SetParameter("PROOF_SharedOutput", (Int_t)0);
+   gProof->SetPrintProgress(&PrintStressProgress);
+   gProof->Process(fc, gH1Sel.Data());
+   gProof->SetPrintProgress(0);
+   if (PT_CheckH1(gProof->GetQueryResult()) != 0) {
+      gProof->DeleteParameters("PROOF_SharedOutput");
+      return -1;
+   }
+   const char *hnam[2] = { "hdmd", "h2" };
+   TH1 *href[2] = { 0, 0 };
+   TList *out = gProof->GetQueryResult()->GetOutputList();
+   for (i = 0; i < 2; i++) {
+      href[i] = (TH1 *) out->FindObject(hnam[i])->Clone();
+      href[i]->SetDirectory(0);
+   }
+
+   // Now in shared output mode
+   PutPoint();
+   if (gProof->GetQueryResults()) gProof->GetQueryResults()->Clear();
+   gProof->SetParameter("PROOF_SharedOutput", (Int_t)1);
+   gProof->SetPrintProgress(&PrintStressProgress);
+   gTimer.Start();
+   gProof->Process(fc, gH1Sel.Data());
+   gTimer.Stop();
+   gProof->SetPrintProgress(0);
+
+   // Restore settings
+   gProof->DeleteParameters("PROOF_SharedOutput");
+
+   // Count
+   gH1Cnt++;
+   gH1Time += gTimer.RealTime();
+
+   // Check the results
+   PutPoint();
+   Int_t rc = PT_CheckH1(gProof->GetQueryResult());
+   out = (rc == 0) ? gProof->GetQueryResult()->GetOutputList() : 0;
+   for (i = 0; out && i < 2; i++) {
+      TH1 *h = (TH1 *) out->FindObject(hnam[i]);
+      if (h->GetEntries() != href[i]->GetEntries()) {
+         printf("\n >>> Test failure: '%s' histo: %d entries (expected %d)\n",
+                hnam[i], (Int_t)h->GetEntries(), (Int_t)href[i]->GetEntries());
+         rc = -1;
+         break;
+      }
+      Int_t nbins = (h->GetNbinsX() + 2) * (h->GetNbinsY() + 2) * (h->GetNbinsZ() + 2);
+      if (nbins != (href[i]->GetNbinsX() + 2) * (href[i]->GetNbinsY() + 2) * (href[i]->GetNbinsZ() + 2)) {
+         printf("\n >>> Test failure: '%s' histo: wrong number of bins\n", hnam[i]);
+         rc = -1;
+         break;
+      }
+      for (Int_t ib = 0; ib < nbins; ib++) {
+         if (h->GetBinContent(ib) != href[i]->GetBinContent(ib)) {
+            printf("\n >>> Test failure: '%s' histo: bin %d has content %f (expected %f)\n",
+                   hnam[i], ib, h->GetBinContent(ib), href[i]->GetBinContent(ib));
+            rc = -1;
+            break;
+         }
+      }
+      if (rc != 0) break;
+   }
+   for (i = 0; i < 2; i++) delete href[i];
+
+   // Done
+   PutPoint();
+   return rc;
+}
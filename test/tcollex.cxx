@@ -10,6 +10,7 @@
 #include "TObjArray.h"
 #include "TOrdCollection.h"
 #include "THashTable.h"
+#include "TFlatHashList.h"
 #include "TBtree.h"
 #include "TStopwatch.h"
 
@@ -325,6 +326,80 @@ void Test_THashTable()
    ht2.Delete();
 }
 
+static int CheckFlatHashList(TFlatHashList &l, int nnames)
+{
+   // Check that the index finds exactly the objects of the list.
+
+   int nerr = 0;
+   for (int i = 0; i < nnames; i++) {
+      TString name = TString::Format("key%d", i);
+      int inlist = 0;
+      TIter next(&l);
+      TObject *obj;
+      while ((obj = next()))
+         if (name == obj->GetName()) inlist++;
+      int found = 0;
+      Int_t slot = -1;
+      while ((obj = l.FindNext(name, slot))) {
+         if (name != obj->GetName() || !l.FindObject(obj)) nerr++;
+         found++;
+      }
+      if (found != inlist) nerr++;
+      if ((l.FindObject(name) != 0) != (inlist > 0)) nerr++;
+   }
+   return nerr;
+}
+
+int Test_TFlatHashList()
+{
+   Printf(
+   "////////////////////////////////////////////////////////////////\n"
+   "// Test of TFlatHashList                                      //\n"
+   "////////////////////////////////////////////////////////////////"
+   );
+
+   const int nnames = 300;
+   int i, nerr = 0;
+
+   // Start small so that the index grows several times while filling.
+   TFlatHashList l(16);
+   l.SetOwner(kTRUE);
+
+   Printf("Filling TFlatHashList with two objects per name");
+   for (i = 0; i < nnames; i++)
+      l.Add(new TObjString(TString::Format("key%d", i)));
+   for (i = 0; i < nnames; i++) {
+      TString name = TString::Format("key%d", i);
+      l.AddBefore(l.FindObject(name), new TObjString(name));
+   }
+   Printf("Number of slots: %d, objects: %d, average collisions: %f",
+          l.GetCapacity(), l.GetSize(), l.AverageCollisions());
+   nerr += CheckFlatHashList(l, nnames);
+
+   Printf("Remove and delete one object of every third name, both of every fifth");
+   for (i = 0; i < nnames; i++) {
+      TString name = TString::Format("key%d", i);
+      if (i % 3 == 0) delete l.Remove(l.FindObject(name));
+      if (i % 5 == 0)
+         while (TObject *obj = l.FindObject(name)) delete l.Remove(obj);
+   }
+   nerr += CheckFlatHashList(l, nnames);
+
+   Printf("Add the removed objects again and rehash");
+   for (i = 0; i < nnames; i += 5)
+      l.AddFirst(new TObjString(TString::Format("key%d", i)));
+   nerr += CheckFlatHashList(l, nnames);
+   l.Rehash(l.GetSize());
+   nerr += CheckFlatHashList(l, nnames);
+
+   Printf("Delete all heap based objects");
+   l.Delete("slow");
+   if (l.GetSize() || l.FindObject("key1")) nerr++;
+
+   Printf("TFlatHashList errors: %d", nerr);
+   return nerr;
+}
+
 void Test_TBtree()
 {
    Printf(
@@ -382,9 +457,10 @@ int tcollex() {
    Test_TList();
    Test_TSortedList();
    Test_THashTable();
+   int nerr = Test_TFlatHashList();
    Test_TBtree();
 
-   return 0;
+   return nerr ? 1 : 0;
 }
 
 #ifndef __CINT__
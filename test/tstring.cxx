@@ -187,6 +187,24 @@ int main()
    fs.ReadToken(f2);   // read '//'
    fs.ReadToken(f2);   // read 'Author:'
    Ok(35, fs == "Author:");
+
+   // test formatting, with results shorter and longer than the buffer
+   // used internally by AppendFormat
+   TString s30 = TString::Format("%s %d", "aap", 13);
+   Ok(36, s30 == "aap 13");
+
+   TString s31 = "noot";
+   s31.AppendFormat("[%d][%s]", 2, "mies");
+   Ok(37, s31 == "noot[2][mies]");
+
+   TString longarg('x', 1000);
+   TString s32 = "aap";
+   s32.AppendFormat("%s%d", longarg.Data(), 7);
+   Ok(38, s32.Length() == 1004 && s32.BeginsWith("aapxx") && s32.EndsWith("x7"));
+
+   TString s33;
+   s33.Form("%s|%s", longarg.Data(), longarg.Data());
+   Ok(39, s33.Length() == 2001 && s33(1000) == '|');
    
    return 0;
 }
@@ -0,0 +1,178 @@
+// @(#)root/test:$Id$
+// Author: agent   18/10/26
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Round trip test of TXMLFile with nested subdirectories.              //
+//                                                                      //
+// A file with objects in several levels of subdirectories is written   //
+// and read back. A file opened for reading is parsed in streaming      //
+// mode, where keys only remember their position in the file; the       //
+// objects are therefore read in a different order than they were       //
+// written. The file is then switched to UPDATE mode, with some of the  //
+// subdirectories not yet read, a new object is added, and the file is  //
+// read again: all the objects must be found.                           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <string.h>
+
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TH1F.h"
+#include "TNamed.h"
+#include "TString.h"
+#include "TSystem.h"
+
+static const char *gFileName = "xmltest.xml";
+
+//______________________________________________________________________________
+static TH1F *MakeHist(const char *name, Int_t shift)
+{
+   // Create a histogram with contents depending on shift.
+
+   TH1F *h = new TH1F(name, name, 20, 0., 20.);
+   h->SetDirectory(0);
+   for (Int_t i = 0; i < 200; ++i) h->Fill((i * 7 + shift) % 20, 0.5 + i % 3);
+   return h;
+}
+
+//______________________________________________________________________________
+static Bool_t CheckNamed(TFile *f, const char *path, const char *title)
+{
+   // Read TNamed at path and compare its title.
+
+   TNamed *n = dynamic_cast<TNamed*>(f->Get(path));
+   Bool_t ok = n && !strcmp(n->GetTitle(), title);
+   if (!ok) printf("%s: %s\n", path, n ? "wrong title" : "not found");
+   delete n;
+   return ok;
+}
+
+//______________________________________________________________________________
+static Bool_t CheckHist(TFile *f, const char *path, Int_t shift)
+{
+   // Read histogram at path and compare its contents bin by bin.
+
+   TH1F *h = dynamic_cast<TH1F*>(f->Get(path));
+   if (!h) {
+      printf("%s: not found\n", path);
+      return kFALSE;
+   }
+   h->SetDirectory(0);
+   TH1F *ref = MakeHist("ref", shift);
+   Bool_t ok = (h->GetEntries() == ref->GetEntries());
+   for (Int_t bin = 0; ok && bin <= h->GetNbinsX() + 1; ++bin)
+      ok = (h->GetBinContent(bin) == ref->GetBinContent(bin));
+   if (!ok) printf("%s: wrong contents\n", path);
+   delete ref;
+   delete h;
+   return ok;
+}
+
+//______________________________________________________________________________
+static Bool_t Write()
+{
+   // Write objects in the top directory and in nested subdirectories.
+
+   TFile *f = TFile::Open(gFileName, "RECREATE");
+   if (!f || f->IsZombie()) { delete f; return kFALSE; }
+
+   TNamed top("top", "top title");
+   top.Write();
+   TH1F *h = MakeHist("h", 0);
+   h->Write();
+   delete h;
+
+   TDirectory *a = f->mkdir("a");
+   a->cd();
+   TNamed na("na", "title in a");
+   na.Write();
+   TDirectory *b = a->mkdir("b");
+   b->cd();
+   h = MakeHist("hb", 3);
+   h->Write();
+   delete h;
+   TDirectory *c = b->mkdir("c");
+   c->cd();
+   TNamed nc("nc", "title in c");
+   nc.Write();
+
+   TDirectory *d = f->mkdir("d");
+   d->cd();
+   TNamed nd("nd", "title in d");
+   nd.Write();
+
+   f->Close();
+   delete f;
+   return kTRUE;
+}
+
+//______________________________________________________________________________
+static Bool_t Read(Bool_t updated)
+{
+   // Read all objects, deepest first.
+
+   TFile *f = TFile::Open(gFileName, "READ");
+   if (!f || f->IsZombie()) { delete f; return kFALSE; }
+
+   Bool_t ok = CheckNamed(f, "a/b/c/nc", "title in c");
+   ok = CheckHist(f, "a/b/hb", 3) && ok;
+   ok = CheckNamed(f, "d/nd", "title in d") && ok;
+   ok = CheckNamed(f, "top", "top title") && ok;
+   ok = CheckNamed(f, "a/na", "title in a") && ok;
+   ok = CheckHist(f, "h", 0) && ok;
+   if (updated) ok = CheckNamed(f, "a/b/added", "added in b") && ok;
+
+   delete f;
+   return ok;
+}
+
+//______________________________________________________________________________
+static Bool_t Update()
+{
+   // Open the file for reading, read one subdirectory only, switch to
+   // UPDATE mode and add an object in it.
+
+   TFile *f = TFile::Open(gFileName, "READ");
+   if (!f || f->IsZombie()) { delete f; return kFALSE; }
+
+   Bool_t ok = CheckHist(f, "a/b/hb", 3);
+   if (ok && f->ReOpen("UPDATE") < 0) {
+      printf("cannot switch to UPDATE mode\n");
+      ok = kFALSE;
+   }
+   if (ok) {
+      TDirectory *b = f->GetDirectory("a/b");
+      if (b) {
+         b->cd();
+         TNamed added("added", "added in b");
+         added.Write();
+      } else {
+         printf("a/b: not found after ReOpen\n");
+         ok = kFALSE;
+      }
+   }
+
+   f->Close();
+   delete f;
+   return ok;
+}
+
+//______________________________________________________________________________
+int main()
+{
+   Int_t nfail = 0;
+
+   Bool_t ok = Write() && Read(kFALSE);
+   printf("Test write and read nested directories ............. %s\n", ok ? "OK" : "FAILED");
+   if (!ok) ++nfail;
+
+   ok = ok && Update() && Read(kTRUE);
+   printf("Test update and read nested directories ............ %s\n", ok ? "OK" : "FAILED");
+   if (!ok) ++nfail;
+
+   if (!nfail) gSystem->Unlink(gFileName);
+   return nfail ? 1 : 0;
+}
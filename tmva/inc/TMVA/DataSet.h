@@ -104,6 +104,7 @@ namespace TMVA {
       void      SetCurrentEvent( Long64_t ievt         ) const { fCurrentEventIdx = ievt; }
       void      SetCurrentType ( Types::ETreeType type ) const { fCurrentTreeIdx = TreeIndex(type); }
       Types::ETreeType GetCurrentType() const;
+      Long64_t  GetCurrentEventIdx() const { return fCurrentEventIdx; }
 
       void                       SetEventCollection( std::vector<Event*>*, Types::ETreeType );
       const std::vector<Event*>& GetEventCollection( Types::ETreeType type = Types::kMaxTreeType ) const;
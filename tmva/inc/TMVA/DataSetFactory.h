@@ -310,6 +310,8 @@ namespace TMVA {
       // verbosity
       Bool_t                     fVerbose;           //! Verbosity
       TString                    fVerboseLevel;      //! VerboseLevel
+      Int_t                      fCacheSize;         //! size of the TTreeCache used to read the input trees (MB)
+      Int_t                      fChunkSize;         //! number of tree entries read per chunk (0: whole tree)
 
       // the event
       mutable TTree*             fCurrentTree;       //! the tree, events are currently read from
@@ -451,6 +451,12 @@ namespace TMVA {
 
       Bool_t           IsConstructedFromWeightFile() const { return fConstructedFromWeightFile; }
 
+      // fill test tree with classification or regression results
+      virtual void     AddClassifierOutput    ( Types::ETreeType type );
+      virtual void     AddClassifierOutputProb( Types::ETreeType type );
+      virtual void     AddRegressionOutput    ( Types::ETreeType type );
+      virtual void     AddMulticlassOutput    ( Types::ETreeType type );
+
    public:
       virtual void SetCurrentEvent( Long64_t ievt ) const {
          Data()->SetCurrentEvent(ievt);
@@ -486,12 +492,6 @@ namespace TMVA {
       // used for file parsing
       Bool_t           GetLine( std::istream& fin, char * buf );
 
-      // fill test tree with classification or regression results
-      virtual void     AddClassifierOutput    ( Types::ETreeType type );
-      virtual void     AddClassifierOutputProb( Types::ETreeType type );
-      virtual void     AddRegressionOutput    ( Types::ETreeType type );
-      virtual void     AddMulticlassOutput    ( Types::ETreeType type );
-
    private:
 
       void             AddInfoItem( void* gi, const TString& name,
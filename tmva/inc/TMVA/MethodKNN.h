@@ -99,6 +99,10 @@ namespace TMVA
       // get help message text
       void GetHelpMessage() const;
 
+      // evaluate the whole sample with parallel batch queries
+      void AddClassifierOutput( Types::ETreeType type );
+      void AddRegressionOutput( Types::ETreeType type );
+
    private:
 
       // the option handling methods
@@ -121,6 +125,9 @@ namespace TMVA
       
       double getLDAValue(const kNN::List &rlist, const kNN::Event &event_knn);
 
+      // neighbors of the current event, taken from the batch results if available
+      const kNN::List& FindNeighbors(const kNN::Event &event_knn, UInt_t nfind);
+
    private:
 
       // number of events (sumOfWeights)
@@ -142,6 +149,14 @@ namespace TMVA
       Bool_t fUseWeight;      // use weights to count kNN
       Bool_t fUseLDA;         // use local linear discriminat analysis to compute MVA
 
+      Float_t fApproxEps;     // relative distance error of approximate kNN search (0 = exact)
+      Int_t fMaxChecks;       // maximum number of tree nodes checked per approximate search (0 = no limit)
+      Int_t fNThreads;        // number of threads for batch kNN queries during evaluation
+
+      Bool_t fBatchMode;                  //! whole sample is being evaluated
+      Long64_t fBatchFirst;               //! first event of the current batch
+      std::vector<kNN::List> fBatchList;  //! neighbor lists of the current batch
+
       kNN::EventVec fEvent;   //! (untouched) events used for learning
 
       LDA fLDA;               //! Experimental feature for local knn analysis
@@ -125,6 +125,14 @@ namespace TMVA {
 
          Bool_t Find(Event event, UInt_t nfind = 100, const std::string &option = "count") const;
          Bool_t Find(UInt_t nfind, const std::string &option) const;
+
+         // search nearest neighbors of all events, split over nthreads threads
+         Bool_t FindBatch(const EventVec &events, std::vector<List> &result,
+                          UInt_t nfind = 100, const std::string &option = "count",
+                          UInt_t nthreads = 1) const;
+
+         // approximate search: relative distance error and maximum number of checked nodes
+         void SetApprox(Float_t eps, UInt_t nmaxcheck = 0);
       
          const EventVec& GetEventVec() const;
 
@@ -146,6 +154,10 @@ namespace TMVA {
 
          const Event Scale(const Event &event) const;
 
+         void FindList(List &nlist, Event event, UInt_t nfind, const std::string &option) const;
+
+         static void* FindBatchThread(void *arg);
+
       private:
 
          static TRandom3 fgRndm;
@@ -156,6 +168,9 @@ namespace TMVA {
 
          std::map<Int_t, Double_t> fVarScale;
 
+         Float_t fApproxEps;    // relative distance error of approximate search (0 = exact)
+         UInt_t  fApproxChecks; // maximum number of nodes checked by approximate search (0 = no limit)
+
          mutable List  fkNNList;     // latest result from kNN search
          mutable Event fkNNEvent;    // latest event used for kNN search
          
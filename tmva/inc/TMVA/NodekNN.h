@@ -30,6 +30,10 @@
 #include <list>
 #include <string>
 #include <iostream>
+#include <vector>
+#include <queue>
+#include <functional>
+#include <algorithm>
 
 // ROOT
 #ifndef ROOT_Rtypes
@@ -133,6 +137,15 @@ namespace TMVA
       UInt_t Find(std::list<std::pair<const Node<T> *, Float_t> > &nlist,
                   const Node<T> *node, const T &event, Double_t nfind, Double_t ncurr);
 
+      // approximate search for k-nearest neighbor: k = nfind
+      // nodes are visited in order of their lower distance bound, subtrees that
+      // can not improve the current k-th distance by more than a factor (1+eps)
+      // are skipped, at most nmaxcheck nodes are checked (0 = no limit)
+      template<class T>
+      UInt_t FindApprox(std::list<std::pair<const Node<T> *, Float_t> > &nlist,
+                        const Node<T> *node, const T &event, UInt_t nfind,
+                        Float_t eps, UInt_t nmaxcheck);
+
       // recursively travel upward until root node is reached
       template <class T>
       UInt_t Depth(const Node<T> *node);
@@ -546,5 +559,89 @@ UInt_t TMVA::kNN::Find(std::list<std::pair<const TMVA::kNN::Node<T> *, Float_t>
    return count;
 }
 
-#endif
+//-------------------------------------------------------------------------------------------
+template<class T>
+UInt_t TMVA::kNN::FindApprox(std::list<std::pair<const TMVA::kNN::Node<T> *, Float_t> > &nlist,
+                             const TMVA::kNN::Node<T> *node, const T &event, const UInt_t nfind,
+                             const Float_t eps, const UInt_t nmaxcheck)
+{
+   // This is a global templated function that searches for approximate
+   // k-nearest neighbors with a bounded priority (best bin first) search.
+   // Candidate nodes are kept in a priority queue ordered by a lower bound
+   // of the distance between the event and any node in their subtree, 
+   // computed from the minimum and maximum values of the splitting variable.
+   // A subtree is only visited if its bound, enlarged by a factor (1+eps),
+   // is below the distance of the current k-th neighbor, so that each returned
+   // distance is at most (1+eps) times larger than the exact one. 
+   // The search also stops after nmaxcheck checked nodes once k neighbors
+   // have been found. With eps = 0 and nmaxcheck = 0 the search is exact.
+   // Only nodes with positive weights are added to list.
+
+   if (!node || nfind < 1) {
+      return 0;
+   }
+
+   // distances are squared, so is the error factor
+   const Float_t scale = (1.0 + eps)*(1.0 + eps);
+
+   typedef std::pair<Float_t, const Node<T> *> Bound;
+   std::priority_queue<Bound, std::vector<Bound>, std::greater<Bound> > queue;
+   queue.push(Bound(0.0, node));
+
+   UInt_t count = 0;
+   while (!queue.empty()) {
+
+      const Bound top = queue.top();
+      queue.pop();
+
+      if (nlist.size() == nfind) {
+         if (top.first*scale > nlist.back().second) break;
+         if (nmaxcheck > 0 && count >= nmaxcheck) break;
+      }
+
+      const Node<T> *curr = top.second;
+      ++count;
+
+      if (curr->GetWeight() > 0.0) {
+         const Float_t distance = event.GetDist(curr->GetEvent());
 
+         if (nlist.size() < nfind || distance < nlist.back().second) {
+            // need typename keyword because qualified dependent names 
+            // are not valid types unless preceded by 'typename'.
+            typename std::list<std::pair<const Node<T> *, Float_t> >::iterator lit = nlist.begin();
+            for (; lit != nlist.end(); ++lit) {
+               if (distance < lit->second) {
+                  break;
+               }
+            }
+
+            nlist.insert(lit, std::pair<const Node<T> *, Float_t>(curr, distance));
+
+            if (nlist.size() > nfind) {
+               nlist.pop_back();
+            }
+         }
+      }
+
+      const Node<T> *child[2] = { curr->GetNodeL(), curr->GetNodeR() };
+      for (UInt_t i = 0; i < 2; ++i) {
+         if (!child[i]) continue;
+
+         const UInt_t mod = child[i]->GetMod();
+         const Float_t value = event.GetVar(mod);
+
+         Float_t bound = 0.0;
+         if      (value > child[i]->GetVarMax()) bound = event.GetDist(child[i]->GetVarMax(), mod);
+         else if (value < child[i]->GetVarMin()) bound = event.GetDist(child[i]->GetVarMin(), mod);
+         bound = std::max(bound, top.first);
+
+         if (nlist.size() < nfind || !(bound*scale > nlist.back().second)) {
+            queue.push(Bound(bound, child[i]));
+         }
+      }
+   }
+
+   return count;
+}
+
+#endif
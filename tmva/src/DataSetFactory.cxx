@@ -98,6 +98,8 @@ namespace TMVA {
 TMVA::DataSetFactory::DataSetFactory() :
    fVerbose(kFALSE),
    fVerboseLevel(TString("Info")),
+   fCacheSize(30),
+   fChunkSize(0),
    fCurrentTree(0),
    fCurrentEvtIdx(0),
    fInputFormulas(0),
@@ -632,6 +634,11 @@ TMVA::DataSetFactory::InitOptions( TMVA::DataSetInfo& dsi,
    splitSpecs.AddPreDefVal(TString("Verbose"));
    splitSpecs.AddPreDefVal(TString("Info"));
 
+   splitSpecs.DeclareOptionRef( fCacheSize=30, "CacheSize",
+                                "Size in MB of the TTreeCache used to read the input trees (0: no cache)" );
+   splitSpecs.DeclareOptionRef( fChunkSize=0, "ChunkSize",
+                                "Number of tree entries read and cached per chunk (0: the whole tree at once); the selected events are still all kept in memory" );
+
    splitSpecs.ParseOptions();
    splitSpecs.CheckForUnusedOptions();
 
@@ -718,9 +725,31 @@ TMVA::DataSetFactory::BuildEventVector( TMVA::DataSetInfo& dsi,
          // count number of events in tree before cut
          classEventCounts.nInitialEvents += currentInfo.GetTree()->GetEntries();
 
+         // read the entries in chunks through the TTreeCache: the cache learns
+         // the branches used by the formulas on the first entry, then
+         // prefetches the baskets of the current chunk only; the baskets of
+         // a chunk are dropped once it has been read. A chunk never spans
+         // two trees of a chain, so that the baskets are dropped from the
+         // tree they were read from before the chain moves on.
+         const Long64_t nEvts = currentInfo.GetTree()->GetEntries();
+         const Long64_t chunkSize = (fChunkSize > 0 ? Long64_t(fChunkSize) : nEvts);
+         Long64_t chunkEnd = 0;
+         const Long64_t userCacheSize = currentInfo.GetTree()->GetCacheSize();
+         if (fCacheSize > 0) {
+            currentInfo.GetTree()->SetCacheSize( Long64_t(fCacheSize)*1024*1024 );
+            currentInfo.GetTree()->SetCacheLearnEntries( 1 );
+         }
+
          // loop over events in ntuple
-         const UInt_t nEvts = currentInfo.GetTree()->GetEntries();
          for (Long64_t evtIdx = 0; evtIdx < nEvts; evtIdx++) {
+            if (evtIdx >= chunkEnd) {
+               if (evtIdx > 0 && currentInfo.GetTree()->GetTree()) currentInfo.GetTree()->GetTree()->DropBaskets();
+               currentInfo.GetTree()->LoadTree(evtIdx);
+               const TTree* tree = currentInfo.GetTree()->GetTree();
+               chunkEnd = evtIdx+chunkSize;
+               if (tree) chunkEnd = TMath::Min( chunkEnd, tree->GetChainOffset()+tree->GetEntries() );
+               if (fCacheSize > 0) currentInfo.GetTree()->SetCacheEntryRange( evtIdx, chunkEnd );
+            }
             currentInfo.GetTree()->LoadTree(evtIdx);
 
             // may need to reload tree in case of chains
@@ -871,7 +900,9 @@ TMVA::DataSetFactory::BuildEventVector( TMVA::DataSetInfo& dsi,
                event_v.push_back(new Event(vars, tgts , vis, cl , weight));
             }
          }
+         if (currentInfo.GetTree()->GetTree()) currentInfo.GetTree()->GetTree()->DropBaskets();
          currentInfo.GetTree()->ResetBranchAddresses();
+         if (fCacheSize > 0) currentInfo.GetTree()->SetCacheSize( userCacheSize );
       }
    }
 
@@ -69,6 +69,11 @@ TMVA::MethodKNN::MethodKNN( const TString& jobName,
    , fUseKernel(kFALSE)
    , fUseWeight(kFALSE)
    , fUseLDA(kFALSE)
+   , fApproxEps(0)
+   , fMaxChecks(0)
+   , fNThreads(1)
+   , fBatchMode(kFALSE)
+   , fBatchFirst(0)
    , fTreeOptDepth(0)
 {
    // standard constructor
@@ -90,6 +95,11 @@ TMVA::MethodKNN::MethodKNN( DataSetInfo& theData,
    , fUseKernel(kFALSE)
    , fUseWeight(kFALSE)
    , fUseLDA(kFALSE)
+   , fApproxEps(0)
+   , fMaxChecks(0)
+   , fNThreads(1)
+   , fBatchMode(kFALSE)
+   , fBatchFirst(0)
    , fTreeOptDepth(0)
 {
    // constructor from weight file
@@ -116,6 +126,9 @@ void TMVA::MethodKNN::DeclareOptions()
    // fUseKernel    = false;  // use polynomial kernel weight function
    // fUseWeight    = true;   // count events using weights
    // fUseLDA       = false
+   // fApproxEps    = 0.0;    // relative distance error of approximate search
+   // fMaxChecks    = 0;      // maximum number of checked tree nodes per query
+   // fNThreads     = 1;      // number of threads for evaluation of the whole sample
 
    DeclareOptionRef(fnkNN         = 20,     "nkNN",         "Number of k-nearest neighbors");
    DeclareOptionRef(fBalanceDepth = 6,      "BalanceDepth", "Binary tree balance depth");
@@ -126,6 +139,9 @@ void TMVA::MethodKNN::DeclareOptions()
    DeclareOptionRef(fUseKernel    = kFALSE, "UseKernel",    "Use polynomial kernel weight");
    DeclareOptionRef(fUseWeight    = kTRUE,  "UseWeight",    "Use weight to count kNN events");
    DeclareOptionRef(fUseLDA       = kFALSE, "UseLDA",       "Use local linear discriminant - experimental feature");
+   DeclareOptionRef(fApproxEps    = 0.0,    "ApproxEps",    "Relative distance error of approximate kNN search (0 = exact search)");
+   DeclareOptionRef(fMaxChecks    = 0,      "MaxChecks",    "Maximum number of tree nodes checked by approximate kNN search (0 = no limit)");
+   DeclareOptionRef(fNThreads     = 1,      "NThreads",     "Number of threads used for kNN queries when evaluating a sample");
 }
 
 //_______________________________________________________________________
@@ -153,6 +169,18 @@ void TMVA::MethodKNN::ProcessOptions()
       fBalanceDepth = 6;
       Log() << kWARNING << "Optimize must be a positive integer: set Optimize = " << fBalanceDepth << Endl;      
    }
+   if (fApproxEps < 0.0) {
+      fApproxEps = 0.0;
+      Log() << kWARNING << "ApproxEps can not be negative: set ApproxEps = " << fApproxEps << Endl;
+   }
+   if (fMaxChecks < 0) {
+      fMaxChecks = 0;
+      Log() << kWARNING << "MaxChecks can not be negative: set MaxChecks = " << fMaxChecks << Endl;
+   }
+   if (!(fNThreads > 0)) {
+      fNThreads = 1;
+      Log() << kWARNING << "NThreads must be a positive integer: set NThreads = " << fNThreads << Endl;
+   }
 
    Log() << kVERBOSE
          << "kNN options: \n" 
@@ -162,7 +190,10 @@ void TMVA::MethodKNN::ProcessOptions()
          << "  ScaleFrac = \n" << fScaleFrac
          << "  Kernel = \n" << fKernel
          << "  Trim = \n" << fTrim 
-         << "  Optimize = " << fBalanceDepth << Endl;
+         << "  Optimize = " << fBalanceDepth
+         << "  ApproxEps = " << fApproxEps
+         << "  MaxChecks = " << fMaxChecks
+         << "  NThreads = " << fNThreads << Endl;
 }
 
 //_______________________________________________________________________
@@ -196,6 +227,8 @@ void TMVA::MethodKNN::MakeKNN()
    }
 
    fModule->Clear();
+   fModule->SetApprox(fApproxEps, static_cast<UInt_t>(fMaxChecks));
+   fBatchList.clear();
 
    std::string option;
    if (fScaleFrac > 0.0) {
@@ -302,9 +335,7 @@ Double_t TMVA::MethodKNN::GetMvaValue( Double_t* err, Double_t* errUpper )
    // events to avoid Monte-Carlo events with zero distance
    // most of CPU time is spent in this recursive function
    const kNN::Event event_knn(vvec, weight, 3);
-   fModule->Find(event_knn, knn + 2);
-
-   const kNN::List &rlist = fModule->GetkNNList();
+   const kNN::List &rlist = FindNeighbors(event_knn, knn + 2);
    if (rlist.size() != knn + 2) {
       Log() << kFATAL << "kNN result list is empty" << Endl;
       return -100.0;  
@@ -444,9 +475,7 @@ const std::vector< Float_t >& TMVA::MethodKNN::GetRegressionValues()
    // events to avoid Monte-Carlo events with zero distance
    // most of CPU time is spent in this recursive function
    const kNN::Event event_knn(vvec, evt->GetWeight(), 3);
-   fModule->Find(event_knn, knn + 2);
-
-   const kNN::List &rlist = fModule->GetkNNList();
+   const kNN::List &rlist = FindNeighbors(event_knn, knn + 2);
    if (rlist.size() != knn + 2) {
       Log() << kFATAL << "kNN result list is empty" << Endl;
       return *fRegressionReturnVal;
@@ -499,6 +528,65 @@ const std::vector< Float_t >& TMVA::MethodKNN::GetRegressionValues()
    return *fRegressionReturnVal;
 }
 
+//_______________________________________________________________________
+const TMVA::kNN::List& TMVA::MethodKNN::FindNeighbors(const kNN::Event &event_knn, const UInt_t nfind)
+{
+   // return the nfind nearest neighbors of the current event.
+   // When a whole sample is evaluated the queries are done in batches of
+   // consecutive events, which are searched in parallel by fNThreads threads
+
+   if (!fBatchMode) {
+      fModule->Find(event_knn, nfind);
+      return fModule->GetkNNList();
+   }
+
+   const Long64_t ievt = Data()->GetCurrentEventIdx();
+   if (ievt < fBatchFirst || ievt >= fBatchFirst + Long64_t(fBatchList.size())) {
+
+      const Long64_t batchSize = 1000*fNThreads;
+      const Long64_t nevt = TMath::Min(batchSize, Data()->GetNEvents() - ievt);
+      const UInt_t   nvar = GetNVariables();
+
+      kNN::EventVec events;
+      events.reserve(nevt);
+      for (Long64_t jevt = ievt; jevt < ievt + nevt; ++jevt) {
+         Data()->SetCurrentEvent(jevt);
+         const Event *ev = GetEvent();
+         kNN::VarVec vvec(nvar, 0.0);
+         for (UInt_t ivar = 0; ivar < nvar; ++ivar) vvec[ivar] = ev->GetValue(ivar);
+         events.push_back(kNN::Event(vvec, ev->GetWeight(), 3));
+      }
+      Data()->SetCurrentEvent(ievt);
+
+      fModule->FindBatch(events, fBatchList, nfind, "count", static_cast<UInt_t>(fNThreads));
+      fBatchFirst = ievt;
+   }
+
+   return fBatchList[ievt - fBatchFirst];
+}
+
+//_______________________________________________________________________
+void TMVA::MethodKNN::AddClassifierOutput( Types::ETreeType type )
+{
+   // evaluate the classifier on the whole sample using batch kNN queries
+   fBatchMode = kTRUE;
+   fBatchList.clear();
+   MethodBase::AddClassifierOutput(type);
+   fBatchMode = kFALSE;
+   fBatchList.clear();
+}
+
+//_______________________________________________________________________
+void TMVA::MethodKNN::AddRegressionOutput( Types::ETreeType type )
+{
+   // evaluate the regression on the whole sample using batch kNN queries
+   fBatchMode = kTRUE;
+   fBatchList.clear();
+   MethodBase::AddRegressionOutput(type);
+   fBatchMode = kFALSE;
+   fBatchList.clear();
+}
+
 //_______________________________________________________________________
 const TMVA::Ranking* TMVA::MethodKNN::CreateRanking() 
 {
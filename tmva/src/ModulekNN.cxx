@@ -33,6 +33,7 @@
 #include <algorithm>
 
 #include "TMath.h"
+#include "TThread.h"
 
 // TMVA
 #include "TMVA/MsgLogger.h"
@@ -159,6 +160,8 @@ TRandom3 TMVA::kNN::ModulekNN::fgRndm(1);
 TMVA::kNN::ModulekNN::ModulekNN()
    :fDimn(0),
     fTree(0),
+    fApproxEps(0.0),
+    fApproxChecks(0),
     fLogger( new MsgLogger("ModulekNN") )
 {
    // default constructor
@@ -352,24 +355,142 @@ Bool_t TMVA::kNN::ModulekNN::Find(Event event, const UInt_t nfind, const std::st
    // latest event for k-nearest neighbor search
    fkNNEvent = event;
    fkNNList.clear();
-   
+
+   FindList(fkNNList, event, nfind, option);
+
+   return kTRUE;
+}
+
+//-------------------------------------------------------------------------------------------
+void TMVA::kNN::ModulekNN::FindList(List &nlist, Event event, const UInt_t nfind, const std::string &option) const
+{
+   // search the tree for the nearest neighbors of an already scaled event,
+   // only reads the module so it can be called from several threads at once
+
    if(option.find("weight") != std::string::npos)
    {
       // recursive kd-tree search for nfind-nearest neighbors
       // use event weight to find all nearest events
       // that have sum of weights >= nfind
-      kNN::Find<kNN::Event>(fkNNList, fTree, event, Double_t(nfind), 0.0);
+      kNN::Find<kNN::Event>(nlist, fTree, event, Double_t(nfind), 0.0);
+   }
+   else if (fApproxEps > 0.0 || fApproxChecks > 0)
+   {
+      // priority search for approximate nfind-nearest neighbors
+      kNN::FindApprox<kNN::Event>(nlist, fTree, event, nfind, fApproxEps, fApproxChecks);
    }
    else
    {
       // recursive kd-tree search for nfind-nearest neighbors
       // count nodes and do not use event weight
-      kNN::Find<kNN::Event>(fkNNList, fTree, event, nfind);      
+      kNN::Find<kNN::Event>(nlist, fTree, event, nfind);      
+   }
+}
+
+namespace TMVA {
+   namespace kNN {
+      // work unit of one thread of ModulekNN::FindBatch
+      struct FindBatchArgs {
+         const ModulekNN   *fModule;
+         const EventVec    *fEvents;
+         std::vector<List> *fResult;
+         const std::string *fOption;
+         UInt_t             fNFind;
+         UInt_t             fFirst;
+         UInt_t             fLast;
+      };
+   }
+}
+
+//-------------------------------------------------------------------------------------------
+void* TMVA::kNN::ModulekNN::FindBatchThread(void *arg)
+{
+   // thread function: search the nearest neighbors for a range of events
+   FindBatchArgs *args = static_cast<FindBatchArgs *>(arg);
+   for (UInt_t ievt = args->fFirst; ievt < args->fLast; ++ievt) {
+      args->fModule->FindList((*args->fResult)[ievt], (*args->fEvents)[ievt], args->fNFind, *args->fOption);
+   }
+   return 0;
+}
+
+//-------------------------------------------------------------------------------------------
+Bool_t TMVA::kNN::ModulekNN::FindBatch(const EventVec &events, std::vector<List> &result,
+                                       const UInt_t nfind, const std::string &option,
+                                       const UInt_t nthreads) const
+{
+   // find nearest neighbors of all events; result[i] holds the neighbor list
+   // of events[i]. The events are rescaled once and then split in equal ranges
+   // over nthreads threads, which search the (read-only) tree concurrently.
+   // The latest result list (GetkNNList) is not modified.
+
+   if (!fTree) {
+      Log() << kFATAL << "ModulekNN::FindBatch() - tree has not been filled" << Endl;
+      return kFALSE;
+   }
+   if (nfind < 1) {
+      Log() << kFATAL << "ModulekNN::FindBatch() - requested 0 nearest neighbors" << Endl;
+      return kFALSE;
+   }
+
+   EventVec scaled;
+   scaled.reserve(events.size());
+   for (EventVec::const_iterator it = events.begin(); it != events.end(); ++it) {
+      if (fDimn != it->GetNVar()) {
+         Log() << kFATAL << "ModulekNN::FindBatch() - number of dimension does not match training events" << Endl;
+         return kFALSE;
+      }
+      scaled.push_back(fVarScale.empty() ? *it : Scale(*it));
+   }
+
+   result.clear();
+   result.resize(scaled.size());
+
+   const UInt_t nevent  = scaled.size();
+   const UInt_t nworker = std::max(1u, std::min(nthreads, nevent));
+   const UInt_t nchunk  = (nevent + nworker - 1)/nworker;
+
+   std::vector<FindBatchArgs> args(nworker);
+   for (UInt_t i = 0; i < nworker; ++i) {
+      args[i].fModule = this;
+      args[i].fEvents = &scaled;
+      args[i].fResult = &result;
+      args[i].fOption = &option;
+      args[i].fNFind  = nfind;
+      args[i].fFirst  = std::min(nevent, i*nchunk);
+      args[i].fLast   = std::min(nevent, (i + 1)*nchunk);
+   }
+
+   if (nworker == 1) {
+      FindBatchThread(&args[0]);
+      return kTRUE;
+   }
+
+   // the calling thread processes the last range itself
+   std::vector<TThread *> threads(nworker - 1, (TThread *)0);
+   for (UInt_t i = 0; i + 1 < nworker; ++i) {
+      threads[i] = new TThread(Form("kNNFind%d", i), FindBatchThread, (void *)&args[i]);
+      threads[i]->Run();
+   }
+   FindBatchThread(&args[nworker - 1]);
+   for (UInt_t i = 0; i + 1 < nworker; ++i) {
+      threads[i]->Join();
+      delete threads[i];
    }
 
    return kTRUE;
 }
 
+//-------------------------------------------------------------------------------------------
+void TMVA::kNN::ModulekNN::SetApprox(const Float_t eps, const UInt_t nmaxcheck)
+{
+   // switch to approximate search for the count option: the distance of each
+   // returned neighbor is at most (1+eps) times the exact one and at most
+   // nmaxcheck nodes are checked per query (0 = no limit); eps = 0 and 
+   // nmaxcheck = 0 restore the exact search
+   fApproxEps    = (eps > 0.0 ? eps : 0.0);
+   fApproxChecks = nmaxcheck;
+}
+
 //-------------------------------------------------------------------------------------------
 Bool_t TMVA::kNN::ModulekNN::Find(const UInt_t nfind, const std::string &option) const
 {
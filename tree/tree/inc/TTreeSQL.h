@@ -38,6 +38,7 @@
 
 class TSQLServer;
 class TSQLRow;
+class TSQLStatement;
 class TBasketSQL;
 
 class TTreeSQL : public TTree {
@@ -92,6 +93,9 @@ public:
    virtual Long64_t       PrepEntry(Long64_t entry);
            void           Refresh();
 
+   static  TTree         *ImportStatement(TSQLStatement *stmt, const char *name, const char *title = "",
+                                          const char *branchDescriptor = "", Int_t bulksize = 1000);
+
    ClassDef(TTreeSQL,1);  // TTree Implementation read and write to a SQL database.
 };
 
@@ -1140,7 +1140,7 @@ void TBranchElement::BuildTitle(const char* name)
       if (dim>=0) {
          branchname.Remove(dim);
       }
-      branchname += Form("[%s_]",name);
+      branchname.AppendFormat("[%s_]",name);
       bre->SetTitle(branchname);
       if (lf) {
          lf->SetTitle(branchname);
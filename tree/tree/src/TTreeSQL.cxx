@@ -34,6 +34,9 @@
 #include "TSQLRow.h"
 #include "TSQLResult.h"
 #include "TSQLServer.h"
+#include "TSQLStatement.h"
+#include "TObjArray.h"
+#include "TObjString.h"
 
 #include "TTreeSQL.h"
 #include "TBasketSQL.h"
@@ -543,6 +546,117 @@ Bool_t TTreeSQL::CreateTable(const TString &table)
    return (fResult!=0);
 }
 
+//______________________________________________________________________________
+TTree *TTreeSQL::ImportStatement(TSQLStatement *stmt, const char *name, const char *title,
+                                 const char *branchDescriptor, Int_t bulksize)
+{
+   // Create a new TTree in the current directory and fill it with all rows of
+   // the result set of the statement. The statement should be processed and
+   // its result stored with TSQLStatement::StoreResult() before.
+   // The branchDescriptor describes one branch per column of the result set,
+   // in the same order, with the syntax of TTree::ReadFile: "id/I:e/D:name/C".
+   // Supported types are I, i, L, l, F, D and C (strings up to 255 characters).
+   // If branchDescriptor is empty, all columns are stored as Double_t in
+   // branches named after the fields.
+   // Rows are fetched with TSQLStatement::FetchBulk() in blocks of bulksize
+   // rows into typed arrays, from which the branch buffers are filled
+   // without any conversion to text.
+
+   if (stmt==0) return 0;
+
+   Int_t ncols = stmt->GetNumFields();
+   if (ncols<=0) {
+      ::Error("TTreeSQL::ImportStatement", "Statement does not have a result set");
+      return 0;
+   }
+   if (bulksize<=0) bulksize = 1000;
+
+   const Int_t kMaxString = 256;
+
+   std::vector<TString> names(ncols);
+   std::vector<char> types(ncols, 'D');
+
+   if (branchDescriptor && *branchDescriptor) {
+      TObjArray *tokens = TString(branchDescriptor).Tokenize(":");
+      if (tokens->GetEntriesFast()!=ncols) {
+         ::Error("TTreeSQL::ImportStatement", "Branch descriptor has %d entries while result set has %d columns",
+                 tokens->GetEntriesFast(), ncols);
+         delete tokens;
+         return 0;
+      }
+      for (Int_t n=0;n<ncols;n++) {
+         TString tok = ((TObjString*) tokens->At(n))->GetString();
+         Ssiz_t pos = tok.Last('/');
+         if (pos==kNPOS) {
+            names[n] = tok;
+         } else {
+            names[n] = tok(0, pos);
+            types[n] = (pos+1<tok.Length()) ? tok[pos+1] : ' ';
+         }
+         if (strchr("IiLlFDC", types[n])==0) {
+            ::Error("TTreeSQL::ImportStatement", "Unsupported type %c for branch %s", types[n], names[n].Data());
+            delete tokens;
+            return 0;
+         }
+      }
+      delete tokens;
+   } else {
+      for (Int_t n=0;n<ncols;n++)
+         names[n] = stmt->GetFieldName(n);
+   }
+
+   TTree *tree = new TTree(name, title);
+
+   std::vector<char*> arrays(ncols);
+   std::vector<char*> values(ncols);
+   std::vector<Int_t> sizes(ncols);
+
+   stmt->ResetBulk();
+   for (Int_t n=0;n<ncols;n++) {
+      Int_t bulktype = 0;
+      switch (types[n]) {
+         case 'I': bulktype = TSQLStatement::kBulkInt; sizes[n] = sizeof(Int_t); break;
+         case 'i': bulktype = TSQLStatement::kBulkUInt; sizes[n] = sizeof(UInt_t); break;
+         case 'L': bulktype = TSQLStatement::kBulkLong64; sizes[n] = sizeof(Long64_t); break;
+         case 'l': bulktype = TSQLStatement::kBulkULong64; sizes[n] = sizeof(ULong64_t); break;
+         case 'F': bulktype = TSQLStatement::kBulkFloat; sizes[n] = sizeof(Float_t); break;
+         case 'D': bulktype = TSQLStatement::kBulkDouble; sizes[n] = sizeof(Double_t); break;
+         case 'C': bulktype = TSQLStatement::kBulkString; sizes[n] = kMaxString; break;
+      }
+      arrays[n] = new char[bulksize*sizes[n]];
+      values[n] = new char[sizes[n]];
+      memset(values[n], 0, sizes[n]);
+      stmt->BindBulkColumn(n, bulktype, arrays[n], sizes[n]);
+      tree->Branch(names[n].Data(), values[n], TString::Format("%s/%c", names[n].Data(), types[n]).Data());
+   }
+
+   Int_t nrows = 0;
+   while ((nrows = stmt->FetchBulk(bulksize)) > 0) {
+      for (Int_t row=0;row<nrows;row++) {
+         for (Int_t n=0;n<ncols;n++) {
+            if (types[n]=='C')
+               strcpy(values[n], arrays[n] + row*sizes[n]);
+            else
+               memcpy(values[n], arrays[n] + row*sizes[n], sizes[n]);
+         }
+         tree->Fill();
+      }
+   }
+
+   if (stmt->IsError())
+      ::Error("TTreeSQL::ImportStatement", "Error when fetching rows: %s", stmt->GetErrorMsg());
+
+   stmt->ResetBulk();
+   tree->ResetBranchAddresses();
+
+   for (Int_t n=0;n<ncols;n++) {
+      delete [] arrays[n];
+      delete [] values[n];
+   }
+
+   return tree;
+}
+
 //______________________________________________________________________________
 void TTreeSQL::Init()
 {
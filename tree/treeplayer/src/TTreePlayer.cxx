@@ -2510,7 +2510,7 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
 
    for (ui=0;ui<ncols;ui++) {
       TString starFormat = Form("*%%%d.%ds",colSizes[ui]+2,colSizes[ui]+2);
-      onerow += Form(starFormat.Data(),var[ui]->PrintValue(-2));
+      onerow.AppendFormat(starFormat.Data(),var[ui]->PrintValue(-2));
    }
    if (fScanRedirect)
       out<<onerow.Data()<<"*"<<endl;
@@ -2520,7 +2520,7 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
    if (hasArray) onerow += "* Instance ";
    for (ui=0;ui<ncols;ui++) {
       TString numbFormat = Form("* %%%d.%ds ",colSizes[ui],colSizes[ui]);
-      onerow += Form(numbFormat.Data(),var[ui]->PrintValue(-1));
+      onerow.AppendFormat(numbFormat.Data(),var[ui]->PrintValue(-1));
    }
    if (fScanRedirect)
       out<<onerow.Data()<<"*"<<endl;
@@ -2530,7 +2530,7 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
    if (hasArray) onerow += "***********";
    for (ui=0;ui<ncols;ui++) {
       TString starFormat = Form("*%%%d.%ds",colSizes[ui]+2,colSizes[ui]+2);
-      onerow += Form(starFormat.Data(),var[ui]->PrintValue(-2));
+      onerow.AppendFormat(starFormat.Data(),var[ui]->PrintValue(-2));
    }
    if (fScanRedirect)
       out<<onerow.Data()<<"*"<<endl;
@@ -2596,14 +2596,14 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
          }
          onerow = Form("* %8lld ",entryNumber);
          if (hasArray) {
-            onerow += Form("* %8d ",inst);
+            onerow.AppendFormat("* %8d ",inst);
          }
          for (ui=0;ui<ncols;++ui) {
             TString numbFormat = Form("* %%%d.%ds ",colSizes[ui],colSizes[ui]);
-            if (var[ui]->GetNdim()) onerow += Form(numbFormat.Data(),var[ui]->PrintValue(0,inst,colFormats[ui].Data()));
+            if (var[ui]->GetNdim()) onerow.AppendFormat(numbFormat.Data(),var[ui]->PrintValue(0,inst,colFormats[ui].Data()));
             else {
                TString emptyForm = Form("* %%%dc ",colSizes[ui]);
-               onerow += Form(emptyForm.Data(),' ');
+               onerow.AppendFormat(emptyForm.Data(),' ');
             }
          }
          fSelectedRows++;
@@ -2630,7 +2630,7 @@ Long64_t TTreePlayer::Scan(const char *varexp, const char *selection,
    if (hasArray) onerow += "***********";
    for (ui=0;ui<ncols;ui++) {
       TString starFormat = Form("*%%%d.%ds",colSizes[ui]+2,colSizes[ui]+2);
-      onerow += Form(starFormat.Data(),var[ui]->PrintValue(-2));
+      onerow.AppendFormat(starFormat.Data(),var[ui]->PrintValue(-2));
    }
    if (fScanRedirect)
       out<<onerow.Data()<<"*"<<endl;
@@ -633,10 +633,10 @@ void TMemStatShow::FillBTString(Int_t entry,Int_t mode,TString &btstring)
       if (strstr(bar,"libMemStat")) continue;
       if (strstr(bar,"G__Exception")) continue;
       if (mode) {
-         btstring += TString::Format("%s ",bar);
+         btstring.AppendFormat("%s ",bar);
          if (btstring.Length() > 80) return;
       } else {
-         btstring += TString::Format("%2d %s\n",i,bar+1);
+         btstring.AppendFormat("%2d %s\n",i,bar+1);
       }
    }
 }